@@ -8,7 +8,9 @@
 
 #include "BleManager.h"
 #include "DisplayManager.h"
+#include "../../shared/heap/HeapGuard.h"
 #include "Config.h"
+#include "../../shared/log/DeferredLog.h"
 
 BleManager::BleManager(DisplayManager* displayManager) : 
     _displayManager(displayManager),
@@ -59,48 +61,52 @@ void BleManager::init() {
     _pStatusCharacteristic->setValue("Ready");
 }
 
-void BleManager::sendStatusUpdate(const String& status) {
+void BleManager::sendStatusUpdate(const char* status) {
     if (_deviceConnected) {
-        _pStatusCharacteristic->setValue(status.c_str());
+        HeapGuardAllow allow;   // stiva BLE își alocă singură notificarea
+        _pStatusCharacteristic->setValue(status);
         _pStatusCharacteristic->notify();
-        Serial.print("Status notificat: ");
-        Serial.println(status);
+        LOG_DEBUG("Status notificat: %s", status);
     }
 }
 
 void BleManager::onConnect(BLEServer* pServer) {
     _deviceConnected = true;
-    Serial.println("Dispozitiv conectat!");
+    LOG_INFO("Dispozitiv conectat!");
     sendStatusUpdate("Connected");
 }
 
 void BleManager::onDisconnect(BLEServer* pServer) {
     _deviceConnected = false;
-    Serial.println("Dispozitiv deconectat!");
+    LOG_INFO("Dispozitiv deconectat!");
     
     // Repornește advertising când te deconectezi, pentru a permite noi conexiuni
     delay(500); // Delay mic pentru stabilizare
     pServer->startAdvertising();
-    Serial.println("Restarting advertising");
+    LOG_INFO("Restarting advertising");
 }
 
 void BleManager::onWrite(BLECharacteristic* characteristic) {
-    if (characteristic->getUUID().toString() == SIGN_CHARACTERISTIC_UUID) {
-        // Obținem valoarea caracteristicii ca un șir de caractere
-        String command = characteristic->getValue().c_str(); // Conversia la const char* și apoi la String Arduino
-        
-        Serial.print("Comandă primită: ");
-        Serial.println(command);
+    if (characteristic == _pSignCharacteristic) {
+        // Callback-ul stivei BLE: comanda se copiază într-un buffer fix, fără String
+        HeapGuardHot hot("BLE");
+        char command[BLE_COMMAND_MAX];
+        size_t len = min(characteristic->getLength(), sizeof(command) - 1);
+        memcpy(command, characteristic->getData(), len);
+        command[len] = '\0';
+        LOG_INFO("Comandă primită: %s", command);
         
         // Procesează comanda primită
         if (_displayManager) {
             // Afișarea semnului corespunzător
-            _displayManager->showTrafficSign(command.c_str());
+            _displayManager->showTrafficSign(command);
             
             // Trimitere confirmare că semnul a fost afișat
-            sendStatusUpdate("Sign updated: " + command);
+            char status[BLE_STATUS_MAX];
+            snprintf(status, sizeof(status), "Sign updated: %s", command);
+            sendStatusUpdate(status);
         } else {
-            Serial.println("Error: Display Manager not initialized");
+            LOG_ERROR("Display Manager not initialized");
             sendStatusUpdate("Error: Display Manager not initialized");
         }
     }
@@ -25,11 +25,14 @@ class DisplayManager;
 #define SIGN_CHARACTERISTIC_UUID         "8f0e0d0c-0b0a-0908-0706-050403020101"
 #define STATUS_CHARACTERISTIC_UUID       "8f0e0d0c-0b0a-0908-0706-050403020102"
 
+#define BLE_STATUS_MAX 128               // un mesaj de stare, formatat pe stivă
+#define BLE_COMMAND_MAX 32               // o comandă de la aplicație (numele semnului)
+
 class BleManager : public BLEServerCallbacks, public BLECharacteristicCallbacks {
 public:
     BleManager(DisplayManager* displayManager);
     void init();
-    void sendStatusUpdate(const String& status);
+    void sendStatusUpdate(const char* status);
     
     // Metode de callback pentru BLEServerCallbacks
     void onConnect(BLEServer* pServer) override;
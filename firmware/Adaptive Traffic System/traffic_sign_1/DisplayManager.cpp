@@ -34,7 +34,7 @@ DisplayManager epaperDisplay;
 // CONSTRUCTOR
 // ----------------------------------------------------------------------
 DisplayManager::DisplayManager()
-  : display(GxEPD2_213_flex(PIN_CS, PIN_DC, PIN_RST, /*busy*/ PIN_BUSY)) {}
+  : display(GxEPD2_213_flex(PIN_CS, PIN_DC, PIN_RST, /*busy*/ PIN_BUSY)), panelRefresh(true) {}
 
 // ----------------------------------------------------------------------
 // INITIALIZARE
@@ -79,6 +79,13 @@ void DisplayManager::clipire(int n) {
   delay(300);
 }
 
+void DisplayManager::setPanelRefresh(bool enabled) { panelRefresh = enabled; }
+
+bool DisplayManager::nextPage() {
+  // Fără refresh, pagina desenată nu pleacă spre panou (bufferul are toată înălțimea)
+  return panelRefresh && display.nextPage();
+}
+
 void DisplayManager::drawCenteredText(const char* txt, int16_t baselineY, uint8_t sz) {
   int16_t x1, y1; uint16_t w, h;
   display.setTextSize(sz);
@@ -92,7 +99,7 @@ void DisplayManager::drawCenteredText(const char* txt, int16_t baselineY, uint8_
 // ----------------------------------------------------------------------
 void DisplayManager::fullRefresh() {
   display.firstPage();
-  do { display.fillScreen(GxEPD_WHITE); } while (display.nextPage());
+  do { display.fillScreen(GxEPD_WHITE); } while (nextPage());
   delay(50);
 }
 
@@ -105,7 +112,7 @@ void DisplayManager::update() {
   display.firstPage();
   do {
     // Conținutul este deja desenat prin alte metode
-  } while (display.nextPage());
+  } while (nextPage());
 }
 void DisplayManager::hibernate()   { display.hibernate(); }
 
@@ -125,7 +132,7 @@ void DisplayManager::welcomeMessage() {
     display.setTextSize(1);
     display.setCursor(10, 80);  display.println("Bulgariu Elena-Iuliana");
     display.setCursor(10, 95);  display.println("19.06.2025");
-  } while (display.nextPage());
+  } while (nextPage());
   clipire(3);
 }
 
@@ -144,7 +151,7 @@ void DisplayManager::showTrafficSign(const char* sign) {
       display.setTextSize(1);
       drawCenteredText("Semn necunoscut:", 20, 1);
       drawCenteredText(sign,                 40, 2);
-    } while (display.nextPage());
+    } while (nextPage());
   }
 }
 
@@ -197,7 +204,7 @@ void DisplayManager::showStopSign() {
     display.setCursor(cx - w / 2, baselineY);
     display.print(txt);
 
-  } while (display.nextPage());
+  } while (nextPage());
 }
 
 
@@ -234,7 +241,7 @@ void DisplayManager::showYieldSign() {
     drawCenteredText("CEDEAZĂ",  cy + s + 10, YIELD_TEXT_SIZE);
     drawCenteredText("TRECEREA", cy + s + 22, YIELD_TEXT_SIZE);
 
-  } while (display.nextPage());
+  } while (nextPage());
 }
 
 // ----------------------------------------------------------------------
@@ -267,5 +274,5 @@ void DisplayManager::showSpeedLimitSign(int limit) {
     display.setTextSize(1);
     drawCenteredText("km/h", cy + r + KMH_OFFSET, 1);
 
-  } while (display.nextPage());
+  } while (nextPage());
 }
@@ -33,6 +33,9 @@ class DisplayManager {
     // Funcții utilitare
     void drawCenteredText(const char* text, int16_t y, uint8_t textSize);
     void clipire(int n); // Mutată din codul principal
+
+    // false: desenele rămân în buffer, fără transfer SPI și refresh al panoului (microbenchmark-uri)
+    void setPanelRefresh(bool enabled);
    
     
   private:
@@ -47,12 +50,16 @@ class DisplayManager {
     
     // Driver pentru display e-paper 2.13" MH-ET LIVE (212×104 pixeli)
     GxEPD2_BW<GxEPD2_213_flex, GxEPD2_213_flex::HEIGHT> display;
+    bool panelRefresh;
     
     // Metode de inițializare
     void initPins();
     void resetDisplay();
     void initSPI();
     void initDisplay();
+
+    // display.nextPage(), doar cu refresh-ul panoului activ
+    bool nextPage();
 };
 
 extern DisplayManager epaperDisplay;
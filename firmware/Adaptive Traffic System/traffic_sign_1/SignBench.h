@@ -0,0 +1,25 @@
+#ifndef SIGN_BENCH_H
+#define SIGN_BENCH_H
+
+#include "../../shared/bench/MicroBench.h"
+
+/**
+ * Microbenchmark-urile semnului: desenarea semnului STOP (geometrie și text), routerul
+ * showTrafficSign() și parserele mesajelor ESP-NOW de la semne și de la vehicule,
+ * pe corpusuri fixe. Desenele rămân în bufferul display-ului (fără refresh al panoului).
+ *
+ * Cu SIGN_BENCH=1, setup() doar le rulează și tipărește JSON-ul pe Serial
+ * (MicroBenchArduino.h); pe calculator le rulează tools/host-sim/bench/sign_bench.
+ * Definițiile sunt în SignBenchKernels.h, inclus la sfârșitul schiței (după ESP_NOW_Peer_Class).
+ */
+
+#ifndef SIGN_BENCH
+#define SIGN_BENCH 0
+#endif
+
+#define SIGN_BENCH_CORPUS 8
+
+extern const BenchCase SIGN_BENCH_CASES[];
+extern const size_t SIGN_BENCH_CASE_COUNT;
+
+#endif
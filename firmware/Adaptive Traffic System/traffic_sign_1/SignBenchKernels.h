@@ -0,0 +1,83 @@
+// Cazurile din SignBench.h; inclus o singură dată, la sfârșitul traffic_sign_1.ino
+
+// Parserele sunt metode ale peer-ului; acesta nu este înregistrat, deci nu trimite nimic
+static ESP_NOW_Peer_Class& signBenchPeer() {
+  static ESP_NOW_Peer_Class peer(ESP_NOW.BROADCAST_ADDR, ESPNOW_WIFI_CHANNEL, WIFI_IF_STA, NULL);
+  return peer;
+}
+
+// ******************* DISPLAY *****************************************
+static const char* const SIGN_BENCH_SIGNS[SIGN_BENCH_CORPUS] = {
+  "STOP", "YIELD", "SPEED_LIMIT_30", "SPEED_LIMIT_50", "ACCIDENT", "OBSTACOL", "URGENTA", "#12"
+};
+
+static void signBenchDisplaySetup() {
+  epaperDisplay.setPanelRefresh(false);
+}
+
+static void signBenchStopSign(uint32_t iterations) {
+  for (uint32_t i = 0; i < iterations; i++) {
+    epaperDisplay.showStopSign();
+  }
+}
+
+static void signBenchRouter(uint32_t iterations) {
+  for (uint32_t i = 0; i < iterations; i++) {
+    for (int s = 0; s < SIGN_BENCH_CORPUS; s++) {
+      epaperDisplay.showTrafficSign(SIGN_BENCH_SIGNS[s]);
+    }
+  }
+}
+
+// ******************* MESAJE ESP-NOW **********************************
+// Schimbări de semn, un mesaj pentru alt semn și mesaje prioritare cunoscute și necunoscute
+static const traffic_message SIGN_BENCH_SIGN_MESSAGES[SIGN_BENCH_CORPUS] = {
+  { 0, "STOP", 0 },
+  { SIGN_ID, "YIELD", 0 },
+  { SIGN_ID + 1, "STOP", 0 },
+  { 0, "ACCIDENT", 1 },
+  { 0, "OBSTACOL", 1 },
+  { SIGN_ID, "SPEED_LIMIT_30", 0 },
+  { 0, "EMERGENCY", 1 },
+  { 0, "DRUM INCHIS", 1 },
+};
+
+// Toate tipurile de eveniment, direct de la vehicul (propagate) și retransmise broadcast
+static const ElysiumMessage SIGN_BENCH_VEHICLE_MESSAGES[SIGN_BENCH_CORPUS] = {
+  { EVENT_NORMAL, 1, "Elysium RC" },
+  { EVENT_ACCIDENT, 9, "Intersectia 1" },
+  { EVENT_OBSTACLE, 5, "Banda 2" },
+  { EVENT_EMERGENCY, 10, "Elysium RC" },
+  { EVENT_ACCIDENT, 7, "Elysium RC" },
+  { EVENT_NORMAL, 1, "Parcare" },
+  { EVENT_OBSTACLE, 3, "Curba nord" },
+  { EVENT_EMERGENCY, 8, "Intersectia 2" },
+};
+
+static void signBenchSignMessages(uint32_t iterations) {
+  for (uint32_t i = 0; i < iterations; i++) {
+    for (int m = 0; m < SIGN_BENCH_CORPUS; m++) {
+      signBenchPeer().processTrafficSignMessage((const uint8_t*)&SIGN_BENCH_SIGN_MESSAGES[m],
+                                                sizeof(traffic_message), true);
+    }
+  }
+}
+
+static void signBenchVehicleMessages(uint32_t iterations) {
+  for (uint32_t i = 0; i < iterations; i++) {
+    for (int m = 0; m < SIGN_BENCH_CORPUS; m++) {
+      signBenchPeer().processVehicleMessage((const uint8_t*)&SIGN_BENCH_VEHICLE_MESSAGES[m],
+                                            sizeof(ElysiumMessage), m % 2 == 0);
+    }
+  }
+  // Evenimentele marcate pentru propagare nu pleacă nicăieri
+  propaga_mesaj_urgenta = false;
+}
+
+const BenchCase SIGN_BENCH_CASES[] = {
+  { "sign/display_stop", signBenchDisplaySetup, signBenchStopSign, 1 },
+  { "sign/display_router", signBenchDisplaySetup, signBenchRouter, SIGN_BENCH_CORPUS },
+  { "sign/traffic_sign_message", signBenchDisplaySetup, signBenchSignMessages, SIGN_BENCH_CORPUS },
+  { "sign/vehicle_message", signBenchDisplaySetup, signBenchVehicleMessages, SIGN_BENCH_CORPUS },
+};
+const size_t SIGN_BENCH_CASE_COUNT = sizeof(SIGN_BENCH_CASES) / sizeof(SIGN_BENCH_CASES[0]);
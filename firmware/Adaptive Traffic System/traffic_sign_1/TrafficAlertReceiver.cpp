@@ -1,4 +1,5 @@
 #include "TrafficAlertReceiver.h"
+#include "Config.h"
 #include <esp_wifi.h>  // Necesar pentru esp_wifi_set_protocol
 
 // Inițializare pointer static
@@ -47,6 +48,13 @@ void TrafficAlertReceiver::setElysiumMac(const uint8_t* mac) {
 void TrafficAlertReceiver::onDataReceived(const esp_now_recv_info_t* info, const uint8_t* data, int data_len) {
   // Verifică dacă avem o instanță validă
   if (!_instance) return;
+
+  // Alertele cu confirmare se acceptă de la orice vehicul (au magic și versiune proprii)
+  AlertFrame alert;
+  if (alertDecode(data, data_len, alert)) {
+    _instance->processAlert(info->src_addr, alert);
+    return;
+  }
   
   // Verifică dacă mesajul este de la Elysium
   if (memcmp(info->src_addr, _instance->_elysiumMacAddress, 6) == 0) {
@@ -91,3 +99,30 @@ void TrafficAlertReceiver::processMessage(const ElysiumMessage& message) {
       break;
   }
 }
+
+// Confirmă alerta unicast către expeditor; un incident nou se afișează o singură dată
+void TrafficAlertReceiver::processAlert(const uint8_t* srcMac, const AlertFrame& alert) {
+  if (alert.type != ALERT_TYPE_ALERT) return;
+
+  if (!esp_now_is_peer_exist(srcMac)) {
+    esp_now_peer_info_t peerInfo = {};
+    memcpy(peerInfo.peer_addr, srcMac, 6);
+    peerInfo.channel = 0;                 // canalul curent
+    peerInfo.encrypt = false;
+    esp_now_add_peer(&peerInfo);
+  }
+
+  AlertFrame ack = alert;
+  ack.type = ALERT_TYPE_ACK;
+  ack.signId = SIGN_ID;
+  uint8_t buffer[ALERT_FRAME_LEN];
+  size_t len = alertEncode(ack, buffer);
+  esp_now_send(srcMac, buffer, len);
+
+  if (!_seenAlerts.insert(alert.incidentId)) return;
+
+  ElysiumMessage message = {};
+  message.eventType = alert.event;
+  message.severity = alert.severity;
+  processMessage(message);
+}
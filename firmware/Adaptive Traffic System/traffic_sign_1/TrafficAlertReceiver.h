@@ -5,6 +5,7 @@
 #include <esp_now.h>
 #include <WiFi.h>
 #include "DisplayManager.h"
+#include "../../shared/alert/AlertProtocol.h"
 
 // Tipuri de evenimente ce pot fi primite de la Elysium RC
 enum ElysiumEventType {
@@ -32,6 +33,9 @@ private:
   DisplayManager* _displayManager;
   uint8_t _elysiumMacAddress[6];
   bool _isInitialized;
+  AlertSeenCache<8> _seenAlerts;   // incidentele deja afișate
+
+  void processAlert(const uint8_t* srcMac, const AlertFrame& alert);
 
   // Callback-uri statice pentru ESP-Now
   static void onDataReceived(const esp_now_recv_info_t* info, const uint8_t* data, int data_len);
@@ -31,6 +31,11 @@ extern struct traffic_message mesaj_urgenta_de_propagat; // struct forward decla
 #include <esp_wifi.h>
 #include <esp_mac.h>  // Pentru macrourile MAC2STR și MACSTR
 #include <vector>
+#include "../../shared/log/DeferredLog.h"
+#include "../../shared/heap/HeapGuard.h"
+#include "../../shared/alert/AlertProtocol.h"
+#include "../../shared/bench/MicroBenchArduino.h"
+#include "SignBench.h"
 
 // Dezactivăm modulul TrafficAlertReceiver deoarece funcționalitatea sa 
 // a fost integrată în implementarea ESP32_NOW
@@ -69,6 +74,21 @@ typedef struct __attribute__((packed)) traffic_message {
 volatile bool propaga_mesaj_urgenta = false;
 traffic_message mesaj_urgenta_de_propagat;
 
+// Incidentele deja afișate; retransmisiile vehiculului se confirmă din nou, dar nu se mai afișează
+static AlertSeenCache<8> alerteVazute;
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+// Patru octeți consecutivi din mesaj, pentru afișarea hex în jurnal (completați cu 0);
+// folosită doar de LOG_DEBUG, deci compilată doar cu nivelul activ
+static uint32_t hexWord(const uint8_t *data, size_t len, size_t offset) {
+  uint32_t word = 0;
+  for (size_t i = offset; i < offset + 4; i++) {
+    word = (word << 8) | (i < len ? data[i] : 0);
+  }
+  return word;
+}
+#endif
+
 /* Clasă pentru gestionarea peer-ilor ESP-NOW */
 class ESP_NOW_Peer_Class : public ESP_NOW_Peer {
 public:
@@ -94,23 +114,21 @@ public:
 
   // Funcție pentru procesarea mesajelor primite de la master
   void onReceive(const uint8_t *data, size_t len, bool broadcast) {
-    Serial.printf("Mesaj primit de la master " MACSTR " (%s)\n", MAC2STR(addr()), broadcast ? "broadcast" : "unicast");
-    
-    // Afișăm conținutul mesajului pentru debugging
-    Serial.print("Conținut mesaj (text): '");
-    for (int i = 0; i < len && i < 32; i++) {
-      Serial.print((char)data[i]);
-    }
-    Serial.println("'");
-
-    Serial.print("Conținut mesaj (hex): ");
-    for (int i = 0; i < len && i < 16; i++) {
-      Serial.printf("%02X ", data[i]);
-    }
-    Serial.println();
+    // Suntem în callback-ul radio: doar copiem datele în jurnal, formatarea se face mai târziu
+    HeapGuardHot hot("ESP-NOW");
+    // Argumentele LOG_DEBUG nu se evaluează când nivelul este dezactivat
+    LOG_DEBUG("Mesaj primit de la master %02x:%02x:%02x:%02x:%02x:%02x (%s)",
+              addr()[0], addr()[1], addr()[2], addr()[3], addr()[4], addr()[5], broadcast ? "broadcast" : "unicast");
+    LOG_DEBUG("Conținut mesaj (hex, %u octeți): %08lX %08lX %08lX %08lX", (unsigned)len,
+              hexWord(data, len, 0), hexWord(data, len, 4), hexWord(data, len, 8), hexWord(data, len, 12));
     
     // Analizăm tipul de mesaj primit și îl procesăm corespunzător
-    if (len == sizeof(traffic_message)) {
+    AlertFrame alert;
+    if (alertDecode(data, len, alert)) {
+      // Alertă cu confirmare de la un vehicul
+      processAlert(alert, broadcast);
+    }
+    else if (len == sizeof(traffic_message)) {
       // Este un mesaj de la un alt semn de circulație
       processTrafficSignMessage(data, len, broadcast);
     } 
@@ -126,7 +144,7 @@ public:
       int copyLen = min(len, sizeof(textBuffer)-1);
       memcpy(textBuffer, data, copyLen);
       
-      Serial.printf("  Mesaj text primit: %s\n", textBuffer);
+      LOG_INFO("  Mesaj text primit: %s", textBuffer);
       
       // Pentru testare, vom afișa mesaj pe semn când primim mesaje text
       // Extragem numărul mesajului pentru afișare
@@ -138,38 +156,70 @@ public:
       }
       
       // Notificăm aplicația Android
-      String status = "SignID=" + String(SIGN_ID) + ";Event=TEXT_MESSAGE;Content=";
-      status += String(textBuffer);
+      char status[BLE_STATUS_MAX];
+      snprintf(status, sizeof(status), "SignID=%d;Event=TEXT_MESSAGE;Content=%s", SIGN_ID, textBuffer);
       bleManager.sendStatusUpdate(status);
     }
   }
   
+  // Confirmă alerta unicast către vehicul; un incident nou se afișează ca mesajul unui vehicul
+  void processAlert(const AlertFrame &alert, bool broadcast) {
+    if (alert.type != ALERT_TYPE_ALERT) return;
+
+    // Confirmarea pleacă direct din callback: esp_now_send doar pune cadrul în coada radio
+    AlertFrame ack = alert;
+    ack.type = ALERT_TYPE_ACK;
+    ack.signId = SIGN_ID;
+    uint8_t buffer[ALERT_FRAME_LEN];
+    size_t ackLen = alertEncode(ack, buffer);
+    bool sent;
+    {
+      HeapGuardAllow allow;   // esp_now_send își alocă singur cadrul
+      sent = send_message(buffer, ackLen);
+    }
+    if (!sent) {
+      LOG_WARN("Confirmarea alertei %08lx nu a putut fi trimisă", (unsigned long)alert.incidentId);
+    }
+
+    if (!alerteVazute.insert(alert.incidentId)) {
+      LOG_DEBUG("Alerta %08lx (seq %u) deja afișată, doar confirmată",
+                (unsigned long)alert.incidentId, alert.sequence);
+      return;
+    }
+
+    ElysiumMessage message = {};
+    message.eventType = alert.event;
+    message.severity = alert.severity;
+    strncpy(message.location, "Elysium RC", sizeof(message.location) - 1);
+    processVehicleMessage((const uint8_t*)&message, sizeof(message), broadcast);
+  }
+
   // Procesare mesaje de la alte semne de circulație
   void processTrafficSignMessage(const uint8_t *data, size_t len, bool broadcast) {
     traffic_message *message = (traffic_message*) data;
   
     // Verificăm dacă mesajul este pentru acest semn sau broadcast
     if (message->targetId == 0 || message->targetId == SIGN_ID) {
-      Serial.printf("Mesaj primit de la alt semn pentru semnul %d\n", SIGN_ID);
-      Serial.printf("Tip de semn: %s, Prioritate: %d\n", message->signType, message->priority);
+      LOG_INFO("Mesaj primit de la alt semn pentru semnul %d", SIGN_ID);
+      LOG_INFO("Tip de semn: %s, Prioritate: %d", message->signType, message->priority);
       
       // Ne ocupăm de mesaj în funcție de prioritate
       if (message->priority > 0) {
         // Mesaj prioritar (accident, urgență, obstacol)
-        Serial.println("ATENȚIE: Mesaj prioritar primit!");
+        LOG_WARN("ATENȚIE: Mesaj prioritar primit!");
         
         // Verificăm dacă mesajul conține un eveniment de tip accident
         if (strstr(message->signType, "ACCIDENT") != NULL) {
           epaperDisplay.showTrafficSign("ACCIDENT");
-          Serial.println("Afișez ACCIDENT pe display");
+          LOG_INFO("Afișez ACCIDENT pe display");
         } 
         else if (strstr(message->signType, "OBSTACLE") != NULL || strstr(message->signType, "OBSTACOL") != NULL) {
           epaperDisplay.showTrafficSign("OBSTACOL");
-          Serial.println("Afișez OBSTACOL pe display");
+          LOG_INFO("Afișez OBSTACOL pe display");
         }
         else if (strstr(message->signType, "EMERGENCY") != NULL || strstr(message->signType, "URGENTA") != NULL) {
           epaperDisplay.showTrafficSign("URGENTA");
-          Serial.println("Afișez URGENTA pe display");
+          LOG_INFO("Afișez URGENTA pe display");
         }
         else {
           // Alt tip de mesaj prioritar, afișăm direct conținutul
@@ -177,23 +227,25 @@ public:
         }
         
         // Notificăm aplicația Android despre eveniment prioritar
-        String status = "SignID=" + String(SIGN_ID) + ";Event=" + String(message->signType);
-        status += ";Priority=" + String(message->priority) + ";Source=OtherSign";
+        char status[BLE_STATUS_MAX];
+        snprintf(status, sizeof(status), "SignID=%d;Event=%.*s;Priority=%d;Source=OtherSign", SIGN_ID,
+                 (int)sizeof(message->signType), message->signType, message->priority);
         bleManager.sendStatusUpdate(status);
       } else {
         // Mesaj normal (schimbare de semn)
-        Serial.printf("Actualizez semnul cu: %s\n", message->signType);
+        LOG_INFO("Actualizez semnul cu: %s", message->signType);
         epaperDisplay.showTrafficSign(message->signType);
         
         // Notificăm aplicația Android despre schimbarea normală
-        String status = "SignID=" + String(SIGN_ID) + ";Event=SignChange;"
-                     + "Sign=" + String(message->signType) + ";Ack=OK";
+        char status[BLE_STATUS_MAX];
+        snprintf(status, sizeof(status), "SignID=%d;Event=SignChange;Sign=%.*s;Ack=OK", SIGN_ID,
+                 (int)sizeof(message->signType), message->signType);
         bleManager.sendStatusUpdate(status);
       }
       
     } else {
       // Mesaj pentru alt semn - îl ignorăm
-      Serial.printf("Mesaj destinat semnului %d - ignorat.\n", message->targetId);
+      LOG_DEBUG("Mesaj destinat semnului %d - ignorat.", message->targetId);
     }
   }
   
@@ -201,9 +253,8 @@ public:
   void processVehicleMessage(const uint8_t *data, size_t len, bool broadcast) {
     ElysiumMessage *message = (ElysiumMessage*) data;
     
-    Serial.print("Mesaj de la vehicul. Tip eveniment: ");
-    String eventType;
-    String eventDisplay;
+    const char* eventType;
+    const char* eventDisplay;
     bool isEmergency = false; // Flag pentru evenimentele care necesită propagare
     
     // În funcție de tipul evenimentului, actualizăm afișajul
@@ -211,27 +262,24 @@ public:
       case EVENT_ACCIDENT:
         eventType = "ACCIDENT";
         eventDisplay = "ACCIDENT";
-        Serial.println("Accident");
-        Serial.printf("Accident raportat în locația: %s. Severitate: %d\n", 
-                      message->location, message->severity);
+        LOG_WARN("Mesaj de la vehicul: Accident în locația: %s. Severitate: %d",
+                 message->location, message->severity);
         isEmergency = true;
         break;
         
       case EVENT_OBSTACLE:
         eventType = "OBSTACLE";
         eventDisplay = "OBSTACOL";
-        Serial.println("Obstacol");
-        Serial.printf("Obstacol raportat în locația: %s. Severitate: %d\n", 
-                      message->location, message->severity);
+        LOG_WARN("Mesaj de la vehicul: Obstacol în locația: %s. Severitate: %d",
+                 message->location, message->severity);
         isEmergency = true;
         break;
         
       case EVENT_EMERGENCY:
         eventType = "EMERGENCY";
         eventDisplay = "URGENTA";
-        Serial.println("Urgență");
-        Serial.printf("Urgență raportată în locația: %s. Severitate: %d\n", 
-                      message->location, message->severity);
+        LOG_WARN("Mesaj de la vehicul: Urgență în locația: %s. Severitate: %d",
+                 message->location, message->severity);
         isEmergency = true;
         break;
         
@@ -239,18 +287,18 @@ public:
       default:
         eventType = "NORMAL";
         eventDisplay = "STOP"; // Semnul default pentru acest semn
-        Serial.println("Normal/Default");
+        LOG_INFO("Mesaj de la vehicul: Normal/Default");
         break;
     }
     
     // Afișăm semnul corespunzător
-    epaperDisplay.showTrafficSign(eventDisplay.c_str());
+    epaperDisplay.showTrafficSign(eventDisplay);
     
     // Notificăm aplicația Android cu detalii despre vehicul și eveniment
-    String status = "SignID=" + String(SIGN_ID) + ";Event=" + eventType;
-    status += ";Location=" + String(message->location);
-    status += ";Severity=" + String(message->severity);
-    status += ";Time=" + String(millis());
+    char status[BLE_STATUS_MAX];
+    snprintf(status, sizeof(status), "SignID=%d;Event=%s;Location=%.*s;Severity=%d;Time=%lu", SIGN_ID,
+             eventType, (int)sizeof(message->location), message->location, message->severity,
+             (unsigned long)millis());
     bleManager.sendStatusUpdate(status);
     
     // Dacă este un eveniment de urgență (accident, obstacol, etc.),
@@ -259,7 +307,7 @@ public:
       // Creăm un mesaj de trafic care va fi transmis din exteriorul clasei
       static traffic_message emergencyMessage;
       emergencyMessage.targetId = 0; // 0 = broadcast
-      strncpy(emergencyMessage.signType, eventType.c_str(), sizeof(emergencyMessage.signType)-1);
+      strncpy(emergencyMessage.signType, eventType, sizeof(emergencyMessage.signType)-1);
       emergencyMessage.signType[sizeof(emergencyMessage.signType)-1] = '\0'; // Asigurăm NULL terminator
       emergencyMessage.priority = 1; // 1 = urgent
       
@@ -267,7 +315,7 @@ public:
       propaga_mesaj_urgenta = true;
       memcpy(&mesaj_urgenta_de_propagat, &emergencyMessage, sizeof(traffic_message));
       
-      Serial.printf("Am marcat evenimentul %s pentru propagare către alte semne\n", eventType.c_str());
+      LOG_INFO("Am marcat evenimentul %s pentru propagare către alte semne", eventType);
     }
   }
 };
@@ -286,27 +334,22 @@ BleManager bleManager(&epaperDisplay);
 
 /* Callback pentru înregistrarea unui nou master */
 void register_new_master(const esp_now_recv_info_t *info, const uint8_t *data, int len, void *arg) {
-  // Adăugăm debug pentru toate mesajele primite
-  Serial.println("DEBUG: Callback onNewPeer a fost apelat!");
-  Serial.printf("DEBUG: Mesaj primit de la " MACSTR " pentru " MACSTR ", len=%d\n", 
-                MAC2STR(info->src_addr), MAC2STR(info->des_addr), len);
-  
-  // Afișăm conținutul mesajului pentru debugging
-  Serial.print("DEBUG: Conținut mesaj: '");
-  for (int i = 0; i < min(len, 32); i++) {
-    Serial.print((char)data[i]);
-  }
-  Serial.println("'");
+  // Callback radio: doar jurnal amânat, fără scrieri pe Serial
+  const uint8_t *src = info->src_addr;
+  // Cel mult LOG_MAX_ARGS argumente numerice pe mesaj: lungimea merge cu conținutul
+  LOG_DEBUG("Callback onNewPeer: mesaj de la %02x:%02x:%02x:%02x:%02x:%02x",
+            src[0], src[1], src[2], src[3], src[4], src[5]);
+  LOG_DEBUG("Conținut mesaj (hex, %d octeți): %08lX %08lX %08lX %08lX", len,
+            hexWord(data, len, 0), hexWord(data, len, 4), hexWord(data, len, 8), hexWord(data, len, 12));
   
   if (memcmp(info->des_addr, ESP_NOW.BROADCAST_ADDR, 6) == 0) {
-    Serial.printf("Master necunoscut " MACSTR " a trimis un mesaj broadcast\n", MAC2STR(info->src_addr));
-    Serial.println("Înregistrez peer-ul ca master");
+    LOG_INFO("Master necunoscut %02x:%02x:%02x:%02x:%02x:%02x a trimis un mesaj broadcast, îl înregistrez",
+             src[0], src[1], src[2], src[3], src[4], src[5]);
 
     // Verificăm dacă dispozitivul nu există deja în lista noastră
     for (auto &master : masters) {
       if (memcmp(info->src_addr, master.addr(), ESP_NOW_ETH_ALEN) == 0) {
-        Serial.print("Master-ul există deja: ");
-        Serial.printf(MACSTR "\n", MAC2STR(info->src_addr));
+        LOG_DEBUG("Master-ul există deja");
         return;
       }
     }
@@ -315,21 +358,35 @@ void register_new_master(const esp_now_recv_info_t *info, const uint8_t *data, i
 
     masters.push_back(new_master);
     if (!masters.back().add_peer()) {
-      Serial.println("Eroare la înregistrarea noului master");
+      LOG_ERROR("Eroare la înregistrarea noului master");
       return;
     }
     
-    Serial.println("Master nou înregistrat cu succes");
+    LOG_INFO("Master nou înregistrat cu succes");
+
+    // Biblioteca nu livrează peer-ului primul mesaj: îl procesăm aici (ex. prima transmisie a unei alerte)
+    masters.back().onReceive(data, len, true);
   } else {
     // Semnul va primi doar mesaje broadcast
-    Serial.printf("Mesaj unicast primit de la " MACSTR ", ignorat\n", MAC2STR(info->src_addr));
+    LOG_DEBUG("Mesaj unicast primit de la %02x:%02x:%02x:%02x:%02x:%02x, ignorat",
+              src[0], src[1], src[2], src[3], src[4], src[5]);
   }
 }
 uint8_t elysiumMacAddress[] = ELYSIUM_MAC;
+char adresaMacLocala[18];   // citită o dată la pornire: WiFi.macAddress() întoarce un String
 
 void setup() {
+#if SIGN_BENCH
+  // Doar microbenchmark-urile: JSON pe Serial, apoi taskul loop se oprește
+  Serial.begin(115200);
+  delay(500);
+  benchRunOnBoard(SIGN_BENCH_CASES, SIGN_BENCH_CASE_COUNT, "traffic_sign_1", Serial);
+  vTaskDelete(NULL);
+#endif
+
   // Inițializare serial pentru debugging
   Serial.begin(115200);
+  Log_init(Serial);
   Serial.println("Adaptive Traffic System - Pornire");
   
   // 1. Eliberare memorie Bluetooth Classic (doar BLE necesar)
@@ -354,7 +411,8 @@ void setup() {
   Serial.println("Adaptive Traffic System - ESP-NOW Slave");
   Serial.println("Parametri Wi-Fi:");
   Serial.println("  Mod: STA");
-  Serial.println("  Adresa MAC: " + WiFi.macAddress());
+  snprintf(adresaMacLocala, sizeof(adresaMacLocala), "%s", WiFi.macAddress().c_str());
+  Serial.printf("  Adresa MAC: %s\n", adresaMacLocala);
   Serial.printf("  Canal: %d\n", ESPNOW_WIFI_CHANNEL);
   
   // Inițializare protocol ESP-NOW pentru comunicare cu orice dispozitiv
@@ -368,7 +426,7 @@ void setup() {
   
   // Afișăm informații de debugging despre starea ESP-NOW
   Serial.printf("DEBUG: Total peer count: %d\n", ESP_NOW.getTotalPeerCount());
-  Serial.printf("DEBUG: Adresa MAC locală: %s\n", WiFi.macAddress().c_str());
+  Serial.printf("DEBUG: Adresa MAC locală: %s\n", adresaMacLocala);
   
   // Înregistrăm callback-ul pentru auto-înregistrarea dispozitivelor
   ESP_NOW.onNewPeer(register_new_master, NULL);
@@ -402,6 +460,10 @@ void setup() {
   
   Serial.println("Inițializare completă. Sistem pregătit pentru comenzi BLE și mesaje ESP-NOW.");
   Serial.println("Aștept mesaje broadcast de la dispozitive master...");
+
+  // De aici încolo loop() și callback-urile nu mai alocă din heap (shared/heap/HeapGuard)
+  HeapGuard_watchCurrentTask("loop");
+  HeapGuard_endBoot();
 }
 
 
@@ -423,22 +485,23 @@ void loop() {
   
   // Propagăm mesajele de urgență dacă este necesar
   if (propaga_mesaj_urgenta) {
-    Serial.println("Propagare mesaj de urgență către toate semnele înregistrate");
+    LOG_INFO("Propagare mesaj de urgență către toate semnele înregistrate");
     
     // Trimitem mesajul către toate semnele înregistrate
     bool cel_putin_unul_trimis = false;
     for (auto &master : masters) {
-      Serial.printf("Trimit mesajul de urgență '%s' către un alt semn\n", mesaj_urgenta_de_propagat.signType);
+      LOG_INFO("Trimit mesajul de urgență '%s' către un alt semn", mesaj_urgenta_de_propagat.signType);
+      HeapGuardAllow allow;
       if (master.send_message((uint8_t*)&mesaj_urgenta_de_propagat, sizeof(traffic_message))) {
         cel_putin_unul_trimis = true;
-        Serial.println("Mesaj trimis cu succes!");
+        LOG_INFO("Mesaj trimis cu succes!");
       } else {
-        Serial.println("Eroare la trimiterea mesajului!");
+        LOG_ERROR("Eroare la trimiterea mesajului!");
       }
     }
     
     if (!cel_putin_unul_trimis) {
-      Serial.println("Atenție: Niciun semn nu a putut fi notificat!");
+      LOG_WARN("Atenție: Niciun semn nu a putut fi notificat!");
     }
     
     // Resetăm flag-ul
@@ -449,18 +512,24 @@ void loop() {
   static unsigned long lastDebugTime = 0;
   if (millis() - lastDebugTime > 10000) {  // La fiecare 10 secunde
     lastDebugTime = millis();
-    Serial.printf("DEBUG: Stare ESP-NOW - Total peers: %d\n", ESP_NOW.getTotalPeerCount());
-    Serial.printf("DEBUG: Număr masters înregistrați: %d\n", masters.size());
-    Serial.println("DEBUG: Aștept în continuare mesaje broadcast...");
-    Serial.println("DEBUG: Adresa MAC locală: " + WiFi.macAddress());
-    Serial.printf("DEBUG: Canal WiFi: %d\n", WiFi.channel());
+    LOG_DEBUG("Stare ESP-NOW - Total peers: %d, masters înregistrați: %u, canal WiFi: %d",
+              ESP_NOW.getTotalPeerCount(), (unsigned)masters.size(), WiFi.channel());
+    LOG_DEBUG("Adresa MAC locală: %s", adresaMacLocala);
+    HeapGuard_report();
     
     // Verificăm dacă canalul WiFi coincide cu cel configurat
     if (WiFi.channel() != ESPNOW_WIFI_CHANNEL) {
-      Serial.printf("AVERTISMENT: Canalul WiFi curent (%d) nu coincide cu ESPNOW_WIFI_CHANNEL (%d)\n", 
-                    WiFi.channel(), ESPNOW_WIFI_CHANNEL);
+      LOG_WARN("Canalul WiFi curent (%d) nu coincide cu ESPNOW_WIFI_CHANNEL (%d)",
+               WiFi.channel(), ESPNOW_WIFI_CHANNEL);
     }
   }
   
   delay(100);
 }
+
+// Cazurile microbenchmark-urilor folosesc ESP_NOW_Peer_Class, deci vin după ea
+#include "SignBenchKernels.h"
+
+// Implementarea jurnalului comun (Arduino IDE compilează doar fișierele din directorul sketch-ului)
+#include "../../shared/log/DeferredLog.cpp"
+#include "../../shared/heap/HeapGuard.cpp"
@@ -8,6 +8,7 @@
 
 #include "BleManager.h"
 #include "DisplayManager.h"
+#include "../../shared/heap/HeapGuard.h"
 
 BleManager::BleManager(DisplayManager* displayManager) : 
     _displayManager(displayManager),
@@ -57,9 +58,10 @@ void BleManager::init() {
     _pStatusCharacteristic->setValue("Ready");
 }
 
-void BleManager::sendStatusUpdate(const String& status) {
+void BleManager::sendStatusUpdate(const char* status) {
     if (_deviceConnected) {
-        _pStatusCharacteristic->setValue(status.c_str());
+        HeapGuardAllow allow;   // stiva BLE își alocă singură notificarea
+        _pStatusCharacteristic->setValue(status);
         _pStatusCharacteristic->notify();
     }
 }
@@ -78,17 +80,23 @@ void BleManager::onDisconnect(BLEServer* pServer) {
 }
 
 void BleManager::onWrite(BLECharacteristic* characteristic) {
-    if (characteristic->getUUID().toString() == SIGN_CHARACTERISTIC_UUID) {
-        // Obținem valoarea caracteristicii ca un șir de caractere
-        String command = characteristic->getValue().c_str(); // Conversia la const char* și apoi la String Arduino
+    if (characteristic == _pSignCharacteristic) {
+        // Callback-ul stivei BLE: comanda se copiază într-un buffer fix, fără String
+        HeapGuardHot hot("BLE");
+        char command[BLE_COMMAND_MAX];
+        size_t len = min(characteristic->getLength(), sizeof(command) - 1);
+        memcpy(command, characteristic->getData(), len);
+        command[len] = '\0';
         
         // Procesează comanda primită
         if (_displayManager) {
             // Afișarea semnului corespunzător
-            _displayManager->showTrafficSign(command.c_str());
+            _displayManager->showTrafficSign(command);
             
             // Trimitere confirmare că semnul a fost afișat
-            sendStatusUpdate("Sign updated: " + command);
+            char status[BLE_STATUS_MAX];
+            snprintf(status, sizeof(status), "Sign updated: %s", command);
+            sendStatusUpdate(status);
         } else {
             sendStatusUpdate("Error: Display Manager not initialized");
         }
@@ -1,4 +1,7 @@
 #include "TrafficAlertReceiver.h"
+#include "Config.h"
+#include "../../shared/log/DeferredLog.h"
+#include "../../shared/heap/HeapGuard.h"
 
 // Inițializare pointer static
 TrafficAlertReceiver* TrafficAlertReceiver::_instance = nullptr;
@@ -45,6 +48,14 @@ void TrafficAlertReceiver::setElysiumMac(const uint8_t* mac) {
 void TrafficAlertReceiver::onDataReceived(const esp_now_recv_info* info, const uint8_t* data, int data_len) {
   // Verifică dacă avem o instanță validă
   if (!_instance) return;
+  HeapGuardHot hot("ESP-NOW");
+
+  // Alertele cu confirmare se acceptă de la orice vehicul (au magic și versiune proprii)
+  AlertFrame alert;
+  if (alertDecode(data, data_len, alert)) {
+    _instance->processAlert(info->src_addr, alert);
+    return;
+  }
   
   // Verifică dacă mesajul este de la Elysium
   if (memcmp(info->src_addr, _instance->_elysiumMacAddress, 6) == 0) {
@@ -56,6 +67,8 @@ void TrafficAlertReceiver::onDataReceived(const esp_now_recv_info* info, const u
       
       // Procesarea mesajului
       _instance->processMessage(message);
+    } else {
+      LOG_WARN("ESP-NOW: mesaj prea scurt (%d octeți)", data_len);
     }
   }
 }
@@ -63,6 +76,8 @@ void TrafficAlertReceiver::onDataReceived(const esp_now_recv_info* info, const u
 void TrafficAlertReceiver::processMessage(const ElysiumMessage& message) {
   // Dacă nu avem un display manager, nu putem face nimic
   if (!_displayManager) return;
+
+  LOG_INFO("Alertă Elysium: eveniment %d", (int)message.eventType);
   
   // În funcție de tipul evenimentului, actualizăm afișajul
   switch (message.eventType) {
@@ -89,3 +104,31 @@ void TrafficAlertReceiver::processMessage(const ElysiumMessage& message) {
       break;
   }
 }
+
+// Confirmă alerta unicast către expeditor; un incident nou se afișează o singură dată
+void TrafficAlertReceiver::processAlert(const uint8_t* srcMac, const AlertFrame& alert) {
+  if (alert.type != ALERT_TYPE_ALERT) return;
+  HeapGuardAllow allow;   // peer-ul nou și cadrul confirmării sunt alocate de stiva ESP-NOW
+
+  if (!esp_now_is_peer_exist(srcMac)) {
+    esp_now_peer_info_t peerInfo = {};
+    memcpy(peerInfo.peer_addr, srcMac, 6);
+    peerInfo.channel = 0;                 // canalul curent
+    peerInfo.encrypt = false;
+    esp_now_add_peer(&peerInfo);
+  }
+
+  AlertFrame ack = alert;
+  ack.type = ALERT_TYPE_ACK;
+  ack.signId = SIGN_ID;
+  uint8_t buffer[ALERT_FRAME_LEN];
+  size_t len = alertEncode(ack, buffer);
+  esp_now_send(srcMac, buffer, len);
+
+  if (!_seenAlerts.insert(alert.incidentId)) return;
+
+  ElysiumMessage message = {};
+  message.eventType = alert.event;
+  message.severity = alert.severity;
+  processMessage(message);
+}
@@ -15,6 +15,8 @@
 #include "DisplayManager.h"
 #include "BleManager.h"
 #include "TrafficAlertReceiver.h"
+#include "../../shared/log/DeferredLog.h"
+#include "../../shared/heap/HeapGuard.h"
 
 // Variabile pentru controlul secvenței de afișare
 bool welcomeShown = false;
@@ -41,6 +43,7 @@ uint8_t elysiumMacAddress[] = {0x24, 0x6F, 0x28, 0x00, 0x00, 0x00};
 void setup() {
   // Inițializare display manager - include inițializarea hardware
   epaperDisplay.init();
+  Log_init(Serial);   // Serial este pornit de DisplayManager
   
   // Inițializare BLE Manager
   bleManager.init();
@@ -57,6 +60,10 @@ void setup() {
   // Inițializarea cronometrului pentru tranziție
   welcomeStartTime = millis();
   welcomeShown = true;
+
+  // De aici încolo loop() și callback-urile nu mai alocă din heap (shared/heap/HeapGuard)
+  HeapGuard_watchCurrentTask("loop");
+  HeapGuard_endBoot();
 }
 
 void loop() {
@@ -70,6 +77,17 @@ void loop() {
     bleManager.sendStatusUpdate("Ready to receive commands");
   }
   
+  // Alocările după pornire și fragmentarea heap-ului, periodic în jurnal
+  static unsigned long lastHeapReport = 0;
+  if (millis() - lastHeapReport > 10000) {
+    lastHeapReport = millis();
+    HeapGuard_report();
+  }
+  
   // Delay mic pentru a nu supraîncărca procesorul
   delay(50);
 }
+
+// Implementarea jurnalului comun (Arduino IDE compilează doar fișierele din directorul sketch-ului)
+#include "../../shared/log/DeferredLog.cpp"
+#include "../../shared/heap/HeapGuard.cpp"
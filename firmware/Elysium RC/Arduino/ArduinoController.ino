@@ -2,90 +2,129 @@
 #include <MechaQMC5883.h>
 #include <SoftwareSerial.h>
 
+// Portul serial hardware (pinii 0/1) este legătura cu ESP32; jurnalul merge pe un
+// port software separat și este oprit implicit, pentru că SoftwareSerial dezactivează
+// întreruperile cât timp trimite un octet (s-ar pierde impulsuri de encoder).
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_NONE
+#endif
+#include "../../shared/log/DeferredLog.h"
+#include "../../shared/link/SensorLinkCodec.h"
+#include "QuadratureDecoder.h"
 
-SoftwareSerial Serial1(10, 11); 
 
-#define outputA 2  // Pin INT0 pentru encoder
-#define outputB 3  // Pin INT1 pentru encoder
+SoftwareSerial debugSerial(10, 11);   // adaptor USB-serial pentru depanare
+
+#define outputA 2  // Pin INT0 pentru encoder (PD2)
+#define outputB 3  // Pin INT1 pentru encoder (PD3)
 
 int offset =20;// set the correction offset value
 
-volatile int counter = 0; // Contor pentru encoder
+// Starea encoderului, modificată doar în întrerupere. Se citește numai cu întreruperile
+// oprite (cli() este și barieră de memorie pentru compilator), vezi readEncoder().
+QuadratureState encoder;
 MechaQMC5883 qmc;         // Busolă
 
-void encoderA() {
-  if (digitalRead(outputA) != digitalRead(outputB)) {
-    counter++;
-  } else {
-    counter--;
-  }
+// Legătura binară cu ESP32
+uint16_t linkSequence = 0;
+unsigned long nextSampleUs = 0;
+unsigned long linkBusyFrames = 0;   // cadre renunțate pentru că bufferul de transmisie era plin
+
+// Ambii pini sunt pe portul D: o singură citire de registru în loc de două digitalRead()
+static inline uint8_t encoderPins() {
+  uint8_t pins = PIND;
+  return ((pins >> 1) & 0x02) | ((pins >> 3) & 0x01);   // (A << 1) | B
 }
 
-void encoderB() {
-  if (digitalRead(outputA) == digitalRead(outputB)) {
-    counter++;
-  } else {
-    counter--;
-  }
+// Același vector pentru INT0 și INT1 (orice front pe A sau B)
+ISR(INT0_vect) {
+  quadratureEdge(encoder, encoderPins(), micros());
+}
+ISR(INT1_vect, ISR_ALIASOF(INT0_vect));
+
+// Copie coerentă a stării encoderului (contorul pe 32 de biți nu se citește atomic pe AVR)
+static QuadratureState readEncoder() {
+  noInterrupts();
+  QuadratureState copy = encoder;
+  interrupts();
+  return copy;
 }
 
 void setup() {
 
-  Serial.begin(115200);
- 
+  // Pinii 0/1 sunt legați la ESP32 (RX 16); deconectați-i la încărcarea programului
+  Serial.begin(SENSOR_LINK_BAUD);
+  debugSerial.begin(57600);
+  Log_init(debugSerial);     // depanare prin jurnalul amânat, golit din loop()
+
 
 
 
   pinMode(outputA, INPUT_PULLUP);  // Rezistențe pull-up interne
   pinMode(outputB, INPUT_PULLUP);
+  quadratureInit(encoder, encoderPins());
 
-  Serial1.begin(9600);   // Transmisie către ESP32
-  Serial1.println("Test comunicare Arduino Uno cu ESP32");
-  delay(5000);
   Wire.begin();         // Inițializare bus I2C pentru busolă
+  Wire.setClock(400000);  // citirea busolei trebuie să încapă în perioada de eșantionare
   qmc.init();           // Inițializare QMC5883
 
-  // Configurarea întreruperilor pentru encoder
-  attachInterrupt(digitalPinToInterrupt(outputA), encoderA, CHANGE);
-  attachInterrupt(digitalPinToInterrupt(outputB), encoderB, CHANGE);
+  // Întreruperi pentru encoder direct din registre (fără attachInterrupt și apelul indirect):
+  // INT0 și INT1 la orice schimbare de nivel
+  EICRA = (EICRA & ~((1 << ISC01) | (1 << ISC11))) | (1 << ISC00) | (1 << ISC10);
+  EIFR = (1 << INTF0) | (1 << INTF1);
+  EIMSK |= (1 << INT0) | (1 << INT1);
+
+  nextSampleUs = micros();
 }
 
 void loop() {
+  // Eșantionare la perioadă fixă (SENSOR_LINK_PERIOD_US), fără delay()
+  if ((long)(micros() - nextSampleUs) < 0) {
+    Log_drain();
+    return;
+  }
+  nextSampleUs += SENSOR_LINK_PERIOD_US;
+
   int x, y, z;
-  qmc.read(&x, &y, &z); // Citirea valorilor busolei\
-
-
-   int volt = analogRead(A0);// read the input
-  double voltage = map(volt,0,1023, 0, 2500) + offset;// map 0-1023 to 0-2500 and add correction offset
-  
-  voltage /=100;// divide by 100 to get the decimal values
-
-  // Transmite datele către ESP32
-  Serial.print("Counter: ");
-  Serial.print(counter);
-  Serial.print(", X: ");
-  Serial.print(x);
-  Serial.print(", Y: ");
-  Serial.print(y);
-  Serial.print(", Z: ");
-  Serial.print(z);
-  Serial.print(" Voltage:");
-  Serial.println(voltage);
-  
-
-  Serial1.print("Counter: ");
-  Serial1.print(counter);
-  Serial1.print(", X: ");
-  Serial1.print(x);
-  Serial1.print(", Y: ");
-  Serial1.print(y);
-  Serial1.print(", Z: ");
-  Serial1.print(z);
-  Serial1.print(" Voltage:");
-  Serial1.println(voltage);
-
-
-
-
-  delay(100); // Pauză pentru transmisie
+  qmc.read(&x, &y, &z); // Citirea valorilor busolei
+
+  int volt = analogRead(A0);// read the input
+  // map 0-1023 to 0-2500 and add correction offset -> centivolți
+  long voltage = map(volt, 0, 1023, 0, 2500) + offset;
+
+  QuadratureState enc = readEncoder();
+  SensorLinkSample sample;
+  sample.encoder = enc.count;
+  sample.encoderErrors = (uint16_t)enc.errors;
+  sample.lastEdgeUs = enc.lastEdgeUs;
+  sample.edgePeriodUs = enc.edgePeriodUs;
+  sample.sequence = linkSequence++;
+  sample.arduinoTimeUs = micros();
+  sample.compass[0] = x;
+  sample.compass[1] = y;
+  sample.compass[2] = z;
+  sample.voltageCentivolts = (uint16_t)voltage;
+
+  // Transmite datele către ESP32; dacă bufferul UART nu are loc, cadrul se pierde
+  // (ESP32 îl vede ca salt de secvență) în loc să blocheze bucla
+  uint8_t frame[SENSOR_LINK_MAX_FRAME];
+  size_t len = sensorLinkEncode(sample, frame);
+  if ((size_t)Serial.availableForWrite() >= len) {
+    Serial.write(frame, len);
+  } else {
+    linkBusyFrames++;
+    LOG_WARN("Legătură: buffer plin, %lu cadre pierdute", linkBusyFrames);
+  }
+
+  LOG_DEBUG("Counter: %ld, erori %lu, perioadă front %ld us",
+            (long)enc.count, (unsigned long)enc.errors, (long)enc.edgePeriodUs);
+  LOG_DEBUG("X: %d, Y: %d, Z: %d Voltage(cV): %ld", x, y, z, voltage);
+
+  // După o întârziere lungă nu recuperăm cadrele ratate, reluăm de la momentul curent
+  if ((long)(micros() - nextSampleUs) > (long)SENSOR_LINK_PERIOD_US) {
+    nextSampleUs = micros();
+  }
 }
+
+// Implementarea jurnalului comun (Arduino IDE compilează doar fișierele din directorul sketch-ului)
+#include "../../shared/log/DeferredLog.cpp"
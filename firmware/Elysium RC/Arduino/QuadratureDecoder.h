@@ -0,0 +1,86 @@
+#ifndef QUADRATURE_DECODER_H
+#define QUADRATURE_DECODER_H
+
+/**
+ * Decodor de encoder în cuadratură cu tabel de tranziții 4x4
+ * (fără dependențe Arduino, testat pe calculator în tools/encoder).
+ *
+ * Starea canalelor este ab = (A << 1) | B. Sensul înainte este cel al vechiului cod
+ * (A conduce): 00 -> 10 -> 11 -> 01 -> 00. Indexul în tabel este (stare veche << 2) | stare nouă;
+ * o tranziție în care ambele canale se schimbă deodată (un front pierdut) nu are sens
+ * și este numărată ca eroare, fără a modifica poziția.
+ *
+ * Pentru viteza mică se păstrează momentul ultimelor fronturi: perioada unui ciclu
+ * complet (4 fronturi în același sens) elimină dezechilibrul de fază dintre A și B.
+ */
+
+#include <stdint.h>
+
+#define QUADRATURE_INVALID 2
+#define QUADRATURE_HISTORY 4    // fronturi într-un ciclu complet; putere a lui 2
+
+static const int8_t QUADRATURE_TABLE[16] = {
+  //         nou: 00   01   10   11
+  /* 00 */         0,  -1,  +1,  QUADRATURE_INVALID,
+  /* 01 */        +1,   0,  QUADRATURE_INVALID,  -1,
+  /* 10 */        -1,  QUADRATURE_INVALID,   0,  +1,
+  /* 11 */        QUADRATURE_INVALID,  +1,  -1,   0
+};
+
+struct QuadratureState {
+  int32_t count;                // poziția, impulsuri (x4)
+  uint32_t errors;              // tranziții invalide (fronturi pierdute)
+  uint32_t lastEdgeUs;          // momentul ultimului front valid
+  int32_t edgePeriodUs;         // perioada medie a unui front, cu semnul sensului; 0 = necunoscută
+  uint32_t history[QUADRATURE_HISTORY];
+  uint8_t head;
+  uint8_t run;                  // fronturi consecutive în același sens (maxim QUADRATURE_HISTORY)
+  int8_t lastStep;
+  uint8_t ab;
+};
+
+static inline void quadratureInit(QuadratureState& s, uint8_t ab) {
+  s.count = 0;
+  s.errors = 0;
+  s.lastEdgeUs = 0;
+  s.edgePeriodUs = 0;
+  for (uint8_t i = 0; i < QUADRATURE_HISTORY; i++) s.history[i] = 0;
+  s.head = 0;
+  s.run = 0;
+  s.lastStep = 0;
+  s.ab = ab & 0x03;
+}
+
+// Apelată la fiecare schimbare a unui canal (din întrerupere); ab = starea nouă a pinilor
+static inline void quadratureEdge(QuadratureState& s, uint8_t ab, uint32_t nowUs) {
+  ab &= 0x03;
+  int8_t step = QUADRATURE_TABLE[(s.ab << 2) | ab];
+  s.ab = ab;
+  if (step == 0) return;   // zgomot: întreruperea a venit, dar starea este aceeași
+  if (step == QUADRATURE_INVALID) {
+    s.errors++;
+    s.run = 0;
+    s.edgePeriodUs = 0;
+    return;
+  }
+
+  s.count += step;
+  if (step != s.lastStep) {
+    // Schimbare de sens: istoricul vechi nu mai descrie mișcarea curentă
+    s.run = 0;
+    s.edgePeriodUs = 0;
+    s.lastStep = step;
+  }
+  if (s.run >= QUADRATURE_HISTORY) {
+    // history[head] este momentul de acum QUADRATURE_HISTORY fronturi
+    int32_t period = (int32_t)((nowUs - s.history[s.head]) / QUADRATURE_HISTORY);
+    s.edgePeriodUs = step > 0 ? period : -period;
+  } else {
+    s.run++;
+  }
+  s.history[s.head] = nowUs;
+  s.head = (s.head + 1) & (QUADRATURE_HISTORY - 1);
+  s.lastEdgeUs = nowUs;
+}
+
+#endif
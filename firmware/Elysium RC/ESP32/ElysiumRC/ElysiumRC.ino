@@ -9,22 +9,46 @@
 // Core
 #include "../core/BluetoothManager.h"
 #include "../core/TaskManager.h"
+#include "../core/Pipeline.h"
+#include "../core/Telemetry.h"
+#include "../core/CommandChannel.h"
+#include "../core/TaskMonitor.h"
+#include "../core/Recorder.h"
 // Actuators
 #include "../motion-control/DCMotor.h"
 #include "../motion-control/ServoMotor.h"
+#include "../motion-control/SpeedController.h"
+#include "../motion-control/EmergencyBrake.h"
 // Sensors
 #include "../sensors/UltrasonicSensors.h"
 #include "../sensors/RFIDManager.h"
+#include "../sensors/ArduinoLink.h"
+// Navigation
+#include "../navigation/Navigation.h"
+// Alerts
+#include "../alerts/AlertTransmitter.h"
+#include "../alerts/AccidentDetector.h"
 // Feedback
 #include "../feedback/BuzzerManager.h"
+// Jurnal
+#include "../../../shared/log/DeferredLog.h"
+#include "../../../shared/heap/HeapGuard.h"
+// Microbenchmark-uri
+#include "../bench/VehicleBench.h"
+#include "../../../shared/bench/MicroBenchArduino.h"
 
 
 // ******************* GLOBAL **************************************
 Servo servo;
-String mesaj;
 BluetoothManager btManager;
-const int RXD1 = 16;
-const int TXD1 = 17;
+unsigned long loopMaxStallUs = 0;      // cel mai lung loop() măsurat (fără delay-ul final)
+unsigned long lastStallReportMs = 0;
+uint32_t lastLinkFrames = 0;           // pentru rata cadrelor Arduino în raportul periodic
+uint32_t lastRfidReads = 0;            // pentru rata citirilor RFID în raportul periodic
+uint32_t lastBtTxBytes = 0;            // pentru debitul Bluetooth în raportul periodic
+uint32_t lastBtRxBytes = 0;
+uint32_t lastBtPackets = 0;
+int loopMonitorId = -1;                // loop() are perioada dată de delay(10) de la final
 // *******************************************************************
 
 
@@ -32,10 +56,18 @@ const int TXD1 = 17;
 
 void setup() {
 
+#if ELYSIUM_BENCH
+  // Doar microbenchmark-urile, înaintea oricărui task: JSON pe Serial, apoi taskul loop se oprește
+  Serial.begin(115200);
+  delay(500);
+  benchRunOnBoard(VEHICLE_BENCH_CASES, VEHICLE_BENCH_CASE_COUNT, "ElysiumRC", Serial);
+  vTaskDelete(NULL);
+#endif
+
   // ************************* SERIAL***************************************
   Serial.begin(115200);
   delay(500);
-  Serial1.begin(9600, SERIAL_8N1, RXD1, TXD1);
+  Log_init(Serial);   // mesajele din bucle trec prin jurnalul amânat
   delay(1000);
   //**************************************************************************
 
@@ -48,12 +80,17 @@ void setup() {
   //===========================================================================
 
 
+  Recorder_init();   // înaintea producătorilor de înregistrări
   btManager.begin();
+  CommandChannel_init(btManager);
   DCMotor_init();
+  SpeedController_init();
   ServoMotor_init();
   UltrasonicSensors_init();
   Buzzer_init();
   RFIDManager_init();
+  ArduinoLink_init();
+  Navigation_init();
 
 
   //################################# TEST AND DIAGNOSE #######################################
@@ -79,76 +116,135 @@ void setup() {
   Serial.println("3. Revenire la centru"); delay(1000);
   ServoMotor(CENTER); delay(1000);
 
+  EmergencyBrake_init();   // primul consumator al pipeline-ului, înainte de Tasks_init()
+  AlertTransmitter_init();  // ESP-NOW, înaintea detectorului care îl folosește
+  AccidentDetector_init();
   Tasks_init();
+  loopMonitorId = TaskMonitor_register("loop", 10000, 20000);
   
   //---------------------- RFID -------------------------------------------------
-  Serial.println("\nRFID Reader test..."); delay(1000);
-  Serial.println("1. Așteptare card RFID...");
+  Serial.println("\nRFID Reader: inventar continuu pornit"); delay(1000);
   
 
   Serial.println("\n\n*** Elysium RC is READY! *** \n\n");
   delay(1000);
-  
+
+  // De aici încolo taskurile monitorizate (și loop()) nu mai alocă din heap
+  HeapGuard_endBoot();
 }
 
 void loop() {
-  // Verificăm dacă avem comenzi de la Bluetooth
-  String command = btManager.receiveData();
-  
-  if (command.length() > 0) {
-    Serial.print("Comandă primită: ");
-    Serial.println(command);
-    
-    // Procesăm comanda
-    if (command == "F") {
-      // Înainte
-      DCMotor(true, false);
-    }
-    else if (command == "B") {
-      // Înapoi
-      DCMotor(false, true);
-    }
-    else if (command == "S") {
-      // Stop motor și centrare servo
-      DCMotor(false, false);
-      ServoMotor(CENTER);
-    }
-    else if (command == "L") {
-      // Virare stânga
-      ServoMotor(LEFT);
-    }
-    else if (command == "R") {
-      // Virare dreapta
-      ServoMotor(RIGHT);
+  unsigned long loopStartUs = micros();
+  TaskMonitor_begin(loopMonitorId);
+
+  // Comenzile de la Bluetooth (litere sau control continuu), fără a aștepta date
+  CommandChannel_update();
+
+  // Senzorii ultrasonici sunt citiți de taskul de achiziție din pipeline (Tasks_init)
+
+  // Eșantioanele Arduino (encoder, busolă, tensiune) sunt decodate de taskul ArduinoLink
+
+  // Actualizare stare modul RFID: o singură sosire și o singură plecare pe tag
+  RFIDManager_update();
+  RfidTagEvent tag;
+  while (RFIDManager_nextEvent(tag)) {
+    Recorder_logRfid(tag);
+    char epc[2 * RFID_EPC_MAX + 1];
+    rfidEpcToHex(tag.epc, epc);
+    if (tag.type == RFID_TAG_ARRIVED) {
+      LOG_INFO("Tag RFID sosit: %s (%d dBm)", epc, tag.rssi);
+      // Un tag de pe harta traseului corectează odometria și stabilește limita de viteză a zonei
+      const TrackTag* mark = Navigation_onTrackTag(tag.epc);
+      if (mark != NULL) {
+        LOG_INFO("Traseu: poziție %.2f %.2f m, zona %d, limită %.2f m/s%s", mark->x, mark->y,
+                 mark->zone, mark->speedLimit, (mark->flags & TRACK_TAG_STOP) ? ", linie de oprire" : "");
+      }
+      // ID-ul tagului pleacă prin Bluetooth odată cu telemetria, doar când se schimbă
+      Telemetry_setRfidTag(epc);
+    } else {
+      LOG_INFO("Tag RFID plecat: %lu citiri în %lu ms", (unsigned long)tag.reads,
+               (unsigned long)(tag.lastSeenMs - tag.firstSeenMs));
     }
   }
 
-  readSensorsSequentially();
+  Telemetry_update(btManager);
+  TaskMonitor_update(btManager);
+  Recorder_update(btManager);
+  btManager.update();   // lotul BLE pleacă după un interval de conexiune
 
-  String sensorData = String(distanceFront) + "," + 
-                     String(distanceBack) + "," + 
-                     String(distanceLeft) + "," + 
-                     String(distanceRight);
+  // Raportăm periodic cel mai lung blocaj al buclei principale
+  unsigned long loopUs = micros() - loopStartUs;
+  if (loopUs > loopMaxStallUs) {
+    loopMaxStallUs = loopUs;
+  }
+  if (millis() - lastStallReportMs > 5000) {
+    lastStallReportMs = millis();
+    LOG_INFO("Loop: blocaj maxim %lu us (senzori ultrasonici: %lu us)",
+             loopMaxStallUs, UltrasonicSensors_getMaxStallUs());
+    Pipeline_printStats();
+
+    ArduinoLinkStats link = ArduinoLink_getStats();
+    LOG_INFO("Arduino: %lu Hz, %lu cadre corupte, %lu pierdute, %lu depășiri UART",
+             (unsigned long)((link.framesOk - lastLinkFrames) / 5), (unsigned long)link.crcErrors,
+             (unsigned long)link.lostFrames, (unsigned long)link.uartOverflows);
+    lastLinkFrames = link.framesOk;
+
+    RFIDStats rfid = RFIDManager_getStats();
+    LOG_INFO("RFID: %lu Hz citiri, %lu tag-uri în câmp, %lu cadre corupte, %lu reporniri",
+             (unsigned long)((rfid.tagReads - lastRfidReads) / 5), (unsigned long)rfid.present,
+             (unsigned long)rfid.checksumErrors, (unsigned long)rfid.restarts);
+    lastRfidReads = rfid.tagReads;
+
+    EmergencyBrakeStatus aeb = EmergencyBrake_getStatus();
+    LOG_INFO("AEB: %s, %lu intervenții, latență max %lu us (%lu peste țintă)",
+             aeb.overridden ? "dezactivată" : (aeb.engaged ? "frână activă" : "activă"),
+             (unsigned long)aeb.interventions, (unsigned long)aeb.maxLatencyUs,
+             (unsigned long)aeb.latencyMisses);
+
+    AccidentDetectorStatus accident = AccidentDetector_getStatus();
+    if (accident.detections > 0) {
+      LOG_INFO("Accidente: %lu, ultimul acum %lu s (semnale 0x%x)", (unsigned long)accident.detections,
+               (unsigned long)((millis() - accident.lastDetectionMs) / 1000), accident.lastSignals);
+    }
 
-  btManager.sendData(sensorData);
+    AlertStats alerts = AlertTransmitter_getStats();
+    if (alerts.incidents > 0) {
+      LOG_INFO("Alerte: %lu incidente, %lu livrate, %lu expirate, %lu trimiteri, %lu confirmări",
+               (unsigned long)alerts.incidents, (unsigned long)alerts.delivered,
+               (unsigned long)alerts.expired, (unsigned long)alerts.attempts, (unsigned long)alerts.acks);
+      LOG_INFO("Alerte: prima confirmare după %lu us (max %lu us)",
+               (unsigned long)alerts.lastFirstAckUs, (unsigned long)alerts.maxFirstAckUs);
+    }
 
+    BluetoothStats bt = btManager.getStats();
+    CommandChannelStats commands = CommandChannel_getStats();
+    uint32_t btPackets = bt.packets - lastBtPackets;
+    LOG_INFO("Bluetooth %s: profil %s, MTU %u, %lu octeți aruncați", bt.transport,
+             BT_PROFILES[btManager.getProfile()].name, bt.mtu, (unsigned long)bt.dropped);
+    LOG_INFO("Bluetooth: tx %lu B/s în %lu pachete/s (%lu octeți/pachet), rx %lu B/s",
+             (unsigned long)((bt.txBytes - lastBtTxBytes) / 5), (unsigned long)(btPackets / 5),
+             (unsigned long)(btPackets > 0 ? (bt.txBytes - lastBtTxBytes) / btPackets : 0),
+             (unsigned long)((bt.rxBytes - lastBtRxBytes) / 5));
+    LOG_INFO("Comenzi: %lu executate, sosire -> execuție medie %lu us, max %lu us",
+             (unsigned long)commands.executed,
+             (unsigned long)(commands.executed > 0 ? commands.totalDispatchUs / commands.executed : 0),
+             (unsigned long)commands.maxDispatchUs);
+    lastBtTxBytes = bt.txBytes;
+    lastBtRxBytes = bt.rxBytes;
+    lastBtPackets = bt.packets;
+
+    RecorderStats recorder = Recorder_getStats();
+    if (recorder.mounted) {
+      LOG_INFO("Înregistrare: fișier %lu, %lu blocuri (%lu KB), %lu pierdute, scriere max %lu us",
+               (unsigned long)recorder.currentFile, (unsigned long)recorder.blocks,
+               (unsigned long)(recorder.bytes / 1024), (unsigned long)recorder.dropped,
+               (unsigned long)recorder.maxWriteUs);
+    }
 
-  if (Serial1.available()) {
-    mesaj = Serial1.readStringUntil('\n');
+    HeapGuard_report();
   }
 
-  Serial.println(mesaj);
-  
-  // Actualizare stare modul RFID
-  RFIDManager_update();
-  
-  // Verificare dacă a fost detectat un card nou
-  if (isCardPresent() && lastCardID.length() > 0) {
-    Serial.print("Card RFID detectat: ");
-    Serial.println(lastCardID);
-    // Trimite ID-ul cardului prin Bluetooth
-    btManager.sendData("RFID:" + lastCardID);
-  }
+  TaskMonitor_end(loopMonitorId);
   
   delay(10);
 }
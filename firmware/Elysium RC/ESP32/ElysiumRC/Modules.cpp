@@ -3,17 +3,39 @@
  * Este necesar deoarece Arduino IDE compilează automat doar fișierele din directorul sketch-ului
  */
 
+// Jurnal comun pentru toate plăcile
+#include "../../../shared/log/DeferredLog.cpp"
+#include "../../../shared/heap/HeapGuard.cpp"
+
 // Core modules
-// BluetoothManager este implementat direct în header, nu are fișier .cpp separat
+#include "../core/BluetoothManager.cpp"
 #include "../core/TaskManager.cpp"
+#include "../core/Pipeline.cpp"
+#include "../core/TaskMonitor.cpp"
+#include "../core/Telemetry.cpp"
+#include "../core/CommandChannel.cpp"
+#include "../core/Recorder.cpp"
 
 // Motion control
 #include "../motion-control/DCMotor.cpp"
 #include "../motion-control/ServoMotor.cpp"
+#include "../motion-control/SpeedController.cpp"
+#include "../motion-control/EmergencyBrake.cpp"
 
 // Sensors
 #include "../sensors/UltrasonicSensors.cpp"
 #include "../sensors/RFIDManager.cpp"
+#include "../sensors/ArduinoLink.cpp"
+
+// Navigation
+#include "../navigation/Navigation.cpp"
+
+// Alerts
+#include "../alerts/AlertTransmitter.cpp"
+#include "../alerts/AccidentDetector.cpp"
 
 // Feedback
 #include "../feedback/BuzzerManager.cpp"
+
+// Microbenchmark-uri (rulate doar cu ELYSIUM_BENCH=1 sau pe calculator)
+#include "../bench/VehicleBench.cpp"
@@ -0,0 +1,222 @@
+#ifndef ACCIDENT_DETECTION_H
+#define ACCIDENT_DETECTION_H
+
+/**
+ * Detectorul de accident (fără dependențe Arduino, reluat pe calculator în tools/accident).
+ *
+ * Trei semnale, fiecare prelucrat în flux, cu stare de dimensiune fixă:
+ *  - decelerare bruscă cu motorul comandat: viteza roții (medie rapidă) se prăbușește față de
+ *    media ei lentă și față de viteza cerută de bucla de viteză, care încă nu a scăzut
+ *    (o frânare comandată coboară întâi viteza cerută, deci nu declanșează); cât timp frâna
+ *    automată este activă, viteza cerută este anvelopa de frânare: urmează viteza roții, dar
+ *    coboară cel mult cu brakeDecelMs2, deci doar o oprire mai bruscă decât frâna contează
+ *  - salt al distanței ultrasonice până aproape de zero (obiectul a ajuns lipit de senzor)
+ *  - salt al orientării busolei, mai rapid decât poate vira șasiul
+ *
+ * Fiecare semnal aprins contribuie cu o pondere timp de windowUs; accidentul se declară când
+ * suma ponderilor atinge triggerScore. Implicit decelerarea ajunge singură, celelalte două
+ * trebuie să se confirme reciproc sau să confirme decelerarea (un senzor fără ecou sau o
+ * cameră goală nu mai produc alarme).
+ */
+
+#include <stdint.h>
+#include <math.h>
+#include "../motion-control/AebDecision.h"
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define ACC_SIGNAL_DECEL   0x01
+#define ACC_SIGNAL_RANGE   0x02
+#define ACC_SIGNAL_HEADING 0x04
+#define ACC_MAX_RANGE_CHANNELS 8
+#define ACC_BRAKE_DECEL_MARGIN 2.0f    // AEB_DECEL_CMS2 este decelerarea garantată; pe o podea bună frâna e mai puternică
+
+struct AccidentConfig {
+  float minSpeedMs;          // sub această viteză (medie lentă) decelerarea nu contează
+  float speedDropRatio;      // scăderea relativă a vitezei rapide față de cea lentă și de cea cerută
+  float fastTauS;            // constanta de timp a mediei rapide a vitezei
+  float slowTauS;            // constanta de timp a mediei lente
+  float brakeDecelMs2;       // cea mai mare decelerare pe care o poate produce frâna automată
+  float contactCm;           // distanța considerată contact
+  float rangeJumpCm;         // saltul minim al distanței până la contact, între două măsurători
+  float headingJumpRad;      // abaterea orientării față de media ei lentă
+  float headingTauS;         // constanta de timp a mediei orientării
+  uint32_t windowUs;         // semnalele se combină dacă apar în această fereastră
+  uint8_t weightDecel;
+  uint8_t weightRange;
+  uint8_t weightHeading;
+  uint8_t triggerScore;
+  uint32_t holdoffUs;        // după o detecție, alta nu se raportează mai devreme
+};
+
+static inline AccidentConfig accidentDefaultConfig() {
+  AccidentConfig c;
+  c.minSpeedMs = 0.25f;
+  c.speedDropRatio = 0.6f;
+  c.fastTauS = 0.015f;
+  c.slowTauS = 0.15f;
+  c.brakeDecelMs2 = ACC_BRAKE_DECEL_MARGIN * AEB_DECEL_CMS2 * 0.01f;
+  c.contactCm = 6.0f;
+  c.rangeJumpCm = 15.0f;
+  c.headingJumpRad = 0.5f;
+  c.headingTauS = 0.2f;
+  c.windowUs = 150000;
+  c.weightDecel = 2;
+  c.weightRange = 1;
+  c.weightHeading = 1;
+  c.triggerScore = 2;
+  c.holdoffUs = 2000000;
+  return c;
+}
+
+struct AccidentEvent {
+  uint32_t timeUs;           // momentul eșantionului care a completat scorul
+  uint8_t signals;           // ACC_SIGNAL_* aprinse în fereastră
+  uint8_t score;
+};
+
+class AccidentFusion {
+public:
+  explicit AccidentFusion(const AccidentConfig& config = accidentDefaultConfig()) : _cfg(config) { reset(); }
+
+  void reset() {
+    _haveWheel = false;
+    _fastSpeed = _slowSpeed = 0;
+    _wheelUs = 0;
+    _autoBrake = false;
+    _brakeEnvelope = 0;
+    _haveHeading = false;
+    _heading = _headingSlow = 0;
+    _headingUs = 0;
+    for (int i = 0; i < ACC_MAX_RANGE_CHANNELS; i++) _lastRangeCm[i] = -1;
+    for (int i = 0; i < 3; i++) _firedUs[i] = 0;
+    _fired = 0;
+    _haveEvent = false;
+    _lastEventUs = 0;
+  }
+
+  void setConfig(const AccidentConfig& config) { _cfg = config; }
+  const AccidentConfig& config() const { return _cfg; }
+
+  // Starea frânei automate, înainte de eșantioanele roții pe care le afectează
+  void setAutoBrake(bool engaged) {
+    if (engaged && !_autoBrake) _brakeEnvelope = fabsf(_fastSpeed);
+    _autoBrake = engaged;
+  }
+
+  /**
+   * Viteza roții (m/s, cu semn) și viteza cerută de bucla de viteză în același moment.
+   * Întoarce true dacă eșantionul a completat o detecție (vezi event()).
+   */
+  bool onWheel(float speedMs, float commandedMs, uint32_t nowUs) {
+    if (!_haveWheel) {
+      _fastSpeed = _slowSpeed = speedMs;
+      _wheelUs = nowUs;
+      _haveWheel = true;
+      return false;
+    }
+    float dt = (float)(uint32_t)(nowUs - _wheelUs) * 1e-6f;
+    _wheelUs = nowUs;
+    if (dt <= 0) return false;
+    _fastSpeed += (speedMs - _fastSpeed) * (dt / (_cfg.fastTauS + dt));
+    _slowSpeed += (speedMs - _slowSpeed) * (dt / (_cfg.slowTauS + dt));
+
+    // Totul în sensul de mers: viteza lentă dă sensul
+    float dir = _slowSpeed >= 0 ? 1.0f : -1.0f;
+    float slow = _slowSpeed * dir;
+    float fast = _fastSpeed * dir;
+    float commanded = commandedMs * dir;
+    if (_autoBrake) {
+      _brakeEnvelope = fmaxf(fast, _brakeEnvelope - _cfg.brakeDecelMs2 * dt);
+      commanded = _brakeEnvelope;
+    }
+    float keep = 1.0f - _cfg.speedDropRatio;
+    bool collapsed = slow >= _cfg.minSpeedMs && fast < keep * slow && fast < keep * commanded;
+    return collapsed && fire(0, nowUs);
+  }
+
+  // O măsurătoare ultrasonică nouă (cm, negativ = fără ecou) pe canalul channel
+  bool onRange(int channel, float cm, uint32_t nowUs) {
+    if (channel < 0 || channel >= ACC_MAX_RANGE_CHANNELS) return false;
+    float last = _lastRangeCm[channel];
+    _lastRangeCm[channel] = cm;
+    bool contact = cm >= 0 && cm <= _cfg.contactCm && last >= _cfg.contactCm + _cfg.rangeJumpCm;
+    return contact && fire(1, nowUs);
+  }
+
+  // Orientarea absolută a busolei (rad)
+  bool onHeading(float headingRad, uint32_t nowUs) {
+    if (!_haveHeading) {
+      _heading = _headingSlow = headingRad;
+      _headingUs = nowUs;
+      _haveHeading = true;
+      return false;
+    }
+    float dt = (float)(uint32_t)(nowUs - _headingUs) * 1e-6f;
+    _headingUs = nowUs;
+    if (dt <= 0) return false;
+    // Orientarea "desfășurată", ca media să nu sară la trecerea prin ±π
+    float step = headingRad - wrapAngle(_heading);
+    _heading += wrapAngle(step);
+    _headingSlow += (_heading - _headingSlow) * (dt / (_cfg.headingTauS + dt));
+    bool jump = fabsf(_heading - _headingSlow) > _cfg.headingJumpRad;
+    return jump && fire(2, nowUs);
+  }
+
+  // Ultima detecție (validă după ce o funcție on*() a întors true)
+  const AccidentEvent& event() const { return _event; }
+
+private:
+  AccidentConfig _cfg;
+  bool _haveWheel;
+  float _fastSpeed, _slowSpeed;
+  uint32_t _wheelUs;
+  bool _autoBrake;
+  float _brakeEnvelope;        // viteza (în sensul de mers) pe care o poate explica frâna automată
+  bool _haveHeading;
+  float _heading, _headingSlow;
+  uint32_t _headingUs;
+  float _lastRangeCm[ACC_MAX_RANGE_CHANNELS];
+  uint32_t _firedUs[3];
+  uint8_t _fired;              // biții semnalelor cu _firedUs valid
+  AccidentEvent _event;
+  bool _haveEvent;
+  uint32_t _lastEventUs;
+
+  static float wrapAngle(float a) {
+    while (a > (float)M_PI) a -= 2.0f * (float)M_PI;
+    while (a <= -(float)M_PI) a += 2.0f * (float)M_PI;
+    return a;
+  }
+
+  // Aprinde semnalul index și verifică scorul ferestrei
+  bool fire(int index, uint32_t nowUs) {
+    static const uint8_t bits[3] = { ACC_SIGNAL_DECEL, ACC_SIGNAL_RANGE, ACC_SIGNAL_HEADING };
+    const uint8_t weights[3] = { _cfg.weightDecel, _cfg.weightRange, _cfg.weightHeading };
+    _firedUs[index] = nowUs;
+    _fired |= bits[index];
+
+    if (_haveEvent && (uint32_t)(nowUs - _lastEventUs) < _cfg.holdoffUs) return false;
+
+    uint8_t signals = 0;
+    uint8_t score = 0;
+    for (int i = 0; i < 3; i++) {
+      if ((_fired & bits[i]) && (uint32_t)(nowUs - _firedUs[i]) <= _cfg.windowUs) {
+        signals |= bits[i];
+        score += weights[i];
+      }
+    }
+    if (score < _cfg.triggerScore) return false;
+
+    _event.timeUs = nowUs;
+    _event.signals = signals;
+    _event.score = score;
+    _haveEvent = true;
+    _lastEventUs = nowUs;
+    return true;
+  }
+};
+
+#endif
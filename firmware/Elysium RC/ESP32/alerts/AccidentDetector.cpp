@@ -1,93 +1,135 @@
 #include "AccidentDetector.h"
 
-#include "../sensors/UltrasonicSensors.h"
-#include "ESP32_NOW.h"
-#include "WiFi.h"
-#include <esp_mac.h>
-#include <string.h>
-
-#define ESPNOW_WIFI_CHANNEL 6
-// Declanșează accident dacă un senzor raportează -1 timp de ≥5 secunde
-#define ACC_INVALID_MS 5000
-#define ACC_COOLDOWN_MS 100
-
-// Struct identic cu cel folosit de semnele de trafic
-typedef struct __attribute__((packed)) traffic_message {
-  uint8_t targetId;      // 0 = broadcast
-  char    signType[20];  // "ACCIDENT" etc.
-  uint8_t priority;      // 1 = urgent
-} traffic_message;
-
-class AccidentBroadcastPeer : public ESP_NOW_Peer {
-public:
-  AccidentBroadcastPeer(uint8_t channel, wifi_interface_t iface, const uint8_t *lmk) :
-      ESP_NOW_Peer(ESP_NOW.BROADCAST_ADDR, channel, iface, lmk) {}
-
-  bool begin() {
-    if (!ESP_NOW.begin() || !add()) {
-      return false;
-    }
-    return true;
-  }
+#include "../core/Pipeline.h"
+#include "../core/TaskMonitor.h"
+#include "../sensors/ArduinoLink.h"
+#include "../navigation/Navigation.h"
+#include "../motion-control/DCMotor.h"
+#include "../motion-control/EmergencyBrake.h"
+#include "../motion-control/SpeedController.h"
+#include "../../../shared/log/DeferredLog.h"
+#include "AlertTransmitter.h"
+
+static_assert(ULTRASONIC_SENSOR_COUNT <= ACC_MAX_RANGE_CHANNELS, "detectorul nu are loc pentru toate canalele ultrasonice");
+
+// Starea detectorului, folosită doar din taskul lui
+static AccidentFusion accidentFusion;
+static int accidentSubscriber = -1;
+
+// Configurația nouă, aplicată la începutul pasului următor
+static portMUX_TYPE accidentMux = portMUX_INITIALIZER_UNLOCKED;
+static bool configRequested = false;
+static AccidentConfig requestedConfig;
+static AccidentDetectorStatus accidentStatus = { 0, 0, 0, 0 };
+
+static void onAccident(const AccidentEvent& event, unsigned long sampleUs) {
+  // Vehiculul nu mai trage după impact
+  DCMotor(false, false);
+  // Scorul semnalelor (2-4 cu ponderile implicite) dă severitatea 1-10
+  uint8_t severity = event.score * 3 < 10 ? event.score * 3 : 10;
+  bool queued = AlertTransmitter_send(ALERT_EVENT_ACCIDENT, ACC_ALERT_PRIORITY, severity);
+  uint32_t latency = micros() - sampleUs;
+
+  portENTER_CRITICAL(&accidentMux);
+  accidentStatus.detections++;
+  accidentStatus.lastDetectionMs = millis();
+  accidentStatus.lastSignals = event.signals;
+  accidentStatus.lastLatencyUs = latency;
+  portEXIT_CRITICAL(&accidentMux);
+
+  // Semnale: 1 = decelerare, 2 = contact ultrasonic, 4 = salt de orientare
+  LOG_WARN("Accident: semnale 0x%x (scor %u), latență %lu us, alertă %s",
+           event.signals, event.score, (unsigned long)latency, queued ? "în coadă" : "pierdută");
+}
 
-  bool send_message(const uint8_t *data, size_t len) {
-    return send(data, len);
-  }
-};
+static void applyConfig() {
+  portENTER_CRITICAL(&accidentMux);
+  bool requested = configRequested;
+  AccidentConfig config = requestedConfig;
+  configRequested = false;
+  portEXIT_CRITICAL(&accidentMux);
+  if (requested) accidentFusion.setConfig(config);
+}
 
-static AccidentBroadcastPeer broadcast_peer(ESPNOW_WIFI_CHANNEL, WIFI_IF_STA, NULL);
+// Trezit de fiecare eșantion Arduino; cadrele pipeline-ului se preiau fără așteptare
+static void accidentTask(void* parameter) {
+  int monitorId = TaskMonitor_register("Accident", 0, 1000);
+  PerceptionFrame frame;
+  unsigned long rangeUs[ULTRASONIC_SENSOR_COUNT] = {0};
+  uint16_t lastSequence = 0;
+  bool haveEncoder = false;
+  int32_t lastEncoder = 0;
+  uint32_t lastArduinoUs = 0;
+
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(ACC_WAIT_MS));
+    TaskMonitor_begin(monitorId);
+    applyConfig();
+
+    ArduinoSample sample = ArduinoLink_getSample();
+    if (sample.valid && sample.sequence != lastSequence) {
+      lastSequence = sample.sequence;
+      uint32_t nowUs = (uint32_t)sample.receivedUs;
+
+      // Viteza roții între două eșantioane, cu ceasul Arduino
+      uint32_t dtUs = sample.arduinoTimeUs - lastArduinoUs;
+      if (haveEncoder && dtUs > 0) {
+        float speed = (sample.encoder - lastEncoder) * 1e6f / dtUs / NAV_COUNTS_PER_METER;
+        // Frâna automată este o oprire comandată, dar numai în anvelopa ei de decelerare
+        accidentFusion.setAutoBrake(EmergencyBrake_getStatus().engaged);
+        float commanded = SpeedController_getStats().setpoint / NAV_COUNTS_PER_METER;
+        if (accidentFusion.onWheel(speed, commanded, nowUs)) onAccident(accidentFusion.event(), sample.receivedUs);
+      }
+      lastEncoder = sample.encoder;
+      lastArduinoUs = sample.arduinoTimeUs;
+      haveEncoder = true;
+
+      NavigationStatus nav = Navigation_getStatus();
+      if (nav.calibrated && !nav.calibrating) {
+        float heading = compassHeading(nav.calibration, sample.compass[0], sample.compass[1],
+                                       NAV_COMPASS_SIGN, NAV_COMPASS_MOUNT_RAD);
+        if (accidentFusion.onHeading(heading, nowUs)) onAccident(accidentFusion.event(), sample.receivedUs);
+      }
+    }
 
-// Stare internă
-static unsigned long invalidSince[4] = {0};
-static unsigned long lastAccidentMillis = 0;
+    // Distanțele brute: filtrul ultrasonic ar respinge tocmai saltul până la contact
+    if (Pipeline_wait(accidentSubscriber, frame, 0)) {
+      forEachUltrasonic([&](auto ch) {
+        constexpr int i = decltype(ch)::value;
+        if (frame.ultrasonic.timestampUs[i] == rangeUs[i]) return;
+        rangeUs[i] = frame.ultrasonic.timestampUs[i];
+        float cm = frame.ultrasonic.isValid(i) ? (float)frame.ultrasonic.distance[i] : -1.0f;
+        if (accidentFusion.onRange(i, cm, rangeUs[i])) onAccident(accidentFusion.event(), rangeUs[i]);
+      });
+      Pipeline_markReaction(accidentSubscriber, frame);
+    }
 
-static void sendAccident() {
-  traffic_message msg{};
-  msg.targetId = 0;
-  strncpy(msg.signType, "ACCIDENT", sizeof(msg.signType));
-  msg.priority = 1;
+    TaskMonitor_end(monitorId);
+  }
 
-  broadcast_peer.send_message(reinterpret_cast<uint8_t*>(&msg), sizeof(msg));
-  Serial.println("[AccidentDetector] ACCIDENT transmis prin ESP-NOW!");
+  vTaskDelete(NULL);
 }
 
+// Trebuie apelată după AlertTransmitter_init() și înainte de Tasks_init(), ca să se înscrie în pipeline
 void AccidentDetector_init() {
-  WiFi.mode(WIFI_STA);
-  WiFi.setChannel(ESPNOW_WIFI_CHANNEL);
-  while (!WiFi.STA.started()) {
-    delay(50);
-  }
-
-  if (!broadcast_peer.begin()) {
-    Serial.println("[AccidentDetector] Eroare init ESP-NOW, se repornește în 5s");
-    delay(5000);
-    ESP.restart();
-  }
+  Serial.println("\nPornire detector de accident...");
+  accidentSubscriber = Pipeline_subscribe("Accident");
+  TaskHandle_t handle = NULL;
+  xTaskCreatePinnedToCore(accidentTask, "Accident", 3072, NULL,
+                          ACC_PRIORITY, &handle, PIPELINE_CORE);
+  ArduinoLink_setNotifyTask(handle);
 }
 
-void AccidentDetector_update() {
-  unsigned long now = millis();
-  long dists[4] = { distanceFront, distanceBack, distanceLeft, distanceRight };
-
-  for (int i = 0; i < 4; ++i) {
-    if (dists[i] == -1) {
-      if (invalidSince[i] == 0) invalidSince[i] = now; // start perioadă invalidă
-    } else {
-      invalidSince[i] = 0; // senzor valid → reset
-    }
-  }
-
-  bool trigger = false;
-  for (int i = 0; i < 4; ++i) {
-    if (invalidSince[i] != 0 && (now - invalidSince[i] >= ACC_INVALID_MS)) {
-      trigger = true;
-      break;
-    }
-  }
-
-  if (trigger && (now - lastAccidentMillis > ACC_COOLDOWN_MS)) {
-    sendAccident();
-    lastAccidentMillis = now;
+void AccidentDetector_setConfig(const AccidentConfig& config) {
+  portENTER_CRITICAL(&accidentMux);
+  requestedConfig = config;
+  configRequested = true;
+  portEXIT_CRITICAL(&accidentMux);
+}
 
-  }
+AccidentDetectorStatus AccidentDetector_getStatus() {
+  portENTER_CRITICAL(&accidentMux);
+  AccidentDetectorStatus copy = accidentStatus;
+  portEXIT_CRITICAL(&accidentMux);
+  return copy;
 }
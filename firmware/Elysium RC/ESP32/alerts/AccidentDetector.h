@@ -2,8 +2,31 @@
 #define ACCIDENT_DETECTOR_H
 
 #include <Arduino.h>
+#include "AccidentDetection.h"
 
+/**
+ * Detectarea accidentelor în timpul mersului și anunțarea lor prin ESP-NOW.
+ *
+ * Taskul detectorului este trezit de fiecare eșantion Arduino (200 Hz: viteza roții și busola)
+ * și preia din pipeline măsurătorile ultrasonice brute; semnalele trec prin AccidentFusion
+ * (AccidentDetection.h). La o detecție vehiculul se oprește și incidentul este
+ * anunțat semnelor de circulație din apropiere prin AlertTransmitter, cu confirmare.
+ */
+
+#define ACC_PRIORITY 3
+#define ACC_WAIT_MS 10                 // fără eșantioane Arduino tot verificăm pipeline-ul
+#define ACC_ALERT_PRIORITY 2           // peste alertele obișnuite în coada de transmisie
+
+struct AccidentDetectorStatus {
+  uint32_t detections;
+  uint32_t lastDetectionMs;      // millis() la ultima detecție, 0 = niciuna
+  uint8_t lastSignals;           // ACC_SIGNAL_* ale ultimei detecții
+  uint32_t lastLatencyUs;        // eșantionul decisiv -> decizie
+};
+
+// Funcții
 void AccidentDetector_init();
-void AccidentDetector_update();
+void AccidentDetector_setConfig(const AccidentConfig& config);
+AccidentDetectorStatus AccidentDetector_getStatus();
 
 #endif
@@ -0,0 +1,293 @@
+#ifndef ALERT_SCHEDULER_H
+#define ALERT_SCHEDULER_H
+
+/**
+ * Planificarea transmisiilor de alertă (fără dependențe Arduino, simulată pe calculator
+ * în tools/alert).
+ *
+ * Fiecare incident primește un ID și rămâne în coadă până când este confirmat de
+ * requiredAcks semne diferite sau până la termenul deadlineUs. Retransmisiile pornesc la
+ * firstBackoffUs după confirmarea radio a trimiterii (callback-ul ESP-NOW) și se dublează
+ * până la maxBackoffUs, cu o abatere aleatoare de ±25% ca două vehicule să nu se
+ * sincronizeze. Un singur cadru este în aer la un moment dat; dintre incidentele scadente
+ * pleacă cel cu prioritatea cea mai mare, apoi cel mai vechi.
+ *
+ * Un incident cerut din nou cât timp același eveniment este încă în coadă nu creează
+ * unul nou (condiția de declanșare poate rămâne adevărată mai mulți pași la rând).
+ */
+
+#include <stdint.h>
+#include "../../../shared/alert/AlertProtocol.h"
+
+#define ALERT_QUEUE_LENGTH 4
+
+struct AlertSchedulerConfig {
+  uint8_t requiredAcks;      // confirmări de la semne diferite pentru livrare
+  uint32_t firstBackoffUs;
+  uint32_t maxBackoffUs;
+  uint32_t deadlineUs;       // de la cerere; după el incidentul se abandonează
+  uint32_t sendTimeoutUs;    // callback-ul de trimitere nu a venit: considerăm trimiterea eșuată
+};
+
+static inline AlertSchedulerConfig alertDefaultConfig() {
+  AlertSchedulerConfig c;
+  c.requiredAcks = 2;
+  c.firstBackoffUs = 10000;
+  c.maxBackoffUs = 500000;
+  c.deadlineUs = 5000000;
+  c.sendTimeoutUs = 50000;
+  return c;
+}
+
+struct AlertStats {
+  uint32_t incidents;        // incidente acceptate
+  uint32_t merged;           // cereri alipite unui incident încă activ
+  uint32_t dropped;          // respinse sau înlocuite când coada era plină
+  uint32_t attempts;         // cadre predate radioului
+  uint32_t sendFailures;     // trimiteri eșuate sau fără callback
+  uint32_t acks;             // confirmări de la semne noi pentru incident
+  uint32_t duplicateAcks;    // confirmări repetate sau pentru incidente deja încheiate
+  uint32_t delivered;
+  uint32_t expired;
+  uint32_t firstAcks;
+  uint32_t lastFirstAckUs;   // cerere -> prima confirmare
+  uint32_t maxFirstAckUs;
+};
+
+class AlertScheduler {
+public:
+  explicit AlertScheduler(const AlertSchedulerConfig& config = alertDefaultConfig(), uint32_t seed = 1)
+      : _cfg(config), _random(seed ? seed : 1), _sequence(0), _inFlight(-1), _stats() {
+    // Partea de sus a ID-ului diferă de la o pornire la alta, ca semnele să nu confunde incidentele
+    _nextId = (seed << 16) | 1;
+    for (int i = 0; i < ALERT_QUEUE_LENGTH; i++) _entries[i].used = false;
+  }
+
+  void setConfig(const AlertSchedulerConfig& config) { _cfg = config; }
+
+  /**
+   * Cere anunțarea unui eveniment. Întoarce ID-ul incidentului (al celui existent dacă
+   * evenimentul este deja în coadă) sau 0 dacă a fost respins.
+   */
+  uint32_t submit(uint8_t event, uint8_t priority, uint8_t severity, uint32_t nowUs) {
+    for (int i = 0; i < ALERT_QUEUE_LENGTH; i++) {
+      Entry& e = _entries[i];
+      if (e.used && e.event == event) {
+        if (priority > e.priority) e.priority = priority;
+        if (severity > e.severity) e.severity = severity;
+        _stats.merged++;
+        return e.incidentId;
+      }
+    }
+
+    int slot = freeSlot(priority);
+    if (slot < 0) {
+      _stats.dropped++;
+      return 0;
+    }
+
+    Entry& e = _entries[slot];
+    e.used = true;
+    e.incidentId = _nextId++;
+    if (_nextId == 0) _nextId = 1;
+    e.event = event;
+    e.priority = priority;
+    e.severity = severity;
+    e.createdUs = nowUs;
+    e.nextUs = nowUs;
+    e.sentUs = 0;
+    e.backoffUs = _cfg.firstBackoffUs;
+    e.attempts = 0;
+    e.ackMask = 0;
+    e.acks = 0;
+    _stats.incidents++;
+    return e.incidentId;
+  }
+
+  // Întoarce true dacă out trebuie trimis acum; după trimitere se apelează onSent()
+  bool poll(uint32_t nowUs, AlertFrame& out) {
+    expire(nowUs);
+    if (_inFlight >= 0) {
+      if (elapsed(_entries[_inFlight].sentUs, nowUs) < _cfg.sendTimeoutUs) return false;
+      onSent(false, nowUs);
+    }
+
+    int best = -1;
+    for (int i = 0; i < ALERT_QUEUE_LENGTH; i++) {
+      const Entry& e = _entries[i];
+      if (!e.used || (int32_t)(nowUs - e.nextUs) < 0) continue;
+      if (best < 0 || e.priority > _entries[best].priority ||
+          (e.priority == _entries[best].priority &&
+           (int32_t)(e.createdUs - _entries[best].createdUs) < 0)) {
+        best = i;
+      }
+    }
+    if (best < 0) return false;
+
+    Entry& e = _entries[best];
+    e.attempts++;
+    e.sentUs = nowUs;
+    _inFlight = best;
+    _stats.attempts++;
+
+    out.type = ALERT_TYPE_ALERT;
+    out.incidentId = e.incidentId;
+    out.sequence = ++_sequence;
+    out.event = e.event;
+    out.priority = e.priority;
+    out.severity = e.severity;
+    out.signId = 0;
+    return true;
+  }
+
+  // Rezultatul radio al ultimului cadru (pentru broadcast: doar că a plecat)
+  void onSent(bool ok, uint32_t nowUs) {
+    if (_inFlight < 0) return;
+    Entry& e = _entries[_inFlight];
+    _inFlight = -1;
+    if (!e.used) return;
+    if (!ok) {
+      // Radioul ocupat sau coada driverului plină: reîncercăm curând, fără să dublăm pauza
+      _stats.sendFailures++;
+      e.nextUs = nowUs + _cfg.firstBackoffUs;
+      return;
+    }
+    e.nextUs = nowUs + jitter(e.backoffUs);
+    e.backoffUs = e.backoffUs * 2 < _cfg.maxBackoffUs ? e.backoffUs * 2 : _cfg.maxBackoffUs;
+  }
+
+  // O confirmare de la un semn; întoarce true dacă incidentul tocmai a fost livrat
+  bool onAck(const AlertFrame& ack, uint32_t nowUs) {
+    if (ack.type != ALERT_TYPE_ACK || ack.signId == 0 || ack.signId > ALERT_MAX_SIGN_ID) return false;
+    int index = find(ack.incidentId);
+    uint32_t bit = 1UL << ack.signId;
+    if (index < 0 || (_entries[index].ackMask & bit)) {
+      _stats.duplicateAcks++;
+      return false;
+    }
+
+    Entry& e = _entries[index];
+    e.ackMask |= bit;
+    e.acks++;
+    _stats.acks++;
+    if (e.acks == 1) {
+      uint32_t latency = elapsed(e.createdUs, nowUs);
+      _stats.firstAcks++;
+      _stats.lastFirstAckUs = latency;
+      if (latency > _stats.maxFirstAckUs) _stats.maxFirstAckUs = latency;
+    }
+    if (e.acks < _cfg.requiredAcks) return false;
+
+    _stats.delivered++;
+    release(index);
+    return true;
+  }
+
+  // Microsecunde până la următoarea acțiune (UINT32_MAX dacă nu este nimic de făcut)
+  uint32_t nextActionUs(uint32_t nowUs) const {
+    uint32_t best = UINT32_MAX;
+    for (int i = 0; i < ALERT_QUEUE_LENGTH; i++) {
+      const Entry& e = _entries[i];
+      if (!e.used) continue;
+      uint32_t due;
+      if (i == _inFlight) {
+        due = remaining(e.sentUs + _cfg.sendTimeoutUs, nowUs);
+      } else {
+        due = remaining(e.nextUs, nowUs);
+      }
+      uint32_t deadline = remaining(e.createdUs + _cfg.deadlineUs, nowUs);
+      if (deadline < due) due = deadline;
+      if (due < best) best = due;
+    }
+    return best;
+  }
+
+  int pending() const {
+    int n = 0;
+    for (int i = 0; i < ALERT_QUEUE_LENGTH; i++) n += _entries[i].used ? 1 : 0;
+    return n;
+  }
+
+  const AlertStats& stats() const { return _stats; }
+
+private:
+  struct Entry {
+    bool used;
+    uint32_t incidentId;
+    uint8_t event;
+    uint8_t priority;
+    uint8_t severity;
+    uint32_t createdUs;
+    uint32_t nextUs;           // următoarea transmisie
+    uint32_t sentUs;           // ultima transmisie
+    uint32_t backoffUs;        // pauza de după următoarea trimitere reușită
+    uint16_t attempts;
+    uint32_t ackMask;          // biții ID-urilor semnelor care au confirmat
+    uint8_t acks;
+  };
+
+  AlertSchedulerConfig _cfg;
+  Entry _entries[ALERT_QUEUE_LENGTH];
+  uint32_t _random;
+  uint32_t _nextId;
+  uint16_t _sequence;
+  int _inFlight;
+  AlertStats _stats;
+
+  static uint32_t elapsed(uint32_t fromUs, uint32_t nowUs) { return nowUs - fromUs; }
+
+  static uint32_t remaining(uint32_t atUs, uint32_t nowUs) {
+    int32_t left = (int32_t)(atUs - nowUs);
+    return left > 0 ? (uint32_t)left : 0;
+  }
+
+  // Pauza cu abatere uniformă de ±25%
+  uint32_t jitter(uint32_t us) {
+    _random = _random * 1664525u + 1013904223u;
+    uint32_t span = us / 2;
+    return us - us / 4 + (span ? (_random >> 8) % span : 0);
+  }
+
+  int find(uint32_t incidentId) const {
+    for (int i = 0; i < ALERT_QUEUE_LENGTH; i++) {
+      if (_entries[i].used && _entries[i].incidentId == incidentId) return i;
+    }
+    return -1;
+  }
+
+  void release(int index) {
+    _entries[index].used = false;
+    if (_inFlight == index) _inFlight = -1;
+  }
+
+  void expire(uint32_t nowUs) {
+    for (int i = 0; i < ALERT_QUEUE_LENGTH; i++) {
+      if (_entries[i].used && elapsed(_entries[i].createdUs, nowUs) >= _cfg.deadlineUs) {
+        _stats.expired++;
+        release(i);
+      }
+    }
+  }
+
+  // Un loc liber sau, cu coada plină, locul celui mai vechi incident cu prioritate mai mică
+  int freeSlot(uint8_t priority) {
+    int victim = -1;
+    for (int i = 0; i < ALERT_QUEUE_LENGTH; i++) {
+      const Entry& e = _entries[i];
+      if (!e.used) return i;
+      if (e.priority >= priority) continue;
+      if (victim < 0 || e.priority < _entries[victim].priority ||
+          (e.priority == _entries[victim].priority &&
+           (int32_t)(e.createdUs - _entries[victim].createdUs) < 0)) {
+        victim = i;
+      }
+    }
+    if (victim >= 0) {
+      _stats.dropped++;
+      release(victim);
+    }
+    return victim;
+  }
+};
+
+#endif
@@ -0,0 +1,196 @@
+#include "AlertTransmitter.h"
+
+#include "../core/Pipeline.h"
+#include "../core/TaskMonitor.h"
+#include "../../../shared/log/DeferredLog.h"
+#include "../../../shared/heap/HeapGuard.h"
+#include "ESP32_NOW.h"
+#include "WiFi.h"
+#include <esp_random.h>
+
+enum AlertTaskEventKind {
+  ALERT_TASK_REQUEST,
+  ALERT_TASK_SENT,
+  ALERT_TASK_ACK
+};
+
+// Ce primește taskul prin coadă; callback-urile radio nu ating planificatorul
+struct AlertTaskEvent {
+  uint8_t kind;
+  bool ok;                   // ALERT_TASK_SENT
+  uint32_t us;
+  AlertFrame frame;          // cererea (event, priority, severity) sau confirmarea
+};
+
+static QueueHandle_t alertQueue = NULL;
+
+static void postEvent(const AlertTaskEvent& event) {
+  if (alertQueue != NULL) xQueueSend(alertQueue, &event, 0);
+}
+
+class AlertBroadcastPeer : public ESP_NOW_Peer {
+public:
+  AlertBroadcastPeer(uint8_t channel, wifi_interface_t iface, const uint8_t *lmk) :
+      ESP_NOW_Peer(ESP_NOW.BROADCAST_ADDR, channel, iface, lmk) {}
+
+  bool begin() {
+    return ESP_NOW.begin() && add();
+  }
+
+  bool send_message(const uint8_t *data, size_t len) {
+    return send(data, len) == len;
+  }
+
+  // Callback-ul de trimitere ESP-NOW (taskul WiFi): pentru broadcast, doar că a plecat
+  void onSent(bool success) {
+    AlertTaskEvent event = {};
+    event.kind = ALERT_TASK_SENT;
+    event.ok = success;
+    event.us = micros();
+    postEvent(event);
+  }
+};
+
+static AlertBroadcastPeer broadcast_peer(ESPNOW_WIFI_CHANNEL, WIFI_IF_STA, NULL);
+
+// Semnele nu sunt peer-i înregistrați: confirmările lor unicast sosesc aici
+static void onUnknownPeer(const esp_now_recv_info_t *info, const uint8_t *data, int len, void *arg) {
+  AlertTaskEvent event = {};
+  if (!alertDecode(data, len, event.frame) || event.frame.type != ALERT_TYPE_ACK) return;
+  event.kind = ALERT_TASK_ACK;
+  event.us = micros();
+  postEvent(event);
+}
+
+// Deținut de taskul alertelor
+static AlertScheduler alertScheduler;
+
+static portMUX_TYPE alertMux = portMUX_INITIALIZER_UNLOCKED;
+static AlertStats alertStats = {};
+static bool alertConfigRequested = false;
+static AlertSchedulerConfig alertRequestedConfig;
+
+static void applyAlertConfig() {
+  portENTER_CRITICAL(&alertMux);
+  bool requested = alertConfigRequested;
+  AlertSchedulerConfig config = alertRequestedConfig;
+  alertConfigRequested = false;
+  portEXIT_CRITICAL(&alertMux);
+  if (requested) alertScheduler.setConfig(config);
+}
+
+static void handleEvent(const AlertTaskEvent& event) {
+  switch (event.kind) {
+    case ALERT_TASK_REQUEST: {
+      uint32_t id = alertScheduler.submit(event.frame.event, event.frame.priority,
+                                          event.frame.severity, event.us);
+      if (id == 0) LOG_WARN("Alertă: coada plină, evenimentul %u respins", event.frame.event);
+      break;
+    }
+    case ALERT_TASK_SENT:
+      alertScheduler.onSent(event.ok, event.us);
+      break;
+    case ALERT_TASK_ACK:
+      if (alertScheduler.onAck(event.frame, event.us)) {
+        LOG_INFO("Alertă: incidentul %08lx livrat (ultima confirmare de la semnul %u)",
+                 (unsigned long)event.frame.incidentId, event.frame.signId);
+      }
+      break;
+  }
+}
+
+// Trimite cadrul scadent, dacă există; radioul are cel mult un cadru de alertă în aer
+static void transmitDue() {
+  AlertFrame frame;
+  uint32_t now = micros();
+  if (!alertScheduler.poll(now, frame)) return;
+
+  uint8_t buffer[ALERT_FRAME_LEN];
+  size_t len = alertEncode(frame, buffer);
+  // Trimiterea refuzată nu produce callback; esp_now_send alocă singur cadrul din coada radio
+  HeapGuardAllow allow;
+  if (!broadcast_peer.send_message(buffer, len)) alertScheduler.onSent(false, now);
+}
+
+static void alertTask(void* parameter) {
+  int monitorId = TaskMonitor_register("Alert", 0, 2000);
+  AlertTaskEvent event;
+  uint32_t lastExpired = 0;
+
+  while (true) {
+    uint32_t waitUs = alertScheduler.nextActionUs(micros());
+    TickType_t ticks = waitUs == UINT32_MAX ? portMAX_DELAY : pdMS_TO_TICKS((waitUs + 999) / 1000);
+    bool received = xQueueReceive(alertQueue, &event, ticks) == pdTRUE;
+    TaskMonitor_begin(monitorId);
+    applyAlertConfig();
+
+    if (received) {
+      handleEvent(event);
+      while (xQueueReceive(alertQueue, &event, 0) == pdTRUE) handleEvent(event);
+    }
+    transmitDue();
+
+    const AlertStats& stats = alertScheduler.stats();
+    if (stats.expired != lastExpired) {
+      lastExpired = stats.expired;
+      LOG_WARN("Alertă: incident abandonat la termen (%lu expirate în total)", (unsigned long)lastExpired);
+    }
+    portENTER_CRITICAL(&alertMux);
+    alertStats = stats;
+    portEXIT_CRITICAL(&alertMux);
+
+    TaskMonitor_end(monitorId);
+  }
+
+  vTaskDelete(NULL);
+}
+
+// Pornește WiFi în modul STA pe canalul semnelor și ESP-NOW; înainte de orice client
+void AlertTransmitter_init() {
+  Serial.println("\nPornire transmisie alerte (ESP-NOW)...");
+  WiFi.mode(WIFI_STA);
+  WiFi.setChannel(ESPNOW_WIFI_CHANNEL);
+  while (!WiFi.STA.started()) {
+    delay(50);
+  }
+
+  if (!broadcast_peer.begin()) {
+    Serial.println("Eroare init ESP-NOW, se repornește în 5s");
+    delay(5000);
+    ESP.restart();
+  }
+  ESP_NOW.onNewPeer(onUnknownPeer, NULL);
+
+  // ID-urile incidentelor diferă de la o pornire la alta
+  alertScheduler = AlertScheduler(alertDefaultConfig(), esp_random() & 0xFFFF);
+  alertQueue = xQueueCreate(ALERT_EVENT_QUEUE_LENGTH, sizeof(AlertTaskEvent));
+  xTaskCreatePinnedToCore(alertTask, "Alert", 3072, NULL, ALERT_PRIORITY, NULL, PIPELINE_CORE);
+}
+
+/**
+ * Cere anunțarea unui eveniment (ALERT_EVENT_*) și revine imediat.
+ * Întoarce false dacă cererea nu a încăput în coada taskului.
+ */
+bool AlertTransmitter_send(uint8_t event, uint8_t priority, uint8_t severity) {
+  AlertTaskEvent request = {};
+  request.kind = ALERT_TASK_REQUEST;
+  request.us = micros();
+  request.frame.event = event;
+  request.frame.priority = priority;
+  request.frame.severity = severity;
+  return alertQueue != NULL && xQueueSend(alertQueue, &request, 0) == pdTRUE;
+}
+
+void AlertTransmitter_setConfig(const AlertSchedulerConfig& config) {
+  portENTER_CRITICAL(&alertMux);
+  alertRequestedConfig = config;
+  alertConfigRequested = true;
+  portEXIT_CRITICAL(&alertMux);
+}
+
+AlertStats AlertTransmitter_getStats() {
+  portENTER_CRITICAL(&alertMux);
+  AlertStats copy = alertStats;
+  portEXIT_CRITICAL(&alertMux);
+  return copy;
+}
@@ -0,0 +1,27 @@
+#ifndef ALERT_TRANSMITTER_H
+#define ALERT_TRANSMITTER_H
+
+#include <Arduino.h>
+#include "AlertScheduler.h"
+
+/**
+ * Transmisia alertelor către semnele de circulație prin ESP-NOW, cu confirmare.
+ *
+ * Cererile (AlertTransmitter_send), rezultatul radio al fiecărui cadru (callback-ul de
+ * trimitere ESP-NOW) și confirmările semnelor ajung printr-o coadă FreeRTOS la un singur
+ * task, care deține AlertScheduler: fiecare incident se retransmite broadcast, cu pauze
+ * dublate, până când îl confirmă ALERT_REQUIRED_ACKS semne sau până la termen.
+ * Taskul doarme până la următoarea retransmisie, fără polling.
+ */
+
+#define ALERT_PRIORITY 2
+#define ALERT_EVENT_QUEUE_LENGTH 8
+#define ESPNOW_WIFI_CHANNEL 6
+
+// Funcții
+void AlertTransmitter_init();
+bool AlertTransmitter_send(uint8_t event, uint8_t priority, uint8_t severity);
+void AlertTransmitter_setConfig(const AlertSchedulerConfig& config);
+AlertStats AlertTransmitter_getStats();
+
+#endif
@@ -0,0 +1,93 @@
+#include "VehicleBench.h"
+#include "../core/Pipeline.h"
+#include "../core/TaskManager.h"
+#include "../sensors/RFIDManager.h"
+#include "../feedback/BuzzerManager.h"
+
+// Zgomot determinist: același corpus pe placă și pe calculator
+static uint32_t benchRandom(uint32_t& state) {
+  state = state * 1664525u + 1013904223u;
+  return state >> 8;
+}
+
+// ******************* RFID ********************************************
+// Inventarul continuu cu 6 tag-uri în câmp: notificări, erori "niciun tag" și un cadru corupt
+static uint8_t benchRfidCorpus[VEHICLE_BENCH_RFID_FRAMES * RFID_MAX_FRAME];
+static size_t benchRfidCorpusLen = 0;
+static unsigned long benchRfidNow = 0;
+
+// Cadrele cititorului au același format ca o comandă, doar tipul diferă
+static size_t benchRfidFrame(uint8_t type, uint8_t command, const uint8_t* params, uint16_t len, uint8_t* out) {
+  size_t n = rfidEncodeCommand(command, params, len, out);
+  out[1] = type;
+  out[n - 2] += type;
+  return n;
+}
+
+static void benchRfidSetup() {
+  uint32_t state = 1;
+  benchRfidCorpusLen = 0;
+  for (int i = 0; i < VEHICLE_BENCH_RFID_FRAMES; i++) {
+    uint8_t* out = benchRfidCorpus + benchRfidCorpusLen;
+    if (i % 8 == 7) {
+      uint8_t error = RFID_ERROR_NO_TAG;
+      benchRfidCorpusLen += benchRfidFrame(RFID_TYPE_RESPONSE, RFID_CMD_ERROR, &error, 1, out);
+      continue;
+    }
+
+    // RSSI | PC | EPC de 96 de biți ca pe harta traseului | CRC tag
+    uint8_t params[5 + RFID_EPC_MAX] = { 0, (RFID_EPC_MAX / 2) << 3, 0x00,
+                                         0xE2, 0x80, 0x68, 0x94, 0x00, 0x00, 0x50, 0x10, 0x00, 0x00, 0x00 };
+    params[0] = (uint8_t)(int8_t)(-40 - (int)(benchRandom(state) % 30));
+    params[3 + RFID_EPC_MAX - 1] = (uint8_t)(1 + i % 6);
+    params[3 + RFID_EPC_MAX] = 0x12;
+    params[4 + RFID_EPC_MAX] = 0x34;
+    size_t n = benchRfidFrame(RFID_TYPE_NOTICE, RFID_CMD_SINGLE_POLL, params, sizeof(params), out);
+    if (i == 13) out[n - 2] ^= 0x5A;   // suma de control greșită
+    benchRfidCorpusLen += n;
+  }
+}
+
+static void benchRfidFeed(uint32_t iterations) {
+  RfidTagEvent event;
+  for (uint32_t i = 0; i < iterations; i++) {
+    benchRfidNow += 20;   // o rundă de inventar la 20 ms
+    RFIDManager_feed(benchRfidCorpus, benchRfidCorpusLen, benchRfidNow);
+    while (RFIDManager_nextEvent(event)) benchKeep(event.type);
+  }
+}
+
+// ******************* BUZZER ******************************************
+// Cadre fuzionate cu canale valide și invalide, obstacole între 2 și 120 cm, apropiere și depărtare
+static PerceptionFrame benchFrames[VEHICLE_BENCH_FRAMES];
+
+static void benchBuzzerSetup() {
+  uint32_t state = 7;
+  memset(benchFrames, 0, sizeof(benchFrames));
+  for (int f = 0; f < VEHICLE_BENCH_FRAMES; f++) {
+    for (int i = 0; i < ULTRASONIC_SENSOR_COUNT; i++) {
+      RangeEstimate& r = benchFrames[f].range[i];
+      r.flags = (benchRandom(state) % 4 != 0) ? RANGE_VALID : 0;
+      r.distanceCm = 2.0f + (float)(benchRandom(state) % 1180) / 10.0f;
+      r.rateCmS = -60.0f + (float)(benchRandom(state) % 80);
+      r.confidence = 80;
+    }
+  }
+}
+
+static void benchBuzzerPattern(uint32_t iterations) {
+  BuzzerPattern pattern = {0, 0, 0, 0, 0};
+  for (uint32_t i = 0; i < iterations; i++) {
+    for (int f = 0; f < VEHICLE_BENCH_FRAMES; f++) {
+      bool beep = buzzerProximityPattern(benchFrames[f], pattern);
+      benchKeep(beep);
+      benchKeep(pattern);
+    }
+  }
+}
+
+const BenchCase VEHICLE_BENCH_CASES[] = {
+  { "vehicle/rfid_feed", benchRfidSetup, benchRfidFeed, VEHICLE_BENCH_RFID_FRAMES },
+  { "vehicle/buzzer_pattern", benchBuzzerSetup, benchBuzzerPattern, VEHICLE_BENCH_FRAMES },
+};
+const size_t VEHICLE_BENCH_CASE_COUNT = sizeof(VEHICLE_BENCH_CASES) / sizeof(VEHICLE_BENCH_CASES[0]);
@@ -0,0 +1,24 @@
+#ifndef VEHICLE_BENCH_H
+#define VEHICLE_BENCH_H
+
+#include "../../../shared/bench/MicroBench.h"
+
+/**
+ * Microbenchmark-urile vehiculului: decodarea cadrelor RFID (RFIDManager_feed) și
+ * maparea distanță -> ritmul buzzer-ului (buzzerProximityPattern), pe corpusuri fixe.
+ *
+ * Cu ELYSIUM_BENCH=1, setup() doar le rulează și tipărește JSON-ul pe Serial
+ * (MicroBenchArduino.h); pe calculator le rulează tools/host-sim/bench/vehicle_bench.
+ */
+
+#ifndef ELYSIUM_BENCH
+#define ELYSIUM_BENCH 0
+#endif
+
+#define VEHICLE_BENCH_RFID_FRAMES 32
+#define VEHICLE_BENCH_FRAMES 64
+
+extern const BenchCase VEHICLE_BENCH_CASES[];
+extern const size_t VEHICLE_BENCH_CASE_COUNT;
+
+#endif
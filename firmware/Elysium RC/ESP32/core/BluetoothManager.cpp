@@ -0,0 +1,233 @@
+#include "BluetoothManager.h"
+#include "../../../shared/log/DeferredLog.h"
+
+#if ELYSIUM_BT_CLASSIC
+// ******************* BLUETOOTH CLASSIC (SPP) ***************************
+void BluetoothManager::begin() {
+  SerialBT.begin(deviceName);
+  SerialBT.onData([this](const uint8_t* data, size_t len) {
+    _stats.rxBytes += len;
+    if (_onData != nullptr) _onData(data, len);
+  });
+  Serial.println("Bluetooth device started, you can pair it with your Android device!");
+}
+
+bool BluetoothManager::isConnected() {
+  return SerialBT.connected();
+}
+
+void BluetoothManager::sendBytes(const uint8_t* data, size_t len) {
+  if (!isConnected()) {
+    _stats.dropped += len;
+    return;
+  }
+  // Stiva Classic își face singură bufferul: fiecare apel devine o scriere
+  HeapGuardAllow allow;
+  SerialBT.write(data, len);
+  _stats.packets++;
+  _stats.txBytes += len;
+  if (len > _stats.maxPacket) _stats.maxPacket = len;
+}
+
+void BluetoothManager::flush() {
+}
+
+void BluetoothManager::update() {
+  bool connected = isConnected();
+  if (connected && !_wasConnected) _stats.connections++;
+  _wasConnected = connected;
+}
+
+void BluetoothManager::setProfile(BtProfile profile) {
+  if (profile >= BT_PROFILE_COUNT) return;
+  _profile = profile;
+  LOG_INFO("Bluetooth SPP: profilul %s nu se aplică (fără parametri de conexiune)", BT_PROFILES[profile].name);
+}
+
+#else
+// ******************* BLE (GATT) ****************************************
+// Callback-urile serverului rulează în taskul Bluetooth și doar predau evenimentul managerului
+class VehicleBleCallbacks : public BLEServerCallbacks, public BLECharacteristicCallbacks {
+public:
+  explicit VehicleBleCallbacks(BluetoothManager* manager) : _manager(manager) {}
+
+  void onConnect(BLEServer* server, esp_ble_gatts_cb_param_t* param) override {
+    _manager->handleConnect(param->connect.conn_id, param->connect.remote_bda);
+  }
+
+  void onDisconnect(BLEServer* server) override {
+    _manager->handleDisconnect();
+  }
+
+  void onWrite(BLECharacteristic* characteristic) override {
+    _manager->handleWrite(characteristic->getData(), characteristic->getLength());
+  }
+
+private:
+  BluetoothManager* _manager;
+};
+
+void BluetoothManager::begin() {
+  // Doar BLE: memoria controllerului Classic se eliberează, ca la semne
+  esp_bt_controller_mem_release(ESP_BT_MODE_CLASSIC_BT);
+  BLEDevice::init(deviceName);
+  BLEDevice::setMTU(BLE_LOCAL_MTU);
+
+  VehicleBleCallbacks* callbacks = new VehicleBleCallbacks(this);
+  _server = BLEDevice::createServer();
+  _server->setCallbacks(callbacks);
+
+  BLEService* service = _server->createService(VEHICLE_SERVICE_UUID);
+  _commandCharacteristic = service->createCharacteristic(
+      VEHICLE_COMMAND_UUID, BLECharacteristic::PROPERTY_WRITE_NR);
+  _commandCharacteristic->setCallbacks(callbacks);
+  _telemetryCharacteristic = service->createCharacteristic(
+      VEHICLE_TELEMETRY_UUID, BLECharacteristic::PROPERTY_NOTIFY);
+  _telemetryCccd = new BLE2902();
+  _telemetryCharacteristic->addDescriptor(_telemetryCccd);
+  service->start();
+
+  BLEAdvertising* advertising = BLEDevice::getAdvertising();
+  advertising->addServiceUUID(VEHICLE_SERVICE_UUID);
+  advertising->setScanResponse(true);
+  BLEDevice::startAdvertising();
+  Serial.println("BLE server started, you can connect from the Android app!");
+}
+
+// Conectat și cu notificările telemetriei activate de aplicație
+bool BluetoothManager::isConnected() {
+  return _connected && _telemetryCccd->getNotifications();
+}
+
+void BluetoothManager::handleConnect(uint16_t connId, const uint8_t* peer) {
+  _connId = connId;
+  memcpy(_peer, peer, sizeof(_peer));
+  _stats.connections++;
+  _connected = true;
+  LOG_INFO("BLE: aplicația s-a conectat");
+}
+
+void BluetoothManager::handleDisconnect() {
+  _connected = false;
+  LOG_INFO("BLE: aplicația s-a deconectat, reluăm anunțarea");
+  _server->startAdvertising();
+}
+
+void BluetoothManager::handleWrite(const uint8_t* data, size_t len) {
+  _stats.rxBytes += len;
+  if (_onData != nullptr) _onData(data, len);
+}
+
+void BluetoothManager::requestProfile() {
+  const BtConnectionProfile& p = BT_PROFILES[_profile];
+  HeapGuardAllow allow;
+  _server->updateConnParams(_peer, p.minInterval, p.maxInterval, p.latency, p.timeout);
+}
+
+// O conexiune nouă (din callback) începe, în loop(), cu MTU implicit și profilul curent
+void BluetoothManager::syncConnection() {
+  if (_stats.connections == _handledConnections) return;
+  _handledConnections = _stats.connections;
+  _mtu = BLE_DEFAULT_MTU;
+  _stats.dropped += _batchLen;
+  _batchLen = 0;
+  requestProfile();
+}
+
+// Un mesaj care încape într-o notificare nu se rupe între două: lotul pleacă înainte
+void BluetoothManager::makeRoom(size_t len) {
+  if (_batchLen > 0 && _batchLen + len > payloadLimit() && len <= payloadLimit()) flush();
+}
+
+// Adaugă octeții la lotul notificării următoare
+void BluetoothManager::sendBytes(const uint8_t* data, size_t len) {
+  if (!isConnected()) {
+    _stats.dropped += len;
+    return;
+  }
+  syncConnection();
+  makeRoom(len);
+
+  size_t limit = payloadLimit();
+  while (len > 0) {
+    if (_batchLen == 0) _batchSinceUs = micros();
+    size_t n = min(len, limit - _batchLen);
+    memcpy(_batch + _batchLen, data, n);
+    _batchLen += n;
+    data += n;
+    len -= n;
+    if (_batchLen == limit) flush();
+  }
+}
+
+void BluetoothManager::flush() {
+  if (_batchLen == 0) return;
+  if (!isConnected()) {
+    _stats.dropped += _batchLen;
+    _batchLen = 0;
+    return;
+  }
+  {
+    HeapGuardAllow allow;   // Bluedroid copiază notificarea într-un mesaj alocat
+    _telemetryCharacteristic->setValue(_batch, _batchLen);
+    _telemetryCharacteristic->notify();
+  }
+  _stats.packets++;
+  _stats.txBytes += _batchLen;
+  if (_batchLen > _stats.maxPacket) _stats.maxPacket = _batchLen;
+  _batchLen = 0;
+}
+
+/**
+ * O notificare nu pleacă înaintea următorului eveniment de conexiune, deci lotul poate
+ * aștepta un interval fără să întârzie datele
+ */
+void BluetoothManager::update() {
+  if (!_connected) {
+    _stats.dropped += _batchLen;
+    _batchLen = 0;
+    return;
+  }
+  syncConnection();
+
+  uint16_t mtu = _server->getPeerMTU(_connId);
+  if (mtu > _mtu) {
+    _mtu = min(mtu, (uint16_t)BLE_LOCAL_MTU);
+    LOG_INFO("BLE: MTU %u, notificări de cel mult %u octeți", _mtu, (unsigned)payloadLimit());
+  }
+
+  if (_batchLen > 0 && micros() - _batchSinceUs >= BT_PROFILES[_profile].minInterval * 1250UL) flush();
+}
+
+void BluetoothManager::setProfile(BtProfile profile) {
+  if (profile >= BT_PROFILE_COUNT) return;
+  _profile = profile;
+  LOG_INFO("BLE: profil %s", BT_PROFILES[profile].name);
+  if (_connected && _handledConnections == _stats.connections) requestProfile();
+}
+#endif
+
+// ******************* COMUN *********************************************
+void BluetoothManager::sendData(const char* line) {
+  size_t len = strlen(line);
+#if !ELYSIUM_BT_CLASSIC
+  if (isConnected()) {
+    syncConnection();
+    makeRoom(len + 2);
+  }
+#endif
+  sendBytes((const uint8_t*)line, len);
+  sendBytes((const uint8_t*)"\r\n", 2);
+}
+
+void BluetoothManager::onData(BluetoothDataCallback callback) {
+  _onData = callback;
+}
+
+BluetoothStats BluetoothManager::getStats() {
+  _stats.connected = isConnected();
+#if !ELYSIUM_BT_CLASSIC
+  _stats.mtu = _connected ? _mtu : 0;
+#endif
+  return _stats;
+}
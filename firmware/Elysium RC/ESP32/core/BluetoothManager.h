@@ -1,37 +1,144 @@
 #ifndef BLUETOOTH_MANAGER_H
 #define BLUETOOTH_MANAGER_H
 
+#include <Arduino.h>
+#include "../../../shared/heap/HeapGuard.h"
+
+/**
+ * Legătura cu aplicația Android. Implicit BLE (GATT), ca la semnele de circulație:
+ *  - caracteristica de comenzi primește scrieri fără răspuns (write-without-response);
+ *    octeții ajung direct în callback-ul onData(), din taskul Bluetooth
+ *  - caracteristica de telemetrie trimite notificări; tot ce se trimite (telemetria binară,
+ *    liniile text) se adună într-un lot de cel mult MTU - 3 octeți, trimis când se umple sau
+ *    după un interval de conexiune (update()), deci o notificare duce mai multe cadre
+ *  - profilul conexiunii (intervalul, evenimentele sărite) se alege între latență mică și
+ *    consum redus, la pornire (ELYSIUM_BT_PROFILE) sau din aplicație (CMD_BT_PROFILE)
+ *
+ * Cu ELYSIUM_BT_CLASSIC=1 se folosește vechiul Bluetooth Classic SPP (BluetoothSerial), cu
+ * aceeași interfață, pentru comparație. Ambele variante numără octeții și pachetele, iar
+ * CommandChannel măsoară latența comenzilor (CMD_PING și sosire -> execuție).
+ *
+ * Toate trimiterile se fac din loop(); callback-urile rulează în taskul Bluetooth.
+ * Liniile de text se trimit din buffere char[] (sendData(const char*)), fără String temporar.
+ */
+
+#ifndef ELYSIUM_BT_CLASSIC
+#define ELYSIUM_BT_CLASSIC 0
+#endif
+
+#if ELYSIUM_BT_CLASSIC
 #include <BluetoothSerial.h>
+#else
+#include <BLEDevice.h>
+#include <BLEServer.h>
+#include <BLEUtils.h>
+#include <BLE2902.h>
+#endif
+
+// UUID-uri BLE; trebuie să fie identice cu cele din aplicația Android
+#define VEHICLE_SERVICE_UUID             "8f0e0d0c-0b0a-0908-0706-0504030201a0"
+#define VEHICLE_COMMAND_UUID             "8f0e0d0c-0b0a-0908-0706-0504030201a1"
+#define VEHICLE_TELEMETRY_UUID           "8f0e0d0c-0b0a-0908-0706-0504030201a2"
+
+#define BLE_LOCAL_MTU 247                // o notificare întreagă într-un pachet cu Data Length Extension
+#define BLE_DEFAULT_MTU 23               // până la schimbul de MTU
+#define BLE_ATT_HEADER 3                 // opcode + handle, din fiecare notificare
+#define BLE_MAX_PAYLOAD (BLE_LOCAL_MTU - BLE_ATT_HEADER)
+
+enum BtProfile {
+  BT_PROFILE_LOW_LATENCY = 0,
+  BT_PROFILE_LOW_POWER = 1,
+  BT_PROFILE_COUNT
+};
+
+#ifndef ELYSIUM_BT_PROFILE
+#define ELYSIUM_BT_PROFILE BT_PROFILE_LOW_LATENCY
+#endif
+
+// Parametrii ceruți telefonului; el alege intervalul în [minInterval, maxInterval]
+struct BtConnectionProfile {
+  const char* name;
+  uint16_t minInterval;     // unități de 1.25 ms
+  uint16_t maxInterval;
+  uint16_t latency;         // evenimente de conexiune pe care vehiculul le poate sări fără date
+  uint16_t timeout;         // supervizare, unități de 10 ms
+};
+
+static const BtConnectionProfile BT_PROFILES[BT_PROFILE_COUNT] = {
+  { "latență mică", 6, 12, 0, 200 },     // 7.5-15 ms
+  { "consum redus", 80, 160, 4, 600 },   // 100-200 ms, până la 1 s fără trafic
+};
+
+typedef void (*BluetoothDataCallback)(const uint8_t* data, size_t len);
+
+struct BluetoothStats {
+  const char* transport;    // "BLE" sau "SPP"
+  bool connected;
+  uint16_t mtu;             // MTU negociat (BLE), 0 la SPP
+  uint32_t connections;
+  uint32_t rxBytes;
+  uint32_t txBytes;
+  uint32_t packets;         // notificări BLE / scrieri SPP
+  uint32_t dropped;         // octeți aruncați: nicio conexiune (sau notificările neactivate)
+  uint32_t maxPacket;       // cel mai mare pachet trimis
+};
 
 class BluetoothManager {
+public:
+    void begin();
+    bool isConnected();
+    void sendData(const char* line);                   // o linie de text, cu "\r\n"
+    void sendData(const String& data) { sendData(data.c_str()); }
+    void sendBytes(const uint8_t* data, size_t len);
+    // Octeții primiți ajung direct în callback (din taskul Bluetooth)
+    void onData(BluetoothDataCallback callback);
+    // Trimite imediat lotul în așteptare (ex. răspunsul la CMD_PING)
+    void flush();
+    // Din loop(): trimite lotul care a așteptat un interval de conexiune
+    void update();
+    void setProfile(BtProfile profile);
+    BtProfile getProfile() const { return _profile; }
+    BluetoothStats getStats();
+    // Crește la fiecare conexiune nouă (la SPP, observată în update())
+    uint32_t connectionCount() const { return _stats.connections; }
+
+#if !ELYSIUM_BT_CLASSIC
+    // Apelate de callback-urile serverului BLE (BluetoothManager.cpp)
+    void handleConnect(uint16_t connId, const uint8_t* peer);
+    void handleDisconnect();
+    void handleWrite(const uint8_t* data, size_t len);
+#endif
+
 private:
-    BluetoothSerial SerialBT;
     const char* deviceName = "ElysiumRC";
-    
-public:
-    void begin() {
-        SerialBT.begin(deviceName);
-        Serial.println("Bluetooth device started, you can pair it with your Android device!");
-    }
-    
-    bool isConnected() {
-        return SerialBT.connected();
-    }
-    
-    void sendData(const String& data) {
-        if (isConnected()) {
-            SerialBT.println(data);
-        }
-    }
-    
-    String receiveData() {
-        String data = "";
-        if (SerialBT.available()) {
-            data = SerialBT.readStringUntil('\n');
-            data.trim();
-        }
-        return data;
-    }
+    BtProfile _profile = (BtProfile)ELYSIUM_BT_PROFILE;
+    BluetoothStats _stats = { ELYSIUM_BT_CLASSIC ? "SPP" : "BLE", false, 0, 0, 0, 0, 0, 0, 0 };
+    BluetoothDataCallback _onData = nullptr;
+
+#if ELYSIUM_BT_CLASSIC
+    BluetoothSerial SerialBT;
+    bool _wasConnected = false;
+#else
+    BLEServer* _server = nullptr;
+    BLECharacteristic* _commandCharacteristic = nullptr;
+    BLECharacteristic* _telemetryCharacteristic = nullptr;
+    BLE2902* _telemetryCccd = nullptr;
+    volatile bool _connected = false;
+    uint32_t _handledConnections = 0;           // conexiuni văzute deja din loop()
+    uint16_t _connId = 0;
+    uint8_t _peer[6];
+    uint16_t _mtu = BLE_DEFAULT_MTU;
+
+    // Lotul notificării următoare
+    uint8_t _batch[BLE_MAX_PAYLOAD];
+    size_t _batchLen = 0;
+    unsigned long _batchSinceUs = 0;
+
+    void requestProfile();
+    void syncConnection();
+    void makeRoom(size_t len);
+    size_t payloadLimit() const { return _mtu - BLE_ATT_HEADER; }
+#endif
 };
 
 #endif
@@ -0,0 +1,353 @@
+#include "CommandChannel.h"
+#include "RingBuffer.h"
+#include "TaskMonitor.h"
+#include "Recorder.h"
+#include "../../../shared/log/DeferredLog.h"
+#include "../../../shared/link/FrameCodec.h"
+#include "../motion-control/DCMotor.h"
+#include "../motion-control/ServoMotor.h"
+#include "../motion-control/SpeedController.h"
+#include "../motion-control/EmergencyBrake.h"
+#include "../navigation/Navigation.h"
+
+#define COMMAND_MAX_PAYLOAD 32
+#define COMMAND_HEADER_LEN 7    // id + seq + timp
+
+// Octeții sosiți prin Bluetooth; scriși din taskul Bluetooth, citiți din loop()
+static RingBuffer<COMMAND_RING_SIZE> rxRing;
+static CommandChannelStats commandStats = {0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0};
+static BluetoothManager* commandBt = nullptr;
+
+// Momentul primei sosiri încă neconsumate, scris din callback doar când nu există deja unul
+static volatile bool rxArrivalPending = false;
+static volatile uint32_t rxArrivalUs = 0;
+static uint32_t updateArrivalUs = 0;     // sosirea octeților consumați de apelul curent
+static uint32_t lastDispatchUs = 0;      // latența ultimei comenzi, pentru răspunsul la CMD_PING
+
+// ******************* HANDLERE ******************************************
+static void cmdForward(const uint8_t* args) {
+  DCMotor(true, false);
+}
+
+static void cmdBackward(const uint8_t* args) {
+  DCMotor(false, true);
+}
+
+static void cmdStop(const uint8_t* args) {
+  // Stop motor și centrare servo (oprește și calibrarea busolei, dacă rulează)
+  Navigation_cancelCalibration();
+  DCMotor(false, false);
+  ServoMotor(CENTER);
+}
+
+static void cmdLeft(const uint8_t* args) {
+  ServoMotor(LEFT);
+}
+
+static void cmdRight(const uint8_t* args) {
+  ServoMotor(RIGHT);
+}
+
+static void cmdReport(const uint8_t* args) {
+  TaskMonitor_requestReport();
+}
+
+static void cmdCalibrate(const uint8_t* args) {
+  Navigation_startCalibration();
+}
+
+static void cmdAebOverride(const uint8_t* args) {
+  EmergencyBrake_setOverride(true);
+}
+
+static void cmdAebArm(const uint8_t* args) {
+  EmergencyBrake_setOverride(false);
+}
+
+static void cmdAeb(const uint8_t* args) {
+  EmergencyBrake_setOverride(args[0] == 0);
+}
+
+static void cmdLogList(const uint8_t* args) {
+  Recorder_requestList();
+}
+
+static void cmdLogRead(const uint8_t* args) {
+  uint16_t file = (uint16_t)args[0] | ((uint16_t)args[1] << 8);
+  uint32_t offset = (uint32_t)args[2] | ((uint32_t)args[3] << 8) |
+                    ((uint32_t)args[4] << 16) | ((uint32_t)args[5] << 24);
+  Recorder_requestChunks(file, offset, args[6]);
+}
+
+static void cmdPing(const uint8_t* args) {
+  uint32_t token = (uint32_t)args[0] | ((uint32_t)args[1] << 8) |
+                   ((uint32_t)args[2] << 16) | ((uint32_t)args[3] << 24);
+  char line[40];
+  snprintf(line, sizeof(line), "PONG %lu %lu", (unsigned long)token, (unsigned long)lastDispatchUs);
+  commandStats.pings++;
+  // Răspunsul nu așteaptă lotul: latența măsurată de aplicație este cea a transportului
+  commandBt->sendData(line);
+  commandBt->flush();
+}
+
+static void cmdBtProfile(const uint8_t* args) {
+  commandBt->setProfile(args[0] == 0 ? BT_PROFILE_LOW_LATENCY : BT_PROFILE_LOW_POWER);
+}
+
+// Accelerație și direcție proporționale, în intervalul -100..100
+static void cmdControl(const uint8_t* args) {
+  int throttle = constrain((int8_t)args[0], -100, 100);
+  int steering = constrain((int8_t)args[1], -100, 100);
+
+  SpeedController_setTarget(throttle * SPEED_CRUISE_COUNTS_PER_S / 100);
+
+  int angle = (steering >= 0) ? CENTER + steering * (RIGHT - CENTER) / 100
+                              : CENTER + steering * (CENTER - LEFT) / 100;
+  ServoMotor_set(angle);
+}
+
+// ******************* TABEL COMENZI *************************************
+struct CommandEntry {
+  uint8_t code;                          // literă sau id binar
+  uint8_t argLen;                        // numărul de octeți de argumente
+  bool motion;                           // comandă de mișcare: anulează controlul continuu
+  void (*handler)(const uint8_t* args);
+};
+
+static constexpr CommandEntry commandTable[] = {
+  { 'F',         0, true,  cmdForward  },
+  { 'B',         0, true,  cmdBackward },
+  { 'S',         0, true,  cmdStop     },
+  { 'L',         0, true,  cmdLeft     },
+  { 'R',         0, true,  cmdRight    },
+  { 'M',         0, false, cmdReport   },
+  { 'C',         0, true,  cmdCalibrate },
+  { 'O',         0, false, cmdAebOverride },
+  { 'A',         0, false, cmdAebArm   },
+  { CMD_CONTROL, 2, true,  cmdControl  },
+  { CMD_STOP,    0, true,  cmdStop     },
+  { CMD_REPORT,  0, false, cmdReport   },
+  { CMD_CALIBRATE, 0, true, cmdCalibrate },
+  { CMD_AEB,     1, false, cmdAeb      },
+  { CMD_LOG_LIST, 0, false, cmdLogList },
+  { CMD_LOG_READ, 7, false, cmdLogRead },
+  { CMD_PING,    4, false, cmdPing     },
+  { CMD_BT_PROFILE, 1, false, cmdBtProfile },
+};
+
+static constexpr size_t COMMAND_COUNT = sizeof(commandTable) / sizeof(commandTable[0]);
+
+static constexpr const CommandEntry* findCommand(uint8_t code, size_t i = 0) {
+  return (i >= COMMAND_COUNT) ? nullptr
+       : (commandTable[i].code == code) ? &commandTable[i]
+       : findCommand(code, i + 1);
+}
+
+static_assert(findCommand(CMD_CONTROL) != nullptr && findCommand(CMD_CONTROL)->argLen == 2,
+              "CMD_CONTROL trebuie sa aiba doua argumente");
+
+// ******************* STARE PARSER **************************************
+static FrameDecoder<COMMAND_MAX_PAYLOAD> commandDecoder(FRAME_SYNC_COMMAND, COMMAND_HEADER_LEN);
+
+// Linia comenzilor literă: începutul ei și litera citită de la început, până la terminator
+static bool letterLineStart = true;
+static uint8_t letterPending = 0;
+static unsigned long lastRxMs = 0;       // ultimul apel care a consumat octeți
+
+// Ultimul cadru de control acceptat dar încă neaplicat (ultimul câștigă)
+static bool pendingControl = false;
+static uint8_t pendingArgs[2];
+
+static bool haveLatency = false;
+static int32_t minLatencyMs = 0;
+static unsigned long lastLatencyDecayMs = 0;
+static bool haveSenderMs = false;
+static uint32_t lastSenderMs = 0;
+static uint32_t senderConnection = 0;    // conexiunea Bluetooth căreia îi aparține ceasul învățat
+static bool controlActive = false;
+static unsigned long lastControlMs = 0;
+
+static void onBluetoothData(const uint8_t* data, size_t len) {
+  if (!rxArrivalPending) {
+    rxArrivalUs = micros();
+    rxArrivalPending = true;
+  }
+  rxRing.write(data, len);
+}
+
+// Apelată chiar înainte de execuția unei comenzi
+static void noteDispatch() {
+  lastDispatchUs = micros() - updateArrivalUs;
+  commandStats.executed++;
+  commandStats.totalDispatchUs += lastDispatchUs;
+  if (lastDispatchUs > commandStats.maxDispatchUs) commandStats.maxDispatchUs = lastDispatchUs;
+}
+
+static void dispatchLetter(uint8_t letter) {
+  const CommandEntry* cmd = findCommand(letter);
+  if (cmd == nullptr || cmd->argLen != 0) return;
+
+  LOG_INFO("Comandă primită: %c", (char)letter);
+  commandStats.legacyCommands++;
+  Recorder_logCommand(letter, nullptr, 0);
+  noteDispatch();
+  if (cmd->motion) {
+    pendingControl = false;
+    controlActive = false;
+  }
+  cmd->handler(nullptr);
+}
+
+// Alt expeditor (sau aplicația repornită) are alt ceas: ordinea și latența minimă se învață din nou
+static void resetSenderClock() {
+  haveSenderMs = false;
+  haveLatency = false;
+}
+
+// Vârsta cadrului = latența lui minus cea mai mică latență văzută (ceasurile nu sunt sincronizate)
+static bool isStale(uint32_t senderMs, unsigned long now) {
+  if (haveSenderMs) {
+    int32_t step = (int32_t)(senderMs - lastSenderMs);
+    if (step < -CONTROL_RESYNC_MS) {
+      LOG_INFO("Comenzi: timpul expeditorului a sărit înapoi %ld ms, ceas nou", (long)-step);
+      resetSenderClock();
+    } else if (step <= 0) {
+      return true;
+    }
+  }
+
+  int32_t latency = (int32_t)(now - senderMs);
+  if (!haveLatency || latency < minLatencyMs) {
+    minLatencyMs = latency;
+    haveLatency = true;
+  }
+  return latency - minLatencyMs > CONTROL_MAX_AGE_MS;
+}
+
+static void handleFrame(const uint8_t* commandFrame, uint8_t commandFrameLen, unsigned long now) {
+  const CommandEntry* cmd = findCommand(commandFrame[0]);
+  if (cmd == nullptr || commandFrameLen != COMMAND_HEADER_LEN + cmd->argLen) {
+    commandStats.crcErrors++;
+    return;
+  }
+  commandStats.framesOk++;
+
+  uint32_t senderMs = (uint32_t)commandFrame[3] | ((uint32_t)commandFrame[4] << 8) |
+                      ((uint32_t)commandFrame[5] << 16) | ((uint32_t)commandFrame[6] << 24);
+  const uint8_t* args = commandFrame + COMMAND_HEADER_LEN;
+
+  if (cmd->code != CMD_CONTROL) {
+    // Comenzile discrete se execută imediat; cele de mișcare anulează controlul în așteptare
+    if (cmd->motion) {
+      pendingControl = false;
+      controlActive = false;
+    }
+    Recorder_logCommand(cmd->code, args, cmd->argLen);
+    noteDispatch();
+    cmd->handler(args);
+    return;
+  }
+
+  if (isStale(senderMs, now)) {
+    commandStats.staleDropped++;
+    return;
+  }
+  if (pendingControl) commandStats.superseded++;
+  pendingControl = true;
+  memcpy(pendingArgs, args, sizeof(pendingArgs));
+  haveSenderMs = true;
+  lastSenderMs = senderMs;
+}
+
+static void parseByte(uint8_t b, unsigned long now) {
+  FrameResult r = commandDecoder.push(b);
+  if (r == FRAME_SKIPPED) {
+    if (b == '\r' || b == '\n') {
+      // Comandă literă: o singură literă între terminatori
+      if (letterPending != 0) dispatchLetter(letterPending);
+      letterLineStart = true;
+      letterPending = 0;
+    } else {
+      letterPending = (letterLineStart && b >= 'A' && b <= 'Z') ? b : 0;
+      letterLineStart = false;
+    }
+    return;
+  }
+
+  // Un octet de cadru întrerupe linia; după un cadru întreg poate urma direct o linie
+  letterLineStart = false;
+  letterPending = 0;
+  if (r == FRAME_READY) {
+    handleFrame(commandDecoder.payload(), commandDecoder.length(), now);
+    letterLineStart = true;
+  } else if (r == FRAME_BAD_LENGTH || r == FRAME_BAD_CRC) {
+    commandStats.crcErrors++;
+    letterLineStart = r == FRAME_BAD_CRC;
+  }
+}
+
+void CommandChannel_init(BluetoothManager& bt) {
+  commandBt = &bt;
+  bt.onData(onBluetoothData);
+}
+
+/**
+ * Consumă tot ce a sosit de la ultimul apel, fără să aștepte date noi,
+ * și aplică o singură dată cel mai recent cadru de control
+ */
+void CommandChannel_update() {
+  unsigned long now = millis();
+  uint8_t b;
+
+  // Octeții sosiți după acest punct primesc un moment nou, chiar dacă se consumă acum
+  updateArrivalUs = rxArrivalUs;
+  rxArrivalPending = false;
+  uint32_t connection = commandBt->connectionCount();
+  if (connection != senderConnection) {
+    senderConnection = connection;
+    resetSenderClock();
+    // Conexiunea nouă nu continuă cadrul sau linia celei vechi
+    commandDecoder.reset();
+    letterLineStart = true;
+    letterPending = 0;
+  }
+  bool received = false;
+  while (rxRing.read(b)) {
+    parseByte(b, now);
+    received = true;
+  }
+  if (received) {
+    lastRxMs = now;
+  } else if (commandDecoder.idle() && now - lastRxMs >= COMMAND_LETTER_IDLE_MS) {
+    // Liniște după o literă singură: comanda veche fără '\n' (aplicațiile care trimit doar "F")
+    if (letterPending != 0) dispatchLetter(letterPending);
+    letterLineStart = true;
+    letterPending = 0;
+  }
+
+  if (pendingControl) {
+    pendingControl = false;
+    controlActive = true;
+    lastControlMs = now;
+    Recorder_logCommand(CMD_CONTROL, pendingArgs, sizeof(pendingArgs));
+    noteDispatch();
+    cmdControl(pendingArgs);
+  } else if (controlActive && now - lastControlMs > CONTROL_TIMEOUT_MS) {
+    // Legătura s-a întrerupt în timpul controlului continuu: oprim motorul
+    controlActive = false;
+    commandStats.timeouts++;
+    Recorder_logCommand(RECORD_COMMAND_TIMEOUT, nullptr, 0);
+    SpeedController_setTarget(0);
+  }
+
+  // Permitem latenței minime să crească lent, pentru a urmări deriva ceasurilor
+  if (haveLatency && now - lastLatencyDecayMs >= 1000) {
+    lastLatencyDecayMs = now;
+    minLatencyMs++;
+  }
+}
+
+CommandChannelStats CommandChannel_getStats() {
+  commandStats.bytesDropped = rxRing.dropped();
+  return commandStats;
+}
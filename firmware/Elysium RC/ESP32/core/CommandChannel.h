@@ -0,0 +1,72 @@
+#ifndef COMMAND_CHANNEL_H
+#define COMMAND_CHANNEL_H
+
+#include <Arduino.h>
+#include "BluetoothManager.h"
+
+/**
+ * Canal de comenzi de la aplicație, citit dintr-un buffer circular fix
+ * completat direct din callback-ul de date Bluetooth (fără String, fără așteptare).
+ *
+ * Comenzi acceptate:
+ *  - literele vechi "F", "B", "S", "L", "R", plus "M" (raport taskuri), "C" (calibrarea busolei),
+ *    "O" (dezactivează frâna automată) și "A" (o reactivează), fiecare singură pe o linie
+ *    (încheiată cu '\r' sau '\n') sau urmată de COMMAND_LETTER_IDLE_MS fără alți octeți, ca
+ *    litera simplă trimisă de aplicațiile vechi; o pauză începe și ea o linie nouă. Un octet
+ *    izolat dintr-un cadru stricat nu începe o linie și nu devine comandă
+ *  - cadre binare de control continuu, cu încadramentul comun (FrameCodec.h, fluxul FRAME_SYNC_COMMAND):
+ *      0xA5 0x5C | len | id | seq (u16 LE) | timp expeditor ms (u32 LE) | argumente | crc16 (LE)
+ *    CMD_CONTROL (0x10): accelerație int8 (-100..100), direcție int8 (-100..100)
+ *    CMD_STOP    (0x11): fără argumente
+ *    CMD_REPORT  (0x12): fără argumente, cere raportul TaskMonitor (la fel ca litera "M")
+ *    CMD_CALIBRATE (0x13): fără argumente, pornește calibrarea busolei (la fel ca litera "C")
+ *    CMD_AEB     (0x14): uint8 1 = frâna automată activă, 0 = dezactivată (override)
+ *    CMD_LOG_LIST (0x15): fără argumente, cere lista fișierelor de jurnal (Recorder.h)
+ *    CMD_LOG_READ (0x16): index fișier (u16 LE), offset (u32 LE), număr de bucăți (u8, 0 = tot fișierul)
+ *    CMD_PING    (0x17): jeton (u32 LE); răspuns imediat "PONG jeton us", us = sosire -> execuție
+ *                        în vehicul, pentru latența dus-întors măsurată de aplicație
+ *    CMD_BT_PROFILE (0x18): uint8 0 = latență mică, 1 = consum redus (BluetoothManager.h)
+ *
+ * Dintre cadrele de control sosite între două apeluri se aplică doar ultimul,
+ * iar cadrele mai vechi decât CONTROL_MAX_AGE_MS (față de latența minimă observată)
+ * sau sosite în afara ordinii sunt ignorate. Ordinea și latența minimă se învață din nou la
+ * fiecare conexiune și la un salt înapoi al timpului expeditorului (aplicația a repornit).
+ * Comenzile executate (și opririle de siguranță) ajung în jurnalul înregistratorului. Pentru fiecare comandă executată se măsoară timpul
+ * de la sosirea octeților (callback-ul Bluetooth) până la execuție, în loop().
+ */
+
+#define COMMAND_RING_SIZE 256
+#define CMD_CONTROL 0x10
+#define CMD_STOP 0x11
+#define CMD_REPORT 0x12
+#define CMD_CALIBRATE 0x13
+#define CMD_AEB 0x14
+#define CMD_LOG_LIST 0x15
+#define CMD_LOG_READ 0x16
+#define CMD_PING 0x17
+#define CMD_BT_PROFILE 0x18
+#define CONTROL_MAX_AGE_MS 100     // cadre mai vechi de atât sunt aruncate
+#define CONTROL_TIMEOUT_MS 300     // fără cadre de control de atâta timp -> motor oprit
+#define CONTROL_RESYNC_MS 1000     // un salt înapoi mai mare al timpului expeditorului: alt ceas
+#define COMMAND_LETTER_IDLE_MS 30  // o literă urmată de atâta liniște este o comandă fără terminator
+
+struct CommandChannelStats {
+  uint32_t framesOk;        // cadre binare valide
+  uint32_t crcErrors;       // cadre cu CRC/lungime greșită
+  uint32_t staleDropped;    // cadre de control prea vechi sau în afara ordinii
+  uint32_t superseded;      // cadre de control înlocuite de unul mai nou înainte de aplicare
+  uint32_t legacyCommands;  // comenzi literă
+  uint32_t bytesDropped;    // octeți pierduți din cauza bufferului plin
+  uint32_t timeouts;        // opriri de siguranță
+  uint32_t executed;        // comenzi executate (cu latența măsurată)
+  uint32_t maxDispatchUs;   // sosire -> execuție
+  uint32_t totalDispatchUs;
+  uint32_t pings;
+};
+
+// Funcții
+void CommandChannel_init(BluetoothManager& bt);
+void CommandChannel_update();
+CommandChannelStats CommandChannel_getStats();
+
+#endif
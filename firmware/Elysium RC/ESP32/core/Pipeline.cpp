@@ -0,0 +1,197 @@
+#include "Pipeline.h"
+#include "TaskMonitor.h"
+#include "Recorder.h"
+#include "../../../shared/log/DeferredLog.h"
+
+// Achiziție -> fuziune: doar ultimul cadru contează (xQueueOverwrite)
+static QueueHandle_t acquisitionQueue = NULL;
+
+// Câte o cutie poștală de un element pentru fiecare consumator
+static QueueHandle_t pipelineMailbox[PIPELINE_MAX_SUBSCRIBERS];
+static PipelineLatency pipelineLatency[PIPELINE_MAX_SUBSCRIBERS];
+static int pipelineSubscribers = 0;
+static portMUX_TYPE pipelineMux = portMUX_INITIALIZER_UNLOCKED;
+
+// Ultimul cadru fuzionat, pentru cititorii care nu sunt conduși de evenimente (telemetrie)
+static SeqLock<PerceptionFrame> perceptionSnapshot;
+
+static uint32_t fusionMaxUs = 0;   // cea mai mare latență captură -> publicare în fuziune
+
+// Etapa 1: declanșează senzorii și doarme până la ecou sau până la următoarea declanșare
+static void acquisitionTask(void* parameter) {
+  uint32_t lastSequence = 0;
+  int monitorId = TaskMonitor_register("Acquisition", 0, 1000);
+
+  while (true) {
+    TaskMonitor_begin(monitorId);
+    unsigned long waitUs = readSensorsSequentially();
+
+    UltrasonicFrame frame = UltrasonicSensors_getFrame();
+    if (frame.sequence != lastSequence) {
+      lastSequence = frame.sequence;
+      xQueueOverwrite(acquisitionQueue, &frame);
+    }
+    TaskMonitor_end(monitorId);
+
+    TickType_t waitTicks = pdMS_TO_TICKS((waitUs + 999) / 1000);
+    ulTaskNotifyTake(pdTRUE, waitTicks > 0 ? waitTicks : 1);
+  }
+
+  vTaskDelete(NULL);
+}
+
+// Filtrele canalelor și momentul ultimei măsurători trecute prin fiecare; doar taskul de fuziune le folosește
+static RangeFilter rangeFilters[ULTRASONIC_SENSOR_COUNT];
+static unsigned long filteredUs[ULTRASONIC_SENSOR_COUNT] = {0};
+static SeqLock<RangeFilterStats> filterStatsSnapshot[ULTRASONIC_SENSOR_COUNT];
+
+static void fuseFrame(const UltrasonicFrame& in, PerceptionFrame& out) {
+  out.ultrasonic = in;
+  out.sequence = in.sequence;
+  out.nearestSensor = -1;
+  out.nearestDistance = 0;
+  out.acquiredUs = 0;
+
+  bool first = true;
+  forEachUltrasonic([&](auto ch) {
+    constexpr int i = decltype(ch)::value;
+    // Cea mai nouă captură dă momentul de referință pentru latență
+    if (first || (long)(in.timestampUs[i] - out.acquiredUs) > 0) {
+      out.acquiredUs = in.timestampUs[i];
+      first = false;
+    }
+
+    // Cadrul conține ultimele valori ale tuturor canalelor: filtrăm doar măsurătorile noi
+    if (in.timestampUs[i] != filteredUs[i]) {
+      filteredUs[i] = in.timestampUs[i];
+      Recorder_logRange(i, in.isValid(i) ? in.distance[i] : -1, in.timestampUs[i]);
+      if (in.isValid(i)) {
+        rangeFilters[i].measure((float)in.distance[i], in.timestampUs[i]);
+      } else {
+        rangeFilters[i].miss();
+      }
+      filterStatsSnapshot[i].write(rangeFilters[i].stats());
+    }
+  });
+
+  forEachUltrasonic([&](auto ch) {
+    constexpr int i = decltype(ch)::value;
+    rangeFilters[i].age(out.acquiredUs);
+    out.range[i] = rangeFilters[i].estimate();
+    if (out.range[i].valid() && (out.nearestSensor < 0 || out.range[i].distanceCm < out.nearestDistance)) {
+      out.nearestSensor = i;
+      out.nearestDistance = out.range[i].distanceCm;
+    }
+  });
+}
+
+// Etapa 2: fuziune, apoi livrare către toți consumatorii
+static void fusionTask(void* parameter) {
+  UltrasonicFrame raw;
+  PerceptionFrame frame;
+  int monitorId = TaskMonitor_register("Fusion", 0, 1000);
+
+  while (true) {
+    if (xQueueReceive(acquisitionQueue, &raw, portMAX_DELAY) != pdTRUE) continue;
+    TaskMonitor_begin(monitorId);
+
+    fuseFrame(raw, frame);
+    frame.fusedUs = micros();
+
+    uint32_t latency = frame.fusedUs - frame.acquiredUs;
+    if (latency > fusionMaxUs) fusionMaxUs = latency;
+
+    perceptionSnapshot.write(frame);
+    for (int i = 0; i < pipelineSubscribers; i++) {
+      xQueueOverwrite(pipelineMailbox[i], &frame);
+    }
+    TaskMonitor_end(monitorId);
+  }
+
+  vTaskDelete(NULL);
+}
+
+void Pipeline_init() {
+  Serial.println("\nCreare pipeline senzori...");
+  acquisitionQueue = xQueueCreate(1, sizeof(UltrasonicFrame));
+
+  TaskHandle_t acquisitionHandle = NULL;
+  xTaskCreatePinnedToCore(acquisitionTask, "Acquisition", 2048, NULL,
+                          PIPELINE_ACQUISITION_PRIORITY, &acquisitionHandle, PIPELINE_CORE);
+  UltrasonicSensors_setNotifyTask(acquisitionHandle);
+
+  xTaskCreatePinnedToCore(fusionTask, "Fusion", 2048, NULL,
+                          PIPELINE_FUSION_PRIORITY, NULL, PIPELINE_CORE);
+}
+
+/**
+ * Înregistrează un consumator; trebuie apelată înainte de a porni taskul acestuia.
+ * Întoarce indexul folosit de Pipeline_wait() sau -1 dacă nu mai există locuri.
+ */
+int Pipeline_subscribe(const char* name) {
+  if (pipelineSubscribers >= PIPELINE_MAX_SUBSCRIBERS) return -1;
+
+  int index = pipelineSubscribers;
+  pipelineMailbox[index] = xQueueCreate(1, sizeof(PerceptionFrame));
+  pipelineLatency[index] = { name, 0, 0, 0 };
+  pipelineSubscribers = index + 1;
+  return index;
+}
+
+// Blochează consumatorul până la următorul cadru fuzionat
+bool Pipeline_wait(int subscriber, PerceptionFrame& frame, TickType_t timeout) {
+  if (subscriber < 0 || subscriber >= pipelineSubscribers) return false;
+  return xQueueReceive(pipelineMailbox[subscriber], &frame, timeout) == pdTRUE;
+}
+
+// Apelată de consumator după ce a reacționat la cadru (ex. a trimis modelul către buzzer)
+void Pipeline_markReaction(int subscriber, const PerceptionFrame& frame) {
+  if (subscriber < 0 || subscriber >= pipelineSubscribers) return;
+
+  uint32_t latency = micros() - frame.acquiredUs;
+  portENTER_CRITICAL(&pipelineMux);
+  PipelineLatency& stats = pipelineLatency[subscriber];
+  stats.frames++;
+  stats.lastUs = latency;
+  if (latency > stats.maxUs) stats.maxUs = latency;
+  portEXIT_CRITICAL(&pipelineMux);
+}
+
+PerceptionFrame Pipeline_getLatest() {
+  return perceptionSnapshot.read();
+}
+
+PipelineLatency Pipeline_getLatency(int subscriber) {
+  PipelineLatency copy = { "", 0, 0, 0 };
+  if (subscriber < 0 || subscriber >= pipelineSubscribers) return copy;
+
+  portENTER_CRITICAL(&pipelineMux);
+  copy = pipelineLatency[subscriber];
+  portEXIT_CRITICAL(&pipelineMux);
+  return copy;
+}
+
+int Pipeline_getSubscriberCount() {
+  return pipelineSubscribers;
+}
+
+RangeFilterStats Pipeline_getFilterStats(int sensor) {
+  RangeFilterStats stats = { 0, 0, 0, 0 };
+  if (sensor < 0 || sensor >= ULTRASONIC_SENSOR_COUNT) return stats;
+  return filterStatsSnapshot[sensor].read();
+}
+
+void Pipeline_printStats() {
+  LOG_INFO("Pipeline: fuziune max %lu us", (unsigned long)fusionMaxUs);
+  for (int i = 0; i < ULTRASONIC_SENSOR_COUNT; i++) {
+    RangeFilterStats stats = Pipeline_getFilterStats(i);
+    LOG_INFO("  Filtru %d: %lu acceptate, %lu respinse, %lu fără ecou, %lu reachiziții", i,
+             (unsigned long)stats.accepted, (unsigned long)stats.outliers,
+             (unsigned long)stats.misses, (unsigned long)stats.reacquired);
+  }
+  for (int i = 0; i < pipelineSubscribers; i++) {
+    PipelineLatency stats = Pipeline_getLatency(i);
+    LOG_INFO("  %s: %lu cadre, latență %lu us (max %lu us)", stats.name,
+                  (unsigned long)stats.frames, (unsigned long)stats.lastUs, (unsigned long)stats.maxUs);
+  }
+}
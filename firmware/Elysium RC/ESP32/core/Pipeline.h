@@ -0,0 +1,61 @@
+#ifndef PIPELINE_H
+#define PIPELINE_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "SeqLock.h"
+#include "../sensors/UltrasonicSensors.h"
+#include "../sensors/RangeFilter.h"
+
+/**
+ * Lanțul de procesare a senzorilor, condus de evenimente:
+ *
+ *   ecou (întrerupere) -> achiziție -> filtrare/fuziune -> consumatori (buzzer, diagnostic, ...)
+ *
+ * Fuziunea trece fiecare măsurătoare nouă prin filtrul canalului ei (RangeFilter.h):
+ * consumatorii primesc distanța filtrată, viteza relativă și validitatea explicită.
+ *
+ * Fiecare etapă doarme până primește date noi (notificare de task sau coadă tipizată),
+ * nu până expiră un delay. Taskurile rulează pe PIPELINE_CORE, nucleul pe care nu rulează
+ * stivele Bluetooth/Wi-Fi, iar fiecare cadru poartă momentul capturii, astfel încât
+ * latența senzor -> reacție se poate măsura pentru fiecare consumator.
+ */
+
+#define PIPELINE_CORE 1                 // APP_CPU; Bluetooth și Wi-Fi rulează pe PRO_CPU (0)
+#define PIPELINE_MAX_SUBSCRIBERS 6
+
+#define PIPELINE_ACQUISITION_PRIORITY 5
+#define PIPELINE_FUSION_PRIORITY 4
+
+// Rezultatul etapei de fuziune, livrat fiecărui consumator
+struct PerceptionFrame {
+  UltrasonicFrame ultrasonic;                   // măsurătorile brute
+  RangeEstimate range[ULTRASONIC_SENSOR_COUNT]; // filtrate: distanță, viteză relativă, încredere
+  int nearestSensor;                            // UltrasonicSensorId sau -1 dacă niciun canal nu este valid
+  float nearestDistance;                        // cm, doar dacă nearestSensor >= 0
+  unsigned long acquiredUs;                // captura celei mai noi măsurători
+  unsigned long fusedUs;                   // momentul publicării de către fuziune
+  uint32_t sequence;
+};
+
+struct PipelineLatency {
+  const char* name;
+  uint32_t frames;          // cadre primite de consumator
+  uint32_t lastUs;          // ultima latență captură -> reacție
+  uint32_t maxUs;
+};
+
+// Funcții
+void Pipeline_init();
+int Pipeline_subscribe(const char* name);
+bool Pipeline_wait(int subscriber, PerceptionFrame& frame, TickType_t timeout = portMAX_DELAY);
+void Pipeline_markReaction(int subscriber, const PerceptionFrame& frame);
+PerceptionFrame Pipeline_getLatest();
+PipelineLatency Pipeline_getLatency(int subscriber);
+int Pipeline_getSubscriberCount();
+RangeFilterStats Pipeline_getFilterStats(int sensor);
+void Pipeline_printStats();
+
+#endif
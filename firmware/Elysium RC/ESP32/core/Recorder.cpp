@@ -0,0 +1,366 @@
+#include "Recorder.h"
+#include "TaskMonitor.h"
+#include <LittleFS.h>
+#include "../navigation/Navigation.h"
+#include "../motion-control/DCMotor.h"
+#include "../motion-control/SpeedController.h"
+#include "../motion-control/EmergencyBrake.h"
+#include "../../../shared/log/DeferredLog.h"
+#include "../../../shared/heap/HeapGuard.h"
+
+// Două blocuri: producătorii completează unul, taskul de scriere îl golește pe celălalt
+static uint8_t recorderBlocks[2][RECORDER_BLOCK_SIZE];
+static RecorderBlockEncoder recorderEncoder;
+static int recorderActive = 0;            // blocul completat acum
+static int recorderSealed = -1;           // blocul care așteaptă scrierea, -1 niciunul
+static size_t recorderSealedLen = 0;
+static uint32_t recorderSequence = 0;
+static unsigned long recorderBlockStartMs = 0;
+static bool recorderWakeWriter = false;
+static bool recorderFlushRequested = false;
+
+static portMUX_TYPE recorderMux = portMUX_INITIALIZER_UNLOCKED;
+static TaskHandle_t recorderTask = NULL;
+static volatile bool recorderReady = false;
+static RecorderStats recorderStats = {};
+
+// Ultima stare de mers înregistrată: RECORD_DRIVE pleacă doar la schimbare
+static bool haveDrive = false;
+static int8_t lastDriveDirection = 0;
+static int32_t lastDriveSetpoint = 0;
+static uint8_t lastDriveFlags = 0;
+
+// Folosite doar de taskul de scriere
+static File recorderFile;
+static uint32_t recorderNextIndex = 0;
+
+// Cererile Bluetooth, preluate de Recorder_update() din loop()
+static bool listRequested = false;
+static bool chunksActive = false;
+static uint16_t chunkFile = 0;
+static uint32_t chunkOffset = 0;
+static uint16_t chunkRemaining = 0;     // 0 = până la sfârșitul fișierului
+
+// ******************* FIȘIERE *******************************************
+static void recorderPath(uint32_t index, char* out, size_t size) {
+  snprintf(out, size, RECORDER_DIR "/%05lu.erl", (unsigned long)index);
+}
+
+// Indexul din numele unui fișier de jurnal sau -1 (name() poate fi și calea completă)
+static long recorderFileIndex(const char* name) {
+  const char* base = strrchr(name, '/');
+  base = base ? base + 1 : name;
+  char* end = NULL;
+  unsigned long index = strtoul(base, &end, 10);
+  return (end != base && strcmp(end, ".erl") == 0) ? (long)index : -1;
+}
+
+// Cel mai vechi și cel mai nou fișier; întoarce numărul lor
+static int scanFiles(long& oldest, long& newest) {
+  oldest = newest = -1;
+  int count = 0;
+  HeapGuardAllow allow;   // LittleFS alocă descriptorii fișierelor deschise
+  File dir = LittleFS.open(RECORDER_DIR);
+  if (!dir || !dir.isDirectory()) return 0;
+  File f;
+  while ((f = dir.openNextFile())) {
+    long index = f.isDirectory() ? -1 : recorderFileIndex(f.name());
+    f.close();
+    if (index < 0) continue;
+    count++;
+    if (oldest < 0 || index < oldest) oldest = index;
+    if (index > newest) newest = index;
+  }
+  return count;
+}
+
+// Face loc pentru un fișier nou: cel mult RECORDER_MAX_FILES - 1 rămân, plus spațiul minim liber
+static void pruneFiles() {
+  long oldest, newest;
+  int count;
+  while ((count = scanFiles(oldest, newest)) > 0) {
+    size_t freeBytes = LittleFS.totalBytes() - LittleFS.usedBytes();
+    if (count < RECORDER_MAX_FILES && freeBytes >= RECORDER_MIN_FREE_BYTES) break;
+    char path[24];
+    recorderPath((uint32_t)oldest, path, sizeof(path));
+    LittleFS.remove(path);
+    LOG_INFO("Înregistrare: %s șters (%d fișiere, %lu octeți liberi)", path, count, (unsigned long)freeBytes);
+  }
+}
+
+static bool openNextFile() {
+  pruneFiles();
+  char path[24];
+  recorderPath(recorderNextIndex, path, sizeof(path));
+  recorderFile = LittleFS.open(path, FILE_WRITE);
+  if (!recorderFile) return false;
+
+  // Calibrarea busolei de acum, ca reluarea să poată calcula orientarea din valorile brute
+  NavigationStatus nav = Navigation_getStatus();
+  RecorderFileHeader header;
+  header.blockSize = RECORDER_BLOCK_SIZE;
+  header.flags = nav.calibrated ? RECORDER_FLAG_CALIBRATED : 0;
+  header.fileIndex = recorderNextIndex;
+  header.startMs = millis();
+  header.compassOffsetX = nav.calibration.offsetX;
+  header.compassOffsetY = nav.calibration.offsetY;
+  header.compassScaleX = nav.calibration.scaleX;
+  header.compassScaleY = nav.calibration.scaleY;
+  header.compassSign = NAV_COMPASS_SIGN;
+  header.compassMountRad = NAV_COMPASS_MOUNT_RAD;
+  uint8_t bytes[RECORDER_FILE_HEADER];
+  recorderEncodeFileHeader(header, bytes);
+  size_t written = recorderFile.write(bytes, sizeof(bytes));
+
+  portENTER_CRITICAL(&recorderMux);
+  recorderStats.files++;
+  recorderStats.bytes += written;
+  recorderStats.currentFile = recorderNextIndex;
+  portEXIT_CRITICAL(&recorderMux);
+
+  LOG_INFO("Înregistrare: fișierul %s", path);
+  recorderNextIndex++;
+  return true;
+}
+
+static void writeBlock(const uint8_t* block, size_t len) {
+  if (!recorderFile && !openNextFile()) {
+    portENTER_CRITICAL(&recorderMux);
+    recorderStats.writeErrors++;
+    portEXIT_CRITICAL(&recorderMux);
+    return;
+  }
+
+  unsigned long startUs = micros();
+  size_t written = recorderFile.write(block, len);
+  recorderFile.flush();
+  uint32_t elapsed = micros() - startUs;
+
+  portENTER_CRITICAL(&recorderMux);
+  recorderStats.blocks++;
+  recorderStats.bytes += written;
+  if (written != len) recorderStats.writeErrors++;
+  if (elapsed > recorderStats.maxWriteUs) recorderStats.maxWriteUs = elapsed;
+  portEXIT_CRITICAL(&recorderMux);
+
+  // Rotire după dimensiune; după o eroare încercăm un fișier nou
+  if (written != len || recorderFile.size() >= RECORDER_FILE_BYTES) recorderFile.close();
+}
+
+// ******************* BLOCURI *******************************************
+// Cu recorderMux luat: predă blocul activ scrierii și continuă în celălalt
+static bool rotateBlock() {
+  if (recorderSealed >= 0) return false;
+  recorderSealedLen = recorderEncoder.seal();
+  recorderSealed = recorderActive;
+  recorderActive ^= 1;
+  recorderEncoder.begin(recorderBlocks[recorderActive], ++recorderSequence);
+  recorderBlockStartMs = millis();
+  recorderWakeWriter = true;
+  return true;
+}
+
+static bool appendBegin() {
+  if (!recorderReady) return false;
+  portENTER_CRITICAL(&recorderMux);
+  if (recorderEncoder.empty()) recorderBlockStartMs = millis();
+  return true;
+}
+
+static void appendEnd(bool ok) {
+  if (ok) recorderStats.records++;
+  else recorderStats.dropped++;
+  bool wake = recorderWakeWriter;
+  recorderWakeWriter = false;
+  portEXIT_CRITICAL(&recorderMux);
+  if (wake) xTaskNotifyGive(recorderTask);
+}
+
+static void recorderWriterTask(void* parameter) {
+  // Fără termen: scrierile în flash pot dura oricât, doar timpul și stiva intră în raport
+  int monitorId = TaskMonitor_register("Recorder", 0, 0);
+
+  while (true) {
+    ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(RECORDER_FLUSH_MS));
+    TaskMonitor_begin(monitorId);
+
+    // Un bloc început de prea mult timp (sau cerut prin Bluetooth) pleacă incomplet
+    portENTER_CRITICAL(&recorderMux);
+    if (!recorderEncoder.empty() &&
+        (recorderFlushRequested || millis() - recorderBlockStartMs >= RECORDER_FLUSH_MS)) {
+      rotateBlock();
+    }
+    recorderFlushRequested = false;
+    recorderWakeWriter = false;
+    int sealed = recorderSealed;
+    size_t len = recorderSealedLen;
+    portEXIT_CRITICAL(&recorderMux);
+
+    if (sealed >= 0) {
+      {
+        HeapGuardAllow allow;   // LittleFS alocă la deschiderea și rotirea fișierelor
+        writeBlock(recorderBlocks[sealed], len);
+      }
+
+      portENTER_CRITICAL(&recorderMux);
+      recorderSealed = -1;
+      portEXIT_CRITICAL(&recorderMux);
+    }
+    TaskMonitor_end(monitorId);
+  }
+
+  vTaskDelete(NULL);
+}
+
+// Trebuie apelată înaintea producătorilor (CommandChannel_init, Pipeline, ArduinoLink_init)
+void Recorder_init() {
+  Serial.println("\nPornire înregistrator de senzori...");
+  if (!LittleFS.begin(true)) {
+    Serial.println("Înregistrare: LittleFS nu poate fi montat, jurnalul este dezactivat");
+    return;
+  }
+  if (!LittleFS.exists(RECORDER_DIR)) LittleFS.mkdir(RECORDER_DIR);
+
+  // Numerotarea continuă după ultimul fișier de la pornirile anterioare
+  long oldest, newest;
+  int count = scanFiles(oldest, newest);
+  recorderNextIndex = newest >= 0 ? (uint32_t)newest + 1 : 0;
+  Serial.printf("Înregistrare: %d fișiere, %lu din %lu octeți ocupați\n", count,
+                (unsigned long)LittleFS.usedBytes(), (unsigned long)LittleFS.totalBytes());
+
+  recorderEncoder.begin(recorderBlocks[recorderActive], recorderSequence);
+  recorderStats.mounted = true;
+  xTaskCreatePinnedToCore(recorderWriterTask, "Recorder", 4096, NULL,
+                          RECORDER_PRIORITY, &recorderTask, RECORDER_CORE);
+  recorderReady = true;
+}
+
+// ******************* PRODUCĂTORI ***************************************
+void Recorder_logRange(int channel, long cm, unsigned long timeUs) {
+  if (!appendBegin()) return;
+  bool ok = recorderEncoder.addRange(timeUs, (uint8_t)channel, cm);
+  if (!ok && rotateBlock()) ok = recorderEncoder.addRange(timeUs, (uint8_t)channel, cm);
+  appendEnd(ok);
+}
+
+void Recorder_logArduino(const ArduinoSample& s) {
+  // Starea de mers de lângă eșantion: reluarea are nevoie de viteza cerută și de sensul comandat
+  int8_t direction = isMovingForward ? 1 : (isMovingBackward ? -1 : 0);
+  int32_t setpoint = (int32_t)lroundf(SpeedController_getStats().setpoint);
+  EmergencyBrakeStatus aeb = EmergencyBrake_getStatus();
+  uint8_t flags = (aeb.engaged ? RECORD_DRIVE_AEB_ENGAGED : 0) |
+                  (aeb.overridden ? RECORD_DRIVE_AEB_OVERRIDDEN : 0);
+  uint32_t timeUs = (uint32_t)s.receivedUs;
+
+  if (!appendBegin()) return;
+  if (!haveDrive || direction != lastDriveDirection || setpoint != lastDriveSetpoint || flags != lastDriveFlags) {
+    bool ok = recorderEncoder.addDrive(timeUs, direction, setpoint, flags);
+    if (!ok && rotateBlock()) ok = recorderEncoder.addDrive(timeUs, direction, setpoint, flags);
+    if (ok) {
+      haveDrive = true;
+      lastDriveDirection = direction;
+      lastDriveSetpoint = setpoint;
+      lastDriveFlags = flags;
+      recorderStats.records++;
+    }
+  }
+  bool ok = recorderEncoder.addArduino(timeUs, s.encoder, s.arduinoTimeUs, s.compass, s.voltageCentivolts);
+  if (!ok && rotateBlock()) ok = recorderEncoder.addArduino(timeUs, s.encoder, s.arduinoTimeUs, s.compass,
+                                                            s.voltageCentivolts);
+  appendEnd(ok);
+}
+
+void Recorder_logRfid(const RfidTagEvent& e) {
+  uint32_t timeUs = micros();
+  if (!appendBegin()) return;
+  bool ok = recorderEncoder.addRfid(timeUs, e.type, e.rssi, e.epc.bytes, e.epc.len);
+  if (!ok && rotateBlock()) ok = recorderEncoder.addRfid(timeUs, e.type, e.rssi, e.epc.bytes, e.epc.len);
+  appendEnd(ok);
+}
+
+void Recorder_logCommand(uint8_t code, const uint8_t* args, uint8_t len) {
+  uint32_t timeUs = micros();
+  if (!appendBegin()) return;
+  bool ok = recorderEncoder.addCommand(timeUs, code, args, len);
+  if (!ok && rotateBlock()) ok = recorderEncoder.addCommand(timeUs, code, args, len);
+  appendEnd(ok);
+}
+
+// ******************* BLUETOOTH *****************************************
+void Recorder_requestList() {
+  listRequested = true;
+}
+
+// count bucăți de la offset; 0 = până la sfârșitul fișierului
+void Recorder_requestChunks(uint16_t fileIndex, uint32_t offset, uint8_t count) {
+  chunksActive = true;
+  chunkFile = fileIndex;
+  chunkOffset = offset;
+  chunkRemaining = count;
+  // Blocul din RAM ajunge în fișier, ca aplicația să vadă și ultimele secunde
+  if (recorderReady) {
+    portENTER_CRITICAL(&recorderMux);
+    recorderFlushRequested = true;
+    portEXIT_CRITICAL(&recorderMux);
+    xTaskNotifyGive(recorderTask);
+  }
+}
+
+static void sendList(BluetoothManager& bt) {
+  char line[48];
+  int count = 0;
+  File dir = LittleFS.open(RECORDER_DIR);
+  if (dir && dir.isDirectory()) {
+    File f;
+    while ((f = dir.openNextFile())) {
+      long index = f.isDirectory() ? -1 : recorderFileIndex(f.name());
+      if (index >= 0) {
+        snprintf(line, sizeof(line), "LOG %ld %lu", index, (unsigned long)f.size());
+        bt.sendData(line);
+        count++;
+      }
+      f.close();
+    }
+  }
+  size_t freeBytes = recorderStats.mounted ? LittleFS.totalBytes() - LittleFS.usedBytes() : 0;
+  snprintf(line, sizeof(line), "LOG END %d %lu", count, (unsigned long)freeBytes);
+  bt.sendData(line);
+}
+
+// Câteva bucăți la fiecare apel, ca loop() să nu stea după portul Bluetooth
+static void sendChunks(BluetoothManager& bt) {
+  char path[24];
+  recorderPath(chunkFile, path, sizeof(path));
+  HeapGuardAllow allow;
+  File f = recorderStats.mounted ? LittleFS.open(path, FILE_READ) : File();
+  uint8_t data[RECORDER_CHUNK_DATA];
+  uint8_t frame[RECORDER_CHUNK_MAX_FRAME];
+
+  for (int i = 0; i < RECORDER_CHUNKS_PER_UPDATE; i++) {
+    size_t n = 0;
+    if (f && f.seek(chunkOffset)) n = f.read(data, sizeof(data));
+    bt.sendBytes(frame, recorderEncodeChunk(chunkFile, chunkOffset, data, n, frame));
+    chunkOffset += n;
+    // Bucata goală a marcat sfârșitul fișierului (sau un fișier inexistent)
+    if (n == 0 || (chunkRemaining > 0 && --chunkRemaining == 0)) {
+      chunksActive = false;
+      break;
+    }
+  }
+  if (f) f.close();
+}
+
+void Recorder_update(BluetoothManager& bt) {
+  if (listRequested) {
+    listRequested = false;
+    sendList(bt);
+  }
+  if (chunksActive) sendChunks(bt);
+}
+
+RecorderStats Recorder_getStats() {
+  portENTER_CRITICAL(&recorderMux);
+  RecorderStats copy = recorderStats;
+  portEXIT_CRITICAL(&recorderMux);
+  return copy;
+}
@@ -0,0 +1,63 @@
+#ifndef RECORDER_H
+#define RECORDER_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "BluetoothManager.h"
+#include "RecorderFormat.h"
+#include "../sensors/ArduinoLink.h"
+#include "../sensors/RFIDManager.h"
+
+/**
+ * Înregistratorul de senzori: distanțele ultrasonice, eșantioanele Arduino (encoder, busolă,
+ * tensiune), starea de mers, tag-urile RFID și comenzile aplicației, cu momentul lor, într-un
+ * jurnal binar append-only pe LittleFS (formatul din RecorderFormat.h).
+ *
+ * Producătorii (fuziunea, legătura Arduino, loop()) doar codează înregistrarea în blocul
+ * activ din RAM, într-o secțiune critică de câteva microsecunde. Când blocul se umple, se
+ * schimbă cu al doilea, iar taskul de scriere, cu prioritatea minimă, pe nucleul fără
+ * pipeline, îl scrie în flash: latența LittleFS nu ajunge la bucla de control. Dacă și al
+ * doilea bloc așteaptă încă scrierea, înregistrarea se pierde și este numărată.
+ *
+ * Un bloc început de RECORDER_FLUSH_MS se scrie incomplet, deci la o pană de curent se pierd
+ * cel mult atâtea milisecunde. Fișierele se rotesc după RECORDER_FILE_BYTES; cele mai vechi
+ * se șterg peste RECORDER_MAX_FILES sau când spațiul liber scade sub RECORDER_MIN_FREE_BYTES.
+ *
+ * Prin Bluetooth: CMD_LOG_LIST trimite lista fișierelor (linii "LOG index dimensiune", apoi
+ * "LOG END număr liber"), CMD_LOG_READ trimite un fișier în bucăți binare de la un offset.
+ */
+
+#define RECORDER_DIR "/rec"
+#define RECORDER_FILE_BYTES (256 * 1024UL)
+#define RECORDER_MAX_FILES 8
+#define RECORDER_MIN_FREE_BYTES (64 * 1024UL)
+#define RECORDER_FLUSH_MS 2000
+#define RECORDER_PRIORITY 0                // sub toate celelalte taskuri, inclusiv loop()
+#define RECORDER_CORE 0                    // nucleul Bluetooth; pipeline-ul rulează pe PIPELINE_CORE
+#define RECORDER_CHUNKS_PER_UPDATE 4       // bucăți trimise la un apel Recorder_update()
+
+struct RecorderStats {
+  bool mounted;             // LittleFS montat, jurnalul este activ
+  uint32_t records;         // înregistrări puse în blocuri
+  uint32_t dropped;         // pierdute: ambele blocuri așteptau scrierea
+  uint32_t blocks;          // blocuri scrise
+  uint32_t bytes;           // octeți scriși, cu antetele
+  uint32_t files;           // fișiere deschise de la pornire
+  uint32_t writeErrors;
+  uint32_t maxWriteUs;      // cea mai lungă scriere a unui bloc, în taskul de scriere
+  uint32_t currentFile;     // indexul fișierului deschis
+};
+
+// Funcții
+void Recorder_init();
+void Recorder_logRange(int channel, long cm, unsigned long timeUs);
+void Recorder_logArduino(const ArduinoSample& sample);
+void Recorder_logRfid(const RfidTagEvent& event);
+void Recorder_logCommand(uint8_t code, const uint8_t* args, uint8_t len);
+void Recorder_requestList();
+void Recorder_requestChunks(uint16_t fileIndex, uint32_t offset, uint8_t count);
+void Recorder_update(BluetoothManager& bt);
+RecorderStats Recorder_getStats();
+
+#endif
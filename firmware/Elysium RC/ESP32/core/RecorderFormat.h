@@ -0,0 +1,456 @@
+#ifndef RECORDER_FORMAT_H
+#define RECORDER_FORMAT_H
+
+/**
+ * Formatul jurnalului binar al înregistratorului de senzori (fără dependențe Arduino,
+ * citit pe calculator de tools/recorder).
+ *
+ * Fișier (append-only, rotit după dimensiune):
+ *   antet de RECORDER_FILE_HEADER octeți | bloc | bloc | ...
+ * Antet:
+ *   "ERL1" | dimensiunea blocului (u16) | indicatori (u16) | index fișier (u32) | millis la deschidere (u32) |
+ *   calibrarea busolei: offsetX, offsetY, scaleX, scaleY, semn, unghi de montare (float LE)
+ * Bloc:
+ *   0xE5 0x1B | lungime înregistrări (u16) | secvență bloc (u32) | timp de bază us (u32) |
+ *   înregistrări[lungime] | crc16 (LE, peste tot ce urmează după sincronizare)
+ * Înregistrare:
+ *   tip (u8) | diferența de timp față de înregistrarea anterioară din bloc (varint zigzag, us) | date
+ *
+ * Fiecare bloc se decodează singur (timpul și diferențele encoderului pornesc de la zero în
+ * fiecare bloc), deci un bloc scris pe jumătate la o pană de curent se pierde doar pe el.
+ * Varint-urile și zigzag-ul sunt cele ale telemetriei (TelemetryCodec.h), CRC16 cel din FrameCodec.h.
+ *
+ * Blocurile pot fi citite și prin Bluetooth, în bucăți (fluxul FRAME_SYNC_RECORDER_CHUNK):
+ *   0xA5 0x5B | len | index fișier (u16) | offset (u32) | octeți | crc16 (LE, peste len + payload)
+ * O bucată fără octeți marchează sfârșitul fișierului.
+ */
+
+#include "TelemetryCodec.h"
+
+#define RECORDER_MAGIC "ERL1"
+#define RECORDER_FILE_HEADER 40
+#define RECORDER_FLAG_CALIBRATED 0x0001      // calibrarea busolei din antet este validă
+#define RECORDER_BLOCK_SIZE 1024              // cu antet și CRC
+#define RECORDER_BLOCK_HEADER 12
+#define RECORDER_BLOCK_SYNC_1 0xE5
+#define RECORDER_BLOCK_SYNC_2 0x1B
+#define RECORDER_MAX_RECORD 48                // cea mai lungă înregistrare (comandă cu argumente)
+#define RECORDER_DATA_MAX 32
+
+#define RECORDER_CHUNK_DATA 192
+#define RECORDER_CHUNK_HEADER 6               // index + offset
+#define RECORDER_CHUNK_MAX_FRAME (RECORDER_CHUNK_HEADER + RECORDER_CHUNK_DATA + FRAME_OVERHEAD)
+
+enum RecorderRecordType {
+  RECORD_RANGE = 1,        // canal (u8) | cm (varint zigzag, -1 = fără ecou)
+  RECORD_ARDUINO = 2,      // encoder (dif.) | timp Arduino us (dif.) | busolă x, y, z | tensiune cV
+  RECORD_DRIVE = 3,        // sens (i8) | viteza cerută după rampă, impulsuri/s (varint zigzag) | indicatori
+  RECORD_RFID = 4,         // sosire/plecare (u8) | RSSI (i8) | lungime EPC (u8) | EPC
+  RECORD_COMMAND = 5       // cod (literă sau id binar) | număr argumente (u8) | argumente
+};
+
+// Indicatorii înregistrării RECORD_DRIVE
+#define RECORD_DRIVE_AEB_ENGAGED 0x01
+#define RECORD_DRIVE_AEB_OVERRIDDEN 0x02
+
+// Codul comenzii pentru oprirea de siguranță a controlului continuu (nu vine de la aplicație)
+#define RECORD_COMMAND_TIMEOUT 0x00
+
+struct RecorderFileHeader {
+  uint16_t blockSize;
+  uint16_t flags;
+  uint32_t fileIndex;
+  uint32_t startMs;
+  float compassOffsetX;
+  float compassOffsetY;
+  float compassScaleX;
+  float compassScaleY;
+  float compassSign;
+  float compassMountRad;
+};
+
+// O înregistrare decodată; doar câmpurile tipului ei au sens
+struct RecorderEvent {
+  uint8_t type;
+  uint32_t timeUs;             // ceasul ESP32 (micros)
+  uint32_t blockSequence;
+  uint8_t channel;             // RANGE
+  int32_t value;               // RANGE: cm; DRIVE: viteza cerută
+  int32_t encoder;             // ARDUINO (absolut, după refacerea diferențelor)
+  uint32_t arduinoTimeUs;
+  int16_t compass[3];
+  uint16_t voltageCentivolts;
+  int8_t direction;            // DRIVE
+  uint8_t flags;               // DRIVE: RECORD_DRIVE_*; RFID: tipul evenimentului
+  int8_t rssi;                 // RFID
+  uint8_t code;                // COMMAND
+  uint8_t len;                 // RFID: EPC; COMMAND: argumente
+  uint8_t data[RECORDER_DATA_MAX];
+};
+
+static inline void recorderPutU16(uint8_t* out, uint16_t v) {
+  out[0] = (uint8_t)v;
+  out[1] = (uint8_t)(v >> 8);
+}
+
+static inline void recorderPutU32(uint8_t* out, uint32_t v) {
+  for (int i = 0; i < 4; i++) out[i] = (uint8_t)(v >> (8 * i));
+}
+
+static inline uint16_t recorderGetU16(const uint8_t* in) {
+  return (uint16_t)in[0] | ((uint16_t)in[1] << 8);
+}
+
+static inline uint32_t recorderGetU32(const uint8_t* in) {
+  return (uint32_t)in[0] | ((uint32_t)in[1] << 8) | ((uint32_t)in[2] << 16) | ((uint32_t)in[3] << 24);
+}
+
+// ESP32 și calculatoarele x86/ARM sunt little-endian: float-ul se copiază ca atare
+static inline void recorderPutFloat(uint8_t* out, float v) {
+  memcpy(out, &v, sizeof(v));
+}
+
+static inline float recorderGetFloat(const uint8_t* in) {
+  float v;
+  memcpy(&v, in, sizeof(v));
+  return v;
+}
+
+static inline void recorderEncodeFileHeader(const RecorderFileHeader& h, uint8_t* out) {
+  memcpy(out, RECORDER_MAGIC, 4);
+  recorderPutU16(out + 4, h.blockSize);
+  recorderPutU16(out + 6, h.flags);
+  recorderPutU32(out + 8, h.fileIndex);
+  recorderPutU32(out + 12, h.startMs);
+  recorderPutFloat(out + 16, h.compassOffsetX);
+  recorderPutFloat(out + 20, h.compassOffsetY);
+  recorderPutFloat(out + 24, h.compassScaleX);
+  recorderPutFloat(out + 28, h.compassScaleY);
+  recorderPutFloat(out + 32, h.compassSign);
+  recorderPutFloat(out + 36, h.compassMountRad);
+}
+
+static inline bool recorderDecodeFileHeader(const uint8_t* in, size_t len, RecorderFileHeader& h) {
+  if (len < RECORDER_FILE_HEADER || memcmp(in, RECORDER_MAGIC, 4) != 0) return false;
+  h.blockSize = recorderGetU16(in + 4);
+  h.flags = recorderGetU16(in + 6);
+  h.fileIndex = recorderGetU32(in + 8);
+  h.startMs = recorderGetU32(in + 12);
+  h.compassOffsetX = recorderGetFloat(in + 16);
+  h.compassOffsetY = recorderGetFloat(in + 20);
+  h.compassScaleX = recorderGetFloat(in + 24);
+  h.compassScaleY = recorderGetFloat(in + 28);
+  h.compassSign = recorderGetFloat(in + 32);
+  h.compassMountRad = recorderGetFloat(in + 36);
+  return true;
+}
+
+/**
+ * Completează un bloc în memorie, înregistrare cu înregistrare. Fiecare add...() întoarce
+ * false dacă înregistrarea nu mai încape; blocul se închide cu seal() înainte de scriere.
+ */
+class RecorderBlockEncoder {
+public:
+  RecorderBlockEncoder() : _block(NULL), _used(0) {}
+
+  void begin(uint8_t* block, uint32_t sequence) {
+    _block = block;
+    _used = 0;
+    _sequence = sequence;
+    _lastTimeUs = 0;
+    _haveArduino = false;
+  }
+
+  bool empty() const { return _used == 0; }
+  uint32_t sequence() const { return _sequence; }
+
+  bool addRange(uint32_t timeUs, uint8_t channel, int32_t cm) {
+    uint8_t* p = open(timeUs, RECORD_RANGE);
+    if (p == NULL) return false;
+    *p++ = channel;
+    p += telemetryPutVarint(p, telemetryZigZag(cm));
+    return close(p);
+  }
+
+  bool addArduino(uint32_t timeUs, int32_t encoder, uint32_t arduinoTimeUs, const int16_t compass[3],
+                  uint16_t voltageCentivolts) {
+    uint8_t* p = open(timeUs, RECORD_ARDUINO);
+    if (p == NULL) return false;
+    // Diferențe față de eșantionul anterior din bloc: de obicei câte un octet sau doi
+    int32_t encoderDelta = _haveArduino ? encoder - _lastEncoder : encoder;
+    uint32_t arduinoDelta = _haveArduino ? arduinoTimeUs - _lastArduinoUs : arduinoTimeUs;
+    p += telemetryPutVarint(p, telemetryZigZag(encoderDelta));
+    p += telemetryPutVarint(p, arduinoDelta);
+    for (int i = 0; i < 3; i++) p += telemetryPutVarint(p, telemetryZigZag(compass[i]));
+    p += telemetryPutVarint(p, voltageCentivolts);
+    _lastEncoder = encoder;
+    _lastArduinoUs = arduinoTimeUs;
+    _haveArduino = true;
+    return close(p);
+  }
+
+  bool addDrive(uint32_t timeUs, int8_t direction, int32_t setpoint, uint8_t flags) {
+    uint8_t* p = open(timeUs, RECORD_DRIVE);
+    if (p == NULL) return false;
+    *p++ = (uint8_t)direction;
+    p += telemetryPutVarint(p, telemetryZigZag(setpoint));
+    *p++ = flags;
+    return close(p);
+  }
+
+  bool addRfid(uint32_t timeUs, uint8_t type, int8_t rssi, const uint8_t* epc, uint8_t len) {
+    if (len > RECORDER_DATA_MAX) len = RECORDER_DATA_MAX;
+    uint8_t* p = open(timeUs, RECORD_RFID);
+    if (p == NULL) return false;
+    *p++ = type;
+    *p++ = (uint8_t)rssi;
+    *p++ = len;
+    memcpy(p, epc, len);
+    return close(p + len);
+  }
+
+  bool addCommand(uint32_t timeUs, uint8_t code, const uint8_t* args, uint8_t len) {
+    if (len > RECORDER_DATA_MAX) len = RECORDER_DATA_MAX;
+    uint8_t* p = open(timeUs, RECORD_COMMAND);
+    if (p == NULL) return false;
+    *p++ = code;
+    *p++ = len;
+    if (len > 0) memcpy(p, args, len);
+    return close(p + len);
+  }
+
+  // Scrie antetul și CRC-ul; întoarce numărul de octeți de scris în fișier
+  size_t seal() {
+    _block[0] = RECORDER_BLOCK_SYNC_1;
+    _block[1] = RECORDER_BLOCK_SYNC_2;
+    recorderPutU16(_block + 2, (uint16_t)_used);
+    recorderPutU32(_block + 4, _sequence);
+    recorderPutU32(_block + 8, _baseUs);
+    size_t end = RECORDER_BLOCK_HEADER + _used;
+    recorderPutU16(_block + end, frameCrc16(_block + 2, end - 2));
+    return end + 2;
+  }
+
+private:
+  uint8_t* _block;
+  size_t _used;
+  uint32_t _sequence;
+  uint32_t _baseUs;
+  uint32_t _lastTimeUs;
+  bool _haveArduino;
+  int32_t _lastEncoder;
+  uint32_t _lastArduinoUs;
+
+  uint8_t* open(uint32_t timeUs, uint8_t type) {
+    if (RECORDER_BLOCK_HEADER + _used + RECORDER_MAX_RECORD + 2 > RECORDER_BLOCK_SIZE) return NULL;
+    if (_used == 0) _baseUs = _lastTimeUs = timeUs;
+    uint8_t* p = _block + RECORDER_BLOCK_HEADER + _used;
+    *p++ = type;
+    // Producătorii sunt taskuri diferite: diferența poate fi și negativă
+    p += telemetryPutVarint(p, telemetryZigZag((int32_t)(timeUs - _lastTimeUs)));
+    _lastTimeUs = timeUs;
+    return p;
+  }
+
+  bool close(uint8_t* end) {
+    _used = (size_t)(end - (_block + RECORDER_BLOCK_HEADER));
+    return true;
+  }
+};
+
+struct RecorderReaderStats {
+  uint32_t blocks;
+  uint32_t corruptBlocks;      // CRC sau lungime greșită
+  uint32_t skippedBytes;       // octeți ignorați la resincronizare
+  uint32_t events;
+};
+
+/**
+ * Citește înregistrările unui fișier întreg aflat în memorie (pe calculator, mapat cu mmap).
+ * Un bloc corupt este sărit până la următoarea sincronizare validă.
+ */
+class RecorderReader {
+public:
+  RecorderReader(const uint8_t* data, size_t len)
+      : _data(data), _len(len), _pos(0), _end(0), _ok(false) {
+    memset(&_stats, 0, sizeof(_stats));
+    _ok = recorderDecodeFileHeader(data, len, _header);
+    _pos = RECORDER_FILE_HEADER;
+  }
+
+  bool valid() const { return _ok; }
+  const RecorderFileHeader& header() const { return _header; }
+  const RecorderReaderStats& stats() const { return _stats; }
+
+  bool next(RecorderEvent& e) {
+    if (!_ok) return false;
+    while (_pos >= _end && nextBlock()) {
+    }
+    if (_pos >= _end) return false;
+    if (!decodeRecord(e)) {
+      // Înregistrare trunchiată în interiorul unui bloc cu CRC bun: versiune de format diferită
+      _stats.corruptBlocks++;
+      _pos = _end;
+      return next(e);
+    }
+    _stats.events++;
+    return true;
+  }
+
+private:
+  const uint8_t* _data;
+  size_t _len;
+  size_t _pos;                 // următoarea înregistrare
+  size_t _end;                 // sfârșitul înregistrărilor blocului curent
+  size_t _blockEnd;            // după CRC
+  bool _ok;
+  RecorderFileHeader _header;
+  RecorderReaderStats _stats;
+  uint32_t _sequence;
+  uint32_t _timeUs;
+  bool _haveArduino;
+  int32_t _encoder;
+  uint32_t _arduinoTimeUs;
+
+  bool nextBlock() {
+    size_t at = _end > 0 ? _blockEnd : _pos;
+    while (at + RECORDER_BLOCK_HEADER + 2 <= _len) {
+      if (_data[at] == RECORDER_BLOCK_SYNC_1 && _data[at + 1] == RECORDER_BLOCK_SYNC_2) {
+        size_t used = recorderGetU16(_data + at + 2);
+        size_t end = at + RECORDER_BLOCK_HEADER + used;
+        if (used <= RECORDER_BLOCK_SIZE - RECORDER_BLOCK_HEADER - 2 && end + 2 <= _len &&
+            frameCrc16(_data + at + 2, end - at - 2) == recorderGetU16(_data + end)) {
+          _stats.blocks++;
+          _sequence = recorderGetU32(_data + at + 4);
+          _timeUs = recorderGetU32(_data + at + 8);
+          _haveArduino = false;
+          _pos = at + RECORDER_BLOCK_HEADER;
+          _end = end;
+          _blockEnd = end + 2;
+          return true;
+        }
+        _stats.corruptBlocks++;
+      }
+      at++;
+      _stats.skippedBytes++;
+    }
+    _pos = _end = _blockEnd = _len;
+    return false;
+  }
+
+  bool getVarint(uint32_t* v) {
+    size_t n = telemetryGetVarint(_data + _pos, _end - _pos, v);
+    _pos += n;
+    return n > 0;
+  }
+
+  bool getSigned(int32_t* v) {
+    uint32_t raw;
+    if (!getVarint(&raw)) return false;
+    *v = telemetryUnZigZag(raw);
+    return true;
+  }
+
+  bool getByte(uint8_t* v) {
+    if (_pos >= _end) return false;
+    *v = _data[_pos++];
+    return true;
+  }
+
+  bool getBytes(uint8_t* out, uint8_t len) {
+    if (len > RECORDER_DATA_MAX || _end - _pos < len) return false;
+    memcpy(out, _data + _pos, len);
+    _pos += len;
+    return true;
+  }
+
+  bool decodeRecord(RecorderEvent& e) {
+    int32_t dt;
+    uint8_t b;
+    if (!getByte(&e.type) || !getSigned(&dt)) return false;
+    _timeUs += (uint32_t)dt;
+    e.timeUs = _timeUs;
+    e.blockSequence = _sequence;
+
+    switch (e.type) {
+      case RECORD_RANGE:
+        return getByte(&e.channel) && getSigned(&e.value);
+
+      case RECORD_ARDUINO: {
+        int32_t encoderDelta, c;
+        uint32_t arduinoDelta, voltage;
+        if (!getSigned(&encoderDelta) || !getVarint(&arduinoDelta)) return false;
+        for (int i = 0; i < 3; i++) {
+          if (!getSigned(&c)) return false;
+          e.compass[i] = (int16_t)c;
+        }
+        if (!getVarint(&voltage)) return false;
+        _encoder = _haveArduino ? _encoder + encoderDelta : encoderDelta;
+        _arduinoTimeUs = _haveArduino ? _arduinoTimeUs + arduinoDelta : arduinoDelta;
+        _haveArduino = true;
+        e.encoder = _encoder;
+        e.arduinoTimeUs = _arduinoTimeUs;
+        e.voltageCentivolts = (uint16_t)voltage;
+        return true;
+      }
+
+      case RECORD_DRIVE:
+        if (!getByte(&b) || !getSigned(&e.value)) return false;
+        e.direction = (int8_t)b;
+        return getByte(&e.flags);
+
+      case RECORD_RFID:
+        if (!getByte(&e.flags) || !getByte(&b) || !getByte(&e.len)) return false;
+        e.rssi = (int8_t)b;
+        return getBytes(e.data, e.len);
+
+      case RECORD_COMMAND:
+        return getByte(&e.code) && getByte(&e.len) && getBytes(e.data, e.len);
+    }
+    return false;
+  }
+};
+
+// Scrie o bucată a unui fișier în out (minim RECORDER_CHUNK_MAX_FRAME octeți); întoarce lungimea
+static inline size_t recorderEncodeChunk(uint16_t fileIndex, uint32_t offset, const uint8_t* data, size_t len,
+                                         uint8_t* out) {
+  if (len > RECORDER_CHUNK_DATA) len = RECORDER_CHUNK_DATA;
+  recorderPutU16(out + FRAME_HEADER_LEN, fileIndex);
+  recorderPutU32(out + FRAME_HEADER_LEN + 2, offset);
+  memcpy(out + FRAME_HEADER_LEN + RECORDER_CHUNK_HEADER, data, len);
+  return frameSeal(out, FRAME_SYNC_RECORDER_CHUNK, RECORDER_CHUNK_HEADER + len);
+}
+
+/**
+ * Extrage bucățile de jurnal dintr-un flux Bluetooth (amestecat cu telemetria și cu rapoartele
+ * text): push() întoarce true când o bucată validă este gata în fileIndex/offset/data/len.
+ */
+class RecorderChunkDecoder {
+public:
+  uint16_t fileIndex;
+  uint32_t offset;
+  uint8_t data[RECORDER_CHUNK_DATA];
+  size_t len;
+
+  RecorderChunkDecoder() : _frame(FRAME_SYNC_RECORDER_CHUNK, RECORDER_CHUNK_HEADER), _errors(0) {}
+
+  uint32_t errors() const { return _errors; }
+
+  bool push(uint8_t b) {
+    FrameResult r = _frame.push(b);
+    if (r == FRAME_BAD_CRC) _errors++;
+    if (r != FRAME_READY) return false;
+    const uint8_t* p = _frame.payload();
+    fileIndex = recorderGetU16(p);
+    offset = recorderGetU32(p + 2);
+    len = _frame.length() - RECORDER_CHUNK_HEADER;
+    memcpy(data, p + RECORDER_CHUNK_HEADER, len);
+    return true;
+  }
+
+private:
+  FrameDecoder<RECORDER_CHUNK_HEADER + RECORDER_CHUNK_DATA> _frame;
+  uint32_t _errors;
+};
+
+#endif
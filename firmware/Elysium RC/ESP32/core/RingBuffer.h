@@ -0,0 +1,60 @@
+#ifndef RING_BUFFER_H
+#define RING_BUFFER_H
+
+#include <atomic>
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * Buffer circular de octeți, fără alocări și fără mutex, pentru un singur
+ * producător (ex. callback-ul Bluetooth) și un singur consumator (ex. loop()).
+ * N trebuie să fie putere a lui 2.
+ */
+template <size_t N>
+class RingBuffer {
+  static_assert((N & (N - 1)) == 0, "RingBuffer: N trebuie sa fie putere a lui 2");
+
+public:
+  RingBuffer() : _head(0), _tail(0), _dropped(0) {}
+
+  // Producător: copiază cât încape; octeții care nu încap sunt numărați ca pierduți
+  size_t write(const uint8_t* data, size_t len) {
+    size_t head = _head.load(std::memory_order_relaxed);
+    size_t tail = _tail.load(std::memory_order_acquire);
+    size_t space = N - (head - tail);
+    size_t n = len < space ? len : space;
+    for (size_t i = 0; i < n; i++) {
+      _buf[(head + i) & (N - 1)] = data[i];
+    }
+    _head.store(head + n, std::memory_order_release);
+    if (n < len) {
+      _dropped.fetch_add(len - n, std::memory_order_relaxed);
+    }
+    return n;
+  }
+
+  // Consumator: întoarce false dacă bufferul este gol
+  bool read(uint8_t& out) {
+    size_t tail = _tail.load(std::memory_order_relaxed);
+    if (tail == _head.load(std::memory_order_acquire)) return false;
+    out = _buf[tail & (N - 1)];
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+  }
+
+  size_t available() const {
+    return _head.load(std::memory_order_acquire) - _tail.load(std::memory_order_acquire);
+  }
+
+  uint32_t dropped() const {
+    return _dropped.load(std::memory_order_relaxed);
+  }
+
+private:
+  uint8_t _buf[N];
+  std::atomic<size_t> _head;
+  std::atomic<size_t> _tail;
+  std::atomic<uint32_t> _dropped;
+};
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef SEQ_LOCK_H
+#define SEQ_LOCK_H
+
+#include <atomic>
+#include <stdint.h>
+
+/**
+ * Seqlock pentru un singur scriitor și oricâți cititori, fără mutex.
+ *
+ * Scriitorul face contorul impar cât timp copiază datele și par după ce a terminat.
+ * Cititorul copiază structura și reîncearcă doar dacă a prins o scriere în curs,
+ * astfel încât fiecare citire întoarce un cadru complet și coerent.
+ * T trebuie să fie o structură simplă (copiabilă cu memcpy).
+ */
+template <typename T>
+class SeqLock {
+public:
+  SeqLock() : _seq(0), _data() {}
+
+  // Apelată exclusiv de scriitorul unic
+  void write(const T& value) {
+    uint32_t seq = _seq.load(std::memory_order_relaxed);
+    _seq.store(seq + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+    _data = value;
+    _seq.store(seq + 2, std::memory_order_release);
+  }
+
+  // Poate fi apelată din orice task; nu blochează scriitorul
+  T read() const {
+    T copy;
+    uint32_t before, after;
+    do {
+      before = _seq.load(std::memory_order_acquire);
+      copy = _data;
+      std::atomic_thread_fence(std::memory_order_acquire);
+      after = _seq.load(std::memory_order_relaxed);
+    } while ((before & 1) || before != after);
+    return copy;
+  }
+
+  // Numărul de scrieri complete de la pornire
+  uint32_t version() const {
+    return _seq.load(std::memory_order_acquire) >> 1;
+  }
+
+private:
+  std::atomic<uint32_t> _seq;
+  T _data;
+};
+
+#endif
@@ -1,144 +1,159 @@
 #include "TaskManager.h"
+#include "Pipeline.h"
+#include "TaskMonitor.h"
+#include "../../../shared/log/DeferredLog.h"
 #include "../sensors/UltrasonicSensors.h"
 #include "../feedback/BuzzerManager.h"
 
-// Declarăm coada pentru mesaje
-QueueHandle_t queue;
+// Indexul fiecărui consumator în pipeline
+static int obstacleSubscriber = -1;
+static int buzzerSubscriber = -1;
 
 void Tasks_init() {
-  Serial.println("\nCreare coadă mesaje...");
-  queue = xQueueCreate(5, sizeof(char[50]));
-  
+  // Consumatorii se înscriu înainte ca fuziunea să publice primul cadru
+  obstacleSubscriber = Pipeline_subscribe("Obstacle");
+  buzzerSubscriber = Pipeline_subscribe("Buzzer");
+  Pipeline_init();
+
   Serial.println("\nCreare taskuri...");
-  xTaskCreate(
+  xTaskCreatePinnedToCore(
     obstacleDetectionTask, 
     "ObstacleTask", 
     2048,           // Stack size
     NULL,           // Task input parameter
     1,              // Priority
-    NULL            // Task handle
+    NULL,           // Task handle
+    PIPELINE_CORE   // Nucleul fără Bluetooth
   );
   
-  xTaskCreate(
+  xTaskCreatePinnedToCore(
     buzzerTask, 
     "BuzzerTask", 
     2048,           // Stack size
     NULL,           // Task input parameter
-    1,              // Priority
-    NULL            // Task handle
+    3,              // Priority: reacția la obstacole înaintea diagnosticării
+    NULL,           // Task handle
+    PIPELINE_CORE   // Nucleul fără Bluetooth
   );
 }
 
 void obstacleDetectionTask(void *parameter) {
+  unsigned long lastPrintMs = 0;
+  PerceptionFrame frame;
+  int monitorId = TaskMonitor_register("Obstacle", 0, 20000);
+
   while (true) {
-    // Folosim variabilele globale care sunt actualizate ciclic în loop()
-    long front = distanceFront;
-    long back  = distanceBack;
-    long left  = distanceLeft;
-    long right = distanceRight;
+    // Ne trezim la fiecare cadru fuzionat, dar afișăm cel mult o dată la 500 ms
+    if (!Pipeline_wait(obstacleSubscriber, frame)) continue;
+    TaskMonitor_begin(monitorId);
+    Pipeline_markReaction(obstacleSubscriber, frame);
+    if (millis() - lastPrintMs < 500) {
+      TaskMonitor_end(monitorId);
+      continue;
+    }
+    lastPrintMs = millis();
+
+    unsigned validMask = 0;
+    forEachUltrasonic([&](auto ch) {
+      if (frame.range[decltype(ch)::value].valid()) validMask |= 1u << decltype(ch)::value;
+    });
 
-    // Formăm un mesaj de diagnosticare
-    String mesajComplet = String("Obstacle Task: ") +
-                        "Front: " + String(front) + " " +
-                        "Back: " + String(back) + " " +
-                        "Left: " + String(left) + " " +
-                        "Right: " + String(right);
-                        
-    Serial.println(mesajComplet);
+    // Mesaj de diagnosticare, formatat mai târziu de taskul de jurnal
+    LOG_INFO("Obstacle Task: Front: %.0f Back: %.0f Left: %.0f Right: %.0f (valide 0x%x)",
+             frame.range[SENSOR_FRONT].distanceCm, frame.range[SENSOR_BACK].distanceCm,
+             frame.range[SENSOR_LEFT].distanceCm, frame.range[SENSOR_RIGHT].distanceCm, validMask);
     
-    // Activăm buzzerul dacă obstacolul din față este prea aproape
-    if (front > 0 && front < OBSTACLE_DISTANCE) {
-      digitalWrite(BUZZER_PIN, HIGH);
-    } else {
-      digitalWrite(BUZZER_PIN, LOW);
-    }
+    // Avertizarea sonoră pentru obstacolul din față este trimisă de buzzerTask
+    // (pragurile din UltrasonicProfile.h > OBSTACLE_DISTANCE); pinul buzzer-ului are un singur proprietar.
+    TaskMonitor_end(monitorId);
     
     // IMPORTANT: taskul nu trebuie să se termine niciodată!
-    vTaskDelay(pdMS_TO_TICKS(500));  // Pauză de 500 ms între verificări
   }
   
   // Nu se ajunge niciodată aici
   vTaskDelete(NULL);
 }
 
+// Parametrii pentru temporizarea bipurilor
+static const int BUZZER_MIN_DELAY_MS = 50;    // pauza minimă când obstacolul este foarte aproape
+static const int BUZZER_MAX_DELAY_MS = 500;   // pauza maximă când obstacolul este la limita pragului
+static const int BUZZER_BEEP_ON_MS = 50;      // durata efectivă a bipului
+
+bool buzzerProximityPattern(const PerceptionFrame& frame, BuzzerPattern& pattern) {
+  // Determinăm senzorul cu obstacolul cel mai apropiat, sub pragul propriu din profil
+  bool found = false;
+  long minDistance = 0;
+  long warnCm = 0;
+  uint16_t toneFreq = 0;                   // fiecare senzor are frecvența lui
+  float approachCmS = 0;                   // pozitiv dacă obiectul se apropie
+
+  forEachUltrasonic([&](auto ch) {
+    constexpr UltrasonicChannelSpec spec = ULTRASONIC_CHANNELS[decltype(ch)::value];
+    const RangeEstimate& r = frame.range[decltype(ch)::value];
+    if (!r.valid()) return;
+    long d = lroundf(r.distanceCm);
+    if (d < spec.warnCm && (!found || d < minDistance)) {
+      found = true;
+      minDistance = d;
+      warnCm = spec.warnCm;
+      toneFreq = spec.toneHz;
+      approachCmS = -r.rateCmS;
+    }
+  });
+
+  if (!found) return false;
+
+  pattern = {toneFreq, 0, 0, 0, BUZZER_PRIORITY_PROXIMITY};
+  if (minDistance >= 4) {
+    // Calculăm timpul de pauză între bipuri folosind o mapare cvadratică:
+    int offTime = BUZZER_MIN_DELAY_MS + ((minDistance * minDistance * (BUZZER_MAX_DELAY_MS - BUZZER_MIN_DELAY_MS)) /
+                                         (warnCm * warnCm));
+    
+    // Viteza de apropiere estimată de filtru
+    if (approachCmS > BUZZER_FAST_APPROACH_CMS) {
+       // Dacă obiectul se apropie rapid, reducem și mai mult offTime
+       offTime = offTime / 2;
+    }
+    pattern.onMs = BUZZER_BEEP_ON_MS;
+    pattern.offMs = offTime;
+  }
+  // minDistance < 4: onMs = 0, ton continuu
+  return true;
+}
+
 void buzzerTask(void *parameter) {
-  // Parametrii pentru temporizare:
-  const int minDelay = 50;    // întârziere minimă (ms) când obstacolul este foarte aproape
-  const int maxDelay = 500;   // întârziere maximă (ms) când obstacolul este la limita pragului
-  const int beepOnTime = 50;  // durata efectivă a bipului (ms)
-  
-  // Pentru calculul ratei de apropiere (viteză aparentă)
-  long previousMinDistance = BUZZER_THRESHOLD;
+  // Ultimul model trimis către buzzer
+  BuzzerPattern lastPattern = {0, 0, 0, 0, 0};
+  bool buzzing = false;
+  PerceptionFrame frame;
+  int monitorId = TaskMonitor_register("Buzzer", 0, 5000);
   
   while (true) {
-    // Citim valorile locale ale senzorilor
-    long front = distanceFront;
-    long left  = distanceLeft;
-    long right = distanceRight;
-    long back  = distanceBack;
+    // Dormim până la următorul cadru fuzionat; distanțele sunt deja filtrate
+    if (!Pipeline_wait(buzzerSubscriber, frame)) continue;
+    TaskMonitor_begin(monitorId);
     
-    // Determinăm senzorul cu obstacolul cel mai apropiat (sub BUZZER_THRESHOLD)
-    int sensorID = -1;   // 0: front, 1: stânga, 2: dreapta, 3: spate
-    long minDistance = BUZZER_THRESHOLD + 1; // valoare inițială peste prag
-    
-    if (front > 0 && front < BUZZER_THRESHOLD && front < minDistance) {
-      minDistance = front;
-      sensorID = 0;
-    }
-    if (left > 0 && left < BUZZER_THRESHOLD && left < minDistance) {
-      minDistance = left;
-      sensorID = 1;
-    }
-    if (right > 0 && right < BUZZER_THRESHOLD && right < minDistance) {
-      minDistance = right;
-      sensorID = 2;
-    }
-    if (back > 0 && back < BUZZER_THRESHOLD && back < minDistance) {
-      minDistance = back;
-      sensorID = 3;
-    }
-    
-    if (sensorID != -1) {
-      int toneFreq = 0;
-      // Asociem fiecărui senzor o frecvență unică:
-      switch(sensorID) {
-        case 0: toneFreq = 1000; break; // față: 1000 Hz
-        case 1: toneFreq = 800;  break; // stânga: 800 Hz
-        case 2: toneFreq = 1200; break; // dreapta: 1200 Hz
-        case 3: toneFreq = 600;  break; // spate: 600 Hz
-      }
-
-      if (minDistance < 4) {
-        tone(BUZZER_PIN, toneFreq);  // pornește tonul continuu
-        // Așteptăm puțin înainte de re-verificare
-        vTaskDelay(pdMS_TO_TICKS(100));
-      } else {
-        // Calculăm timpul de pauză între bipuri folosind o mapare cvadratică:
-        int offTime = minDelay + ((minDistance * minDistance * (maxDelay - minDelay)) / (BUZZER_THRESHOLD * BUZZER_THRESHOLD));
-        
-        // Calculăm „viteza" de apropiere (diferența între citirile succesive)
-        long speed = previousMinDistance - minDistance; // pozitiv dacă obiectul se apropie
-        previousMinDistance = minDistance;
-        if (speed > 5) {  
-           // Dacă obiectul se apropie rapid (mai mult de 5 cm între citiri), reducem și mai mult offTime
-           offTime = offTime / 2;
+    BuzzerPattern pattern;
+    if (buzzerProximityPattern(frame, pattern)) {
+      // Trimitem modelul doar când se schimbă; ritmul bipurilor este generat de timerul buzzer-ului.
+      // Îl retrimitem și dacă nu mai sună: o alertă cu prioritate mai mare l-a înlocuit și s-a terminat
+      bool replaced = buzzing && Buzzer_getActivePriority() < BUZZER_PRIORITY_PROXIMITY;
+      if (!buzzing || replaced || memcmp(&pattern, &lastPattern, sizeof(pattern)) != 0) {
+        // Cu coada plină cererea se pierde: o reluăm la cadrul următor
+        if (Buzzer_play(pattern)) {
+          lastPattern = pattern;
+          buzzing = true;
         }
-        
-        // Emit bipul:
-        tone(BUZZER_PIN, toneFreq, beepOnTime);
-        vTaskDelay(pdMS_TO_TICKS(beepOnTime));
-        noTone(BUZZER_PIN);
-        vTaskDelay(pdMS_TO_TICKS(offTime));
       }
     } else {
       // Niciun obstacol detectat: ne asigurăm că buzzer-ul este oprit
-      noTone(BUZZER_PIN);
-      previousMinDistance = BUZZER_THRESHOLD; // resetăm pentru următoarea comparație
-      vTaskDelay(pdMS_TO_TICKS(100));
+      if (buzzing && Buzzer_stop(BUZZER_PRIORITY_PROXIMITY)) {
+        buzzing = false;
+      }
     }
-    
-    // IMPORTANT: adăugăm un mic delay între verificări
-    vTaskDelay(pdMS_TO_TICKS(10));
+
+    Pipeline_markReaction(buzzerSubscriber, frame);
+    TaskMonitor_end(monitorId);
   }
   
   // Nu se ajunge niciodată aici
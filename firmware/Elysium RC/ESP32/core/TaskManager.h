@@ -6,13 +6,16 @@
 #include "freertos/task.h"
 #include "freertos/queue.h"
 
-// Declarări externe
-extern QueueHandle_t queue;
+struct PerceptionFrame;
+struct BuzzerPattern;
 
 // Funcții de task
 void buzzerTask(void *parameter);
 void obstacleDetectionTask(void *parameter);
 
+// Avertizarea sonoră pentru un cadru fuzionat; false dacă niciun obstacol nu este sub prag
+bool buzzerProximityPattern(const PerceptionFrame& frame, BuzzerPattern& pattern);
+
 // Funcții de management
 void Tasks_init();
 
@@ -0,0 +1,192 @@
+#include "TaskMonitor.h"
+#include "../../../shared/heap/HeapGuard.h"
+
+static TaskMonitorEntry monitorEntries[TASK_MONITOR_MAX_TASKS];
+static int monitorCount = 0;
+static int monitorRejected = 0;          // înregistrări refuzate: tabelul este prea mic
+static portMUX_TYPE monitorMux = portMUX_INITIALIZER_UNLOCKED;
+static volatile bool monitorReportRequested = false;
+
+// Începutul intervalului pentru procentul de CPU (resetat la fiecare raport)
+static unsigned long monitorWindowStartUs = 0;
+static uint32_t monitorWindowBusyUs[TASK_MONITOR_MAX_TASKS];
+
+// Indexul bucket-ului: 0 sub TASK_MONITOR_BUCKET_BASE_US, apoi câte unul pentru fiecare dublare
+static inline int monitorBucket(uint32_t us) {
+  uint32_t scaled = us / TASK_MONITOR_BUCKET_BASE_US;
+  if (scaled == 0) return 0;
+  int bucket = 32 - __builtin_clz(scaled);
+  return bucket < TASK_MONITOR_BUCKETS ? bucket : TASK_MONITOR_BUCKETS - 1;
+}
+
+/**
+ * Înregistrează taskul curent; trebuie apelată din taskul monitorizat.
+ * Întoarce -1 dacă nu mai există locuri (scrie pe Serial; apelurile ulterioare sunt ignorate).
+ */
+int TaskMonitor_register(const char* name, uint32_t periodUs, uint32_t deadlineUs) {
+  // Taskurile cu termene sunt și căile fierbinți în care heap-ul nu se mai folosește
+  HeapGuard_watchCurrentTask(name);
+#if TASK_MONITOR_ENABLED
+  portENTER_CRITICAL(&monitorMux);
+  int id = (monitorCount < TASK_MONITOR_MAX_TASKS) ? monitorCount++ : -1;
+  if (id < 0) monitorRejected++;
+  portEXIT_CRITICAL(&monitorMux);
+  if (id < 0) {
+    // Un task nemonitorizat ar lipsi din raport fără nicio urmă: TASK_MONITOR_MAX_TASKS e prea mic
+    Serial.printf("TaskMonitor: tabel plin (%d taskuri), %s nu este monitorizat\n", TASK_MONITOR_MAX_TASKS, name);
+    return -1;
+  }
+
+  TaskMonitorEntry& e = monitorEntries[id];
+  memset(&e, 0, sizeof(e));
+  e.name = name;
+  e.handle = xTaskGetCurrentTaskHandle();
+  e.periodUs = periodUs;
+  e.deadlineUs = deadlineUs;
+  return id;
+#else
+  return -1;
+#endif
+}
+
+void TaskMonitor_begin(int id) {
+#if TASK_MONITOR_ENABLED
+  if (id < 0) return;
+  TaskMonitorEntry& e = monitorEntries[id];
+  unsigned long now = micros();
+
+  if (e.periodUs > 0 && e.started) {
+    // Eliberarea așteptată = începutul anterior + perioada; tot ce trece peste e întârziere
+    e.releaseUs = e.startUs + e.periodUs;
+    uint32_t lateness = ((long)(now - e.releaseUs) > 0) ? now - e.releaseUs : 0;
+    e.latenessHistogram[monitorBucket(lateness)]++;
+    if (lateness > e.maxLatenessUs) e.maxLatenessUs = lateness;
+  } else {
+    e.releaseUs = now;
+  }
+  e.startUs = now;
+  e.started = true;
+#endif
+}
+
+void TaskMonitor_end(int id) {
+#if TASK_MONITOR_ENABLED
+  if (id < 0) return;
+  TaskMonitorEntry& e = monitorEntries[id];
+  unsigned long now = micros();
+
+  uint32_t exec = now - e.startUs;
+  e.execHistogram[monitorBucket(exec)]++;
+  if (exec > e.maxExecUs) e.maxExecUs = exec;
+  e.busyUs += exec;
+  e.iterations++;
+
+  // O iterație pornită puțin înaintea eliberării așteptate (jitter de tick) nu este o depășire
+  if (e.deadlineUs > 0 && (long)(now - e.releaseUs) > (long)e.deadlineUs) {
+    e.deadlineMisses++;
+  }
+#endif
+}
+
+TaskMonitorEntry TaskMonitor_get(int id) {
+  TaskMonitorEntry copy;
+  memset(&copy, 0, sizeof(copy));
+  if (id >= 0 && id < monitorCount) copy = monitorEntries[id];
+  return copy;
+}
+
+int TaskMonitor_getCount() {
+  return monitorCount;
+}
+
+int TaskMonitor_getRejected() {
+  return monitorRejected;
+}
+
+// Apelată din CommandChannel; raportul propriu-zis se trimite din loop()
+void TaskMonitor_requestReport() {
+  monitorReportRequested = true;
+}
+
+// snprintf întoarce lungimea dorită, nu cea scrisă: o linie trunchiată rămâne la size - 1
+static int monitorClamp(int n, size_t size) {
+  if (n < 0) return 0;
+  return n < (int)size ? n : (int)size - 1;
+}
+
+static int monitorPrintHistogram(char* out, size_t size, const uint32_t* histogram) {
+  int n = 0;
+  for (int i = 0; i < TASK_MONITOR_BUCKETS && n < (int)size - 1; i++) {
+    n = monitorClamp(n + snprintf(out + n, size - n, i ? ",%lu" : "%lu", (unsigned long)histogram[i]), size);
+  }
+  return n;
+}
+
+static void sendReport(BluetoothManager& bt) {
+  unsigned long now = micros();
+  unsigned long windowUs = now - monitorWindowStartUs;
+  char line[256];
+
+  for (int i = 0; i < monitorCount; i++) {
+    TaskMonitorEntry e = monitorEntries[i];
+    uint32_t busy = e.busyUs - monitorWindowBusyUs[i];
+    monitorWindowBusyUs[i] = e.busyUs;
+    unsigned long cpuPermille = windowUs ? (unsigned long)((uint64_t)busy * 1000 / windowUs) : 0;
+    // În ESP-IDF marcajul de stivă este în octeți
+    unsigned long stackFree = e.handle ? (unsigned long)uxTaskGetStackHighWaterMark(e.handle) : 0;
+
+    int n = snprintf(line, sizeof(line), "MON %s T=%lu D=%lu n=%lu miss=%lu cpu=%lu.%lu%% stack=%lu exec=%lu/",
+                     e.name, (unsigned long)e.periodUs, (unsigned long)e.deadlineUs,
+                     (unsigned long)e.iterations, (unsigned long)e.deadlineMisses,
+                     cpuPermille / 10, cpuPermille % 10, stackFree, (unsigned long)e.maxExecUs);
+    n = monitorClamp(n, sizeof(line));
+    n += monitorPrintHistogram(line + n, sizeof(line) - n, e.execHistogram);
+    if (e.periodUs > 0 && n < (int)sizeof(line) - 1) {
+      n = monitorClamp(n + snprintf(line + n, sizeof(line) - n, " late=%lu/", (unsigned long)e.maxLatenessUs),
+                       sizeof(line));
+      monitorPrintHistogram(line + n, sizeof(line) - n, e.latenessHistogram);
+    }
+    bt.sendData(line);
+  }
+
+#if configGENERATE_RUN_TIME_STATS && configUSE_TRACE_FACILITY
+  // Procentul de CPU al fiecărui nucleu, din timpul petrecut în taskurile IDLE
+  static TaskStatus_t monitorStatus[24];
+  static uint32_t monitorIdlePrev[2] = {0, 0};
+  static uint32_t monitorTotalPrev = 0;
+  uint32_t total = 0;
+  UBaseType_t count = uxTaskGetSystemState(monitorStatus, 24, &total);
+  uint32_t idle[2] = {0, 0};
+  for (UBaseType_t i = 0; i < count; i++) {
+    if (strncmp(monitorStatus[i].pcTaskName, "IDLE", 4) == 0) {
+      int core = (monitorStatus[i].pcTaskName[4] == '1') ? 1 : 0;
+      idle[core] = monitorStatus[i].ulRunTimeCounter;
+    }
+  }
+  uint32_t elapsed = total - monitorTotalPrev;
+  if (monitorTotalPrev != 0 && elapsed > 0) {
+    unsigned long busy0 = 1000 - (unsigned long)((uint64_t)(idle[0] - monitorIdlePrev[0]) * 1000 / elapsed);
+    unsigned long busy1 = 1000 - (unsigned long)((uint64_t)(idle[1] - monitorIdlePrev[1]) * 1000 / elapsed);
+    snprintf(line, sizeof(line), "MON cores cpu0=%lu.%lu%% cpu1=%lu.%lu%% tasks=%u heap=%lu",
+             busy0 / 10, busy0 % 10, busy1 / 10, busy1 % 10, (unsigned)count, (unsigned long)ESP.getFreeHeap());
+    bt.sendData(line);
+  }
+  monitorIdlePrev[0] = idle[0];
+  monitorIdlePrev[1] = idle[1];
+  monitorTotalPrev = total;
+#else
+  snprintf(line, sizeof(line), "MON heap=%lu", (unsigned long)ESP.getFreeHeap());
+  bt.sendData(line);
+#endif
+
+  monitorWindowStartUs = now;
+}
+
+/**
+ * Trimite raportul dacă a fost cerut; apelată din loop()
+ */
+void TaskMonitor_update(BluetoothManager& bt) {
+  if (!monitorReportRequested) return;
+  monitorReportRequested = false;
+  sendReport(bt);
+}
@@ -0,0 +1,65 @@
+#ifndef TASK_MONITOR_H
+#define TASK_MONITOR_H
+
+#include <Arduino.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "BluetoothManager.h"
+
+/**
+ * Monitorizarea taskurilor: timp de execuție, întârziere față de perioadă,
+ * depășiri de termen, stivă liberă și procent de CPU.
+ *
+ * Fiecare task se înregistrează o dată (din propriul context) și marchează
+ * începutul și sfârșitul fiecărei iterații:
+ *
+ *   int id = TaskMonitor_register("Buzzer", 0, 5000);
+ *   while (true) {
+ *     ...așteptare...
+ *     TaskMonitor_begin(id);
+ *     ...lucru...
+ *     TaskMonitor_end(id);
+ *   }
+ *
+ * Cele două apeluri costă doar câte un micros() și câteva incrementări, fără
+ * blocări, astfel încât monitorul poate rămâne activ și în producție.
+ * Raportul (text compact, liniile încep cu "MON") se trimite prin Bluetooth
+ * la comanda 'M' sau CMD_REPORT.
+ */
+
+#ifndef TASK_MONITOR_ENABLED
+#define TASK_MONITOR_ENABLED 1
+#endif
+
+#define TASK_MONITOR_MAX_TASKS 11
+#define TASK_MONITOR_BUCKETS 8            // histograme logaritmice
+#define TASK_MONITOR_BUCKET_BASE_US 128   // bucket 0: < 128 µs, apoi dublare, ultimul: >= 8192 µs
+
+struct TaskMonitorEntry {
+  const char* name;
+  TaskHandle_t handle;
+  uint32_t periodUs;        // 0 = task condus de evenimente (fără întârziere calculată)
+  uint32_t deadlineUs;      // termenul pentru o iterație, măsurat de la eliberarea așteptată
+  uint32_t iterations;
+  uint32_t deadlineMisses;
+  uint32_t maxExecUs;
+  uint32_t maxLatenessUs;
+  uint32_t execHistogram[TASK_MONITOR_BUCKETS];
+  uint32_t latenessHistogram[TASK_MONITOR_BUCKETS];
+  uint32_t busyUs;          // timp total de execuție (se reia după ~71 min), pentru procentul de CPU
+  unsigned long startUs;    // începutul iterației curente
+  unsigned long releaseUs;  // eliberarea așteptată a iterației curente
+  bool started;
+};
+
+// Funcții
+int TaskMonitor_register(const char* name, uint32_t periodUs, uint32_t deadlineUs);
+void TaskMonitor_begin(int id);
+void TaskMonitor_end(int id);
+void TaskMonitor_requestReport();
+void TaskMonitor_update(BluetoothManager& bt);
+TaskMonitorEntry TaskMonitor_get(int id);
+int TaskMonitor_getCount();
+int TaskMonitor_getRejected();
+
+#endif
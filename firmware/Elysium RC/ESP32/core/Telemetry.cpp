@@ -0,0 +1,86 @@
+#include "Telemetry.h"
+#include "../sensors/UltrasonicSensors.h"
+#include "../sensors/ArduinoLink.h"
+#include "../motion-control/DCMotor.h"
+#include "../motion-control/ServoMotor.h"
+#include "../navigation/Navigation.h"
+
+// Ultimul ID primit de la cititorul RFID
+static char telemetryRfidTag[TELEMETRY_RFID_MAX + 1] = "";
+
+static TelemetryEncoder telemetryEncoder;
+static unsigned long lastTelemetryMs = 0;
+static unsigned long lastTelemetryKeyframeMs = 0;
+
+void Telemetry_setRfidTag(const char* cardID) {
+  strncpy(telemetryRfidTag, cardID, TELEMETRY_RFID_MAX);
+  telemetryRfidTag[TELEMETRY_RFID_MAX] = '\0';
+}
+
+static void buildTelemetrySample(TelemetrySample& s) {
+  UltrasonicFrame frame = UltrasonicSensors_getFrame();
+  // Protocolul aplicației are doar cele patru direcții principale, pe orice șasiu
+  s.value[TELEMETRY_CH_US_FRONT] = frame.distance[SENSOR_FRONT];
+  s.value[TELEMETRY_CH_US_LEFT]  = frame.distance[SENSOR_LEFT];
+  s.value[TELEMETRY_CH_US_BACK]  = frame.distance[SENSOR_BACK];
+  s.value[TELEMETRY_CH_US_RIGHT] = frame.distance[SENSOR_RIGHT];
+
+  ArduinoSample arduino = ArduinoLink_getSample();
+  s.value[TELEMETRY_CH_ENCODER]   = arduino.encoder;
+  s.value[TELEMETRY_CH_COMPASS_X] = arduino.compass[0];
+  s.value[TELEMETRY_CH_COMPASS_Y] = arduino.compass[1];
+  s.value[TELEMETRY_CH_COMPASS_Z] = arduino.compass[2];
+  s.value[TELEMETRY_CH_VOLTAGE]   = arduino.voltageCentivolts;
+
+  s.value[TELEMETRY_CH_MOTOR_DIR]   = isMovingForward ? 1 : (isMovingBackward ? -1 : 0);
+  s.value[TELEMETRY_CH_MOTOR_PWM]   = abs(DCMotor_getDuty());
+  s.value[TELEMETRY_CH_SERVO_ANGLE] = currentServoAngle;
+
+  NavPose pose = Navigation_getPose();
+  s.value[TELEMETRY_CH_POSE_X]       = (int32_t)lroundf(pose.x * 100.0f);
+  s.value[TELEMETRY_CH_POSE_Y]       = (int32_t)lroundf(pose.y * 100.0f);
+  s.value[TELEMETRY_CH_POSE_HEADING] = (int32_t)lroundf(pose.theta * 1800.0f / (float)M_PI);
+
+  s.rfidLen = strlen(telemetryRfidTag);
+  memcpy(s.rfid, telemetryRfidTag, s.rfidLen);
+}
+
+/**
+ * Trimite telemetria la rată fixă, doar dacă valorile s-au schimbat
+ * (plus un cadru cheie periodic, pentru resincronizarea aplicației)
+ */
+void Telemetry_update(BluetoothManager& bt) {
+  unsigned long now = millis();
+  if (now - lastTelemetryMs < TELEMETRY_PERIOD_MS) return;
+  lastTelemetryMs = now;
+
+  TelemetrySample sample;
+  buildTelemetrySample(sample);
+
+  bool keyframe = (now - lastTelemetryKeyframeMs >= TELEMETRY_KEYFRAME_MS);
+  if (!keyframe && !telemetryEncoder.changed(sample)) return;
+
+#if TELEMETRY_BINARY
+  if (keyframe) lastTelemetryKeyframeMs = now;
+  uint8_t frame[TELEMETRY_MAX_FRAME];
+  size_t len = telemetryEncoder.encode(sample, now, keyframe, frame);
+  bt.sendBytes(frame, len);
+#else
+  // Formatul text vechi: doar distanțele, plus linia RFID când se schimbă cardul
+  static char lastTag[TELEMETRY_RFID_MAX + 1] = "";
+  if (keyframe) lastTelemetryKeyframeMs = now;
+  uint8_t unused[TELEMETRY_MAX_FRAME];
+  telemetryEncoder.encode(sample, now, keyframe, unused);  // actualizează doar starea pentru changed()
+
+  char line[64];
+  snprintf(line, sizeof(line), "%ld,%ld,%ld,%ld",
+           (long)sample.value[TELEMETRY_CH_US_FRONT], (long)sample.value[TELEMETRY_CH_US_BACK],
+           (long)sample.value[TELEMETRY_CH_US_LEFT], (long)sample.value[TELEMETRY_CH_US_RIGHT]);
+  bt.sendData(line);
+  if (strcmp(lastTag, telemetryRfidTag) != 0) {
+    strcpy(lastTag, telemetryRfidTag);
+    snprintf(line, sizeof(line), "RFID:%s", telemetryRfidTag);
+    bt.sendData(line);
+  }
+#endif
+}
@@ -0,0 +1,20 @@
+#ifndef TELEMETRY_H
+#define TELEMETRY_H
+
+#include <Arduino.h>
+#include "BluetoothManager.h"
+#include "TelemetryCodec.h"
+
+// 1 = cadre binare (TelemetryCodec.h), 0 = vechiul format text "f,b,l,r"
+#ifndef TELEMETRY_BINARY
+#define TELEMETRY_BINARY 1
+#endif
+
+#define TELEMETRY_PERIOD_MS 50      // rata fixă de transmisie (20 Hz)
+#define TELEMETRY_KEYFRAME_MS 1000  // cadru cheie periodic, chiar dacă nimic nu s-a schimbat
+
+// Funcții
+void Telemetry_setRfidTag(const char* cardID);
+void Telemetry_update(BluetoothManager& bt);
+
+#endif
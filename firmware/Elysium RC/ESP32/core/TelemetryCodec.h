@@ -0,0 +1,239 @@
+#ifndef TELEMETRY_CODEC_H
+#define TELEMETRY_CODEC_H
+
+/**
+ * Format binar pentru telemetria Elysium RC (fără dependențe Arduino,
+ * poate fi compilat și pe calculator pentru decodare și măsurători).
+ *
+ * Cadru (FrameCodec.h, fluxul FRAME_SYNC_TELEMETRY):
+ *   0xA5 0x5A | len | payload[len] | crc16 (LE, peste len + payload)
+ * Payload:
+ *   seq (u16 LE) | flags (u8) | timp (varint) | mască canale (varint) |
+ *   valori (varint zigzag, câte una pentru fiecare bit din mască) |
+ *   [RFID: lungime (u8) + octeți, dacă bitul TELEMETRY_CH_RFID e setat]
+ *
+ * Într-un cadru cheie (TELEMETRY_FLAG_KEYFRAME) timpul și valorile sunt absolute
+ * și toate canalele sunt prezente. În celelalte cadre timpul este diferența față
+ * de cadrul anterior, iar valorile sunt diferențe doar pentru canalele modificate.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "../../../shared/link/FrameCodec.h"
+
+#define TELEMETRY_FLAG_KEYFRAME 0x01
+#define TELEMETRY_RFID_MAX 24
+#define TELEMETRY_MAX_PAYLOAD 128
+#define TELEMETRY_MAX_FRAME (TELEMETRY_MAX_PAYLOAD + FRAME_OVERHEAD)
+
+// Canalele transmise; ordinea dă poziția bitului în mască
+enum TelemetryChannel {
+  TELEMETRY_CH_US_FRONT = 0,   // cm, -1 = invalid
+  TELEMETRY_CH_US_LEFT,
+  TELEMETRY_CH_US_BACK,
+  TELEMETRY_CH_US_RIGHT,
+  TELEMETRY_CH_ENCODER,        // impulsuri encoder (Arduino)
+  TELEMETRY_CH_COMPASS_X,      // valori brute QMC5883
+  TELEMETRY_CH_COMPASS_Y,
+  TELEMETRY_CH_COMPASS_Z,
+  TELEMETRY_CH_VOLTAGE,        // centivolți
+  TELEMETRY_CH_MOTOR_DIR,      // -1 înapoi, 0 oprit, 1 înainte
+  TELEMETRY_CH_MOTOR_PWM,      // factor de umplere 0-255
+  TELEMETRY_CH_SERVO_ANGLE,    // grade
+  TELEMETRY_CH_POSE_X,         // cm, poziția estimată (navigație)
+  TELEMETRY_CH_POSE_Y,         // cm
+  TELEMETRY_CH_POSE_HEADING,   // zecimi de grad, sens trigonometric
+  TELEMETRY_CHANNEL_COUNT,
+  TELEMETRY_CH_RFID = TELEMETRY_CHANNEL_COUNT  // bit separat pentru ID-ul tag-ului
+};
+
+struct TelemetrySample {
+  int32_t value[TELEMETRY_CHANNEL_COUNT];
+  uint8_t rfidLen;
+  uint8_t rfid[TELEMETRY_RFID_MAX];
+};
+
+static inline size_t telemetryPutVarint(uint8_t* out, uint32_t v) {
+  size_t n = 0;
+  while (v >= 0x80) {
+    out[n++] = (uint8_t)(v | 0x80);
+    v >>= 7;
+  }
+  out[n++] = (uint8_t)v;
+  return n;
+}
+
+// Întoarce numărul de octeți consumați sau 0 dacă varint-ul e incomplet/invalid
+static inline size_t telemetryGetVarint(const uint8_t* in, size_t len, uint32_t* v) {
+  uint32_t result = 0;
+  for (size_t i = 0; i < len && i < 5; i++) {
+    result |= (uint32_t)(in[i] & 0x7F) << (7 * i);
+    if ((in[i] & 0x80) == 0) {
+      *v = result;
+      return i + 1;
+    }
+  }
+  return 0;
+}
+
+static inline uint32_t telemetryZigZag(int32_t v) {
+  return ((uint32_t)v << 1) ^ (uint32_t)(v >> 31);
+}
+
+static inline int32_t telemetryUnZigZag(uint32_t v) {
+  return (int32_t)(v >> 1) ^ -(int32_t)(v & 1);
+}
+
+static inline bool telemetryRfidEqual(const TelemetrySample& a, const TelemetrySample& b) {
+  return a.rfidLen == b.rfidLen && memcmp(a.rfid, b.rfid, a.rfidLen) == 0;
+}
+
+class TelemetryEncoder {
+public:
+  TelemetryEncoder() : _seq(0), _lastTimeMs(0), _hasPrevious(false) {
+    memset(&_prev, 0, sizeof(_prev));
+  }
+
+  // Adevărat dacă eșantionul diferă de ultimul cadru transmis
+  bool changed(const TelemetrySample& s) const {
+    if (!_hasPrevious) return true;
+    return memcmp(s.value, _prev.value, sizeof(s.value)) != 0 || !telemetryRfidEqual(s, _prev);
+  }
+
+  // Scrie un cadru complet în out (minim TELEMETRY_MAX_FRAME octeți); întoarce lungimea
+  size_t encode(const TelemetrySample& s, uint32_t timeMs, bool keyframe, uint8_t* out) {
+    if (!_hasPrevious) keyframe = true;
+
+    uint8_t* p = out + FRAME_HEADER_LEN;
+    *p++ = (uint8_t)(_seq & 0xFF);
+    *p++ = (uint8_t)(_seq >> 8);
+    *p++ = keyframe ? TELEMETRY_FLAG_KEYFRAME : 0;
+    p += telemetryPutVarint(p, keyframe ? timeMs : timeMs - _lastTimeMs);
+
+    uint32_t mask = 0;
+    for (int i = 0; i < TELEMETRY_CHANNEL_COUNT; i++) {
+      if (keyframe || s.value[i] != _prev.value[i]) mask |= (1UL << i);
+    }
+    if (keyframe || !telemetryRfidEqual(s, _prev)) mask |= (1UL << TELEMETRY_CH_RFID);
+    p += telemetryPutVarint(p, mask);
+
+    for (int i = 0; i < TELEMETRY_CHANNEL_COUNT; i++) {
+      if (mask & (1UL << i)) {
+        int32_t v = keyframe ? s.value[i] : s.value[i] - _prev.value[i];
+        p += telemetryPutVarint(p, telemetryZigZag(v));
+      }
+    }
+    if (mask & (1UL << TELEMETRY_CH_RFID)) {
+      uint8_t len = s.rfidLen > TELEMETRY_RFID_MAX ? TELEMETRY_RFID_MAX : s.rfidLen;
+      *p++ = len;
+      memcpy(p, s.rfid, len);
+      p += len;
+    }
+
+    size_t frameLen = frameSeal(out, FRAME_SYNC_TELEMETRY, (size_t)(p - (out + FRAME_HEADER_LEN)));
+
+    _prev = s;
+    _prev.rfidLen = s.rfidLen > TELEMETRY_RFID_MAX ? TELEMETRY_RFID_MAX : s.rfidLen;
+    _hasPrevious = true;
+    _lastTimeMs = timeMs;
+    _seq++;
+    return frameLen;
+  }
+
+private:
+  TelemetrySample _prev;
+  uint16_t _seq;
+  uint32_t _lastTimeMs;
+  bool _hasPrevious;
+};
+
+/**
+ * Decodor incremental: primește octet cu octet și reconstruie eșantioanele.
+ * După un cadru pierdut (salt de secvență) ignoră diferențele până la următorul cadru cheie.
+ */
+class TelemetryDecoder {
+public:
+  uint32_t framesOk;
+  uint32_t crcErrors;
+  uint32_t sequenceGaps;
+  uint32_t skippedDeltas;
+
+  TelemetryDecoder() : framesOk(0), crcErrors(0), sequenceGaps(0), skippedDeltas(0),
+                       _frame(FRAME_SYNC_TELEMETRY), _synced(false), _lastSeq(0), _timeMs(0) {
+    memset(&_sample, 0, sizeof(_sample));
+  }
+
+  // Întoarce true când un cadru valid a actualizat sample()/timeMs()
+  bool push(uint8_t b) {
+    FrameResult r = _frame.push(b);
+    if (r == FRAME_READY) return finishFrame(_frame.payload(), _frame.length());
+    if (r == FRAME_BAD_CRC) crcErrors++;
+    return false;
+  }
+
+  const TelemetrySample& sample() const { return _sample; }
+  uint32_t timeMs() const { return _timeMs; }
+  uint16_t sequence() const { return _lastSeq; }
+
+private:
+  FrameDecoder<TELEMETRY_MAX_PAYLOAD> _frame;
+  TelemetrySample _sample;
+  bool _synced;
+  uint16_t _lastSeq;
+  uint32_t _timeMs;
+
+  bool finishFrame(const uint8_t* payload, uint8_t len) {
+    if (len < 5) {
+      crcErrors++;
+      return false;
+    }
+
+    const uint8_t* p = payload;
+    const uint8_t* end = payload + len;
+    uint16_t seq = (uint16_t)p[0] | ((uint16_t)p[1] << 8);
+    bool keyframe = (p[2] & TELEMETRY_FLAG_KEYFRAME) != 0;
+    p += 3;
+
+    if (_synced && seq != (uint16_t)(_lastSeq + 1)) {
+      sequenceGaps++;
+      _synced = false;
+    }
+    _lastSeq = seq;
+    if (!keyframe && !_synced) {
+      skippedDeltas++;
+      return false;
+    }
+
+    uint32_t time, mask, raw;
+    size_t n = telemetryGetVarint(p, end - p, &time);
+    if (!n) { crcErrors++; return false; }
+    p += n;
+    n = telemetryGetVarint(p, end - p, &mask);
+    if (!n) { crcErrors++; return false; }
+    p += n;
+
+    TelemetrySample next = _sample;
+    for (int i = 0; i < TELEMETRY_CHANNEL_COUNT; i++) {
+      if (!(mask & (1UL << i))) continue;
+      n = telemetryGetVarint(p, end - p, &raw);
+      if (!n) { crcErrors++; return false; }
+      p += n;
+      int32_t v = telemetryUnZigZag(raw);
+      next.value[i] = keyframe ? v : next.value[i] + v;
+    }
+    if (mask & (1UL << TELEMETRY_CH_RFID)) {
+      if (p >= end || p[0] > TELEMETRY_RFID_MAX || p + 1 + p[0] > end) { crcErrors++; return false; }
+      next.rfidLen = p[0];
+      memcpy(next.rfid, p + 1, p[0]);
+    }
+
+    _sample = next;
+    _timeMs = keyframe ? time : _timeMs + time;
+    _synced = true;
+    framesOk++;
+    return true;
+  }
+};
+
+#endif
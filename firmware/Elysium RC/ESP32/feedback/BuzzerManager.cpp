@@ -1,22 +1,182 @@
 #include "BuzzerManager.h"
+#include "freertos/queue.h"
+#include "esp_timer.h"
+
+// Cererile clienților ajung printr-o coadă; timerul le execută fără a bloca pe nimeni.
+// buzzerTimer marchează sfârșitul fazei și este programat doar din callback; clienții pornesc
+// buzzerWake, care rulează același callback: o cerere nu mai poate fi amânată de o reprogramare
+// concurentă a sfârșitului de fază
+static QueueHandle_t buzzerQueue = NULL;
+static esp_timer_handle_t buzzerTimer = NULL;
+static esp_timer_handle_t buzzerWake = NULL;
+// Incrementat din clienți (coadă plină) și din callback (prioritate prea mică)
+static portMUX_TYPE buzzerMux = portMUX_INITIALIZER_UNLOCKED;
+static uint32_t buzzerDropped = 0;
+
+// Starea secvențiatorului, folosită doar din callback-ul timerului
+static BuzzerPattern buzzerCurrent = {0, 0, 0, 0, 0};
+static bool buzzerActive = false;
+static bool buzzerToneOn = false;
+static uint8_t buzzerRepeatsLeft = 0;
+static int64_t buzzerPhaseEndUs = 0;
+// Prioritatea modelului care sună, -1 = liniște; citită de clienți din alte taskuri
+static volatile int buzzerPlayingPriority = -1;
+
+static void buzzerSetActive(bool active) {
+  buzzerActive = active;
+  buzzerPlayingPriority = active ? buzzerCurrent.priority : -1;
+}
+
+static void buzzerCountDrop() {
+  portENTER_CRITICAL(&buzzerMux);
+  buzzerDropped++;
+  portEXIT_CRITICAL(&buzzerMux);
+}
+
+static void buzzerOutput(uint16_t frequency) {
+  if (frequency > 0) {
+    ledcWriteTone(BUZZER_PIN, frequency);
+  } else {
+    ledcWrite(BUZZER_PIN, 0);
+  }
+}
+
+// Doar din callback (taskul esp_timer)
+static void buzzerArm(int64_t delayUs) {
+  esp_timer_stop(buzzerTimer);
+  esp_timer_start_once(buzzerTimer, delayUs > 0 ? delayUs : 1);
+}
+
+static void buzzerStartPhase(bool toneOn, int64_t now) {
+  buzzerToneOn = toneOn;
+  buzzerOutput(toneOn ? buzzerCurrent.frequency : 0);
+
+  uint16_t durationMs = toneOn ? buzzerCurrent.onMs : buzzerCurrent.offMs;
+  if (toneOn && durationMs == 0) {
+    // Ton continuu: nu mai programăm nimic până la o cerere nouă
+    buzzerPhaseEndUs = INT64_MAX;
+    return;
+  }
+  buzzerPhaseEndUs = now + (int64_t)durationMs * 1000;
+  buzzerArm(buzzerPhaseEndUs - now);
+}
+
+static void buzzerAccept(const BuzzerPattern& request, int64_t now) {
+  if (request.frequency == 0) {
+    buzzerSetActive(false);
+    buzzerToneOn = false;
+    buzzerOutput(0);
+    return;
+  }
+
+  // Același ton repetat la nesfârșit: actualizăm doar ritmul, fără a reporni bipul
+  if (buzzerActive && buzzerCurrent.repeat == 0 && request.repeat == 0 &&
+      buzzerCurrent.frequency == request.frequency && buzzerCurrent.priority == request.priority &&
+      buzzerCurrent.onMs != 0 && request.onMs != 0) {
+    buzzerCurrent.onMs = request.onMs;
+    buzzerCurrent.offMs = request.offMs;
+    return;
+  }
+
+  buzzerCurrent = request;
+  buzzerSetActive(true);
+  buzzerRepeatsLeft = request.repeat;
+  buzzerStartPhase(true, now);
+}
+
+// Callback-ul timerului: preia cererile noi și avansează modelul curent
+static void buzzerStep(void* arg) {
+  int64_t now = esp_timer_get_time();
+  bool preempted = false;
+  BuzzerPattern request;
+
+  while (xQueueReceive(buzzerQueue, &request, 0) == pdTRUE) {
+    if (!buzzerActive || request.priority >= buzzerCurrent.priority) {
+      bool wasActive = buzzerActive;
+      int64_t previousEnd = buzzerPhaseEndUs;
+      buzzerAccept(request, now);
+      preempted = !(wasActive && buzzerActive && buzzerPhaseEndUs == previousEnd);
+    } else {
+      buzzerCountDrop();
+    }
+  }
+
+  if (preempted || !buzzerActive) return;
+
+  // Trezit de o cerere respinsă sau doar actualizată: buzzerTimer așteaptă încă sfârșitul fazei
+  if (now < buzzerPhaseEndUs) return;
+
+  if (buzzerToneOn && buzzerCurrent.offMs > 0) {
+    buzzerStartPhase(false, now);
+    return;
+  }
+
+  // Sfârșitul unei repetări
+  if (buzzerCurrent.repeat != 0 && --buzzerRepeatsLeft == 0) {
+    buzzerSetActive(false);
+    buzzerToneOn = false;
+    buzzerOutput(0);
+    return;
+  }
+  buzzerStartPhase(true, now);
+}
 
 void Buzzer_init() {
   Serial.println("\nConfigurare buzzer...");
-  pinMode(BUZZER_PIN, OUTPUT);
-  digitalWrite(BUZZER_PIN, LOW);
+  // Canal PWM 3 pentru buzzer, atașat o singură dată
+  ledcAttachChannel(BUZZER_PIN, 1000, 8, BUZZER_LEDC_CHANNEL);
+  ledcWrite(BUZZER_PIN, 0);
+
+  buzzerQueue = xQueueCreate(BUZZER_QUEUE_LENGTH, sizeof(BuzzerPattern));
+
+  esp_timer_create_args_t timerArgs = {};
+  timerArgs.callback = buzzerStep;
+  timerArgs.name = "buzzer";
+  esp_timer_create(&timerArgs, &buzzerTimer);
+  timerArgs.name = "buzzer_wake";
+  esp_timer_create(&timerArgs, &buzzerWake);
 }
 
-void tone(int pin, int frequency, int duration) {
-  // Canal PWM 3 pentru buzzer
-  ledcAttachChannel(pin, frequency, 8, 3);  // Folosim PIN, freq, resolution, channel
-  ledcWrite(3, 128); // 50% duty cycle
-  
-  if (duration > 0) {
-    delay(duration);
-    noTone(pin);
+/**
+ * Trimite un model către buzzer și revine imediat.
+ * Întoarce false dacă coada este plină (cererea se pierde).
+ */
+bool Buzzer_play(const BuzzerPattern& pattern) {
+  if (buzzerQueue == NULL || xQueueSend(buzzerQueue, &pattern, 0) != pdTRUE) {
+    buzzerCountDrop();
+    return false;
   }
+  // Dacă trezirea este deja programată (ESP_ERR_INVALID_STATE), ea va prelua și cererea noastră:
+  // un timer one-shot devine inactiv înainte de callback, deci coada nu este încă golită
+  esp_timer_start_once(buzzerWake, 1);
+  return true;
+}
+
+bool Buzzer_stop(uint8_t priority) {
+  BuzzerPattern silence = {0, 0, 0, 1, priority};
+  return Buzzer_play(silence);
+}
+
+/**
+ * Prioritatea modelului care sună acum, -1 dacă buzzer-ul tace. Un client își poate retrimite
+ * modelul după ce o cerere cu prioritate mai mare l-a înlocuit și s-a terminat.
+ */
+int Buzzer_getActivePriority() {
+  return buzzerPlayingPriority;
+}
+
+uint32_t Buzzer_getDroppedRequests() {
+  portENTER_CRITICAL(&buzzerMux);
+  uint32_t dropped = buzzerDropped;
+  portEXIT_CRITICAL(&buzzerMux);
+  return dropped;
+}
+
+void tone(int pin, int frequency, int duration) {
+  BuzzerPattern pattern = {(uint16_t)frequency, (uint16_t)duration, 0, 1, BUZZER_PRIORITY_INFO};
+  Buzzer_play(pattern);
 }
 
 void noTone(int pin) {
-  ledcWrite(3, 0);
+  Buzzer_stop(BUZZER_PRIORITY_INFO);
 }
@@ -5,10 +5,37 @@
 
 // Definițiile pinilor și constantelor
 #define BUZZER_PIN 15
-#define BUZZER_THRESHOLD 50
+#define BUZZER_FAST_APPROACH_CMS 25.0f  // apropiere rapidă: bipurile se îndesesc
+#define BUZZER_LEDC_CHANNEL 3     // canal PWM atașat o singură dată, în Buzzer_init()
+#define BUZZER_QUEUE_LENGTH 4
+
+// Prioritățile clienților: o cerere cu prioritate mai mare sau egală o înlocuiește pe cea curentă
+enum BuzzerPriority {
+  BUZZER_PRIORITY_INFO = 0,       // bipuri de stare
+  BUZZER_PRIORITY_PROXIMITY = 1,  // avertizarea de obstacol din buzzerTask
+  BUZZER_PRIORITY_ALERT = 2       // frânare de urgență, accident
+};
+
+// Un model sonor: repeat x (ton onMs, pauză offMs)
+//  - repeat = 0: se repetă până la înlocuire sau Buzzer_stop()
+//  - onMs = 0: ton continuu
+//  - frequency = 0: liniște (oprește modelul curent)
+struct BuzzerPattern {
+  uint16_t frequency;
+  uint16_t onMs;
+  uint16_t offMs;
+  uint8_t repeat;
+  uint8_t priority;
+};
 
 // Funcții
 void Buzzer_init();
+bool Buzzer_play(const BuzzerPattern& pattern);
+bool Buzzer_stop(uint8_t priority);
+int Buzzer_getActivePriority();
+uint32_t Buzzer_getDroppedRequests();
+
+// Compatibilitate cu codul vechi; pinul este ignorat, buzzer-ul are un singur proprietar
 void tone(int pin, int frequency, int duration = 0);
 void noTone(int pin);
 
@@ -0,0 +1,61 @@
+#ifndef AEB_DECISION_H
+#define AEB_DECISION_H
+
+/**
+ * Decizia frânei automate (fără dependențe Arduino, reluată pe calculator de tools/recorder):
+ * timpul până la coliziune din estimarea filtrată a senzorului din sensul de mers și pragul
+ * dependent de viteză. Taskul din EmergencyBrake.cpp adaugă doar acțiunea și starea.
+ *
+ * Pragul: TTC < AEB_REACTION_S + v / (2 * AEB_DECEL_CMS2), adică timpul de reacție plus
+ * timpul de oprire la viteza curentă; sub AEB_MIN_DISTANCE_CM se frânează oricum.
+ *
+ * Distanța se estimează la următoarea citire a canalului (aebHorizonS): frâna se decide chiar
+ * la sosirea eșantionului, nu după ce extrapolarea unei măsurători vechi trece pragul.
+ */
+
+#include <math.h>
+#include "../sensors/RangeFilter.h"
+
+#define AEB_REACTION_S 0.05f            // marjă; întârzierea senzorilor este acoperită de aebHorizonS
+#define AEB_DECEL_CMS2 300.0f           // decelerarea sigură la frânare (de calibrat pe vehicul)
+#define AEB_MIN_CLOSING_CMS 5.0f        // sub această viteză de apropiere TTC este infinit
+#define AEB_MIN_DISTANCE_CM 15.0f       // frânare oricum, dacă ne deplasăm spre un obstacol atât de aproape
+#define AEB_RELEASE_CM 40.0f            // drumul este liber peste această distanță (sau fără ecou)
+#define AEB_RELEASE_MS 500              // ... de atâta timp
+
+struct AebAssessment {
+  float distanceCm;         // adusă la orizontul estimării
+  float closingCmS;
+  float ttcS;               // INFINITY sub AEB_MIN_CLOSING_CMS
+  bool brake;
+};
+
+// Pragul TTC pentru viteza de apropiere dată: reacție + timpul de oprire
+static inline float aebTtcThresholdS(float closingCmS) {
+  return AEB_REACTION_S + closingCmS / (2.0f * AEB_DECEL_CMS2);
+}
+
+// Orizontul estimării: până la următoarea citire a canalului, sau vârsta măsurătorii dacă a întârziat
+static inline float aebHorizonS(float ageS, float refreshS) {
+  return fmaxf(ageS, refreshS);
+}
+
+static inline bool aebPathClear(const RangeEstimate& r) {
+  return (r.flags & RANGE_NO_ECHO) || (r.valid() && r.distanceCm > AEB_RELEASE_CM);
+}
+
+/**
+ * r: estimarea validă a senzorului din sensul de mers; vehicleCmS: viteza roților (modul);
+ * horizonS: de la măsurătoare până la momentul estimat (aebHorizonS)
+ */
+static inline AebAssessment aebAssess(const RangeEstimate& r, float vehicleCmS, float horizonS) {
+  AebAssessment a;
+  // Apropierea: cea mai mare dintre viteza relativă măsurată și viteza roților
+  a.closingCmS = fmaxf(-r.rateCmS, vehicleCmS);
+  a.distanceCm = fmaxf(r.distanceCm - a.closingCmS * horizonS, 0.0f);
+  a.ttcS = a.closingCmS > AEB_MIN_CLOSING_CMS ? a.distanceCm / a.closingCmS : INFINITY;
+  a.brake = a.ttcS < aebTtcThresholdS(a.closingCmS) || a.distanceCm < AEB_MIN_DISTANCE_CM;
+  return a;
+}
+
+#endif
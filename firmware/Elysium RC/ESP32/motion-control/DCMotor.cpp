@@ -1,4 +1,6 @@
 #include "DCMotor.h"
+#include "SpeedController.h"
+#include "../../../shared/log/DeferredLog.h"
 
 // Definirea constantelor
 const int PIN_MOTOR_IN1 = 5;  // Control direcție
@@ -13,6 +15,13 @@ const int MOTOR_SPEED = 190;  // Viteza maximă (0-255)
 // Variabile de stare
 bool isMovingForward = false;
 bool isMovingBackward = false;
+static int currentDuty = 0;
+
+// Frâna de urgență: sensul blocat (+1 înainte, -1 înapoi, 0 liber) și un contor
+// incrementat la fiecare frânare, ca DCMotor_drive() să observe o frânare concurentă
+static portMUX_TYPE motorMux = portMUX_INITIALIZER_UNLOCKED;
+static volatile int blockedDirection = 0;
+static volatile uint32_t brakeGeneration = 0;
 
 void DCMotor_init() {
   Serial.println("\nInițializare Motor DC... ");
@@ -24,28 +33,83 @@ void DCMotor_init() {
 
 void DCMotor(bool forward, bool backward) {
 
+  // Factorul de umplere este urcat/coborât treptat de SpeedController
   if (forward && !backward) {
     // Mișcare înainte
-    digitalWrite(PIN_MOTOR_IN1, HIGH);
-    digitalWrite(PIN_MOTOR_IN2, LOW);
-    ledcWrite(PIN_MOTOR_ENA, MOTOR_SPEED);
-    Serial.println("DCMotor: Înainte");
+    SpeedController_setTarget(SPEED_CRUISE_COUNTS_PER_S);
+    LOG_INFO("DCMotor: Înainte");
   }
   else if (!forward && backward) {
     // Mișcare înapoi
-    digitalWrite(PIN_MOTOR_IN1, LOW);
-    digitalWrite(PIN_MOTOR_IN2, HIGH);
-    ledcWrite(PIN_MOTOR_ENA, MOTOR_SPEED);
-    Serial.println("DCMotor: Înapoi");
+    SpeedController_setTarget(-SPEED_CRUISE_COUNTS_PER_S);
+    LOG_INFO("DCMotor: Înapoi");
   }
   else {
     // Oprire
-    digitalWrite(PIN_MOTOR_IN1, LOW);
-    digitalWrite(PIN_MOTOR_IN2, LOW);
-    ledcWrite(PIN_MOTOR_ENA, 0);
-    Serial.println("DCMotor: Oprit");
+    SpeedController_setTarget(0);
+    LOG_INFO("DCMotor: Oprit");
   }
-  
-  isMovingForward = forward;
-  isMovingBackward = backward;
+}
+
+// Scrie puntea H: duty între -255 și 255, sau frână activă (ambele intrări sus, motorul în scurtcircuit)
+static void writeBridge(int duty, bool brake) {
+  if (brake) {
+    digitalWrite(PIN_MOTOR_IN1, HIGH);
+    digitalWrite(PIN_MOTOR_IN2, HIGH);
+    ledcWrite(PIN_MOTOR_ENA, 255);
+  } else {
+    digitalWrite(PIN_MOTOR_IN1, duty > 0 ? HIGH : LOW);
+    digitalWrite(PIN_MOTOR_IN2, duty < 0 ? HIGH : LOW);
+    ledcWrite(PIN_MOTOR_ENA, abs(duty));
+  }
+}
+
+// Ieșirea brută spre puntea H: duty între -255 (înapoi) și 255 (înainte), 0 = oprit
+// Fără mesaje pe Serial, deoarece este apelată la fiecare pas al buclei de viteză
+void DCMotor_drive(int duty) {
+  duty = constrain(duty, -255, 255);
+  currentDuty = duty;
+
+  while (true) {
+    uint32_t generation = brakeGeneration;
+    int blocked = blockedDirection;
+    // Cât timp frâna este activă, doar sensul opus obstacolului este permis
+    bool brake = blocked != 0 && duty * blocked >= 0;
+    writeBridge(duty, brake);
+    isMovingForward = !brake && duty > 0;
+    isMovingBackward = !brake && duty < 0;
+    // O frânare apărută în timpul scrierii ar fi fost suprascrisă: o aplicăm din nou
+    if (brakeGeneration == generation) break;
+  }
+}
+
+int DCMotor_getDuty() {
+  return currentDuty;
+}
+
+/**
+ * Frânare de urgență, apelabilă din orice task: pune puntea H în frână imediat și blochează
+ * sensul blockedDirection (+1 înainte, -1 înapoi) până la DCMotor_release()
+ */
+void DCMotor_brake(int blockedDirection_) {
+  portENTER_CRITICAL(&motorMux);
+  blockedDirection = blockedDirection_ > 0 ? 1 : -1;
+  brakeGeneration++;
+  portEXIT_CRITICAL(&motorMux);
+
+  writeBridge(0, true);
+  isMovingForward = false;
+  isMovingBackward = false;
+}
+
+// Ridică blocajul; ieșirea revine la următorul pas al buclei de viteză
+void DCMotor_release() {
+  portENTER_CRITICAL(&motorMux);
+  blockedDirection = 0;
+  brakeGeneration++;
+  portEXIT_CRITICAL(&motorMux);
+}
+
+int DCMotor_getBlockedDirection() {
+  return blockedDirection;
 }
@@ -19,5 +19,10 @@ extern bool isMovingBackward;
 // Funcții
 void DCMotor_init();
 void DCMotor(bool forward, bool backward);
+void DCMotor_drive(int duty);
+int DCMotor_getDuty();
+void DCMotor_brake(int blockedDirection);
+void DCMotor_release();
+int DCMotor_getBlockedDirection();
 
 #endif
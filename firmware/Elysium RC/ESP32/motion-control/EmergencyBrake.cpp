@@ -0,0 +1,143 @@
+#include "EmergencyBrake.h"
+#include "DCMotor.h"
+#include "SpeedController.h"
+#include "../core/Pipeline.h"
+#include "../core/TaskMonitor.h"
+#include "../navigation/Navigation.h"
+#include "../feedback/BuzzerManager.h"
+#include "../../../shared/log/DeferredLog.h"
+
+static int brakeSubscriber = -1;
+static volatile bool brakeOverridden = false;
+
+// Scrise doar de taskul AEB, citite prin EmergencyBrake_getStatus()
+static portMUX_TYPE brakeMux = portMUX_INITIALIZER_UNLOCKED;
+static EmergencyBrakeStatus brakeStatus = { false, false, -1, 0, 0, 0, 0, 0, 0, 0 };
+
+// Sensul de mers: comanda punții H, iar dacă motorul nu trage, semnul vitezei din encoder
+static int travelDirection(const NavPose& pose) {
+  if (isMovingForward) return 1;
+  if (isMovingBackward) return -1;
+  if (pose.speed > 0.05f) return 1;
+  if (pose.speed < -0.05f) return -1;
+  return 0;
+}
+
+static void engage(int direction, int sensor, float distance, float closing, float ttc,
+                   const PerceptionFrame& frame) {
+  DCMotor_brake(direction);
+  // De la captura canalului care a declanșat frâna: frame.acquiredUs este cea mai nouă captură
+  // de pe orice canal și ar ascunde vârsta eșantionului decisiv
+  uint32_t latency = micros() - frame.ultrasonic.timestampUs[sensor];
+
+  // Ținta șoferului se anulează: după eliberare vehiculul nu pornește singur
+  SpeedController_setTarget(0);
+  BuzzerPattern alarm = {2000, 80, 40, 4, BUZZER_PRIORITY_ALERT};
+  Buzzer_play(alarm);
+
+  portENTER_CRITICAL(&brakeMux);
+  brakeStatus.engaged = true;
+  brakeStatus.sensor = sensor;
+  brakeStatus.distanceCm = distance;
+  brakeStatus.closingCmS = closing;
+  brakeStatus.ttcS = ttc;
+  brakeStatus.interventions++;
+  brakeStatus.lastLatencyUs = latency;
+  if (latency > brakeStatus.maxLatencyUs) brakeStatus.maxLatencyUs = latency;
+  if (latency > AEB_LATENCY_TARGET_US) brakeStatus.latencyMisses++;
+  portEXIT_CRITICAL(&brakeMux);
+
+  LOG_WARN("AEB: frână %s, %.0f cm, apropiere %.0f cm/s, TTC %.2f s, latență %lu us",
+           direction > 0 ? "înainte" : "înapoi", distance, closing, ttc, (unsigned long)latency);
+}
+
+static void release(const char* reason) {
+  DCMotor_release();
+  portENTER_CRITICAL(&brakeMux);
+  brakeStatus.engaged = false;
+  portEXIT_CRITICAL(&brakeMux);
+  LOG_INFO("AEB: frână eliberată (%s)", reason);
+}
+
+static void emergencyBrakeTask(void* parameter) {
+  PerceptionFrame frame;
+  unsigned long clearSinceMs = 0;
+  bool clearing = false;
+  int monitorId = TaskMonitor_register("AEB", 0, 1000);
+
+  while (true) {
+    if (!Pipeline_wait(brakeSubscriber, frame)) continue;
+    TaskMonitor_begin(monitorId);
+
+    int blocked = DCMotor_getBlockedDirection();
+    if (brakeOverridden) {
+      if (blocked != 0) release("override");
+    } else {
+      if (blocked != 0) {
+        // Eliberăm doar după ce drumul din sensul blocat rămâne liber AEB_RELEASE_MS
+        int sensor = blocked > 0 ? SENSOR_FRONT : SENSOR_BACK;
+        if (!aebPathClear(frame.range[sensor])) {
+          clearing = false;
+        } else if (!clearing) {
+          clearing = true;
+          clearSinceMs = millis();
+        } else if (millis() - clearSinceMs >= AEB_RELEASE_MS) {
+          clearing = false;
+          release("drum liber");
+        }
+      }
+
+      // Sensul opus blocajului rămâne permis, deci și el are nevoie de frână
+      NavPose pose = Navigation_getPose();
+      int direction = travelDirection(pose);
+      int sensor = direction > 0 ? SENSOR_FRONT : SENSOR_BACK;
+      const RangeEstimate& r = frame.range[sensor];
+
+      if (direction != 0 && direction != blocked && r.valid()) {
+        // Distanța adusă la următoarea citire a canalului: decizia se ia la sosirea eșantionului
+        float age = (float)(uint32_t)(micros() - r.updatedUs) * 1e-6f;
+        AebAssessment a = aebAssess(r, fabsf(pose.speed) * 100.0f, aebHorizonS(age, AEB_REFRESH_S));
+        if (a.brake) {
+          clearing = false;
+          engage(direction, sensor, a.distanceCm, a.closingCmS, a.ttcS, frame);
+        }
+      }
+    }
+
+    Pipeline_markReaction(brakeSubscriber, frame);
+    TaskMonitor_end(monitorId);
+  }
+
+  vTaskDelete(NULL);
+}
+
+// Trebuie apelată înainte de Tasks_init(): primul consumator primește primul cadrul
+void EmergencyBrake_init() {
+  Serial.println("\nPornire frânare automată de urgență...");
+  brakeSubscriber = Pipeline_subscribe("AEB");
+  xTaskCreatePinnedToCore(emergencyBrakeTask, "AEB", 3072, NULL,
+                          AEB_PRIORITY, NULL, PIPELINE_CORE);
+}
+
+void EmergencyBrake_setOverride(bool overridden) {
+  brakeOverridden = overridden;
+  portENTER_CRITICAL(&brakeMux);
+  brakeStatus.overridden = overridden;
+  portEXIT_CRITICAL(&brakeMux);
+  if (overridden) {
+    LOG_WARN("AEB: dezactivată de utilizator");
+  } else {
+    LOG_INFO("AEB: activă");
+  }
+}
+
+bool EmergencyBrake_isOverridden() {
+  return brakeOverridden;
+}
+
+EmergencyBrakeStatus EmergencyBrake_getStatus() {
+  portENTER_CRITICAL(&brakeMux);
+  EmergencyBrakeStatus copy = brakeStatus;
+  portEXIT_CRITICAL(&brakeMux);
+  return copy;
+}
@@ -0,0 +1,47 @@
+#ifndef EMERGENCY_BRAKE_H
+#define EMERGENCY_BRAKE_H
+
+#include <Arduino.h>
+#include "AebDecision.h"
+#include "../sensors/UltrasonicSensors.h"
+
+/**
+ * Frânarea automată de urgență (AEB), un consumator al pipeline-ului de senzori.
+ *
+ * La fiecare cadru fuzionat se calculează timpul până la coliziune (TTC) din distanța filtrată
+ * și viteza de apropiere a senzorului din sensul de mers (față la înainte, spate la înapoi).
+ * Dacă TTC scade sub pragul dependent de viteză, taskul pune direct puntea H în frână
+ * (DCMotor_brake), fără să treacă prin loop() sau prin bucla de viteză, și blochează sensul
+ * spre obstacol până când drumul se eliberează. Latența captură ecou -> frână este măsurată.
+ *
+ * Decizia (TTC și pragul dependent de viteză) este în AebDecision.h.
+ *
+ * Override: comanda 'O' (sau CMD_AEB cu argument 0) dezactivează frâna automată,
+ * comanda 'A' (CMD_AEB cu argument 1) o reactivează.
+ */
+
+#define AEB_PRIORITY 6                  // peste achiziție și fuziune: reacția nu așteaptă alte taskuri
+#define AEB_LATENCY_TARGET_US 5000      // ținta captură -> frână; depășirile sunt numărate
+// Un canal se citește din nou după ce au fost declanșați toți ceilalți senzori
+#define AEB_REFRESH_S (ULTRASONIC_SENSOR_COUNT * ULTRASONIC_INTERVAL_MS * 1e-3f)
+
+struct EmergencyBrakeStatus {
+  bool overridden;          // frâna automată dezactivată de utilizator
+  bool engaged;             // un sens este blocat acum
+  int sensor;               // UltrasonicSensorId care a declanșat ultima intervenție, -1 niciuna
+  float distanceCm;         // la ultima intervenție
+  float closingCmS;
+  float ttcS;
+  uint32_t interventions;
+  uint32_t lastLatencyUs;   // captură ecou -> frână, la ultima intervenție
+  uint32_t maxLatencyUs;
+  uint32_t latencyMisses;   // intervenții peste AEB_LATENCY_TARGET_US
+};
+
+// Funcții
+void EmergencyBrake_init();
+void EmergencyBrake_setOverride(bool overridden);
+bool EmergencyBrake_isOverridden();
+EmergencyBrakeStatus EmergencyBrake_getStatus();
+
+#endif
@@ -1,9 +1,62 @@
 #include "ServoMotor.h"
+#include "esp_timer.h"
+#include "../../../shared/log/DeferredLog.h"
 
 // Definirea constantelor
 
-int currentServoAngle = CENTER;
+volatile int currentServoAngle = CENTER;
 
+// Ținta și limitele curente; scrise de apelanți, citite de timer
+static portMUX_TYPE servoMux = portMUX_INITIALIZER_UNLOCKED;
+static int servoTargetAngle = CENTER;
+static float servoTargetRate = SERVO_DEFAULT_RATE;
+static float servoTargetAccel = SERVO_DEFAULT_ACCEL;
+
+// Starea profilului, folosită doar din callback-ul timerului
+static float servoProfileAngle = CENTER;
+static float servoProfileVelocity = 0;
+static volatile bool servoMoving = false;
+
+static esp_timer_handle_t servoTimer = NULL;
+
+// Un pas al profilului trapezoidal: accelerează până la viteza maximă,
+// apoi frânează astfel încât să se oprească exact pe țintă (v^2 = 2·a·d)
+static void servoTick(void* arg) {
+  portENTER_CRITICAL(&servoMux);
+  float target = servoTargetAngle;
+  float rate = servoTargetRate;
+  float accel = servoTargetAccel;
+  portEXIT_CRITICAL(&servoMux);
+
+  const float dt = SERVO_TICK_MS / 1000.0f;
+  float error = target - servoProfileAngle;
+
+  if (rate <= 0 || accel <= 0) {
+    // Fără limite: salt direct la țintă
+    servoProfileAngle = target;
+    servoProfileVelocity = 0;
+  } else if (error != 0 || servoProfileVelocity != 0) {
+    float direction = (error > 0) ? 1.0f : -1.0f;
+    float desired = direction * fminf(rate, sqrtf(2.0f * accel * fabsf(error)));
+    float dv = constrain(desired - servoProfileVelocity, -accel * dt, accel * dt);
+    servoProfileVelocity += dv;
+
+    float step = servoProfileVelocity * dt;
+    if ((error >= 0 && step >= error) || (error <= 0 && step <= error)) {
+      servoProfileAngle = target;
+      servoProfileVelocity = 0;
+    } else {
+      servoProfileAngle += step;
+    }
+  }
+
+  int angle = lroundf(servoProfileAngle);
+  if (angle != currentServoAngle) {
+    currentServoAngle = angle;
+    servo.write(angle);
+  }
+  servoMoving = (servoProfileAngle != target);
+}
 
 void ServoMotor_init() {
 
@@ -12,23 +65,53 @@ void ServoMotor_init() {
   Serial.println("Setare poziție inițială la centru... ");
   currentServoAngle = CENTER;
   servo.write(currentServoAngle);
+
+  esp_timer_create_args_t timerArgs = {};
+  timerArgs.callback = servoTick;
+  timerArgs.name = "servo";
+  esp_timer_create(&timerArgs, &servoTimer);
+  esp_timer_start_periodic(servoTimer, SERVO_TICK_MS * 1000);
   delay(1000);
 }
 
+/**
+ * Stabilește o nouă țintă și revine imediat; mișcarea este executată de timer.
+ * O țintă nouă înlocuiește mișcarea în curs, pornind de la poziția și viteza actuale.
+ */
+void ServoMotor_moveTo(int position, float maxRate, float accel) {
+  position = constrain(position, LEFT, RIGHT);
+
+  portENTER_CRITICAL(&servoMux);
+  servoTargetAngle = position;
+  servoTargetRate = maxRate;
+  servoTargetAccel = accel;
+  portEXIT_CRITICAL(&servoMux);
+  servoMoving = true;
+}
+
 void ServoMotor(int position) {
 
-  Serial.print("Mișcare de la ");
-  Serial.print(currentServoAngle);
-  Serial.print(" la ");
-  Serial.println(position);
-  
-  // Determinăm direcția de mișcare
-  int step = (position > currentServoAngle) ? 1 : -1;
+  LOG_INFO("Mișcare de la %d la %d", (int)currentServoAngle, position);
   
-  // Mișcăm gradual servo-ul
-  while (currentServoAngle != position) {
-    currentServoAngle += step;
-    servo.write(currentServoAngle);
-    delay(15);
-  }
+  ServoMotor_moveTo(position);
+}
+
+// Setare directă, fără profil (pentru comenzile continue, care vin deja gradual)
+void ServoMotor_set(int position) {
+  ServoMotor_moveTo(position, 0, 0);
+}
+
+int ServoMotor_getCurrentAngle() {
+  return currentServoAngle;
+}
+
+int ServoMotor_getTargetAngle() {
+  portENTER_CRITICAL(&servoMux);
+  int target = servoTargetAngle;
+  portEXIT_CRITICAL(&servoMux);
+  return target;
+}
+
+bool ServoMotor_isMoving() {
+  return servoMoving;
 }
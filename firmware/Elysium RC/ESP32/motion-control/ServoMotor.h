@@ -10,14 +10,24 @@
 #define RIGHT 80
 #define SERVO_PIN 22
 
+// Profilul de mișcare, executat în fundal de un timer periodic
+#define SERVO_TICK_MS 5                // perioada timerului de profil
+#define SERVO_DEFAULT_RATE 67.0f       // grade/s (echivalentul vechiului pas de 1 grad la 15 ms)
+#define SERVO_DEFAULT_ACCEL 600.0f     // grade/s^2
+
 
 extern Servo servo;
-extern int currentServoAngle;
+extern volatile int currentServoAngle;
 
 
 // Funcții
 void ServoMotor_init();
 void ServoMotor(int position);
+void ServoMotor_set(int position);
+void ServoMotor_moveTo(int position, float maxRate = SERVO_DEFAULT_RATE, float accel = SERVO_DEFAULT_ACCEL);
+int ServoMotor_getCurrentAngle();
+int ServoMotor_getTargetAngle();
+bool ServoMotor_isMoving();
 
 
 #endif
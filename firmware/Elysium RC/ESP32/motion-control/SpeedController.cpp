@@ -0,0 +1,196 @@
+#include "SpeedController.h"
+#include "DCMotor.h"
+#include "esp_timer.h"
+
+static portMUX_TYPE speedMux = portMUX_INITIALIZER_UNLOCKED;
+
+static SpeedControllerConfig speedConfig = { 0.05f, 0.4f, SPEED_ACCEL_LIMIT, SPEED_DECEL_LIMIT };
+static SpeedControllerStats speedStats = {};
+static double speedAbsErrorSum = 0;
+static uint32_t speedClosedLoopTicks = 0;
+
+// Scrise de taskul legăturii cu Arduino, citite de timer (protejate de speedMux)
+static float targetSpeed = 0;
+static float speedLimit = SPEED_MAX_COUNTS_PER_S;  // limita zonei curente de pe traseu
+static float measuredSpeed = 0;
+static unsigned long lastEncoderSampleMs = 0;
+static bool haveEncoderFeedback = false;
+
+// Starea buclei, folosită doar din timer
+static float speedSetpoint = 0;
+static float speedIntegral = 0;
+static int speedDuty = 0;
+static int speedBlocked = 0;           // sensul blocat de frâna de urgență la pasul anterior
+static esp_timer_handle_t speedTimer = NULL;
+
+// Estimarea vitezei din impulsurile encoderului
+static long lastEncoderCount = 0;
+static uint32_t lastEncoderTimeUs = 0;
+static bool haveEncoderCount = false;
+
+static void speedControlTick(void* arg) {
+  const float dt = SPEED_CONTROL_PERIOD_MS / 1000.0f;
+  unsigned long now = millis();
+
+  portENTER_CRITICAL(&speedMux);
+  float target = constrain(targetSpeed, -speedLimit, speedLimit);
+  float measured = measuredSpeed;
+  bool feedback = haveEncoderFeedback && (now - lastEncoderSampleMs < SPEED_FEEDBACK_TIMEOUT_MS);
+  SpeedControllerConfig cfg = speedConfig;
+  portEXIT_CRITICAL(&speedMux);
+
+  // Frâna de urgență blochează sensul spre obstacol: o țintă în acel sens devine 0,
+  // altfel integratorul s-ar încărca și vehiculul ar sări înainte la eliberare
+  int blocked = DCMotor_getBlockedDirection();
+  if ((blocked > 0 && target > 0) || (blocked < 0 && target < 0)) target = 0;
+
+  // Rampa: apropierea de zero (frânare) folosește limita de decelerare
+  float delta = target - speedSetpoint;
+  bool braking = (speedSetpoint > 0 && delta < 0) || (speedSetpoint < 0 && delta > 0);
+  float maxStep = (braking ? cfg.decelLimit : cfg.accelLimit) * dt;
+  speedSetpoint += constrain(delta, -maxStep, maxStep);
+
+  // Comandă anticipativă + PI pe viteza măsurată
+  const float feedForward = 255.0f / SPEED_MAX_COUNTS_PER_S;
+  float error = feedback ? speedSetpoint - measured : 0;
+  float output = speedSetpoint * feedForward + cfg.kp * error + cfg.ki * speedIntegral;
+
+  bool saturated = output > 255.0f || output < -255.0f;
+  // Anti-windup: integrăm doar când ieșirea nu este saturată
+  if (feedback && !saturated) {
+    speedIntegral += error * dt;
+  }
+  if (speedSetpoint == 0 && target == 0) {
+    speedIntegral = 0;
+  }
+
+  int wanted = constrain((int)lroundf(output), -255, 255);
+  if (speedSetpoint == 0 && target == 0) wanted = 0;
+  int next = constrain(wanted, speedDuty - SPEED_DUTY_SLEW_PER_TICK, speedDuty + SPEED_DUTY_SLEW_PER_TICK);
+  // La ridicarea frânei puntea H rămâne în frână până la prima scriere: o forțăm
+  if (next != speedDuty || blocked != speedBlocked) {
+    speedDuty = next;
+    speedBlocked = blocked;
+    DCMotor_drive(speedDuty);
+  }
+
+  portENTER_CRITICAL(&speedMux);
+  speedStats.target = target;
+  speedStats.setpoint = speedSetpoint;
+  speedStats.measured = measured;
+  speedStats.error = error;
+  speedStats.duty = speedDuty;
+  speedStats.ticks++;
+  if (saturated) speedStats.saturatedTicks++;
+  if (feedback) {
+    float absError = fabsf(error);
+    if (absError > speedStats.maxAbsError) speedStats.maxAbsError = absError;
+    speedAbsErrorSum += absError;
+    speedClosedLoopTicks++;
+    speedStats.meanAbsError = speedAbsErrorSum / speedClosedLoopTicks;
+  } else {
+    speedStats.openLoopTicks++;
+  }
+  portEXIT_CRITICAL(&speedMux);
+}
+
+void SpeedController_init() {
+  Serial.println("\nPornire control viteză (100 Hz)...");
+  esp_timer_create_args_t timerArgs = {};
+  timerArgs.callback = speedControlTick;
+  timerArgs.name = "speed";
+  esp_timer_create(&timerArgs, &speedTimer);
+  esp_timer_start_periodic(speedTimer, SPEED_CONTROL_PERIOD_MS * 1000);
+}
+
+/**
+ * Viteza dorită a roții, în impulsuri de encoder pe secundă (negativ = înapoi).
+ * Factorul de umplere urcă spre valoarea necesară cu limitele de accelerație configurate.
+ */
+void SpeedController_setTarget(float countsPerSecond) {
+  countsPerSecond = constrain(countsPerSecond, -SPEED_MAX_COUNTS_PER_S, SPEED_MAX_COUNTS_PER_S);
+  portENTER_CRITICAL(&speedMux);
+  targetSpeed = countsPerSecond;
+  portEXIT_CRITICAL(&speedMux);
+}
+
+/**
+ * Viteza maximă, indiferent de țintă (ex. limita zonei de pe harta traseului); se aplică în ambele sensuri
+ */
+void SpeedController_setLimit(float countsPerSecond) {
+  countsPerSecond = constrain(countsPerSecond, 0.0f, SPEED_MAX_COUNTS_PER_S);
+  portENTER_CRITICAL(&speedMux);
+  speedLimit = countsPerSecond;
+  portEXIT_CRITICAL(&speedMux);
+}
+
+/**
+ * Poziția encoderului primită de la Arduino, cu momentul eșantionării și al ultimului
+ * front (ceasul Arduino, µs) și perioada medie a unui front (semnul dă sensul, 0 = necunoscută)
+ */
+void SpeedController_onEncoderSample(long count, uint32_t sampleTimeUs,
+                                     uint32_t lastEdgeUs, int32_t edgePeriodUs) {
+  unsigned long now = millis();
+  if (!haveEncoderCount) {
+    lastEncoderCount = count;
+    lastEncoderTimeUs = sampleTimeUs;
+    haveEncoderCount = true;
+    portENTER_CRITICAL(&speedMux);
+    lastEncoderSampleMs = now;
+    portEXIT_CRITICAL(&speedMux);
+    return;
+  }
+
+  // Contorul Arduino este pe 32 de biți, nu mai trece prin zero în timpul unei rulări
+  long delta = count - lastEncoderCount;
+  uint32_t dtUs = sampleTimeUs - lastEncoderTimeUs;
+  lastEncoderCount = count;
+  lastEncoderTimeUs = sampleTimeUs;
+  if (dtUs == 0) return;
+
+  float instant = delta * 1000000.0f / dtUs;
+  if (labs(delta) < SPEED_PERIOD_MAX_COUNTS && edgePeriodUs != 0) {
+    // Turație mică: puține impulsuri pe eșantion, viteza din perioada fronturilor e mai precisă.
+    // Dacă următorul front întârzie, perioada reală este cel puțin timpul scurs de la ultimul.
+    uint32_t sinceEdgeUs = sampleTimeUs - lastEdgeUs;
+    uint32_t periodUs = (uint32_t)labs(edgePeriodUs);
+    if (sinceEdgeUs > periodUs) periodUs = sinceEdgeUs;
+    if (sinceEdgeUs > SPEED_EDGE_TIMEOUT_US) {
+      instant = 0;
+    } else {
+      instant = (edgePeriodUs > 0 ? 1000000.0f : -1000000.0f) / periodUs;
+    }
+  }
+
+  portENTER_CRITICAL(&speedMux);
+  // filtru exponențial simplu, pentru zgomotul de cuantizare
+  measuredSpeed = haveEncoderFeedback ? 0.5f * measuredSpeed + 0.5f * instant : instant;
+  haveEncoderFeedback = true;
+  lastEncoderSampleMs = now;
+  portEXIT_CRITICAL(&speedMux);
+}
+
+void SpeedController_setConfig(const SpeedControllerConfig& newConfig) {
+  portENTER_CRITICAL(&speedMux);
+  speedConfig = newConfig;
+  portEXIT_CRITICAL(&speedMux);
+}
+
+SpeedControllerStats SpeedController_getStats() {
+  portENTER_CRITICAL(&speedMux);
+  SpeedControllerStats copy = speedStats;
+  portEXIT_CRITICAL(&speedMux);
+  return copy;
+}
+
+void SpeedController_resetStats() {
+  portENTER_CRITICAL(&speedMux);
+  speedStats.maxAbsError = 0;
+  speedStats.meanAbsError = 0;
+  speedStats.ticks = 0;
+  speedStats.saturatedTicks = 0;
+  speedStats.openLoopTicks = 0;
+  speedAbsErrorSum = 0;
+  speedClosedLoopTicks = 0;
+  portEXIT_CRITICAL(&speedMux);
+}
@@ -0,0 +1,50 @@
+#ifndef SPEED_CONTROLLER_H
+#define SPEED_CONTROLLER_H
+
+#include <Arduino.h>
+#include "DCMotor.h"
+
+// Bucla de viteză rulează la rată fixă dintr-un timer periodic
+#define SPEED_CONTROL_PERIOD_MS 10           // 100 Hz
+#define SPEED_MAX_COUNTS_PER_S 2000.0f       // viteza la factor de umplere 255 (de calibrat pe vehicul)
+#define SPEED_ACCEL_LIMIT 2500.0f            // impulsuri/s^2 la accelerare
+#define SPEED_DECEL_LIMIT 5000.0f            // impulsuri/s^2 la frânare
+#define SPEED_DUTY_SLEW_PER_TICK 8           // variația maximă a factorului de umplere într-un pas
+#define SPEED_FEEDBACK_TIMEOUT_MS 300        // fără impulsuri noi -> doar comandă în buclă deschisă
+#define SPEED_PERIOD_MAX_COUNTS 4            // sub atâtea impulsuri pe eșantion viteza vine din perioada fronturilor
+#define SPEED_EDGE_TIMEOUT_US 200000UL       // fără fronturi de atâta timp -> roata este oprită
+
+// Viteza de croazieră pentru comenzile F/B, echivalentă cu vechiul MOTOR_SPEED în buclă deschisă
+#define SPEED_CRUISE_COUNTS_PER_S (SPEED_MAX_COUNTS_PER_S * MOTOR_SPEED / 255.0f)
+
+struct SpeedControllerConfig {
+  float kp;            // factor de umplere per impuls/s de eroare
+  float ki;            // factor de umplere per impuls de eroare integrată
+  float accelLimit;    // impulsuri/s^2
+  float decelLimit;    // impulsuri/s^2
+};
+
+struct SpeedControllerStats {
+  float target;            // impulsuri/s cerute
+  float setpoint;          // ținta după rampă
+  float measured;          // viteza măsurată din encoder
+  float error;             // setpoint - measured
+  float maxAbsError;       // cea mai mare eroare de urmărire
+  float meanAbsError;      // media erorii absolute (doar cu feedback valid)
+  int duty;                // ultimul factor de umplere aplicat (-255..255)
+  uint32_t ticks;          // pași de control executați
+  uint32_t saturatedTicks; // pași în care ieșirea a fost limitată la 255
+  uint32_t openLoopTicks;  // pași fără feedback de la encoder
+};
+
+// Funcții
+void SpeedController_init();
+void SpeedController_setTarget(float countsPerSecond);
+void SpeedController_setLimit(float countsPerSecond);
+void SpeedController_onEncoderSample(long count, uint32_t sampleTimeUs,
+                                     uint32_t lastEdgeUs, int32_t edgePeriodUs);
+void SpeedController_setConfig(const SpeedControllerConfig& config);
+SpeedControllerStats SpeedController_getStats();
+void SpeedController_resetStats();
+
+#endif
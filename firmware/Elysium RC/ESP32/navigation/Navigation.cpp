@@ -0,0 +1,238 @@
+#include "Navigation.h"
+#include "TrackMapData.h"
+#include <Preferences.h>
+#include "../core/Pipeline.h"
+#include "../core/SeqLock.h"
+#include "../core/TaskMonitor.h"
+#include "../sensors/ArduinoLink.h"
+#include "../motion-control/ServoMotor.h"
+#include "../motion-control/SpeedController.h"
+#include "../../../shared/log/DeferredLog.h"
+#include "../../../shared/heap/HeapGuard.h"
+
+// Starea estimatorului, folosită doar din taskul de navigație
+static PoseEstimator poseEstimator(NAV_WHEELBASE_M, NAV_COMPASS_GAIN);
+static CompassCalibrator compassCalibrator;
+static CompassCalibration compassCalibration;
+static unsigned long calibrationStartMs = 0;
+
+// Publicate pentru celelalte module
+static SeqLock<NavPose> poseSnapshot;
+static SeqLock<NavigationStatus> statusSnapshot;
+
+// Cereri din alte taskuri, aplicate la începutul pasului următor
+static portMUX_TYPE navMux = portMUX_INITIALIZER_UNLOCKED;
+static bool poseRequested = false;
+static bool headingRequested = false;
+static float requestedPose[3];
+static volatile bool calibrationRequested = false;
+static volatile bool calibrationCancelRequested = false;
+static bool calibrating = false;
+
+static Preferences navPrefs;
+
+static void loadCalibration() {
+  compassCalibrationDefault(compassCalibration);
+  navPrefs.begin("compass", true);
+  CompassCalibration stored;
+  if (navPrefs.getBytes("cal", &stored, sizeof(stored)) == sizeof(stored) &&
+      stored.version == NAV_CAL_VERSION && stored.valid) {
+    compassCalibration = stored;
+  }
+  navPrefs.end();
+}
+
+// Din taskul de navigație, păzit de HeapGuard: nvs_open și scrierea alocă
+static void saveCalibration() {
+  HeapGuardAllow allow;
+  navPrefs.begin("compass", false);
+  navPrefs.putBytes("cal", &compassCalibration, sizeof(compassCalibration));
+  navPrefs.end();
+}
+
+// Unghiul roților din poziția servomotorului (pozitiv = stânga)
+static float steeringAngleRad() {
+  int angle = currentServoAngle;
+  if (angle <= CENTER) return NAV_STEER_MAX_RAD * (CENTER - angle) / (float)(CENTER - LEFT);
+  return -NAV_STEER_MAX_RAD * (angle - CENTER) / (float)(RIGHT - CENTER);
+}
+
+static void stopCalibration() {
+  calibrating = false;
+  SpeedController_setTarget(0);
+  ServoMotor_set(CENTER);
+}
+
+static void calibrationStep(const ArduinoSample& sample, bool fresh) {
+  if (calibrationCancelRequested) {
+    calibrationCancelRequested = false;
+    if (calibrating) {
+      stopCalibration();
+      LOG_WARN("Busolă: calibrare anulată");
+    }
+  }
+
+  if (calibrationRequested) {
+    calibrationRequested = false;
+    compassCalibrator.reset();
+    calibrationStartMs = millis();
+    calibrating = true;
+    // Cerc încet cu direcția la maxim: busola vede toate orientările
+    ServoMotor_set(LEFT);
+    SpeedController_setTarget(NAV_CAL_SPEED_COUNTS_PER_S);
+    LOG_INFO("Busolă: calibrare pornită");
+  }
+
+  if (!calibrating) return;
+  if (fresh) compassCalibrator.add(sample.compass[0], sample.compass[1]);
+
+  if (compassCalibrator.complete()) {
+    stopCalibration();
+    CompassCalibration result;
+    compassCalibrator.compute(result);
+    compassCalibration = result;
+    saveCalibration();
+    LOG_INFO("Busolă: calibrată, offset %.1f %.1f, scală %.3f %.3f",
+             result.offsetX, result.offsetY, result.scaleX, result.scaleY);
+  } else if (millis() - calibrationStartMs > NAV_CAL_TIMEOUT_MS) {
+    stopCalibration();
+    LOG_WARN("Busolă: calibrare eșuată (%d/%d direcții, %lu eșantioane)",
+             compassCalibrator.coverage(), NAV_CAL_SECTORS, (unsigned long)compassCalibrator.samples());
+  }
+}
+
+static void applyRequests() {
+  portENTER_CRITICAL(&navMux);
+  bool pose = poseRequested;
+  bool heading = headingRequested;
+  float x = requestedPose[0], y = requestedPose[1], theta = requestedPose[2];
+  poseRequested = false;
+  headingRequested = false;
+  portEXIT_CRITICAL(&navMux);
+
+  if (pose) poseEstimator.setPosition(x, y);
+  if (heading) poseEstimator.setHeading(theta);
+}
+
+static void publishStatus() {
+  NavigationStatus status;
+  status.calibrated = compassCalibration.valid;
+  status.calibrating = calibrating;
+  status.calibrationCoverage = compassCalibrator.coverage();
+  status.calibration = compassCalibration;
+  statusSnapshot.write(status);
+}
+
+// Pas fix: distanța din encoder, orientarea din direcție + busolă
+static void navigationTask(void* parameter) {
+  int monitorId = TaskMonitor_register("Navigation", NAV_PERIOD_MS * 1000, NAV_PERIOD_MS * 1000);
+  TickType_t lastWake = xTaskGetTickCount();
+  unsigned long lastUs = micros();
+  int32_t lastEncoder = 0;
+  bool haveEncoder = false;
+  uint16_t lastSequence = 0;
+
+  while (true) {
+    vTaskDelayUntil(&lastWake, pdMS_TO_TICKS(NAV_PERIOD_MS));
+    TaskMonitor_begin(monitorId);
+    unsigned long now = micros();
+    float dt = (now - lastUs) / 1000000.0f;
+    lastUs = now;
+
+    applyRequests();
+
+    ArduinoSample sample = ArduinoLink_getSample();
+    bool fresh = sample.valid && ArduinoLink_isAlive() && sample.sequence != lastSequence;
+    lastSequence = sample.sequence;
+
+    float ds = 0;
+    if (sample.valid) {
+      if (haveEncoder) ds = (sample.encoder - lastEncoder) / NAV_COUNTS_PER_METER;
+      lastEncoder = sample.encoder;
+      haveEncoder = true;
+    }
+
+    calibrationStep(sample, fresh);
+
+    // În timpul calibrării coeficienții vechi pot fi greșiți: doar integrăm direcția
+    bool compassValid = fresh && compassCalibration.valid && !calibrating;
+    float compassRad = compassValid
+        ? compassHeading(compassCalibration, sample.compass[0], sample.compass[1],
+                         NAV_COMPASS_SIGN, NAV_COMPASS_MOUNT_RAD)
+        : 0;
+    poseEstimator.update(ds, dt, steeringAngleRad(), compassRad, compassValid, now);
+
+    poseSnapshot.write(poseEstimator.pose());
+    publishStatus();
+    TaskMonitor_end(monitorId);
+  }
+
+  vTaskDelete(NULL);
+}
+
+void Navigation_init() {
+  Serial.println("\nPornire navigație (busolă + odometrie)...");
+  loadCalibration();
+  if (!compassCalibration.valid) {
+    Serial.println("Busola nu este calibrată: trimiteți comanda 'C'");
+  }
+  publishStatus();
+  xTaskCreatePinnedToCore(navigationTask, "Navigation", 3072, NULL,
+                          NAV_PRIORITY, NULL, PIPELINE_CORE);
+}
+
+NavPose Navigation_getPose() {
+  return poseSnapshot.read();
+}
+
+/**
+ * Poziție și orientare absolute (ex. un punct de referință de pe traseu); se aplică la pasul următor
+ */
+void Navigation_setPose(float x, float y, float theta) {
+  portENTER_CRITICAL(&navMux);
+  requestedPose[0] = x;
+  requestedPose[1] = y;
+  requestedPose[2] = theta;
+  poseRequested = true;
+  headingRequested = true;
+  portEXIT_CRITICAL(&navMux);
+}
+
+void Navigation_setPosition(float x, float y) {
+  portENTER_CRITICAL(&navMux);
+  requestedPose[0] = x;
+  requestedPose[1] = y;
+  poseRequested = true;
+  portEXIT_CRITICAL(&navMux);
+}
+
+/**
+ * Un tag RFID tocmai a intrat în câmpul cititorului. Dacă este pe harta traseului, poziția
+ * estimată sare la poziția tagului și se aplică limita de viteză a zonei care începe acolo.
+ * Întoarce tagul de pe hartă, NULL pentru un tag necunoscut (o căutare O(1), fără alocări).
+ */
+const TrackTag* Navigation_onTrackTag(const RfidEpc& epc) {
+  const TrackTag* tag = trackMapFind(epc);
+  if (tag == NULL) return NULL;
+
+  if (tag->flags & TRACK_TAG_HEADING) {
+    Navigation_setPose(tag->x, tag->y, tag->heading);
+  } else {
+    Navigation_setPosition(tag->x, tag->y);
+  }
+  SpeedController_setLimit(tag->speedLimit > 0 ? tag->speedLimit * NAV_COUNTS_PER_METER
+                                               : SPEED_MAX_COUNTS_PER_S);
+  return tag;
+}
+
+void Navigation_startCalibration() {
+  calibrationRequested = true;
+}
+
+void Navigation_cancelCalibration() {
+  calibrationCancelRequested = true;
+}
+
+NavigationStatus Navigation_getStatus() {
+  return statusSnapshot.read();
+}
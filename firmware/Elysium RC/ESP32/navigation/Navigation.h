@@ -0,0 +1,51 @@
+#ifndef NAVIGATION_H
+#define NAVIGATION_H
+
+#include <Arduino.h>
+#include "NavigationMath.h"
+#include "TrackMap.h"
+
+/**
+ * Orientarea și poziția estimată a vehiculului (x, y, θ), actualizate la rată fixă
+ * dintr-un task pe PIPELINE_CORE, pe baza eșantioanelor Arduino (encoder și busolă)
+ * și a unghiului servomotorului.
+ *
+ * Calibrarea busolei: comanda 'C' (sau CMD_CALIBRATE) pornește rutina ghidată;
+ * vehiculul se rotește încet cu direcția la maxim până când busola a văzut toate
+ * direcțiile, apoi coeficienții se salvează în NVS și sunt încărcați la pornire.
+ *
+ * Repoziționarea pe traseu: un tag RFID de pe harta traseului (TrackMapData.h, generată de
+ * tools/trackmap) fixează poziția și, dacă tagul o are, orientarea, la pasul următor al taskului.
+ */
+
+#define NAV_PERIOD_MS 20                  // 50 Hz
+#define NAV_PRIORITY 2
+#define NAV_COUNTS_PER_METER 2400.0f      // impulsuri encoder (x4) pe metru (de calibrat pe vehicul)
+#define NAV_WHEELBASE_M 0.26f             // ampatamentul
+#define NAV_STEER_MAX_RAD 0.45f           // unghiul roților la LEFT/RIGHT (~26°)
+#define NAV_COMPASS_GAIN 0.05f            // corecția spre busolă la fiecare pas (constantă de timp ~0.4 s)
+#define NAV_COMPASS_SIGN 1.0f             // -1 dacă senzorul este montat cu fața în jos
+#define NAV_COMPASS_MOUNT_RAD 0.0f        // unghiul dintre axa X a senzorului și axa vehiculului
+
+// Rutina de calibrare
+#define NAV_CAL_SPEED_COUNTS_PER_S 400.0f
+#define NAV_CAL_TIMEOUT_MS 30000
+
+struct NavigationStatus {
+  bool calibrated;             // există coeficienți valizi (din NVS sau dintr-o calibrare)
+  bool calibrating;
+  int calibrationCoverage;     // sectoare văzute din NAV_CAL_SECTORS
+  CompassCalibration calibration;
+};
+
+// Funcții
+void Navigation_init();
+NavPose Navigation_getPose();
+void Navigation_setPose(float x, float y, float theta);
+void Navigation_setPosition(float x, float y);
+const TrackTag* Navigation_onTrackTag(const RfidEpc& epc);
+void Navigation_startCalibration();
+void Navigation_cancelCalibration();
+NavigationStatus Navigation_getStatus();
+
+#endif
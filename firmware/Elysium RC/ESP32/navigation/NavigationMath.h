@@ -0,0 +1,205 @@
+#ifndef NAVIGATION_MATH_H
+#define NAVIGATION_MATH_H
+
+/**
+ * Calculele de navigație ale vehiculului (fără dependențe Arduino, folosibile și pe calculator):
+ *  - calibrarea busolei (hard iron: centrul; soft iron: scalarea pe axe a elipsei măsurate)
+ *  - poziția estimată (x, y, θ) din distanța parcursă (encoder) și orientare
+ *
+ * Orientarea θ este în radiani, în sens trigonometric, în intervalul (-π, π].
+ * Toată starea are dimensiune fixă; nimic nu se alocă.
+ */
+
+#include <stdint.h>
+#include <math.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+#define NAV_CAL_SECTORS 8            // busola trebuie să vadă toate direcțiile (câte 45°)
+#define NAV_CAL_MIN_SAMPLES 200
+#define NAV_CAL_MIN_SPAN 60          // amplitudinea minimă (valori brute) pe fiecare axă
+#define NAV_CAL_VERSION 1
+
+static inline float navWrapAngle(float a) {
+  while (a > (float)M_PI) a -= 2.0f * (float)M_PI;
+  while (a <= -(float)M_PI) a += 2.0f * (float)M_PI;
+  return a;
+}
+
+// Coeficienții salvați în NVS
+struct CompassCalibration {
+  uint8_t version;
+  bool valid;
+  float offsetX;      // hard iron
+  float offsetY;
+  float scaleX;       // soft iron (elipsă aliniată cu axele senzorului)
+  float scaleY;
+};
+
+static inline void compassCalibrationDefault(CompassCalibration& c) {
+  c.version = NAV_CAL_VERSION;
+  c.valid = false;
+  c.offsetX = 0;
+  c.offsetY = 0;
+  c.scaleX = 1;
+  c.scaleY = 1;
+}
+
+// Orientarea din valorile brute X/Y; sign și mountRad descriu montarea senzorului pe șasiu
+static inline float compassHeading(const CompassCalibration& c, int16_t x, int16_t y,
+                                   float sign = 1.0f, float mountRad = 0.0f) {
+  float cx = (x - c.offsetX) * c.scaleX;
+  float cy = (y - c.offsetY) * c.scaleY;
+  return navWrapAngle(sign * atan2f(cy, cx) + mountRad);
+}
+
+/**
+ * Colectează eșantioane cât timp vehiculul se rotește: minimul/maximul pe fiecare axă
+ * și sectoarele de direcție acoperite (față de centrul estimat până atunci).
+ */
+class CompassCalibrator {
+public:
+  CompassCalibrator() { reset(); }
+
+  void reset() {
+    _minX = _minY = 32767;
+    _maxX = _maxY = -32768;
+    _samples = 0;
+    _sectors = 0;
+  }
+
+  void add(int16_t x, int16_t y) {
+    if (x < _minX) _minX = x;
+    if (x > _maxX) _maxX = x;
+    if (y < _minY) _minY = y;
+    if (y > _maxY) _maxY = y;
+    _samples++;
+
+    float cx = x - 0.5f * (_minX + _maxX);
+    float cy = y - 0.5f * (_minY + _maxY);
+    float a = atan2f(cy, cx) + (float)M_PI;   // 0..2π
+    int sector = (int)(a * NAV_CAL_SECTORS / (2.0f * (float)M_PI));
+    if (sector >= NAV_CAL_SECTORS) sector = NAV_CAL_SECTORS - 1;
+    _sectors |= (uint16_t)(1u << sector);
+  }
+
+  // Câte dintre cele NAV_CAL_SECTORS direcții au fost văzute
+  int coverage() const {
+    int n = 0;
+    for (int i = 0; i < NAV_CAL_SECTORS; i++) n += (_sectors >> i) & 1;
+    return n;
+  }
+
+  bool complete() const {
+    return coverage() == NAV_CAL_SECTORS && _samples >= NAV_CAL_MIN_SAMPLES &&
+           _maxX - _minX >= NAV_CAL_MIN_SPAN && _maxY - _minY >= NAV_CAL_MIN_SPAN;
+  }
+
+  // Întoarce false dacă datele nu sunt suficiente
+  bool compute(CompassCalibration& out) const {
+    if (!complete()) return false;
+    float rx = 0.5f * (_maxX - _minX);
+    float ry = 0.5f * (_maxY - _minY);
+    float r = 0.5f * (rx + ry);
+    compassCalibrationDefault(out);
+    out.offsetX = 0.5f * (_minX + _maxX);
+    out.offsetY = 0.5f * (_minY + _maxY);
+    out.scaleX = r / rx;
+    out.scaleY = r / ry;
+    out.valid = true;
+    return true;
+  }
+
+  uint32_t samples() const { return _samples; }
+
+private:
+  int16_t _minX, _maxX, _minY, _maxY;
+  uint32_t _samples;
+  uint16_t _sectors;
+};
+
+struct NavPose {
+  float x;                  // m, față de punctul de pornire (sau ultima repoziționare)
+  float y;
+  float theta;              // rad
+  float distance;           // m parcurși în total (cu semn)
+  float speed;              // m/s, din encoder
+  uint32_t timestampUs;
+  uint32_t sequence;
+  bool headingValid;        // orientarea a fost corectată cel puțin o dată de busolă
+};
+
+/**
+ * Estimarea poziției: θ se prezice din modelul bicicletei (distanța parcursă și unghiul
+ * roților), apoi se corectează spre orientarea busolei cu un filtru complementar.
+ */
+class PoseEstimator {
+public:
+  PoseEstimator(float wheelbaseM, float compassGain) : _wheelbase(wheelbaseM), _gain(compassGain) {
+    reset(0, 0, 0);
+  }
+
+  void reset(float x, float y, float theta) {
+    _pose.x = x;
+    _pose.y = y;
+    _pose.theta = navWrapAngle(theta);
+    _pose.distance = 0;
+    _pose.speed = 0;
+    _pose.timestampUs = 0;
+    _pose.sequence = 0;
+    _pose.headingValid = false;
+  }
+
+  // Repoziționare absolută (ex. un punct de referință cunoscut); distanța totală se păstrează
+  void setPosition(float x, float y) {
+    _pose.x = x;
+    _pose.y = y;
+  }
+
+  void setHeading(float theta) {
+    _pose.theta = navWrapAngle(theta);
+    _pose.headingValid = true;
+  }
+
+  /**
+   * Un pas de integrare:
+   *   ds          distanța parcursă de la pasul anterior (m, negativ înapoi)
+   *   steerRad    unghiul roților (pozitiv = stânga)
+   *   compassRad  orientarea busolei, folosită doar dacă compassValid
+   */
+  void update(float ds, float dt, float steerRad, float compassRad, bool compassValid, uint32_t nowUs) {
+    float dTheta = ds * tanf(steerRad) / _wheelbase;
+    float predicted = navWrapAngle(_pose.theta + dTheta);
+
+    if (compassValid) {
+      if (!_pose.headingValid) {
+        // Prima orientare absolută: o luăm direct, fără filtrare
+        predicted = compassRad;
+        _pose.headingValid = true;
+      } else {
+        predicted = navWrapAngle(predicted + _gain * navWrapAngle(compassRad - predicted));
+      }
+    }
+
+    // Integrăm deplasarea pe orientarea medie a pasului
+    float mid = navWrapAngle(_pose.theta + 0.5f * navWrapAngle(predicted - _pose.theta));
+    _pose.x += ds * cosf(mid);
+    _pose.y += ds * sinf(mid);
+    _pose.theta = predicted;
+    _pose.distance += ds;
+    _pose.speed = dt > 0 ? ds / dt : 0;
+    _pose.timestampUs = nowUs;
+    _pose.sequence++;
+  }
+
+  const NavPose& pose() const { return _pose; }
+
+private:
+  NavPose _pose;
+  float _wheelbase;
+  float _gain;
+};
+
+#endif
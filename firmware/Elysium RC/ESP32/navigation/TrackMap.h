@@ -0,0 +1,94 @@
+#ifndef TRACK_MAP_H
+#define TRACK_MAP_H
+
+/**
+ * Harta traseului: tag-urile RFID cu poziție cunoscută (EPC -> x, y, orientare, atributele zonei),
+ * fără dependențe Arduino, folosită și de generatorul din tools/trackmap.
+ *
+ * Tabelul este generat pe calculator (TrackMapData.h) ca dispersie perfectă pe două niveluri:
+ *   h     = FNV-1a(EPC)
+ *   găleata = h % buckets, locul = amestec(h ^ seeds[găleată]) & (slots - 1)
+ * Generatorul alege pentru fiecare găleată un seed cu care cheile ei cad în locuri libere, deci
+ * căutarea este o singură dispersie, un acces în tabel și o comparație a EPC-ului (un tag
+ * necunoscut cade pe un loc gol sau pe alt EPC). Corectitudinea tabelului este verificată și
+ * la compilare, prin static_assert în TrackMapData.h.
+ *
+ * Funcțiile sunt constexpr C++11 (recursive), ca verificarea să poată rula în compilator;
+ * trackMapValid() împarte tabelul în jumătăți, ca adâncimea să nu crească odată cu harta.
+ * Unități: metri, radiani (sens trigonometric, ca NavPose), m/s.
+ */
+
+#include <stdint.h>
+#include "../sensors/RfidProtocol.h"
+
+// Atributele unui tag
+#define TRACK_TAG_HEADING 0x01           // orientarea este cunoscută (tagul stă pe o bandă cu sens unic)
+#define TRACK_TAG_STOP 0x02              // linie de oprire (intersecție, trecere de pietoni)
+
+struct TrackTag {
+  RfidEpc epc;                // len = 0: loc gol în tabel
+  float x;
+  float y;
+  float heading;
+  float speedLimit;           // m/s pentru zona care începe la tag, 0 = fără limită
+  uint8_t zone;               // identificatorul zonei (0 = fără zonă)
+  uint8_t flags;              // TRACK_TAG_*
+};
+
+// FNV-1a pe octeții EPC-ului, aceeași funcție ca în RfidTagCache
+static constexpr uint32_t trackEpcHash(const uint8_t* bytes, uint8_t len, uint32_t h = 2166136261u) {
+  return len == 0 ? h : trackEpcHash(bytes + 1, (uint8_t)(len - 1), (h ^ bytes[0]) * 16777619u);
+}
+
+// Finalizatorul MurmurHash3: fiecare bit al seed-ului schimbă toți biții locului
+static constexpr uint32_t trackMixStep(uint32_t h, int shift, uint32_t mul) {
+  return (h ^ (h >> shift)) * mul;
+}
+
+static constexpr uint32_t trackFold(uint32_t h) {
+  return h ^ (h >> 16);
+}
+
+static constexpr uint32_t trackMix(uint32_t h) {
+  return trackFold(trackMixStep(trackMixStep(h, 16, 0x85EBCA6Bu), 13, 0xC2B2AE35u));
+}
+
+static constexpr uint32_t trackSlot(uint32_t h, const uint16_t* seeds, uint32_t buckets, uint32_t slots) {
+  return trackMix(h ^ seeds[h % buckets]) & (slots - 1);
+}
+
+/**
+ * Tagul cu acest EPC, NULL dacă nu este pe hartă. O dispersie și o comparație, fără bucle de sondare.
+ */
+static inline const TrackTag* trackMapLookup(const RfidEpc& epc, const TrackTag* tags, const uint16_t* seeds,
+                                             uint32_t buckets, uint32_t slots) {
+  const TrackTag& t = tags[trackSlot(trackEpcHash(epc.bytes, epc.len), seeds, buckets, slots)];
+  return (t.epc.len != 0 && t.epc == epc) ? &t : NULL;
+}
+
+static constexpr bool trackSlotValid(const TrackTag* tags, const uint16_t* seeds, uint32_t buckets,
+                                     uint32_t slots, uint32_t i) {
+  return tags[i].epc.len == 0 ||
+         trackSlot(trackEpcHash(tags[i].epc.bytes, tags[i].epc.len), seeds, buckets, slots) == i;
+}
+
+// Locurile [first, first + count), pe jumătăți: adâncimea recursiei este log2(slots), nu slots,
+// deci și o hartă de mii de tag-uri rămâne sub limita constexpr a compilatorului (512 la GCC)
+static constexpr bool trackRangeValid(const TrackTag* tags, const uint16_t* seeds, uint32_t buckets,
+                                      uint32_t slots, uint32_t first, uint32_t count) {
+  return count == 0 ? true
+       : count == 1 ? trackSlotValid(tags, seeds, buckets, slots, first)
+       : trackRangeValid(tags, seeds, buckets, slots, first, count / 2) &&
+         trackRangeValid(tags, seeds, buckets, slots, first + count / 2, count - count / 2);
+}
+
+/**
+ * Fiecare loc ocupat trebuie să fie exact locul la care duce EPC-ul lui; dacă două tag-uri
+ * s-ar dori în același loc, unul dintre ele nu ar fi în locul calculat. Pentru static_assert.
+ */
+static constexpr bool trackMapValid(const TrackTag* tags, const uint16_t* seeds, uint32_t buckets,
+                                    uint32_t slots) {
+  return trackRangeValid(tags, seeds, buckets, slots, 0, slots);
+}
+
+#endif
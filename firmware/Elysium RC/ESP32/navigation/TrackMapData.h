@@ -0,0 +1,47 @@
+#ifndef TRACK_MAP_DATA_H
+#define TRACK_MAP_DATA_H
+
+/**
+ * Harta traseului, generată de tools/trackmap/trackmap_gen din harta_pista.csv; nu se editează manual.
+ * 9 tag-uri în 16 locuri, 3 găleți.
+ */
+
+#include "TrackMap.h"
+
+#define TRACK_MAP_TAG_COUNT 9
+#define TRACK_MAP_BUCKETS 3
+#define TRACK_MAP_SLOTS 16
+
+static constexpr uint16_t TRACK_MAP_SEEDS[TRACK_MAP_BUCKETS] = {
+  1, 2, 1
+};
+
+// { { lungime, EPC }, x, y, orientare, limită, zonă, atribute }
+static constexpr TrackTag TRACK_MAP_TAGS[TRACK_MAP_SLOTS] = {
+  { { 0, { 0 } }, 0, 0, 0, 0, 0, 0 },
+  { { 12, { 0xE2, 0x80, 0x68, 0x94, 0x00, 0x00, 0x50, 0x10, 0x00, 0x00, 0x00, 0x07 } }, 2.000f, 3.200f, 3.14159f, 0.20f, 4, 0x03 },
+  { { 0, { 0 } }, 0, 0, 0, 0, 0, 0 },
+  { { 12, { 0xE2, 0x80, 0x68, 0x94, 0x00, 0x00, 0x50, 0x10, 0x00, 0x00, 0x00, 0x05 } }, 4.600f, 2.600f, 1.57080f, 0.00f, 3, 0x01 },
+  { { 12, { 0xE2, 0x80, 0x68, 0x94, 0x00, 0x00, 0x50, 0x10, 0x00, 0x00, 0x00, 0x02 } }, 2.000f, 0.000f, 0.00000f, 0.00f, 1, 0x01 },
+  { { 12, { 0xE2, 0x80, 0x68, 0x94, 0x00, 0x00, 0x50, 0x10, 0x00, 0x00, 0x00, 0x01 } }, 0.000f, 0.000f, 0.00000f, 0.00f, 1, 0x01 },
+  { { 12, { 0xE2, 0x80, 0x68, 0x94, 0x00, 0x00, 0x50, 0x10, 0x00, 0x00, 0x00, 0x08 } }, 0.000f, 3.200f, 3.14159f, 0.50f, 1, 0x01 },
+  { { 0, { 0 } }, 0, 0, 0, 0, 0, 0 },
+  { { 12, { 0xE2, 0x80, 0x68, 0x94, 0x00, 0x00, 0x50, 0x10, 0x00, 0x00, 0x00, 0x03 } }, 4.000f, 0.000f, 0.00000f, 0.30f, 2, 0x03 },
+  { { 12, { 0xE2, 0x80, 0x68, 0x94, 0x00, 0x00, 0x50, 0x10, 0x00, 0x00, 0x00, 0x09 } }, -0.600f, 1.600f, 0.00000f, 0.00f, 1, 0x00 },
+  { { 0, { 0 } }, 0, 0, 0, 0, 0, 0 },
+  { { 12, { 0xE2, 0x80, 0x68, 0x94, 0x00, 0x00, 0x50, 0x10, 0x00, 0x00, 0x00, 0x06 } }, 4.000f, 3.200f, 3.14159f, 0.20f, 4, 0x01 },
+  { { 0, { 0 } }, 0, 0, 0, 0, 0, 0 },
+  { { 0, { 0 } }, 0, 0, 0, 0, 0, 0 },
+  { { 0, { 0 } }, 0, 0, 0, 0, 0, 0 },
+  { { 12, { 0xE2, 0x80, 0x68, 0x94, 0x00, 0x00, 0x50, 0x10, 0x00, 0x00, 0x00, 0x04 } }, 4.600f, 0.600f, 1.57080f, 0.30f, 2, 0x01 },
+};
+
+static_assert((TRACK_MAP_SLOTS & (TRACK_MAP_SLOTS - 1)) == 0, "TRACK_MAP_SLOTS trebuie sa fie putere a lui 2");
+static_assert(trackMapValid(TRACK_MAP_TAGS, TRACK_MAP_SEEDS, TRACK_MAP_BUCKETS, TRACK_MAP_SLOTS),
+              "harta traseului are coliziuni: regenerati TrackMapData.h");
+
+static inline const TrackTag* trackMapFind(const RfidEpc& epc) {
+  return trackMapLookup(epc, TRACK_MAP_TAGS, TRACK_MAP_SEEDS, TRACK_MAP_BUCKETS, TRACK_MAP_SLOTS);
+}
+
+#endif
@@ -0,0 +1,139 @@
+#include "ArduinoLink.h"
+#include "../core/Pipeline.h"
+#include "../core/TaskMonitor.h"
+#include "../core/Recorder.h"
+#include "../motion-control/SpeedController.h"
+#include "../../../shared/log/DeferredLog.h"
+
+static QueueHandle_t linkEventQueue = NULL;
+static SensorLinkDecoder linkDecoder;
+static SeqLock<ArduinoSample> arduinoSnapshot;
+
+static portMUX_TYPE linkMux = portMUX_INITIALIZER_UNLOCKED;
+static ArduinoLinkStats linkStats = {};
+
+// Taskul trezit la fiecare eșantion nou (detectorul de accident)
+static TaskHandle_t linkNotifyTask = NULL;
+
+static void publishSample(const SensorLinkSample& in) {
+  ArduinoSample sample;
+  sample.encoder = in.encoder;
+  sample.compass[0] = in.compass[0];
+  sample.compass[1] = in.compass[1];
+  sample.compass[2] = in.compass[2];
+  sample.voltageCentivolts = in.voltageCentivolts;
+  sample.encoderErrors = in.encoderErrors;
+  sample.lastEdgeUs = in.lastEdgeUs;
+  sample.edgePeriodUs = in.edgePeriodUs;
+  sample.arduinoTimeUs = in.arduinoTimeUs;
+  sample.receivedUs = micros();
+  sample.sequence = in.sequence;
+  sample.valid = true;
+  arduinoSnapshot.write(sample);
+  Recorder_logArduino(sample);
+
+  // Viteza roții se calculează cu ceasul Arduino, fără jitter-ul recepției
+  SpeedController_onEncoderSample(in.encoder, in.arduinoTimeUs, in.lastEdgeUs, in.edgePeriodUs);
+
+  if (linkNotifyTask != NULL) xTaskNotifyGive(linkNotifyTask);
+}
+
+static void updateStats() {
+  portENTER_CRITICAL(&linkMux);
+  linkStats.framesOk = linkDecoder.framesOk;
+  linkStats.crcErrors = linkDecoder.crcErrors;
+  linkStats.lostFrames = linkDecoder.lostFrames;
+  linkStats.resyncBytes = linkDecoder.resyncBytes;
+  portEXIT_CRITICAL(&linkMux);
+}
+
+// Doarme pe evenimentele driverului UART; nu face polling
+static void arduinoLinkTask(void* parameter) {
+  uart_event_t event;
+  uint8_t chunk[128];
+  int monitorId = TaskMonitor_register("ArduinoLink", 0, 1000);
+
+  while (true) {
+    if (xQueueReceive(linkEventQueue, &event, portMAX_DELAY) != pdTRUE) continue;
+    TaskMonitor_begin(monitorId);
+
+    switch (event.type) {
+      case UART_DATA: {
+        size_t remaining = event.size;
+        while (remaining > 0) {
+          int n = uart_read_bytes(ARDUINO_LINK_UART, chunk, remaining < sizeof(chunk) ? remaining : sizeof(chunk), 0);
+          if (n <= 0) break;
+          for (int i = 0; i < n; i++) {
+            if (linkDecoder.push(chunk[i])) publishSample(linkDecoder.sample());
+          }
+          remaining -= n;
+        }
+        updateStats();
+        break;
+      }
+      case UART_FIFO_OVF:
+      case UART_BUFFER_FULL:
+        // Cadrele din buffer sunt oricum vechi: golim și ne resincronizăm pe următorul cadru
+        uart_flush_input(ARDUINO_LINK_UART);
+        xQueueReset(linkEventQueue);
+        portENTER_CRITICAL(&linkMux);
+        linkStats.uartOverflows++;
+        portEXIT_CRITICAL(&linkMux);
+        break;
+      case UART_FRAME_ERR:
+      case UART_PARITY_ERR:
+        portENTER_CRITICAL(&linkMux);
+        linkStats.lineErrors++;
+        portEXIT_CRITICAL(&linkMux);
+        break;
+      default:
+        break;
+    }
+    TaskMonitor_end(monitorId);
+  }
+
+  vTaskDelete(NULL);
+}
+
+void ArduinoLink_init() {
+  Serial.println("\nPornire legătură Arduino (UART1, binar)...");
+
+  uart_config_t config = {};
+  config.baud_rate = SENSOR_LINK_BAUD;
+  config.data_bits = UART_DATA_8_BITS;
+  config.parity = UART_PARITY_DISABLE;
+  config.stop_bits = UART_STOP_BITS_1;
+  config.flow_ctrl = UART_HW_FLOWCTRL_DISABLE;
+
+  uart_driver_install(ARDUINO_LINK_UART, ARDUINO_LINK_RX_BUFFER, 0,
+                      ARDUINO_LINK_EVENT_QUEUE, &linkEventQueue, 0);
+  uart_param_config(ARDUINO_LINK_UART, &config);
+  uart_set_pin(ARDUINO_LINK_UART, ARDUINO_LINK_TX_PIN, ARDUINO_LINK_RX_PIN,
+               UART_PIN_NO_CHANGE, UART_PIN_NO_CHANGE);
+  // Un eveniment la fiecare cadru complet sau după o pauză de 2 octeți pe linie
+  uart_set_rx_full_threshold(ARDUINO_LINK_UART, SENSOR_LINK_SAMPLE_LEN + 5);
+  uart_set_rx_timeout(ARDUINO_LINK_UART, 2);
+
+  xTaskCreatePinnedToCore(arduinoLinkTask, "ArduinoLink", 3072, NULL,
+                          ARDUINO_LINK_PRIORITY, NULL, PIPELINE_CORE);
+}
+
+ArduinoSample ArduinoLink_getSample() {
+  return arduinoSnapshot.read();
+}
+
+ArduinoLinkStats ArduinoLink_getStats() {
+  portENTER_CRITICAL(&linkMux);
+  ArduinoLinkStats copy = linkStats;
+  portEXIT_CRITICAL(&linkMux);
+  return copy;
+}
+
+void ArduinoLink_setNotifyTask(TaskHandle_t task) {
+  linkNotifyTask = task;
+}
+
+bool ArduinoLink_isAlive() {
+  ArduinoSample sample = arduinoSnapshot.read();
+  return sample.valid && (micros() - sample.receivedUs) < ARDUINO_LINK_TIMEOUT_MS * 1000UL;
+}
@@ -0,0 +1,55 @@
+#ifndef ARDUINO_LINK_H
+#define ARDUINO_LINK_H
+
+#include <Arduino.h>
+#include "driver/uart.h"
+#include "../core/SeqLock.h"
+#include "../../../shared/link/SensorLinkCodec.h"
+
+/**
+ * Recepția eșantioanelor de la Arduino (encoder, busolă, tensiune) pe UART1.
+ *
+ * Driverul UART din ESP-IDF copiază octeții în bufferul său circular din întrerupere
+ * și semnalează un eveniment; taskul legăturii doarme pe coada de evenimente,
+ * decodează cadrele binare (SensorLinkCodec.h) și publică ultimul eșantion.
+ * loop() nu mai citește portul serial deloc.
+ */
+
+#define ARDUINO_LINK_UART UART_NUM_1
+#define ARDUINO_LINK_RX_PIN 16
+#define ARDUINO_LINK_TX_PIN 17
+#define ARDUINO_LINK_RX_BUFFER 1024        // bufferul circular al driverului
+#define ARDUINO_LINK_EVENT_QUEUE 16
+#define ARDUINO_LINK_PRIORITY 4
+#define ARDUINO_LINK_TIMEOUT_MS 100        // fără cadre valide -> legătura este considerată căzută
+
+struct ArduinoSample {
+  int32_t encoder;              // impulsuri encoder
+  int16_t compass[3];           // valori brute QMC5883
+  uint16_t voltageCentivolts;
+  uint16_t encoderErrors;       // fronturi pierdute raportate de decodorul Arduino
+  uint32_t lastEdgeUs;          // ultimul front al encoderului, ceasul Arduino
+  int32_t edgePeriodUs;         // perioada unui front, cu semnul sensului; 0 = necunoscută
+  uint32_t arduinoTimeUs;       // momentul eșantionării, ceasul Arduino
+  unsigned long receivedUs;     // momentul decodării, ceasul ESP32
+  uint16_t sequence;
+  bool valid;                   // false până la primul cadru
+};
+
+struct ArduinoLinkStats {
+  uint32_t framesOk;
+  uint32_t crcErrors;           // cadre corupte
+  uint32_t lostFrames;          // cadre lipsă (salturi de secvență)
+  uint32_t resyncBytes;         // octeți ignorați la resincronizare
+  uint32_t uartOverflows;       // FIFO sau bufferul driverului plin
+  uint32_t lineErrors;          // erori de încadrare/paritate raportate de UART
+};
+
+// Funcții
+void ArduinoLink_init();
+ArduinoSample ArduinoLink_getSample();
+ArduinoLinkStats ArduinoLink_getStats();
+bool ArduinoLink_isAlive();
+void ArduinoLink_setNotifyTask(TaskHandle_t task);
+
+#endif
@@ -1,107 +1,140 @@
 #include "RFIDManager.h"
+#include "../../../shared/log/DeferredLog.h"
 
-// Inițializare variabile globale
-String lastCardID = "";
-bool cardDetected = false;
-unsigned long lastCardReadTime = 0;
-char rfidBuffer[RFID_BUFFER_SIZE];
-int rfidBufferIndex = 0;
+static RfidDecoder rfidDecoder;
+static RfidTagCache rfidCache;
+static unsigned long lastFrameMs = 0;
+static uint32_t rfidRestarts = 0;
+
+// Sosiri și plecări, consumate din loop() (același fir ca RFIDManager_update)
+static RfidTagEvent rfidEvents[RFID_EVENT_QUEUE];
+static uint8_t rfidEventHead = 0;
+static uint8_t rfidEventCount = 0;
+static uint32_t rfidDroppedEvents = 0;
+
+static void pushEvent(const RfidTagEvent& event) {
+  if (rfidEventCount == RFID_EVENT_QUEUE) {
+    rfidDroppedEvents++;
+    return;
+  }
+  rfidEvents[(rfidEventHead + rfidEventCount) % RFID_EVENT_QUEUE] = event;
+  rfidEventCount++;
+}
+
+static void startInventory() {
+  // 0x22 = parametru rezervat, apoi numărul de citiri (MSB întâi)
+  uint8_t params[3] = { 0x22, (uint8_t)(RFID_POLL_COUNT >> 8), (uint8_t)RFID_POLL_COUNT };
+  sendRFIDCommand(RFID_CMD_MULTI_POLL, params, sizeof(params));
+  lastFrameMs = millis();
+}
+
+static void handleRfidFrame(unsigned long now) {
+  lastFrameMs = now;
+
+  RfidTagRead read;
+  if (rfidDecoder.tagRead(read)) {
+    RfidTagEvent arrival, evicted;
+    bool evictedValid;
+    if (rfidCache.observe(read, now, arrival, evicted, evictedValid)) {
+      if (evictedValid) pushEvent(evicted);
+      pushEvent(arrival);
+    }
+    return;
+  }
+
+  int error = rfidDecoder.errorCode();
+  if (error >= 0 && error != RFID_ERROR_NO_TAG) {
+    LOG_WARN("RFID: eroare cititor 0x%02x", error);
+  }
+}
 
 /**
- * Inițializează modulul RFID
+ * Inițializează modulul RFID și pornește inventarul continuu
  */
 void RFIDManager_init() {
   Serial.println("\nInițializare Modul RFID YRM1003...");
-  
-  // Configurare UART2 pentru comunicația cu modulul RFID
+
+  // Configurare UART2 pentru comunicația cu modulul RFID; bufferul se stabilește înainte de begin()
+  Serial2.setRxBufferSize(RFID_RX_BUFFER);
   Serial2.begin(RFID_BAUD_RATE, SERIAL_8N1, RFID_RX_PIN, RFID_TX_PIN);
   delay(500); // Așteaptă stabilizarea conexiunii
-  
-  // Reset buffer
-  memset(rfidBuffer, 0, RFID_BUFFER_SIZE);
-  rfidBufferIndex = 0;
-  
-  Serial.println("Modul RFID YRM1003 inițializat");
-  Serial.println("- RX pin (primire date): " + String(RFID_RX_PIN));
-  Serial.println("- TX pin (trimitere comenzi): " + String(RFID_TX_PIN));
+
+  // Un inventar rămas pornit de la rularea anterioară se oprește, apoi repornește curat
+  sendRFIDCommand(RFID_CMD_STOP_POLL);
+  delay(20);
+  while (Serial2.available() > 0) Serial2.read();
+  startInventory();
+
+  Serial.println("Modul RFID YRM1003 inițializat (inventar continuu)");
+  Serial.printf("- RX pin (primire date): %d\n", RFID_RX_PIN);
+  Serial.printf("- TX pin (trimitere comenzi): %d\n", RFID_TX_PIN);
 }
 
 /**
- * Actualizează starea modulului RFID și procesează datele primite
- * Această funcție trebuie apelată frecvent în loop() pentru a detecta cardurile
+ * Decodează cadrele primite, repornește inventarul oprit și emite plecările tag-urilor.
+ * Această funcție trebuie apelată frecvent în loop()
  */
 void RFIDManager_update() {
-  // Verifică dacă sunt date disponibile de la modulul RFID
-  while (Serial2.available() > 0) {
-    char c = Serial2.read();
-    
-    // Adaugă caracterul la buffer dacă mai este spațiu și nu e caracter de terminare
-    if (rfidBufferIndex < RFID_BUFFER_SIZE - 1 && c != '\r' && c != '\n') {
-      rfidBuffer[rfidBufferIndex] = c;
-      rfidBufferIndex++;
-    } 
-    // Procesează datele când primim terminatorul de linie
-    else if (c == '\n' || c == '\r') {
-      if (rfidBufferIndex > 0) {
-        rfidBuffer[rfidBufferIndex] = '\0'; // Termină string-ul
-        String data = String(rfidBuffer);
-        processRFIDData(data);
-        
-        // Reset buffer pentru următoarea citire
-        memset(rfidBuffer, 0, RFID_BUFFER_SIZE);
-        rfidBufferIndex = 0;
-      }
-    }
+  unsigned long now = millis();
+
+  // Citire în bloc: un apel pe octet ar costa mai mult decât decodarea
+  uint8_t chunk[64];
+  int available;
+  while ((available = Serial2.available()) > 0) {
+    size_t n = Serial2.readBytes(chunk, available < (int)sizeof(chunk) ? available : sizeof(chunk));
+    RFIDManager_feed(chunk, n, now);
   }
-  
-  // Verifică dacă cardul a fost scos (dacă nu s-a mai citit nimic în ultimele 1000ms)
-  if (cardDetected && (millis() - lastCardReadTime > 1000)) {
-    cardDetected = false;
-    Serial.println("Card RFID îndepărtat");
+
+  RfidTagEvent departure;
+  while (rfidCache.expire(now, departure)) pushEvent(departure);
+
+  // Inventarul se oprește după RFID_POLL_COUNT runde sau după o eroare a cititorului
+  if (now - lastFrameMs > RFID_RESTART_MS) {
+    rfidRestarts++;
+    startInventory();
   }
 }
 
 /**
- * Returnează ID-ul ultimului card citit
+ * Decodează octeții primiți de la cititor: cadrele complete ajung în cache și în coada de
+ * evenimente. Apelată din RFIDManager_update(); separată pentru microbenchmark-uri
  */
-String getRFIDCardID() {
-  return lastCardID;
+void RFIDManager_feed(const uint8_t* data, size_t len, unsigned long now) {
+  for (size_t i = 0; i < len; i++) {
+    if (rfidDecoder.push(data[i])) handleRfidFrame(now);
+  }
 }
 
 /**
- * Verifică dacă există un card prezent în câmpul cititorului
+ * Următoarea sosire sau plecare de tag; false dacă nu mai sunt evenimente
  */
-bool isCardPresent() {
-  return cardDetected;
+bool RFIDManager_nextEvent(RfidTagEvent& event) {
+  if (rfidEventCount == 0) return false;
+  event = rfidEvents[rfidEventHead];
+  rfidEventHead = (rfidEventHead + 1) % RFID_EVENT_QUEUE;
+  rfidEventCount--;
+  return true;
 }
 
-/**
- * Trimite o comandă către cititorul RFID
- */
-void sendRFIDCommand(const char* command) {
-  Serial2.println(command);
-  Serial.println("Comandă trimisă către RFID: " + String(command));
+RFIDStats RFIDManager_getStats() {
+  RFIDStats stats;
+  stats.frames = rfidDecoder.framesOk;
+  stats.tagReads = rfidCache.stats().reads;
+  stats.checksumErrors = rfidDecoder.checksumErrors;
+  stats.oversize = rfidDecoder.oversize;
+  stats.restarts = rfidRestarts;
+  stats.droppedEvents = rfidDroppedEvents;
+  stats.present = rfidCache.count();
+  return stats;
 }
 
 /**
- * Procesează datele primite de la cititorul RFID
- * Formatul exact al datelor depinde de modelul YRM1003, 
- * va trebui ajustat în funcție de datele reale primite
+ * Trimite o comandă binară către cititorul RFID
  */
-void processRFIDData(String data) {
-  // Curățăm datele primite de spații și caractere speciale
-  data.trim();
-  
-  // Verificăm dacă avem date valide (putem ajusta această logică)
-  if (data.length() > 8) {
-    Serial.println("Date RFID primite: " + data);
-    
-    // În acest exemplu, presupunem că datele primite conțin direct ID-ul cardului
-    // Va trebui ajustat în funcție de formatul real al datelor
-    lastCardID = data;
-    cardDetected = true;
-    lastCardReadTime = millis();
-    
-    Serial.println("Card RFID detectat, ID: " + lastCardID);
-  }
+void sendRFIDCommand(uint8_t command, const uint8_t* params, uint16_t len) {
+  uint8_t frame[RFID_MAX_FRAME];
+  size_t n = rfidEncodeCommand(command, params, len, frame);
+  if (n == 0) return;
+  Serial2.write(frame, n);
+  LOG_DEBUG("Comandă trimisă către RFID: 0x%02x (%u octeți)", command, (unsigned)len);
 }
@@ -2,26 +2,45 @@
 #define RFID_MANAGER_H
 
 #include <Arduino.h>
+#include "RfidProtocol.h"
+#include "RfidTagCache.h"
+
+/**
+ * Cititorul UHF YRM1003 pe UART2, prin protocolul binar (RfidProtocol.h).
+ *
+ * La pornire cititorul intră în inventar continuu (comanda 0x27), care raportează fiecare
+ * tag din câmp cu RSSI; inventarul este repornit dacă cititorul tace RFID_RESTART_MS.
+ * Citirile trec prin RfidTagCache, deci aplicația primește o singură sosire și o singură
+ * plecare pentru fiecare tag (RFIDManager_nextEvent), fără String-uri și fără alocări.
+ */
 
 // Definițiile pinilor pentru modulul RFID YRM1003
 #define RFID_RX_PIN 23  // ESP32 primește date de la modulul RFID (conectat la TXD al YRM1003)
 #define RFID_TX_PIN 19  // ESP32 trimite date către modulul RFID (conectat la RXD al YRM1003)
 
 // Constants
-#define RFID_BUFFER_SIZE 64
-#define RFID_BAUD_RATE 9600
+#define RFID_BAUD_RATE 115200           // viteza implicită a modulului; o notificare are 24 de octeți
+#define RFID_RX_BUFFER 1024             // ~90 ms de date, peste cel mai lung blocaj al lui loop()
+#define RFID_POLL_COUNT 10000           // citiri per comandă de inventar continuu (maxim 65535)
+#define RFID_RESTART_MS 1000            // niciun cadru atât timp: inventarul s-a oprit, îl repornim
+#define RFID_EVENT_QUEUE 8
 
-// Variabile pentru stocarea datelor
-extern String lastCardID;    // ID-ul ultimului card citit
-extern bool cardDetected;    // Indicator pentru detectarea unui card
-extern unsigned long lastCardReadTime;  // Timestamp pentru ultima citire
+struct RFIDStats {
+  uint32_t frames;
+  uint32_t tagReads;
+  uint32_t checksumErrors;
+  uint32_t oversize;
+  uint32_t restarts;          // reporniri ale inventarului
+  uint32_t droppedEvents;     // sosiri/plecări pierdute cu coada plină
+  int present;                // tag-uri în câmp acum
+};
 
 // Funcții
 void RFIDManager_init();
 void RFIDManager_update();
-String getRFIDCardID();
-bool isCardPresent();
-void sendRFIDCommand(const char* command);
-void processRFIDData(String data);
+void RFIDManager_feed(const uint8_t* data, size_t len, unsigned long now);
+bool RFIDManager_nextEvent(RfidTagEvent& event);
+RFIDStats RFIDManager_getStats();
+void sendRFIDCommand(uint8_t command, const uint8_t* params = NULL, uint16_t len = 0);
 
 #endif // RFID_MANAGER_H
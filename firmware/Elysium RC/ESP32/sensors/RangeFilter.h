@@ -0,0 +1,225 @@
+#ifndef RANGE_FILTER_H
+#define RANGE_FILTER_H
+
+/**
+ * Filtrarea unui canal ultrasonic (fără dependențe Arduino, testată pe calculator în tools/ultrasonic):
+ *
+ *   măsurătoare brută -> poartă de plauzibilitate -> mediană pe RANGE_MEDIAN_WINDOW -> urmăritor alfa-beta
+ *
+ * Poarta respinge salturile izolate (ecouri multiple, interferențe) față de predicția urmăritorului;
+ * un salt repetat coerent înseamnă un obiect nou și repornește urmărirea. Mediana se face pe ultimele
+ * măsurători acceptate, aduse la momentul curent cu viteza estimată, ca să nu întârzie estimarea
+ * când obiectul se mișcă. Urmăritorul estimează distanța și viteza relativă (cm/s, negativ = apropiere).
+ * În locul valorii magice -1, fiecare estimare are o încredere (0-100) și indicatori expliciți:
+ * ecou lipsă (nimic în raza senzorului), salt respins, estimare veche.
+ * Toate calculele sunt în float simplu (FPU-ul ESP32 nu are double în hardware).
+ */
+
+#include <stdint.h>
+#include <math.h>
+
+#define RANGE_MIN_CM 2.0f
+#define RANGE_MAX_CM 400.0f
+#define RANGE_MEDIAN_WINDOW 3            // impar; 1 = fără mediană
+#define RANGE_ALPHA 0.6f
+#define RANGE_BETA 0.25f
+#define RANGE_GATE_CM 15.0f              // salt acceptat independent de timp
+#define RANGE_MAX_RATE_CMS 250.0f        // viteza relativă maximă plauzibilă
+#define RANGE_REACQUIRE_OUTLIERS 2       // atâtea salturi consecutive coerente = obiect nou
+#define RANGE_MISSES_NO_ECHO 2           // ecouri lipsă consecutive până la "nimic în față"
+#define RANGE_STALE_US 600000UL          // fără măsurători de atâta timp -> estimare veche
+#define RANGE_MIN_CONFIDENCE 50
+
+// Indicatori
+#define RANGE_VALID    0x01              // distanța și viteza pot fi folosite
+#define RANGE_NO_ECHO  0x02              // ultimele măsurători nu au avut ecou (spațiu liber sau absorbție)
+#define RANGE_OUTLIER  0x04              // ultima măsurătoare a fost respinsă
+#define RANGE_STALE    0x08              // nicio măsurătoare recentă
+
+struct RangeEstimate {
+  float distanceCm;         // la momentul updatedUs
+  float rateCmS;            // derivata distanței; negativ = apropiere
+  uint32_t updatedUs;       // ultima măsurătoare acceptată
+  uint8_t confidence;       // 0-100
+  uint8_t flags;
+
+  bool valid() const { return (flags & RANGE_VALID) != 0; }
+
+  // Distanța extrapolată la momentul nowUs
+  float predictCm(uint32_t nowUs) const {
+    float dt = (float)(uint32_t)(nowUs - updatedUs) * 1e-6f;
+    return distanceCm + rateCmS * dt;
+  }
+};
+
+struct RangeFilterStats {
+  uint32_t accepted;
+  uint32_t outliers;
+  uint32_t misses;
+  uint32_t reacquired;
+};
+
+class RangeFilter {
+public:
+  RangeFilter() { reset(); }
+
+  void reset() {
+    _est.distanceCm = 0;
+    _est.rateCmS = 0;
+    _est.updatedUs = 0;
+    _est.confidence = 0;
+    _est.flags = RANGE_STALE;
+    _tracking = false;
+    _windowCount = 0;
+    _windowHead = 0;
+    _outlierRun = 0;
+    _lastOutlierCm = 0;
+    _missRun = 0;
+    _stats.accepted = _stats.outliers = _stats.misses = _stats.reacquired = 0;
+  }
+
+  // O măsurătoare cu ecou; valorile în afara domeniului senzorului sunt tratate ca ecou lipsă
+  void measure(float rawCm, uint32_t nowUs) {
+    if (!(rawCm >= RANGE_MIN_CM && rawCm <= RANGE_MAX_CM)) {
+      miss();
+      return;
+    }
+    _missRun = 0;
+    _est.flags &= (uint8_t)~(RANGE_NO_ECHO | RANGE_STALE);
+
+    if (!_tracking) {
+      startTrack(rawCm, nowUs);
+      return;
+    }
+
+    float dt = (float)(uint32_t)(nowUs - _est.updatedUs) * 1e-6f;
+    if (dt <= 0) dt = 1e-3f;
+    float predicted = _est.distanceCm + _est.rateCmS * dt;
+    float gate = RANGE_GATE_CM + RANGE_MAX_RATE_CMS * dt;
+
+    if (fabsf(rawCm - predicted) > gate) {
+      // Salt neplauzibil sau un obiect nou apărut brusc: îl acceptăm doar dacă se repetă coerent
+      _stats.outliers++;
+      bool coherent = _outlierRun > 0 && fabsf(rawCm - _lastOutlierCm) <= gate;
+      _outlierRun = coherent ? _outlierRun + 1 : 1;
+      _lastOutlierCm = rawCm;
+      _est.flags |= RANGE_OUTLIER;
+      lowerConfidence(25);
+      if (_outlierRun >= RANGE_REACQUIRE_OUTLIERS) {
+        _stats.reacquired++;
+        startTrack(rawCm, nowUs);
+      }
+      return;
+    }
+
+    _outlierRun = 0;
+    _est.flags &= (uint8_t)~RANGE_OUTLIER;
+    if (_windowCount == 1) {
+      // A doua măsurătoare a urmei: viteza inițială din diferența celor două
+      _est.rateCmS = (rawCm - _est.distanceCm) / dt;
+      _est.distanceCm = median(rawCm, nowUs);
+    } else {
+      float residual = median(rawCm, nowUs) - predicted;
+      _est.distanceCm = predicted + RANGE_ALPHA * residual;
+      _est.rateCmS += (RANGE_BETA / dt) * residual;
+    }
+    _est.updatedUs = nowUs;
+    _stats.accepted++;
+    raiseConfidence(25);
+  }
+
+  // Măsurătoare fără ecou (timeout)
+  void miss() {
+    _stats.misses++;
+    if (++_missRun >= RANGE_MISSES_NO_ECHO) {
+      // Nimic în raza senzorului: canalul este liber, nu "invalid"
+      _tracking = false;
+      _est.flags |= RANGE_NO_ECHO;
+      _est.confidence = 0;
+      _est.rateCmS = 0;
+    } else {
+      lowerConfidence(20);
+    }
+    updateValid();
+  }
+
+  // Apelată periodic: marchează estimarea ca veche dacă nu au mai venit măsurători acceptate
+  void age(uint32_t nowUs) {
+    if (_tracking && (uint32_t)(nowUs - _est.updatedUs) > RANGE_STALE_US) {
+      _tracking = false;
+      _est.flags |= RANGE_STALE;
+      _est.confidence = 0;
+      updateValid();
+    }
+  }
+
+  const RangeEstimate& estimate() const { return _est; }
+  const RangeFilterStats& stats() const { return _stats; }
+
+private:
+  RangeEstimate _est;
+  RangeFilterStats _stats;
+  float _windowCm[RANGE_MEDIAN_WINDOW];
+  uint32_t _windowUs[RANGE_MEDIAN_WINDOW];
+  uint8_t _windowCount;
+  uint8_t _windowHead;
+  uint8_t _outlierRun;
+  uint8_t _missRun;
+  float _lastOutlierCm;
+  bool _tracking;
+
+  /**
+   * Adaugă măsurătoarea în fereastră și întoarce mediana valorilor aduse la nowUs cu viteza estimată
+   * (sortare prin inserție pe cel mult RANGE_MEDIAN_WINDOW elemente)
+   */
+  float median(float z, uint32_t nowUs) {
+    _windowCm[_windowHead] = z;
+    _windowUs[_windowHead] = nowUs;
+    _windowHead = (uint8_t)((_windowHead + 1) % RANGE_MEDIAN_WINDOW);
+    if (_windowCount < RANGE_MEDIAN_WINDOW) _windowCount++;
+
+    float sorted[RANGE_MEDIAN_WINDOW];
+    for (uint8_t i = 0; i < _windowCount; i++) {
+      float v = _windowCm[i] + _est.rateCmS * (float)(uint32_t)(nowUs - _windowUs[i]) * 1e-6f;
+      int j = i - 1;
+      while (j >= 0 && sorted[j] > v) {
+        sorted[j + 1] = sorted[j];
+        j--;
+      }
+      sorted[j + 1] = v;
+    }
+    return sorted[_windowCount / 2];
+  }
+
+  void startTrack(float z, uint32_t nowUs) {
+    _tracking = true;
+    _outlierRun = 0;
+    _windowCount = 0;
+    _windowHead = 0;
+    median(z, nowUs);
+    _est.distanceCm = z;
+    _est.rateCmS = 0;
+    _est.updatedUs = nowUs;
+    _est.confidence = 25;
+    _est.flags &= (uint8_t)~RANGE_OUTLIER;
+    _stats.accepted++;
+    updateValid();
+  }
+
+  void raiseConfidence(uint8_t step) {
+    _est.confidence = (uint8_t)(_est.confidence + step > 100 ? 100 : _est.confidence + step);
+    updateValid();
+  }
+
+  void lowerConfidence(uint8_t step) {
+    _est.confidence = (uint8_t)(_est.confidence > step ? _est.confidence - step : 0);
+    updateValid();
+  }
+
+  void updateValid() {
+    if (_tracking && _est.confidence >= RANGE_MIN_CONFIDENCE) _est.flags |= RANGE_VALID;
+    else _est.flags &= (uint8_t)~RANGE_VALID;
+  }
+};
+
+#endif
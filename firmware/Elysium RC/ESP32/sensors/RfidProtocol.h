@@ -0,0 +1,198 @@
+#ifndef RFID_PROTOCOL_H
+#define RFID_PROTOCOL_H
+
+/**
+ * Protocolul binar al cititorului UHF YRM1003 (setul de comenzi MagicRF M100),
+ * fără dependențe Arduino, testat pe calculator în tools/rfid.
+ *
+ * Cadru (lungimea parametrilor MSB întâi):
+ *   0xBB | tip | comandă | PL (u16) | parametri[PL] | sumă de control | 0x7E
+ * Suma de control este octetul de jos al sumei câmpurilor de la tip la ultimul parametru.
+ *
+ * Tipuri: 0x00 comandă (ESP32 -> cititor), 0x01 răspuns, 0x02 notificare (un tag citit).
+ * Notificarea unui tag (comanda 0x22, în citirea simplă și în inventarul continuu):
+ *   RSSI (i8, dBm) | PC (u16) | EPC[PL - 5] | CRC tag (u16)
+ * Răspunsul de eroare (comanda 0xFF) are un singur parametru, codul erorii
+ * (0x15 = niciun tag în runda curentă).
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+
+#define RFID_FRAME_HEADER 0xBB
+#define RFID_FRAME_END 0x7E
+
+#define RFID_TYPE_COMMAND 0x00
+#define RFID_TYPE_RESPONSE 0x01
+#define RFID_TYPE_NOTICE 0x02
+
+#define RFID_CMD_SINGLE_POLL 0x22
+#define RFID_CMD_MULTI_POLL 0x27
+#define RFID_CMD_STOP_POLL 0x28
+#define RFID_CMD_ERROR 0xFF
+#define RFID_ERROR_NO_TAG 0x15
+
+#define RFID_MAX_PARAMS 64
+#define RFID_MAX_FRAME (RFID_MAX_PARAMS + 7)
+#define RFID_EPC_MAX 12                  // EPC-uri de 96 de biți; cele mai lungi sunt numărate și ignorate
+
+// EPC-ul unui tag, de dimensiune fixă
+struct RfidEpc {
+  uint8_t len;
+  uint8_t bytes[RFID_EPC_MAX];
+
+  bool operator==(const RfidEpc& other) const {
+    return len == other.len && memcmp(bytes, other.bytes, len) == 0;
+  }
+};
+
+// O citire de tag din notificarea 0x22
+struct RfidTagRead {
+  RfidEpc epc;
+  int8_t rssi;                // dBm
+  uint16_t pc;
+};
+
+// Scrie o comandă în out (minim RFID_MAX_FRAME octeți); întoarce lungimea, 0 dacă parametrii nu încap
+static inline size_t rfidEncodeCommand(uint8_t command, const uint8_t* params, uint16_t len, uint8_t* out) {
+  if (len > RFID_MAX_PARAMS) return 0;
+  out[0] = RFID_FRAME_HEADER;
+  out[1] = RFID_TYPE_COMMAND;
+  out[2] = command;
+  out[3] = (uint8_t)(len >> 8);
+  out[4] = (uint8_t)len;
+  if (len > 0) memcpy(out + 5, params, len);
+  uint8_t sum = 0;
+  for (uint16_t i = 1; i < 5 + len; i++) sum += out[i];
+  out[5 + len] = sum;
+  out[6 + len] = RFID_FRAME_END;
+  return 7 + len;
+}
+
+// EPC-ul în hex majuscule (minim 2 * RFID_EPC_MAX + 1 caractere)
+static inline void rfidEpcToHex(const RfidEpc& epc, char* out) {
+  static const char digits[] = "0123456789ABCDEF";
+  for (uint8_t i = 0; i < epc.len; i++) {
+    out[2 * i] = digits[epc.bytes[i] >> 4];
+    out[2 * i + 1] = digits[epc.bytes[i] & 0x0F];
+  }
+  out[2 * epc.len] = '\0';
+}
+
+/**
+ * Decodor incremental: primește octet cu octet și se resincronizează singur pe următorul 0xBB.
+ * Un cadru valid rămâne disponibil prin type()/command()/params() până la următorul push().
+ */
+class RfidDecoder {
+public:
+  uint32_t framesOk;
+  uint32_t checksumErrors;  // sumă de control greșită sau lipsa lui 0x7E
+  uint32_t oversize;        // parametri mai lungi decât RFID_MAX_PARAMS sau EPC peste RFID_EPC_MAX
+  uint32_t resyncBytes;     // octeți ignorați în afara unui cadru
+
+  RfidDecoder() : framesOk(0), checksumErrors(0), oversize(0), resyncBytes(0),
+                  _state(0), _type(0), _command(0), _len(0), _pos(0), _sum(0) {}
+
+  // Întoarce true când un cadru complet și valid a fost primit
+  bool push(uint8_t b) {
+    switch (_state) {
+      case 0:
+        if (b == RFID_FRAME_HEADER) {
+          _state = 1;
+          _sum = 0;
+        } else {
+          resyncBytes++;
+        }
+        return false;
+      case 1:
+        _type = b;
+        _sum += b;
+        _state = 2;
+        return false;
+      case 2:
+        _command = b;
+        _sum += b;
+        _state = 3;
+        return false;
+      case 3:
+        _len = (uint16_t)b << 8;
+        _sum += b;
+        _state = 4;
+        return false;
+      case 4:
+        _len |= b;
+        _sum += b;
+        _pos = 0;
+        if (_len > RFID_MAX_PARAMS) {
+          oversize++;
+          _state = 0;
+        } else {
+          _state = _len > 0 ? 5 : 6;
+        }
+        return false;
+      case 5:
+        _params[_pos++] = b;
+        _sum += b;
+        if (_pos == _len) _state = 6;
+        return false;
+      case 6:
+        if (b != _sum) {
+          checksumErrors++;
+          _state = (b == RFID_FRAME_HEADER) ? 1 : 0;
+          _sum = 0;
+          return false;
+        }
+        _state = 7;
+        return false;
+      default:
+        _state = 0;
+        if (b != RFID_FRAME_END) {
+          checksumErrors++;
+          if (b == RFID_FRAME_HEADER) {
+            _state = 1;
+            _sum = 0;
+          }
+          return false;
+        }
+        framesOk++;
+        return true;
+    }
+  }
+
+  uint8_t type() const { return _type; }
+  uint8_t command() const { return _command; }
+  uint16_t paramsLen() const { return _len; }
+  const uint8_t* params() const { return _params; }
+
+  // Interpretează ultimul cadru ca notificarea unui tag
+  bool tagRead(RfidTagRead& out) {
+    if (_type != RFID_TYPE_NOTICE || _command != RFID_CMD_SINGLE_POLL || _len < 5) return false;
+    uint16_t epcLen = _len - 5;
+    if (epcLen == 0 || epcLen > RFID_EPC_MAX) {
+      oversize++;
+      return false;
+    }
+    out.rssi = (int8_t)_params[0];
+    out.pc = (uint16_t)((_params[1] << 8) | _params[2]);
+    out.epc.len = (uint8_t)epcLen;
+    memcpy(out.epc.bytes, _params + 3, epcLen);
+    return true;
+  }
+
+  // Codul erorii din ultimul cadru, -1 dacă nu este un răspuns de eroare
+  int errorCode() const {
+    return (_type == RFID_TYPE_RESPONSE && _command == RFID_CMD_ERROR && _len >= 1) ? _params[0] : -1;
+  }
+
+private:
+  uint8_t _params[RFID_MAX_PARAMS];
+  uint8_t _state;
+  uint8_t _type;
+  uint8_t _command;
+  uint16_t _len;
+  uint16_t _pos;
+  uint8_t _sum;
+};
+
+#endif
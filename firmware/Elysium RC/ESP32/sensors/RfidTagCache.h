@@ -0,0 +1,195 @@
+#ifndef RFID_TAG_CACHE_H
+#define RFID_TAG_CACHE_H
+
+/**
+ * Tag-urile din câmpul cititorului, fără dependențe Arduino și fără alocări.
+ *
+ * Tabel de dispersie cu adresare deschisă (sondare liniară, cheia = EPC-ul binar, FNV-1a),
+ * RFID_CACHE_SLOTS locuri dintre care cel mult RFID_CACHE_MAX_TAGS ocupate, ca sondele să
+ * rămână scurte. Fiecare tag are momentul primei și ultimei citiri, numărul de citiri și RSSI.
+ *
+ * Evenimentele se emit o singură dată: sosirea la prima citire, plecarea când tagul nu a mai
+ * fost citit de departMs (sau când este înlocuit, cu tabelul plin, de un tag nou).
+ */
+
+#include <stdint.h>
+#include "RfidProtocol.h"
+
+#define RFID_CACHE_SLOTS 32              // putere a lui 2
+#define RFID_CACHE_MAX_TAGS 16           // încărcare de cel mult 50%
+#define RFID_DEPART_MS 500               // fără citiri atât timp: tagul a ieșit din câmp
+
+enum RfidTagEventType {
+  RFID_TAG_ARRIVED = 0,
+  RFID_TAG_DEPARTED = 1
+};
+
+struct RfidTagEvent {
+  uint8_t type;               // RfidTagEventType
+  RfidEpc epc;
+  int8_t rssi;                // ultima citire; la plecare, cea mai puternică
+  uint32_t firstSeenMs;
+  uint32_t lastSeenMs;
+  uint32_t reads;
+};
+
+struct RfidCacheStats {
+  uint32_t reads;
+  uint32_t arrivals;
+  uint32_t departures;
+  uint32_t evictions;         // plecări forțate de un tabel plin
+  uint16_t maxProbe;          // cea mai lungă sondare
+};
+
+class RfidTagCache {
+public:
+  explicit RfidTagCache(uint32_t departMs = RFID_DEPART_MS) : _departMs(departMs), _count(0), _stats() {
+    for (int i = 0; i < RFID_CACHE_SLOTS; i++) _slots[i].used = false;
+  }
+
+  /**
+   * O citire de tag. Întoarce true dacă a produs evenimente: sosirea tagului în arrival și,
+   * dacă tabelul era plin, plecarea forțată a celui mai vechi în evicted (evictedValid).
+   */
+  bool observe(const RfidTagRead& read, uint32_t nowMs, RfidTagEvent& arrival,
+               RfidTagEvent& evicted, bool& evictedValid) {
+    evictedValid = false;
+    _stats.reads++;
+    int index = find(read.epc);
+    if (index >= 0) {
+      Slot& s = _slots[index];
+      s.lastSeenMs = nowMs;
+      s.reads++;
+      s.rssi = read.rssi;
+      if (read.rssi > s.maxRssi) s.maxRssi = read.rssi;
+      return false;
+    }
+
+    if (_count >= RFID_CACHE_MAX_TAGS) {
+      int oldest = -1;
+      for (int i = 0; i < RFID_CACHE_SLOTS; i++) {
+        if (_slots[i].used && (oldest < 0 || (int32_t)(_slots[i].lastSeenMs - _slots[oldest].lastSeenMs) < 0)) {
+          oldest = i;
+        }
+      }
+      fill(evicted, RFID_TAG_DEPARTED, _slots[oldest]);
+      evictedValid = true;
+      _stats.evictions++;
+      _stats.departures++;
+      remove(oldest);
+    }
+
+    index = insert(read.epc);
+    Slot& s = _slots[index];
+    s.firstSeenMs = s.lastSeenMs = nowMs;
+    s.reads = 1;
+    s.rssi = s.maxRssi = read.rssi;
+    _stats.arrivals++;
+    fill(arrival, RFID_TAG_ARRIVED, s);
+    return true;
+  }
+
+  // Întoarce true și un eveniment de plecare pentru primul tag necitit de departMs
+  bool expire(uint32_t nowMs, RfidTagEvent& departure) {
+    for (int i = 0; i < RFID_CACHE_SLOTS; i++) {
+      if (_slots[i].used && nowMs - _slots[i].lastSeenMs >= _departMs) {
+        fill(departure, RFID_TAG_DEPARTED, _slots[i]);
+        _stats.departures++;
+        remove(i);
+        return true;
+      }
+    }
+    return false;
+  }
+
+  // Tagul, dacă este acum în câmp
+  bool lookup(const RfidEpc& epc, RfidTagEvent& out) const {
+    int index = find(epc);
+    if (index < 0) return false;
+    fill(out, RFID_TAG_ARRIVED, _slots[index]);
+    return true;
+  }
+
+  int count() const { return _count; }
+  const RfidCacheStats& stats() const { return _stats; }
+
+private:
+  struct Slot {
+    bool used;
+    RfidEpc epc;
+    int8_t rssi;
+    int8_t maxRssi;
+    uint32_t firstSeenMs;
+    uint32_t lastSeenMs;
+    uint32_t reads;
+  };
+
+  Slot _slots[RFID_CACHE_SLOTS];
+  uint32_t _departMs;
+  int _count;
+  RfidCacheStats _stats;
+
+  static uint32_t hash(const RfidEpc& epc) {
+    uint32_t h = 2166136261u;
+    for (uint8_t i = 0; i < epc.len; i++) {
+      h ^= epc.bytes[i];
+      h *= 16777619u;
+    }
+    return h;
+  }
+
+  static void fill(RfidTagEvent& e, uint8_t type, const Slot& s) {
+    e.type = type;
+    e.epc = s.epc;
+    e.rssi = type == RFID_TAG_DEPARTED ? s.maxRssi : s.rssi;
+    e.firstSeenMs = s.firstSeenMs;
+    e.lastSeenMs = s.lastSeenMs;
+    e.reads = s.reads;
+  }
+
+  int find(const RfidEpc& epc) const {
+    uint32_t i = hash(epc) & (RFID_CACHE_SLOTS - 1);
+    for (int probe = 0; probe < RFID_CACHE_SLOTS; probe++) {
+      const Slot& s = _slots[i];
+      if (!s.used) return -1;
+      if (s.epc == epc) return (int)i;
+      i = (i + 1) & (RFID_CACHE_SLOTS - 1);
+    }
+    return -1;
+  }
+
+  int insert(const RfidEpc& epc) {
+    uint32_t i = hash(epc) & (RFID_CACHE_SLOTS - 1);
+    uint16_t probe = 0;
+    while (_slots[i].used) {
+      i = (i + 1) & (RFID_CACHE_SLOTS - 1);
+      probe++;
+    }
+    if (probe > _stats.maxProbe) _stats.maxProbe = probe;
+    _slots[i].used = true;
+    _slots[i].epc = epc;
+    _count++;
+    return (int)i;
+  }
+
+  // Ștergere cu deplasare înapoi: intrările următoare din aceeași sondare își păstrează drumul
+  void remove(int index) {
+    uint32_t hole = (uint32_t)index;
+    uint32_t i = hole;
+    _slots[hole].used = false;
+    _count--;
+    while (true) {
+      i = (i + 1) & (RFID_CACHE_SLOTS - 1);
+      if (!_slots[i].used) return;
+      uint32_t home = hash(_slots[i].epc) & (RFID_CACHE_SLOTS - 1);
+      // Intrarea i poate umple gaura doar dacă locul ei de start nu este între gaură și i
+      bool between = hole <= i ? (home > hole && home <= i) : (home > hole || home <= i);
+      if (between) continue;
+      _slots[hole] = _slots[i];
+      _slots[i].used = false;
+      hole = i;
+    }
+  }
+};
+
+#endif
@@ -0,0 +1,96 @@
+#ifndef ULTRASONIC_PROFILE_H
+#define ULTRASONIC_PROFILE_H
+
+#include <stdint.h>
+#include <utility>
+#include <type_traits>
+
+/**
+ * Profilul hardware al senzorilor ultrasonici, declarat o singură dată, la compilare:
+ * pinii, unghiul de montaj, tonul buzzer-ului și pragul de avertizare ale fiecărui canal.
+ *
+ *  - ordinea din tabel este ordinea declanșării și indexul canalului peste tot (cadrul
+ *    ultrasonic, filtrele pipeline-ului, jurnalul înregistratorului); primele patru canale
+ *    sunt aceleași pe toate șasiurile, ca înregistrările să rămână compatibile
+ *  - SENSOR_FRONT/LEFT/BACK/RIGHT se caută în tabel după unghi, tot la compilare
+ *  - forEachUltrasonic() generează corpul buclei pentru fiecare canal, cu indexul ca
+ *    constantă: specificația canalului se pliază în cod, fără salt după index
+ *
+ * Un senzor nou se adaugă doar în tabelul șasiului, ales cu ELYSIUM_CHASSIS.
+ */
+
+#define ELYSIUM_CHASSIS_STANDARD 0   // față, stânga, spate, dreapta
+#define ELYSIUM_CHASSIS_LARGE 1      // plus doi senzori față-lateral, la 45 de grade
+
+#ifndef ELYSIUM_CHASSIS
+#define ELYSIUM_CHASSIS ELYSIUM_CHASSIS_STANDARD
+#endif
+
+#define ULTRASONIC_WARN_CM 50        // pragul implicit al avertizării sonore
+#define ULTRASONIC_MAX_CHANNELS 8    // validMask din UltrasonicFrame are 8 biți
+
+struct UltrasonicChannelSpec {
+  const char* name;
+  uint8_t trigPin;
+  uint8_t echoPin;
+  int16_t mountDeg;    // față de axa mașinii: 0 înainte, 90 stânga, 180 înapoi, -90 dreapta
+  uint16_t toneHz;     // tonul buzzer-ului când acest canal vede obstacolul cel mai apropiat
+  uint16_t warnCm;     // sub această distanță buzzer-ul avertizează
+};
+
+static constexpr UltrasonicChannelSpec ULTRASONIC_CHANNELS[] = {
+  { "față",    13, 12,   0, 1000, ULTRASONIC_WARN_CM },
+  { "stânga",  26, 25,  90,  800, ULTRASONIC_WARN_CM },
+  { "spate",   14, 27, 180,  600, ULTRASONIC_WARN_CM },
+  { "dreapta", 33, 32, -90, 1200, ULTRASONIC_WARN_CM },
+#if ELYSIUM_CHASSIS == ELYSIUM_CHASSIS_LARGE
+  // GPIO 34/35 sunt doar intrări, bune pentru ECHO; GPIO 2 (strapping) rămâne LOW la pornire
+  { "față-stânga",   4, 34,  45,  900, 40 },
+  { "față-dreapta",  2, 35, -45, 1100, 40 },
+#endif
+};
+
+static constexpr int ULTRASONIC_SENSOR_COUNT = sizeof(ULTRASONIC_CHANNELS) / sizeof(ULTRASONIC_CHANNELS[0]);
+
+static_assert(ULTRASONIC_SENSOR_COUNT >= 1, "profilul are cel puțin un senzor ultrasonic");
+static_assert(ULTRASONIC_SENSOR_COUNT <= ULTRASONIC_MAX_CHANNELS, "prea mulți senzori pentru validMask");
+
+// Indexul canalului montat la unghiul dat, -1 dacă lipsește
+static constexpr int ultrasonicChannelAt(int mountDeg) {
+  for (int i = 0; i < ULTRASONIC_SENSOR_COUNT; i++) {
+    if (ULTRASONIC_CHANNELS[i].mountDeg == mountDeg) return i;
+  }
+  return -1;
+}
+
+// Canalele pe care le folosesc frâna automată, telemetria și jurnalul
+enum UltrasonicSensorId {
+  SENSOR_FRONT = ultrasonicChannelAt(0),
+  SENSOR_LEFT  = ultrasonicChannelAt(90),
+  SENSOR_BACK  = ultrasonicChannelAt(180),
+  SENSOR_RIGHT = ultrasonicChannelAt(-90)
+};
+
+static_assert(SENSOR_FRONT >= 0 && SENSOR_LEFT >= 0 && SENSOR_BACK >= 0 && SENSOR_RIGHT >= 0,
+              "profilul trebuie să aibă senzori în față, stânga, spate și dreapta");
+
+template <typename F, int... I>
+static inline void ultrasonicUnroll(F& f, std::integer_sequence<int, I...>) {
+  (f(std::integral_constant<int, I>()), ...);
+}
+
+/**
+ * Corpul f, desfăcut pentru fiecare canal:
+ *
+ *   forEachUltrasonic([&](auto ch) {
+ *     constexpr int i = decltype(ch)::value;
+ *     constexpr UltrasonicChannelSpec spec = ULTRASONIC_CHANNELS[i];
+ *     ...
+ *   });
+ */
+template <typename F>
+static inline void forEachUltrasonic(F&& f) {
+  ultrasonicUnroll(f, std::make_integer_sequence<int, ULTRASONIC_SENSOR_COUNT>());
+}
+
+#endif
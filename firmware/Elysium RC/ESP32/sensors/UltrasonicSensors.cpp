@@ -1,31 +1,86 @@
 #include "UltrasonicSensors.h"
+#include "driver/gpio.h"
 
-// Declară variabilele globale
-volatile long distanceFront = -1;
-volatile long distanceBack  = -1;
-volatile long distanceLeft  = -1;
-volatile long distanceRight = -1;
+SeqLock<UltrasonicFrame> ultrasonicSnapshot;
+
+// Copia locală a scriitorului, din care se publică fiecare cadru nou; distanțele pornesc de la -1
+static UltrasonicFrame currentUltrasonicFrame;
+
+// Starea unui canal de ecou, completată din întrerupere. Pinii se copiază din profil în RAM:
+// întreruperea nu citește tabelul din flash
+struct EchoChannel {
+  uint8_t trigPin;
+  uint8_t echoPin;
+  volatile bool armed;          // canalul așteaptă un ecou după declanșare
+  volatile bool risen;          // a fost văzut frontul crescător
+  volatile bool done;           // măsurătoare completă, gata de publicat
+  volatile unsigned long riseUs;
+  volatile unsigned long fallUs;
+};
+
+static EchoChannel echoChannels[ULTRASONIC_SENSOR_COUNT];
+
+// Cel mai lung timp petrecut într-un apel readSensorsSequentially()
+static unsigned long ultrasonicMaxStallUs = 0;
+
+// Taskul trezit de întrerupere la sfârșitul fiecărui ecou (taskul de achiziție)
+static TaskHandle_t ultrasonicNotifyTask = NULL;
+
+// Întrerupere pe ambele fronturi ale pinului ECHO: marchează începutul și sfârșitul ecoului
+static void IRAM_ATTR echoISR(void* arg) {
+  EchoChannel* ch = (EchoChannel*)arg;
+  unsigned long now = micros();
+
+  if (!ch->armed) return;
+
+  if (gpio_get_level((gpio_num_t)ch->echoPin)) {
+    ch->riseUs = now;
+    ch->risen = true;
+  } else if (ch->risen) {
+    ch->fallUs = now;
+    ch->armed = false;
+    ch->done = true;
+
+    if (ultrasonicNotifyTask != NULL) {
+      BaseType_t woken = pdFALSE;
+      vTaskNotifyGiveFromISR(ultrasonicNotifyTask, &woken);
+      if (woken) portYIELD_FROM_ISR();
+    }
+  }
+}
+
+// Conversie durată ecou (µs) -> cm, în aritmetică întreagă (0.034 / 2 = 17 / 1000)
+static long echoToCM(unsigned long durationUs) {
+  return (durationUs > 0) ? (long)((durationUs * 17UL) / 1000UL) : -1;
+}
 
 void UltrasonicSensors_init() {
   // Configurarea pinilor
-  Serial.println("\nConfigurare senzori ultrasonici...");
-  pinMode(TRIG_FRONT, OUTPUT);
-  pinMode(ECHO_FRONT, INPUT);
-  pinMode(TRIG_BACK, OUTPUT);
-  pinMode(ECHO_BACK, INPUT);
-  pinMode(TRIG_LEFT, OUTPUT);
-  pinMode(ECHO_LEFT, INPUT);
-  pinMode(TRIG_RIGHT, OUTPUT);
-  pinMode(ECHO_RIGHT, INPUT);
+  Serial.printf("\nConfigurare %d senzori ultrasonici...\n", ULTRASONIC_SENSOR_COUNT);
+  forEachUltrasonic([](auto ch) {
+    constexpr int i = decltype(ch)::value;
+    constexpr UltrasonicChannelSpec spec = ULTRASONIC_CHANNELS[i];
+    echoChannels[i].trigPin = spec.trigPin;
+    echoChannels[i].echoPin = spec.echoPin;
+    currentUltrasonicFrame.distance[i] = -1;
+
+    pinMode(spec.trigPin, OUTPUT);
+    digitalWrite(spec.trigPin, LOW);
+    pinMode(spec.echoPin, INPUT);
+#if !ULTRASONIC_BLOCKING_PULSEIN
+    attachInterruptArg(digitalPinToInterrupt(spec.echoPin), echoISR, &echoChannels[i], CHANGE);
+#endif
+  });
 }
 
 long readDistanceCM(int trigPin, int echoPin) {
+  // Variantă blocantă (până la 30 ms), folosită doar când ULTRASONIC_BLOCKING_PULSEIN = 1
   // Dezactivăm toți ceilalți pini TRIG
-  if (trigPin != TRIG_FRONT) digitalWrite(TRIG_FRONT, LOW);
-  if (trigPin != TRIG_BACK) digitalWrite(TRIG_BACK, LOW);
-  if (trigPin != TRIG_LEFT) digitalWrite(TRIG_LEFT, LOW);
-  if (trigPin != TRIG_RIGHT) digitalWrite(TRIG_RIGHT, LOW);
-  
+  forEachUltrasonic([trigPin](auto ch) {
+    constexpr uint8_t pin = ULTRASONIC_CHANNELS[decltype(ch)::value].trigPin;
+    if (trigPin != pin) digitalWrite(pin, LOW);
+  });
+
   delayMicroseconds(100);
   
   digitalWrite(trigPin, LOW);
@@ -34,39 +89,112 @@ long readDistanceCM(int trigPin, int echoPin) {
   delayMicroseconds(10);
   digitalWrite(trigPin, LOW);
   
-  long duration = pulseIn(echoPin, HIGH, 30000);
-  return (duration > 0) ? duration * 0.034 / 2 : -1;
+  long duration = pulseIn(echoPin, HIGH, ULTRASONIC_TIMEOUT_US);
+  return echoToCM(duration);
 }
 
-void readSensorsSequentially() {
+// Pornește o măsurătoare: puls de 10 µs pe TRIG, ecoul este urmărit din întrerupere
+static void triggerSensor(EchoChannel& ch) {
+  ch.risen = false;
+  ch.done = false;
+  ch.armed = true;
+
+  digitalWrite(ch.trigPin, LOW);
+  delayMicroseconds(2);
+  digitalWrite(ch.trigPin, HIGH);
+  delayMicroseconds(10);
+  digitalWrite(ch.trigPin, LOW);
+}
+
+static void publishDistance(int index, long distance, unsigned long captureUs) {
+  currentUltrasonicFrame.distance[index] = distance;
+  currentUltrasonicFrame.timestampUs[index] = captureUs;
+  if (distance >= 0) {
+    currentUltrasonicFrame.validMask |= (1 << index);
+  } else {
+    currentUltrasonicFrame.validMask &= ~(1 << index);
+  }
+  currentUltrasonicFrame.sequence++;
+  ultrasonicSnapshot.write(currentUltrasonicFrame);
+}
+
+// Timpul rămas până când intervalul dintre doi senzori permite o nouă declanșare
+static unsigned long untilNextTriggerUs(unsigned long lastReadTime) {
+  unsigned long elapsedMs = millis() - lastReadTime;
+  return (elapsedMs > ULTRASONIC_INTERVAL_MS) ? 0 : (ULTRASONIC_INTERVAL_MS + 1 - elapsedMs) * 1000UL;
+}
+
+/**
+ * Avansează măsurătorile fără a aștepta ecoul.
+ * Întoarce după câte microsecunde trebuie apelată din nou (dacă nu sosește mai devreme un ecou).
+ */
+unsigned long readSensorsSequentially() {
   static unsigned long lastReadTime = 0;
+  static unsigned long triggerUs = 0;
   static int currentSensor = 0;
-  
-  if (millis() - lastReadTime > 50) {
+  static bool waiting = false;
+
+  unsigned long startUs = micros();
+  unsigned long nextUs;
+
+#if ULTRASONIC_BLOCKING_PULSEIN
+  if (millis() - lastReadTime > ULTRASONIC_INTERVAL_MS) {
     lastReadTime = millis();
-    
-    switch (currentSensor) {
-      case 0:
-        distanceFront = readDistanceCM(TRIG_FRONT, ECHO_FRONT);
-        break;
-      case 1:
-        distanceLeft = readDistanceCM(TRIG_LEFT, ECHO_LEFT);
-        break;
-      case 2:
-        distanceBack = readDistanceCM(TRIG_BACK, ECHO_BACK);
-        break;
-      case 3:
-        distanceRight = readDistanceCM(TRIG_RIGHT, ECHO_RIGHT);
-        break;
+    EchoChannel& ch = echoChannels[currentSensor];
+    publishDistance(currentSensor, readDistanceCM(ch.trigPin, ch.echoPin), micros());
+    currentSensor = (currentSensor + 1) % ULTRASONIC_SENSOR_COUNT;
+  }
+  nextUs = untilNextTriggerUs(lastReadTime);
+#else
+  // Nu așteptăm niciodată ecoul aici: doar publicăm rezultatul dacă întreruperea l-a completat
+  if (waiting) {
+    EchoChannel& ch = echoChannels[currentSensor];
+
+    if (ch.done) {
+      publishDistance(currentSensor, echoToCM(ch.fallUs - ch.riseUs), ch.fallUs);
+      waiting = false;
+    } else if (micros() - triggerUs > ULTRASONIC_TIMEOUT_US) {
+      ch.armed = false;
+      publishDistance(currentSensor, -1, micros());
+      waiting = false;
+    }
+
+    if (!waiting) {
+      currentSensor = (currentSensor + 1) % ULTRASONIC_SENSOR_COUNT;
     }
-    
-    currentSensor = (currentSensor + 1) % 4;
   }
+
+  if (!waiting && millis() - lastReadTime > ULTRASONIC_INTERVAL_MS) {
+    lastReadTime = millis();
+    triggerSensor(echoChannels[currentSensor]);
+    triggerUs = micros();
+    waiting = true;
+  }
+
+  if (waiting) {
+    // Până la expirarea ecoului; întreruperea ne trezește mai devreme
+    unsigned long waited = micros() - triggerUs;
+    nextUs = (waited < ULTRASONIC_TIMEOUT_US) ? ULTRASONIC_TIMEOUT_US - waited : 0;
+  } else {
+    nextUs = untilNextTriggerUs(lastReadTime);
+  }
+#endif
+
+  unsigned long elapsed = micros() - startUs;
+  if (elapsed > ultrasonicMaxStallUs) {
+    ultrasonicMaxStallUs = elapsed;
+  }
+  return nextUs;
+}
+
+void UltrasonicSensors_setNotifyTask(TaskHandle_t task) {
+  ultrasonicNotifyTask = task;
+}
+
+unsigned long UltrasonicSensors_getMaxStallUs() {
+  return ultrasonicMaxStallUs;
 }
 
-String getSensorDataString() {
-  return String(distanceFront) + "," + 
-         String(distanceBack) + "," + 
-         String(distanceLeft) + "," + 
-         String(distanceRight);
+UltrasonicFrame UltrasonicSensors_getFrame() {
+  return ultrasonicSnapshot.read();
 }
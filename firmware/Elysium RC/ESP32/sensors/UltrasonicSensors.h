@@ -2,28 +2,45 @@
 #define ULTRASONIC_SENSORS_H
 
 #include <Arduino.h>
+#include "../core/SeqLock.h"
+#include "UltrasonicProfile.h"   // pinii și canalele: ULTRASONIC_CHANNELS, SENSOR_FRONT...
 
-// Definițiile pinilor
-#define TRIG_FRONT 13
-#define ECHO_FRONT 12
-#define TRIG_BACK 14
-#define ECHO_BACK 27
-#define TRIG_LEFT 26
-#define ECHO_LEFT 25
-#define TRIG_RIGHT 33
-#define ECHO_RIGHT 32
 #define OBSTACLE_DISTANCE 30  // distanta de detectie
 
-// Declară variabile externe
-extern volatile long distanceFront;
-extern volatile long distanceBack;
-extern volatile long distanceLeft;
-extern volatile long distanceRight;
+// Parametrii de măsurare
+#define ULTRASONIC_TIMEOUT_US 30000   // ecou maxim așteptat (~5 m)
+#define ULTRASONIC_INTERVAL_MS 50     // pauză între declanșarea a doi senzori (evită interferențele)
+
+// 1 = vechea metodă blocantă cu pulseIn(), păstrată doar pentru comparație
+#ifndef ULTRASONIC_BLOCKING_PULSEIN
+#define ULTRASONIC_BLOCKING_PULSEIN 0
+#endif
+
+// Cadru coerent cu ultimele măsurători ale tuturor senzorilor
+struct UltrasonicFrame {
+  long distance[ULTRASONIC_SENSOR_COUNT];            // cm, -1 dacă senzorul nu a răspuns
+  unsigned long timestampUs[ULTRASONIC_SENSOR_COUNT]; // momentul capturii fiecărui canal
+  uint8_t validMask;                                 // bitul i setat = distance[i] este valid
+  uint32_t sequence;                                 // crește la fiecare măsurătoare publicată
+
+  bool isValid(int sensor) const {
+    return (validMask >> sensor) & 1;
+  }
+
+  unsigned long ageUs(int sensor, unsigned long nowUs) const {
+    return nowUs - timestampUs[sensor];
+  }
+};
+
+// Ultimul cadru publicat; scris doar de readSensorsSequentially()
+extern SeqLock<UltrasonicFrame> ultrasonicSnapshot;
 
 // Funcții
 void UltrasonicSensors_init();
 long readDistanceCM(int trigPin, int echoPin);
-void readSensorsSequentially();
-String getSensorDataString();
+unsigned long readSensorsSequentially();
+UltrasonicFrame UltrasonicSensors_getFrame();
+unsigned long UltrasonicSensors_getMaxStallUs();
+void UltrasonicSensors_setNotifyTask(TaskHandle_t task);
 
 #endif
@@ -0,0 +1,115 @@
+#ifndef ALERT_PROTOCOL_H
+#define ALERT_PROTOCOL_H
+
+/**
+ * Alertele vehicul -> semne de circulație prin ESP-NOW, cu confirmare
+ * (fără dependențe Arduino, compilat la fel pe ESP32, ESP32-C3 și calculator).
+ *
+ * Cadru (ALERT_FRAME_LEN octeți, câmpurile LE):
+ *   magic 0xE1 0xA7 | versiune | tip | incident (u32) | seq (u16) |
+ *   eveniment | prioritate | severitate | ID semn
+ *
+ *  - ALERT_TYPE_ALERT: vehiculul anunță incidentul (ID semn = 0); fiecare transmisie,
+ *    inclusiv retransmisiile, primește un seq nou, crescător
+ *  - ALERT_TYPE_ACK: semnul confirmă unicast incidentul, cu seq-ul transmisiei primite
+ *    și propriul ID; confirmă fiecare retransmisie, dar afișează incidentul o singură dată
+ *
+ * Lungimea diferă de cea a mesajelor vechi (traffic_message 22, ElysiumMessage 34 octeți),
+ * deci receptoarele le pot deosebi și după lungime, nu doar după magic.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define ALERT_MAGIC_1 0xE1
+#define ALERT_MAGIC_2 0xA7
+#define ALERT_VERSION 1
+#define ALERT_FRAME_LEN 16
+
+#define ALERT_TYPE_ALERT 0x01
+#define ALERT_TYPE_ACK   0x02
+
+// Aceleași valori ca ElysiumEventType de pe semne
+#define ALERT_EVENT_NORMAL    0
+#define ALERT_EVENT_ACCIDENT  1
+#define ALERT_EVENT_OBSTACLE  2
+#define ALERT_EVENT_EMERGENCY 3
+
+#define ALERT_MAX_SIGN_ID 31           // ID-urile semnelor încap într-o mască de 32 de biți
+
+struct AlertFrame {
+  uint8_t type;
+  uint32_t incidentId;
+  uint16_t sequence;
+  uint8_t event;
+  uint8_t priority;           // 0 = normal, mai mare = mai urgent
+  uint8_t severity;           // 1-10
+  uint8_t signId;             // doar în confirmări
+};
+
+// Scrie cadrul în out (minim ALERT_FRAME_LEN octeți); întoarce lungimea
+static inline size_t alertEncode(const AlertFrame& f, uint8_t* out) {
+  out[0] = ALERT_MAGIC_1;
+  out[1] = ALERT_MAGIC_2;
+  out[2] = ALERT_VERSION;
+  out[3] = f.type;
+  out[4] = (uint8_t)f.incidentId;
+  out[5] = (uint8_t)(f.incidentId >> 8);
+  out[6] = (uint8_t)(f.incidentId >> 16);
+  out[7] = (uint8_t)(f.incidentId >> 24);
+  out[8] = (uint8_t)f.sequence;
+  out[9] = (uint8_t)(f.sequence >> 8);
+  out[10] = f.event;
+  out[11] = f.priority;
+  out[12] = f.severity;
+  out[13] = f.signId;
+  out[14] = 0;
+  out[15] = 0;
+  return ALERT_FRAME_LEN;
+}
+
+// Întoarce false pentru orice altceva decât un cadru de alertă valid
+static inline bool alertDecode(const uint8_t* data, size_t len, AlertFrame& f) {
+  if (len != ALERT_FRAME_LEN || data[0] != ALERT_MAGIC_1 || data[1] != ALERT_MAGIC_2 ||
+      data[2] != ALERT_VERSION) {
+    return false;
+  }
+  f.type = data[3];
+  if (f.type != ALERT_TYPE_ALERT && f.type != ALERT_TYPE_ACK) return false;
+  f.incidentId = (uint32_t)data[4] | ((uint32_t)data[5] << 8) | ((uint32_t)data[6] << 16) |
+                 ((uint32_t)data[7] << 24);
+  f.sequence = (uint16_t)(data[8] | (data[9] << 8));
+  f.event = data[10];
+  f.priority = data[11];
+  f.severity = data[12];
+  f.signId = data[13];
+  return true;
+}
+
+/**
+ * Ultimele incidente văzute de un semn: o retransmisie se confirmă din nou,
+ * dar nu se mai afișează și nu se mai propagă.
+ */
+template <int N>
+class AlertSeenCache {
+public:
+  AlertSeenCache() : _next(0), _count(0) {}
+
+  // Întoarce true dacă incidentul este nou (și îl reține)
+  bool insert(uint32_t incidentId) {
+    for (int i = 0; i < _count; i++) {
+      if (_ids[i] == incidentId) return false;
+    }
+    _ids[_next] = incidentId;
+    _next = (_next + 1) % N;
+    if (_count < N) _count++;
+    return true;
+  }
+
+private:
+  uint32_t _ids[N];
+  int _next;
+  int _count;
+};
+
+#endif
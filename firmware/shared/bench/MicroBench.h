@@ -0,0 +1,197 @@
+#ifndef MICRO_BENCH_H
+#define MICRO_BENCH_H
+
+/**
+ * Microbenchmark-uri pentru căile fierbinți ale firmware-urilor
+ * (fără dependențe Arduino, compilat la fel pe ESP32, ESP32-C3 și calculator).
+ *
+ * Un caz (BenchCase) rulează kernelul de `iterations` ori peste un corpus fix, pregătit o
+ * singură dată de `setup`. Numărul de iterații crește până când o rulare durează cel puțin
+ * minTimeUs, apoi rularea se repetă de `repetitions` ori; se raportează mediana, minimul și
+ * maximul timpului pe iterație.
+ *
+ * Ceasul vine de la apelant, ca tacturi pe 32 de biți: contorul de cicluri pe placă
+ * (MicroBenchArduino.h), steady_clock pe calculator (tools/host-sim/bench). O rulare trebuie
+ * să rămână sub 2^31 tacturi (~8 s la 240 MHz).
+ *
+ * Rezultatele se scriu în formatul JSON al Google Benchmark (context + benchmarks[]), deci
+ * capturile de pe placă și de pe calculator se compară cu aceleași unelte.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+
+#define BENCH_MAX_REPETITIONS 16
+
+struct BenchCase {
+  const char* name;                   // "firmware/kernel"
+  void (*setup)();                    // pregătește corpusul; poate fi NULL
+  void (*run)(uint32_t iterations);
+  uint32_t itemsPerIteration;         // elemente din corpus procesate într-o iterație
+};
+
+struct BenchClock {
+  uint32_t (*now)();                  // tacturi
+  uint32_t ticksPerUs;
+};
+
+struct BenchOptions {
+  uint32_t minTimeUs;                 // durata minimă a unei rulări măsurate
+  uint8_t repetitions;                // 1..BENCH_MAX_REPETITIONS
+  uint32_t maxIterations;
+  const char* filter;                 // subșir al numelui; NULL = toate cazurile
+};
+
+// Câmpurile din "context"; cele NULL sau 0 lipsesc din JSON
+struct BenchContext {
+  const char* executable;
+  const char* date;
+  const char* hostName;
+  uint32_t cpus;
+  uint32_t mhzPerCpu;
+  const char* buildType;
+};
+
+struct BenchResult {
+  const char* name;
+  uint32_t iterations;
+  float medianNs;                     // pe iterație
+  float minNs;
+  float maxNs;
+  uint32_t itemsPerIteration;
+};
+
+typedef void (*BenchWrite)(const char* text);
+
+// Împiedică compilatorul să elimine calculul unei valori nefolosite
+template <typename T>
+static inline void benchKeep(const T& value) {
+  asm volatile("" : : "r,m"(value) : "memory");
+}
+
+static inline uint8_t benchRepetitions(const BenchOptions& options) {
+  if (options.repetitions < 1) return 1;
+  return options.repetitions > BENCH_MAX_REPETITIONS ? BENCH_MAX_REPETITIONS : options.repetitions;
+}
+
+static inline uint32_t benchMeasure(const BenchCase& c, const BenchClock& clock, uint32_t iterations) {
+  uint32_t start = clock.now();
+  c.run(iterations);
+  return clock.now() - start;
+}
+
+static inline float benchTicksToNs(const BenchClock& clock, uint32_t ticks, uint32_t iterations) {
+  return (float)ticks * 1000.0f / (float)clock.ticksPerUs / (float)iterations;
+}
+
+/**
+ * Măsoară un caz: calibrează numărul de iterații (ca Google Benchmark, cel mult x10 pe pas),
+ * apoi repetă rularea și sortează timpii pentru mediană
+ */
+static inline BenchResult benchRun(const BenchCase& c, const BenchClock& clock, const BenchOptions& options) {
+  if (c.setup != NULL) c.setup();
+
+  uint64_t minTicks = (uint64_t)options.minTimeUs * clock.ticksPerUs;
+  uint32_t iterations = 1;
+  while (true) {
+    uint32_t ticks = benchMeasure(c, clock, iterations);
+    if (ticks >= minTicks || iterations >= options.maxIterations) break;
+    uint64_t next = ticks == 0 ? (uint64_t)iterations * 10
+                               : (uint64_t)iterations * minTicks * 14 / 10 / ticks + 1;
+    if (next > (uint64_t)iterations * 10) next = (uint64_t)iterations * 10;
+    if (next > options.maxIterations) next = options.maxIterations;
+    iterations = (uint32_t)next;
+  }
+
+  uint8_t repetitions = benchRepetitions(options);
+  float samples[BENCH_MAX_REPETITIONS];
+  for (uint8_t r = 0; r < repetitions; r++) {
+    float ns = benchTicksToNs(clock, benchMeasure(c, clock, iterations), iterations);
+    // Sortare prin inserție: cel mult BENCH_MAX_REPETITIONS valori
+    uint8_t i = r;
+    while (i > 0 && samples[i - 1] > ns) {
+      samples[i] = samples[i - 1];
+      i--;
+    }
+    samples[i] = ns;
+  }
+
+  BenchResult result;
+  result.name = c.name;
+  result.iterations = iterations;
+  result.medianNs = (repetitions % 2) ? samples[repetitions / 2]
+                                      : (samples[repetitions / 2 - 1] + samples[repetitions / 2]) / 2;
+  result.minNs = samples[0];
+  result.maxNs = samples[repetitions - 1];
+  result.itemsPerIteration = c.itemsPerIteration;
+  return result;
+}
+
+static inline void benchWriteContext(BenchWrite write, const BenchContext& context) {
+  char line[160];
+  write("{\n  \"context\": {\n");
+  if (context.date != NULL) {
+    snprintf(line, sizeof(line), "    \"date\": \"%s\",\n", context.date);
+    write(line);
+  }
+  if (context.hostName != NULL) {
+    snprintf(line, sizeof(line), "    \"host_name\": \"%s\",\n", context.hostName);
+    write(line);
+  }
+  if (context.cpus > 0) {
+    snprintf(line, sizeof(line), "    \"num_cpus\": %lu,\n", (unsigned long)context.cpus);
+    write(line);
+  }
+  if (context.mhzPerCpu > 0) {
+    snprintf(line, sizeof(line), "    \"mhz_per_cpu\": %lu,\n", (unsigned long)context.mhzPerCpu);
+    write(line);
+  }
+  snprintf(line, sizeof(line), "    \"library_build_type\": \"%s\",\n",
+           context.buildType != NULL ? context.buildType : "release");
+  write(line);
+  snprintf(line, sizeof(line), "    \"executable\": \"%s\"\n  },\n  \"benchmarks\": [",
+           context.executable != NULL ? context.executable : "");
+  write(line);
+}
+
+static inline void benchWriteResult(BenchWrite write, const BenchResult& r, size_t index, uint8_t repetitions) {
+  char line[200];
+  snprintf(line, sizeof(line), "%s\n    {\n      \"name\": \"%s\",\n      \"family_index\": %u,\n"
+           "      \"run_name\": \"%s\",\n      \"run_type\": \"iteration\",\n", index > 0 ? "," : "",
+           r.name, (unsigned)index, r.name);
+  write(line);
+  snprintf(line, sizeof(line), "      \"repetitions\": %u,\n      \"iterations\": %lu,\n"
+           "      \"real_time\": %.2f,\n      \"cpu_time\": %.2f,\n      \"time_unit\": \"ns\",\n",
+           (unsigned)repetitions, (unsigned long)r.iterations, r.medianNs, r.medianNs);
+  write(line);
+  // Contoarele proprii: dispersia între repetări și debitul corpusului
+  double itemsPerSecond = r.medianNs > 0 ? r.itemsPerIteration * 1e9 / r.medianNs : 0;
+  snprintf(line, sizeof(line), "      \"min_ns\": %.2f,\n      \"max_ns\": %.2f,\n"
+           "      \"items_per_second\": %.0f\n    }", r.minNs, r.maxNs, itemsPerSecond);
+  write(line);
+}
+
+/**
+ * Rulează cazurile care trec de filtru și scrie documentul JSON pe măsură ce avansează
+ * (fără alocări). Dacă results nu este NULL, primește rezultatele, în ordine (cel mult count).
+ * Întoarce numărul de cazuri rulate.
+ */
+static inline size_t benchRunAll(const BenchCase* cases, size_t count, const BenchClock& clock,
+                                 const BenchOptions& options, const BenchContext& context,
+                                 BenchWrite write, BenchResult* results = NULL) {
+  benchWriteContext(write, context);
+  size_t ran = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (options.filter != NULL && strstr(cases[i].name, options.filter) == NULL) continue;
+    BenchResult r = benchRun(cases[i], clock, options);
+    if (results != NULL) results[ran] = r;
+    benchWriteResult(write, r, ran, benchRepetitions(options));
+    ran++;
+  }
+  write("\n  ]\n}\n");
+  return ran;
+}
+
+#endif
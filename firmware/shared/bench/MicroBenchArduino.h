@@ -0,0 +1,42 @@
+#ifndef MICRO_BENCH_ARDUINO_H
+#define MICRO_BENCH_ARDUINO_H
+
+/**
+ * Rularea microbenchmark-urilor pe placă (ESP32, ESP32-C3): ceasul este contorul de cicluri
+ * al procesorului (ESP.getCycleCount()), iar documentul JSON pleacă pe portul serial între
+ * liniile BENCH_BEGIN și BENCH_END, ca să poată fi extras dintr-o captură cu jurnal.
+ */
+
+#include <Arduino.h>
+#include "MicroBench.h"
+
+#define BENCH_BOARD_MIN_TIME_US 200000
+#define BENCH_BOARD_REPETITIONS 5
+
+static Print* benchBoardOut = NULL;
+
+static inline uint32_t benchBoardCycles() {
+  return ESP.getCycleCount();
+}
+
+static inline void benchBoardWrite(const char* text) {
+  benchBoardOut->print(text);
+}
+
+/**
+ * Rulează toate cazurile și tipărește rezultatele pe out. Se apelează din setup(), înainte de
+ * pornirea celorlalte taskuri ale aplicației, ca măsurătorile să nu fie întrerupte de ele.
+ */
+static inline void benchRunOnBoard(const BenchCase* cases, size_t count, const char* executable, Print& out) {
+  benchBoardOut = &out;
+  BenchClock clock = { benchBoardCycles, ESP.getCpuFreqMHz() };
+  BenchOptions options = { BENCH_BOARD_MIN_TIME_US, BENCH_BOARD_REPETITIONS, 1000000, NULL };
+  BenchContext context = { executable, NULL, "esp32", 1, ESP.getCpuFreqMHz(), "release" };
+
+  out.println("BENCH_BEGIN");
+  size_t ran = benchRunAll(cases, count, clock, options, context, benchBoardWrite);
+  out.println("BENCH_END");
+  out.printf("Microbenchmark-uri: %u cazuri, %lu MHz\n", (unsigned)ran, (unsigned long)ESP.getCpuFreqMHz());
+}
+
+#endif
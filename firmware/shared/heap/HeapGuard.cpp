@@ -0,0 +1,212 @@
+#include "HeapGuard.h"
+#include "../log/DeferredLog.h"
+#include "sdkconfig.h"
+#include "esp_heap_caps.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#if HEAP_GUARD_STRICT
+#include "esp_debug_helpers.h"
+#include "esp_rom_sys.h"
+#endif
+
+#if HEAP_GUARD_ENABLED && defined(CONFIG_HEAP_USE_HOOKS) && CONFIG_HEAP_USE_HOOKS
+#define HEAP_GUARD_HOOKED 1
+#else
+#define HEAP_GUARD_HOOKED 0
+#endif
+
+// Un task păzit: hot > 0 cât timp este cale fierbinte, allow > 0 în HeapGuardAllow
+struct HeapGuardTask {
+  TaskHandle_t handle;
+  const char* name;
+  uint16_t hot;
+  uint16_t allow;
+};
+
+static HeapGuardTask heapTasks[HEAP_GUARD_MAX_TASKS];
+static int heapTaskCount = 0;
+static HeapGuardSite heapSites[HEAP_GUARD_MAX_SITES];
+static int heapSiteCount = 0;
+static portMUX_TYPE heapMux = portMUX_INITIALIZER_UNLOCKED;
+
+static volatile bool heapSteady = false;
+static uint32_t heapAllocations = 0;
+static uint32_t heapBytes = 0;
+static uint32_t heapAllowed = 0;
+static uint32_t heapUnexpected = 0;
+static size_t heapBootBlocks = 0;
+
+// Locul taskului curent; cu create, îl adaugă dacă mai este loc. Doar sub heapMux.
+// În IRAM, ca hook-ul de alocare care le apelează (și ele rulează cu flash-ul dezactivat)
+static HeapGuardTask* IRAM_ATTR heapFindTask(TaskHandle_t handle, bool create) {
+  for (int i = 0; i < heapTaskCount; i++) {
+    if (heapTasks[i].handle == handle) return &heapTasks[i];
+  }
+  if (!create || heapTaskCount >= HEAP_GUARD_MAX_TASKS) return NULL;
+  HeapGuardTask* t = &heapTasks[heapTaskCount++];
+  *t = { handle, NULL, 0, 0 };
+  return t;
+}
+
+static void IRAM_ATTR heapRecordSite(const char* task, uint32_t size) {
+  for (int i = 0; i < heapSiteCount; i++) {
+    if (heapSites[i].task == task && heapSites[i].size == size) {
+      heapSites[i].count++;
+      return;
+    }
+  }
+  if (heapSiteCount < HEAP_GUARD_MAX_SITES) heapSites[heapSiteCount++] = { task, size, 1 };
+}
+
+#if HEAP_GUARD_HOOKED
+#if HEAP_GUARD_STRICT
+// Fără jurnal și fără Serial: suntem în alocator, iar placa se oprește oricum
+static void heapGuardFail(const char* task, size_t size) {
+  esp_rom_printf("\nHeapGuard: alocare neasteptata de %u octeti in %s dupa pornire\n",
+                 (unsigned)size, task != NULL ? task : "?");
+  esp_backtrace_print(16);
+  abort();
+}
+#endif
+
+/**
+ * Hook-ul ESP-IDF, apelat după fiecare alocare reușită (și la realloc). Rulează în taskul
+ * care a alocat, deci o alocare dintr-o cale fierbinte se recunoaște după taskul curent.
+ */
+extern "C" void IRAM_ATTR esp_heap_trace_alloc_hook(void* ptr, size_t size, uint32_t caps) {
+  if (!heapSteady) return;
+  TaskHandle_t current = xTaskGetCurrentTaskHandle();
+  const char* unexpectedIn = NULL;
+
+  portENTER_CRITICAL(&heapMux);
+  heapAllocations++;
+  heapBytes += size;
+  HeapGuardTask* t = heapFindTask(current, false);
+  if (t != NULL && t->allow > 0) {
+    heapAllowed++;
+  } else if (t != NULL && t->hot > 0) {
+    heapUnexpected++;
+    heapRecordSite(t->name, size);
+    unexpectedIn = t->name;
+  }
+  portEXIT_CRITICAL(&heapMux);
+
+#if HEAP_GUARD_STRICT
+  if (unexpectedIn != NULL) heapGuardFail(unexpectedIn, size);
+#else
+  (void)unexpectedIn;
+#endif
+}
+#endif
+
+void HeapGuard_watchCurrentTask(const char* name) {
+#if HEAP_GUARD_ENABLED
+  TaskHandle_t current = xTaskGetCurrentTaskHandle();
+  portENTER_CRITICAL(&heapMux);
+  HeapGuardTask* t = heapFindTask(current, true);
+  if (t != NULL) {
+    t->name = name;
+    t->hot++;
+  }
+  portEXIT_CRITICAL(&heapMux);
+#endif
+}
+
+void HeapGuard_enterHot(const char* name) {
+  HeapGuard_watchCurrentTask(name);
+}
+
+void HeapGuard_exitHot() {
+#if HEAP_GUARD_ENABLED
+  TaskHandle_t current = xTaskGetCurrentTaskHandle();
+  portENTER_CRITICAL(&heapMux);
+  HeapGuardTask* t = heapFindTask(current, false);
+  if (t != NULL && t->hot > 0) t->hot--;
+  portEXIT_CRITICAL(&heapMux);
+#endif
+}
+
+void HeapGuard_enterAllow() {
+#if HEAP_GUARD_ENABLED
+  TaskHandle_t current = xTaskGetCurrentTaskHandle();
+  portENTER_CRITICAL(&heapMux);
+  HeapGuardTask* t = heapFindTask(current, true);
+  if (t != NULL) t->allow++;
+  portEXIT_CRITICAL(&heapMux);
+#endif
+}
+
+void HeapGuard_exitAllow() {
+#if HEAP_GUARD_ENABLED
+  TaskHandle_t current = xTaskGetCurrentTaskHandle();
+  portENTER_CRITICAL(&heapMux);
+  HeapGuardTask* t = heapFindTask(current, false);
+  if (t != NULL && t->allow > 0) t->allow--;
+  portEXIT_CRITICAL(&heapMux);
+#endif
+}
+
+void HeapGuard_endBoot() {
+#if HEAP_GUARD_ENABLED
+  multi_heap_info_t info;
+  heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+  heapBootBlocks = info.allocated_blocks;
+  heapSteady = true;
+#endif
+}
+
+HeapGuardStats HeapGuard_getStats() {
+  HeapGuardStats s = {};
+#if HEAP_GUARD_ENABLED
+  multi_heap_info_t info;
+  heap_caps_get_info(&info, MALLOC_CAP_8BIT);
+
+  portENTER_CRITICAL(&heapMux);
+  s.steady = heapSteady;
+  s.allocations = heapAllocations;
+  s.bytes = heapBytes;
+  s.allowed = heapAllowed;
+  s.unexpected = heapUnexpected;
+  portEXIT_CRITICAL(&heapMux);
+
+  s.hooked = HEAP_GUARD_HOOKED;
+  s.freeBytes = info.total_free_bytes;
+  s.largestBlock = info.largest_free_block;
+  s.minFreeBytes = info.minimum_free_bytes;
+  s.blocksDelta = s.steady ? (int32_t)info.allocated_blocks - (int32_t)heapBootBlocks : 0;
+  s.fragmentation = s.freeBytes > 0 ? (uint8_t)(100 - (uint64_t)s.largestBlock * 100 / s.freeBytes) : 0;
+#endif
+  return s;
+}
+
+int HeapGuard_getSites(HeapGuardSite* out, int max) {
+  portENTER_CRITICAL(&heapMux);
+  int n = heapSiteCount < max ? heapSiteCount : max;
+  memcpy(out, heapSites, n * sizeof(HeapGuardSite));
+  portEXIT_CRITICAL(&heapMux);
+  return n;
+}
+
+void HeapGuard_report() {
+#if HEAP_GUARD_ENABLED
+  HeapGuardStats s = HeapGuard_getStats();
+  LOG_INFO("Heap: liber %lu B, cel mai mare bloc %lu B (fragmentare %u%%), minim %lu B",
+           (unsigned long)s.freeBytes, (unsigned long)s.largestBlock, s.fragmentation,
+           (unsigned long)s.minFreeBytes);
+  if (!s.hooked) {
+    LOG_INFO("Heap: %ld blocuri față de pornire (fără CONFIG_HEAP_USE_HOOKS alocările nu se numără)",
+             (long)s.blocksDelta);
+    return;
+  }
+  LOG_INFO("Heap: %lu alocări după pornire (%lu B), %lu permise, %lu neașteptate, %ld blocuri față de pornire",
+           (unsigned long)s.allocations, (unsigned long)s.bytes, (unsigned long)s.allowed,
+           (unsigned long)s.unexpected, (long)s.blocksDelta);
+
+  HeapGuardSite sites[HEAP_GUARD_MAX_SITES];
+  int n = HeapGuard_getSites(sites, HEAP_GUARD_MAX_SITES);
+  for (int i = 0; i < n; i++) {
+    LOG_WARN("Heap: alocare neașteptată în %s: %lu x %lu octeți", sites[i].task,
+             (unsigned long)sites[i].count, (unsigned long)sites[i].size);
+  }
+#endif
+}
@@ -0,0 +1,88 @@
+#ifndef HEAP_GUARD_H
+#define HEAP_GUARD_H
+
+/**
+ * Heap fără alocări după pornire, comun pentru vehicul (ESP32) și semne (ESP32-C3).
+ *
+ *   void setup() { ...; HeapGuard_endBoot(); }   // de aici încolo fiecare malloc se numără
+ *
+ *  - taskurile cu căi fierbinți (loop(), taskurile pipeline-ului) se declară o dată cu
+ *    HeapGuard_watchCurrentTask(); un callback radio al aplicației, cu un HeapGuardHot
+ *    pe durata lui
+ *  - în ele, o alocare după pornire este neașteptată: se numără pe locul ei (task, dimensiune)
+ *    și, cu HEAP_GUARD_STRICT = 1 (compilările de depanare), oprește placa cu un backtrace
+ *  - apelurile în stivele care alocă singure (notificări BLE, esp_now_send, fișiere LittleFS)
+ *    se fac într-un HeapGuardAllow: se numără, dar sunt permise
+ *  - alocările din celelalte taskuri (stivele BLE/WiFi, jurnalul) doar se numără
+ *  - HeapGuard_report() scrie în jurnal alocările și fragmentarea: cel mai mare bloc liber
+ *    față de toată memoria liberă
+ *
+ * Contorizarea folosește hook-ul de alocare din ESP-IDF (CONFIG_HEAP_USE_HOOKS=y); fără el
+ * rămân fragmentarea și variația numărului de blocuri alocate față de sfârșitul pornirii.
+ */
+
+#include <Arduino.h>
+
+#ifndef HEAP_GUARD_ENABLED
+#define HEAP_GUARD_ENABLED 1
+#endif
+
+// 1: o alocare neașteptată oprește placa (abort cu backtrace), pentru compilările de depanare
+#ifndef HEAP_GUARD_STRICT
+#define HEAP_GUARD_STRICT 0
+#endif
+
+#define HEAP_GUARD_MAX_TASKS 16
+#define HEAP_GUARD_MAX_SITES 8
+
+// Un loc de alocare neașteptată: taskul (sau callback-ul) și dimensiunea cerută
+struct HeapGuardSite {
+  const char* task;
+  uint32_t size;
+  uint32_t count;
+};
+
+struct HeapGuardStats {
+  bool steady;              // HeapGuard_endBoot() a fost apelată
+  bool hooked;              // hook-ul de alocare este compilat (contoarele de mai jos au sens)
+  uint32_t allocations;     // după pornire, din toate taskurile
+  uint32_t bytes;
+  uint32_t allowed;         // din HeapGuardAllow
+  uint32_t unexpected;      // din căile fierbinți
+  uint32_t freeBytes;
+  uint32_t largestBlock;    // cel mai mare bloc liber
+  uint32_t minFreeBytes;    // minimul memoriei libere de la pornire
+  int32_t blocksDelta;      // blocuri alocate acum față de sfârșitul pornirii
+  uint8_t fragmentation;    // procent: 100 - cel mai mare bloc / memoria liberă
+};
+
+// Taskul curent devine cale fierbinte; trebuie apelată din task
+void HeapGuard_watchCurrentTask(const char* name);
+// Sfârșitul pornirii, la finalul lui setup()
+void HeapGuard_endBoot();
+HeapGuardStats HeapGuard_getStats();
+// Copiază locurile alocărilor neașteptate; întoarce numărul lor
+int HeapGuard_getSites(HeapGuardSite* out, int max);
+// Alocările, fragmentarea și locurile neașteptate, în jurnalul amânat
+void HeapGuard_report();
+
+void HeapGuard_enterHot(const char* name);
+void HeapGuard_exitHot();
+void HeapGuard_enterAllow();
+void HeapGuard_exitAllow();
+
+// Cale fierbinte pe durata unui bloc, într-un task care altfel nu este păzit (callback radio)
+class HeapGuardHot {
+public:
+  explicit HeapGuardHot(const char* name) { HeapGuard_enterHot(name); }
+  ~HeapGuardHot() { HeapGuard_exitHot(); }
+};
+
+// Alocări permise pe durata unui bloc (apeluri în stivele radio sau în sistemul de fișiere)
+class HeapGuardAllow {
+public:
+  HeapGuardAllow() { HeapGuard_enterAllow(); }
+  ~HeapGuardAllow() { HeapGuard_exitAllow(); }
+};
+
+#endif
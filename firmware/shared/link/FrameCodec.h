@@ -0,0 +1,129 @@
+#ifndef FRAME_CODEC_H
+#define FRAME_CODEC_H
+
+/**
+ * Încadramentul comun al fluxurilor binare Elysium (fără dependențe Arduino, compilat la fel
+ * pe AVR, ESP32 și calculator):
+ *   FRAME_SYNC_1 | sync2 | len | payload[len] | crc16 (LE, peste len + payload)
+ *
+ * Al doilea octet de sincronizare spune fluxul. Pe același fir pot ajunge mai multe fluxuri
+ * (telemetria și bucățile de jurnal pe Bluetooth, jurnalul amânat și textul pe Serial), iar
+ * fiecare decodor le ignoră pe celelalte încă de la antet, nu abia la CRC:
+ *   0x5A telemetria, vehicul -> aplicație (TelemetryCodec.h)
+ *   0x5B bucățile fișierelor de jurnal, amestecate cu telemetria (RecorderFormat.h)
+ *   0x5C comenzile, aplicație -> vehicul (CommandChannel.h)
+ *   0x5D jurnalul amânat binar (LogFormat.h)
+ *   0x5E eșantioanele Arduino -> ESP32 (SensorLinkCodec.h)
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+
+#define FRAME_SYNC_1 0xA5
+#define FRAME_SYNC_TELEMETRY 0x5A
+#define FRAME_SYNC_RECORDER_CHUNK 0x5B
+#define FRAME_SYNC_COMMAND 0x5C
+#define FRAME_SYNC_LOG 0x5D
+#define FRAME_SYNC_SENSOR_LINK 0x5E
+#define FRAME_HEADER_LEN 3       // sincronizare + lungime
+#define FRAME_OVERHEAD 5         // antet + CRC
+
+// CRC16-CCITT (poly 0x1021, init 0xFFFF)
+static inline uint16_t frameCrc16(const uint8_t* data, size_t len, uint16_t crc = 0xFFFF) {
+  for (size_t i = 0; i < len; i++) {
+    crc ^= (uint16_t)data[i] << 8;
+    for (uint8_t b = 0; b < 8; b++) {
+      crc = (crc & 0x8000) ? (uint16_t)((crc << 1) ^ 0x1021) : (uint16_t)(crc << 1);
+    }
+  }
+  return crc;
+}
+
+/**
+ * Completează un cadru al cărui payload este deja scris la out + FRAME_HEADER_LEN:
+ * antetul în față, CRC-ul după payload. Întoarce lungimea totală.
+ */
+static inline size_t frameSeal(uint8_t* out, uint8_t sync2, size_t payloadLen) {
+  out[0] = FRAME_SYNC_1;
+  out[1] = sync2;
+  out[2] = (uint8_t)payloadLen;
+  uint16_t crc = frameCrc16(out + 2, payloadLen + 1);
+  out[FRAME_HEADER_LEN + payloadLen] = (uint8_t)(crc & 0xFF);
+  out[FRAME_HEADER_LEN + payloadLen + 1] = (uint8_t)(crc >> 8);
+  return payloadLen + FRAME_OVERHEAD;
+}
+
+enum FrameResult {
+  FRAME_SKIPPED,     // octetul nu aparține niciunui cadru al fluxului
+  FRAME_PENDING,     // octet dintr-un cadru încă incomplet
+  FRAME_READY,       // cadru valid în payload()/length()
+  FRAME_BAD_LENGTH,  // lungimea din antet este în afara limitelor fluxului
+  FRAME_BAD_CRC      // cadru întreg cu CRC greșit
+};
+
+/**
+ * Decodor incremental pentru un flux: primește octet cu octet și se resincronizează singur.
+ * Un FRAME_SYNC_1 urmat de alt octet decât sync2 se abandonează, iar octetul se reia ca
+ * început posibil al unui cadru; skippedBytes numără octeții rămași în afara cadrelor.
+ */
+template <uint8_t MaxPayload>
+class FrameDecoder {
+public:
+  uint32_t skippedBytes;
+
+  FrameDecoder(uint8_t sync2, uint8_t minPayload = 1)
+    : skippedBytes(0), _sync2(sync2), _minPayload(minPayload), _state(0), _len(0), _pos(0) {}
+
+  FrameResult push(uint8_t b) {
+    switch (_state) {
+      case 0:
+        if (b == FRAME_SYNC_1) {
+          _state = 1;
+          return FRAME_PENDING;
+        }
+        skippedBytes++;
+        return FRAME_SKIPPED;
+      case 1:
+        if (b == _sync2) {
+          _state = 2;
+          return FRAME_PENDING;
+        }
+        skippedBytes++;          // sincronizarea abandonată
+        _state = 0;
+        return push(b);
+      case 2:
+        if (b < _minPayload || b > MaxPayload) {
+          _state = 0;
+          return FRAME_BAD_LENGTH;
+        }
+        _len = b;
+        _pos = 0;
+        _state = 3;
+        return FRAME_PENDING;
+      default:
+        _buf[_pos++] = b;
+        if (_pos < (uint16_t)_len + 2) return FRAME_PENDING;
+        _state = 0;
+        uint16_t crc = frameCrc16(&_len, 1);
+        crc = frameCrc16(_buf, _len, crc);
+        uint16_t rxCrc = (uint16_t)_buf[_len] | ((uint16_t)_buf[_len + 1] << 8);
+        return crc == rxCrc ? FRAME_READY : FRAME_BAD_CRC;
+    }
+  }
+
+  // Niciun cadru început: următorul octet poate fi orice
+  bool idle() const { return _state == 0; }
+  void reset() { _state = 0; }
+  const uint8_t* payload() const { return _buf; }
+  uint8_t length() const { return _len; }
+
+private:
+  uint8_t _buf[MaxPayload + 2];
+  uint8_t _sync2;
+  uint8_t _minPayload;
+  uint8_t _state;
+  uint8_t _len;
+  uint16_t _pos;
+};
+
+#endif
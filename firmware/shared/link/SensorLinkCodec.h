@@ -0,0 +1,139 @@
+#ifndef SENSOR_LINK_CODEC_H
+#define SENSOR_LINK_CODEC_H
+
+/**
+ * Legătura binară Arduino Uno -> ESP32 pentru eșantioanele de senzori
+ * (fără dependențe Arduino, compilată la fel pe AVR, ESP32 și calculator).
+ *
+ * Cadru (FrameCodec.h, fluxul FRAME_SYNC_SENSOR_LINK):
+ *   0xA5 0x5E | len | payload[len] | crc16 (LE, peste len + payload)
+ * Payload (SENSOR_LINK_TYPE_SAMPLE, toate câmpurile LE):
+ *   tip (u8) | seq (u16) | timp Arduino µs (u32) | encoder (i32) |
+ *   busolă X, Y, Z (i16) | tensiune în centivolți (u16) | erori encoder (u16) |
+ *   ultimul front encoder µs (u32) | perioada unui front µs (i32, semnul = sensul, 0 = necunoscută)
+ *
+ * Numărul de secvență crește cu 1 la fiecare cadru trimis, astfel încât
+ * receptorul poate număra separat cadrele corupte și cele pierdute.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <string.h>
+#include "FrameCodec.h"
+
+#define SENSOR_LINK_TYPE_SAMPLE 0x01
+#define SENSOR_LINK_SAMPLE_LEN 29
+#define SENSOR_LINK_MAX_PAYLOAD 32
+#define SENSOR_LINK_MAX_FRAME (SENSOR_LINK_MAX_PAYLOAD + FRAME_OVERHEAD)
+#define SENSOR_LINK_MAX_GAP 1000         // salturi de secvență mai mari = repornire
+
+#define SENSOR_LINK_BAUD 500000UL        // exact la 16 MHz (U2X), suportat de UART-ul ESP32
+#define SENSOR_LINK_PERIOD_US 5000UL     // 200 Hz
+
+struct SensorLinkSample {
+  uint16_t sequence;
+  uint32_t arduinoTimeUs;     // micros() pe Arduino în momentul eșantionării
+  int32_t encoder;            // impulsuri encoder
+  int16_t compass[3];         // valori brute QMC5883
+  uint16_t voltageCentivolts;
+  uint16_t encoderErrors;     // tranziții invalide ale encoderului (fronturi pierdute)
+  uint32_t lastEdgeUs;        // ceasul Arduino la ultimul front al encoderului
+  int32_t edgePeriodUs;       // pentru viteza la turații mici
+};
+
+static inline uint8_t* sensorLinkPut16(uint8_t* p, uint16_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  return p + 2;
+}
+
+static inline uint8_t* sensorLinkPut32(uint8_t* p, uint32_t v) {
+  p[0] = (uint8_t)v;
+  p[1] = (uint8_t)(v >> 8);
+  p[2] = (uint8_t)(v >> 16);
+  p[3] = (uint8_t)(v >> 24);
+  return p + 4;
+}
+
+static inline uint16_t sensorLinkGet16(const uint8_t* p) {
+  return (uint16_t)p[0] | ((uint16_t)p[1] << 8);
+}
+
+static inline uint32_t sensorLinkGet32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Scrie un cadru complet în out (minim SENSOR_LINK_MAX_FRAME octeți); întoarce lungimea
+static inline size_t sensorLinkEncode(const SensorLinkSample& s, uint8_t* out) {
+  uint8_t* p = out + FRAME_HEADER_LEN;
+  *p++ = SENSOR_LINK_TYPE_SAMPLE;
+  p = sensorLinkPut16(p, s.sequence);
+  p = sensorLinkPut32(p, s.arduinoTimeUs);
+  p = sensorLinkPut32(p, (uint32_t)s.encoder);
+  for (uint8_t i = 0; i < 3; i++) p = sensorLinkPut16(p, (uint16_t)s.compass[i]);
+  p = sensorLinkPut16(p, s.voltageCentivolts);
+  p = sensorLinkPut16(p, s.encoderErrors);
+  p = sensorLinkPut32(p, s.lastEdgeUs);
+  p = sensorLinkPut32(p, (uint32_t)s.edgePeriodUs);
+
+  return frameSeal(out, FRAME_SYNC_SENSOR_LINK, (size_t)(p - (out + FRAME_HEADER_LEN)));
+}
+
+/**
+ * Decodor incremental: primește octet cu octet, se resincronizează singur după
+ * octeți corupți și numără cadrele pierdute din salturile de secvență.
+ */
+class SensorLinkDecoder {
+public:
+  uint32_t framesOk;
+  uint32_t crcErrors;       // cadre corupte (CRC, lungime sau tip necunoscut)
+  uint32_t lostFrames;      // cadre lipsă deduse din numărul de secvență
+  uint32_t resyncBytes;     // octeți ignorați în afara unui cadru
+
+  SensorLinkDecoder() : framesOk(0), crcErrors(0), lostFrames(0), resyncBytes(0),
+                        _frame(FRAME_SYNC_SENSOR_LINK), _synced(false) {
+    memset(&_sample, 0, sizeof(_sample));
+  }
+
+  // Întoarce true când un cadru valid a actualizat sample()
+  bool push(uint8_t b) {
+    FrameResult r = _frame.push(b);
+    resyncBytes = _frame.skippedBytes;
+    if (r == FRAME_BAD_LENGTH || r == FRAME_BAD_CRC) crcErrors++;
+    return r == FRAME_READY && finishFrame(_frame.payload(), _frame.length());
+  }
+
+  const SensorLinkSample& sample() const { return _sample; }
+
+private:
+  FrameDecoder<SENSOR_LINK_MAX_PAYLOAD> _frame;
+  SensorLinkSample _sample;
+  bool _synced;
+
+  bool finishFrame(const uint8_t* payload, uint8_t len) {
+    if (len != SENSOR_LINK_SAMPLE_LEN || payload[0] != SENSOR_LINK_TYPE_SAMPLE) {
+      crcErrors++;
+      return false;
+    }
+
+    const uint8_t* p = payload + 1;
+    uint16_t seq = sensorLinkGet16(p);
+    uint16_t gap = (uint16_t)(seq - _sample.sequence - 1);
+    // Un salt foarte mare înseamnă că Arduino a repornit, nu cadre pierdute
+    if (_synced && gap < SENSOR_LINK_MAX_GAP) lostFrames += gap;
+    _synced = true;
+
+    _sample.sequence = seq;
+    _sample.arduinoTimeUs = sensorLinkGet32(p + 2);
+    _sample.encoder = (int32_t)sensorLinkGet32(p + 6);
+    for (uint8_t i = 0; i < 3; i++) _sample.compass[i] = (int16_t)sensorLinkGet16(p + 10 + 2 * i);
+    _sample.voltageCentivolts = sensorLinkGet16(p + 16);
+    _sample.encoderErrors = sensorLinkGet16(p + 18);
+    _sample.lastEdgeUs = sensorLinkGet32(p + 20);
+    _sample.edgePeriodUs = (int32_t)sensorLinkGet32(p + 24);
+    framesOk++;
+    return true;
+  }
+};
+
+#endif
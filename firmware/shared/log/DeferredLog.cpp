@@ -0,0 +1,186 @@
+#include "DeferredLog.h"
+
+#if defined(ARDUINO_ARCH_AVR)
+#include <util/atomic.h>
+#else
+#include <atomic>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#endif
+
+static_assert((LOG_RING_SIZE & (LOG_RING_SIZE - 1)) == 0, "LOG_RING_SIZE trebuie sa fie putere a lui 2");
+
+static Print* logOutput = NULL;
+
+#if defined(ARDUINO_ARCH_AVR)
+// ******************* AVR: secțiune critică scurtă *************************
+static LogRecord logRing[LOG_RING_SIZE];
+static volatile uint8_t logHead = 0;
+static volatile uint8_t logTail = 0;
+static volatile uint32_t logDropped = 0;
+
+bool Log_push(const LogRecord& record) {
+  bool ok = false;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    if ((uint8_t)(logHead - logTail) < LOG_RING_SIZE) {
+      logRing[logHead & (LOG_RING_SIZE - 1)] = record;
+      logHead++;
+      ok = true;
+    } else {
+      logDropped++;
+    }
+  }
+  return ok;
+}
+
+static bool logPop(LogRecord& out) {
+  if (logTail == logHead) return false;
+  out = logRing[logTail & (LOG_RING_SIZE - 1)];
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    logTail++;
+  }
+  return true;
+}
+
+uint32_t Log_getDropped() {
+  uint32_t dropped;
+  ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+    dropped = logDropped;
+  }
+  return dropped;
+}
+
+#else
+// ******************* ESP32: mai mulți producători, fără mutex *************
+// Fiecare loc are un număr de secvență: producătorul își rezervă poziția cu CAS
+// pe logHead, scrie înregistrarea și abia apoi o publică prin seq = poziție + 1.
+struct LogSlot {
+  std::atomic<uint32_t> seq;
+  LogRecord record;
+};
+
+static LogSlot logRing[LOG_RING_SIZE];
+static std::atomic<uint32_t> logHead(0);
+static uint32_t logTail = 0;   // doar taskul de golire
+static std::atomic<uint32_t> logDropped(0);
+static bool logRingReady = false;
+
+static void logRingInit() {
+  for (uint32_t i = 0; i < LOG_RING_SIZE; i++) {
+    logRing[i].seq.store(i, std::memory_order_relaxed);
+  }
+  logRingReady = true;
+}
+
+bool Log_push(const LogRecord& record) {
+  if (!logRingReady) {
+    logDropped.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+
+  uint32_t pos = logHead.load(std::memory_order_relaxed);
+  LogSlot* slot;
+  while (true) {
+    slot = &logRing[pos & (LOG_RING_SIZE - 1)];
+    int32_t diff = (int32_t)(slot->seq.load(std::memory_order_acquire) - pos);
+    if (diff == 0) {
+      if (logHead.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+    } else if (diff < 0) {
+      // Buffer plin: nu așteptăm niciodată
+      logDropped.fetch_add(1, std::memory_order_relaxed);
+      return false;
+    } else {
+      pos = logHead.load(std::memory_order_relaxed);
+    }
+  }
+
+  slot->record = record;
+  slot->seq.store(pos + 1, std::memory_order_release);
+  return true;
+}
+
+static bool logPop(LogRecord& out) {
+  LogSlot& slot = logRing[logTail & (LOG_RING_SIZE - 1)];
+  if (slot.seq.load(std::memory_order_acquire) != logTail + 1) return false;
+  out = slot.record;
+  slot.seq.store(logTail + LOG_RING_SIZE, std::memory_order_release);
+  logTail++;
+  return true;
+}
+
+uint32_t Log_getDropped() {
+  return logDropped.load(std::memory_order_relaxed);
+}
+
+static void logDrainTask(void* parameter) {
+  while (true) {
+    Log_drain();
+    vTaskDelay(pdMS_TO_TICKS(LOG_DRAIN_PERIOD_MS));
+  }
+  vTaskDelete(NULL);
+}
+#endif
+
+// ******************* IEȘIRE ********************************************
+static void logWriteRecord(const LogRecord& r) {
+#if LOG_BINARY_OUTPUT
+  uint8_t frame[LOG_FRAME_HEADER_LEN + 4 * LOG_MAX_ARGS + LOG_STR_MAX + FRAME_OVERHEAD];
+  uint8_t* p = frame + FRAME_HEADER_LEN;
+  uint32_t id = r.site->id;
+  for (int i = 0; i < 4; i++) *p++ = (uint8_t)(id >> (8 * i));
+  for (int i = 0; i < 4; i++) *p++ = (uint8_t)(r.timestampUs >> (8 * i));
+  *p++ = r.site->level;
+  *p++ = r.argc;
+  *p++ = r.stringsLen;
+  for (uint8_t a = 0; a < r.argc; a++) {
+    for (int i = 0; i < 4; i++) *p++ = (uint8_t)(r.args[a] >> (8 * i));
+  }
+  memcpy(p, r.strings, r.stringsLen);
+  p += r.stringsLen;
+
+  logOutput->write(frame, frameSeal(frame, FRAME_SYNC_LOG, (size_t)(p - (frame + FRAME_HEADER_LEN))));
+#else
+  char text[160];
+  unsigned long ms = r.timestampUs / 1000UL;
+  int n = snprintf(text, sizeof(text), "[%7lu.%03lu] %c ", ms / 1000UL, ms % 1000UL,
+                   logLevelLetter(r.site->level));
+  if (n < 0) return;
+  logFormat(text + n, sizeof(text) - n, r.site->format, r.args, r.argc, r.strings, r.stringsLen);
+  logOutput->println(text);
+#endif
+}
+
+/**
+ * Pornește jurnalul; pe ESP32 creează și taskul de golire
+ */
+void Log_init(Print& out) {
+  logOutput = &out;
+#if !defined(ARDUINO_ARCH_AVR)
+  logRingInit();
+  xTaskCreate(logDrainTask, "LogDrain", 3072, NULL, LOG_DRAIN_PRIORITY, NULL);
+#endif
+}
+
+/**
+ * Formatează și scrie tot ce s-a acumulat; întoarce numărul de mesaje scrise.
+ * Pe ESP32 este apelată de taskul de golire, pe AVR din loop().
+ */
+size_t Log_drain() {
+  if (logOutput == NULL) return 0;
+
+  static uint32_t reportedDropped = 0;
+  size_t count = 0;
+  LogRecord record;
+  while (logPop(record)) {
+    logWriteRecord(record);
+    count++;
+  }
+
+  uint32_t dropped = Log_getDropped();
+  if (dropped != reportedDropped) {
+    LOG_WARN("Jurnal: %lu mesaje pierdute (buffer plin)", (unsigned long)(dropped - reportedDropped));
+    // Dacă și avertismentul s-a pierdut, nu îl mai raportăm separat
+    reportedDropped = Log_getDropped();
+  }
+  return count;
+}
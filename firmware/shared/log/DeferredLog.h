@@ -0,0 +1,176 @@
+#ifndef DEFERRED_LOG_H
+#define DEFERRED_LOG_H
+
+/**
+ * Jurnal amânat, comun pentru toate plăcile (vehicul ESP32, semne ESP32-C3, Arduino Uno).
+ *
+ *   LOG_INFO("Motor: duty %d, viteza %ld", duty, speed);
+ *
+ *  - nivelul se filtrează la compilare: apelurile peste LOG_LEVEL dispar complet,
+ *    fără a evalua argumentele
+ *  - un apel activ doar copiază ID-ul formatului, momentul și argumentele brute
+ *    într-un buffer circular fără mutex (sigur și din întreruperi/callback-uri radio);
+ *    dacă bufferul este plin mesajul se pierde și este numărat, apelul nu așteaptă niciodată
+ *  - formatarea și scrierea pe port se fac mai târziu: pe ESP32 dintr-un task cu prioritate
+ *    mică, pe AVR din Log_drain() apelată în loop()
+ *
+ * Argumente acceptate: întregi de cel mult 32 de biți, float/double (salvate ca float)
+ * și șiruri char* (copiate, în total cel mult LOG_STR_MAX - 1 caractere pe mesaj).
+ * Cu LOG_BINARY_OUTPUT = 1 se trimit cadre binare, decodate pe calculator de tools/log.
+ */
+
+#include <Arduino.h>
+#include "LogFormat.h"
+
+#ifndef LOG_LEVEL
+#define LOG_LEVEL LOG_LEVEL_INFO
+#endif
+
+#ifndef LOG_BINARY_OUTPUT
+#define LOG_BINARY_OUTPUT 0
+#endif
+
+// Dimensiuni implicite: mai mici pe Arduino Uno (2 KB RAM)
+#if defined(ARDUINO_ARCH_AVR)
+#ifndef LOG_RING_SIZE
+#define LOG_RING_SIZE 8
+#endif
+#ifndef LOG_MAX_ARGS
+#define LOG_MAX_ARGS 5
+#endif
+#ifndef LOG_STR_MAX
+#define LOG_STR_MAX 4
+#endif
+#else
+#ifndef LOG_RING_SIZE
+#define LOG_RING_SIZE 64          // putere a lui 2
+#endif
+#ifndef LOG_MAX_ARGS
+#define LOG_MAX_ARGS 6
+#endif
+#ifndef LOG_STR_MAX
+#define LOG_STR_MAX 24
+#endif
+#define LOG_DRAIN_PERIOD_MS 20
+#define LOG_DRAIN_PRIORITY 1
+#endif
+
+// Un loc de apel: formatul, ID-ul lui (calculat la compilare) și nivelul
+struct LogSite {
+  const char* format;
+  uint32_t id;
+  uint8_t level;
+};
+
+struct LogRecord {
+  const LogSite* site;
+  uint32_t timestampUs;
+  uint8_t argc;
+  uint8_t stringsLen;
+  uint32_t args[LOG_MAX_ARGS];
+  char strings[LOG_STR_MAX];
+};
+
+// ******************* ÎMPACHETAREA ARGUMENTELOR ************************
+static inline void logPackRaw(LogRecord& r, uint32_t raw) {
+  if (r.argc < LOG_MAX_ARGS) r.args[r.argc++] = raw;
+}
+
+static inline void logPack(LogRecord& r, const char* s) {
+  if (s == NULL) s = "(null)";
+  size_t room = LOG_STR_MAX - r.stringsLen;
+  if (room == 0) return;
+  size_t len = strlen(s);
+  if (len > room - 1) len = room - 1;
+  memcpy(r.strings + r.stringsLen, s, len);
+  r.strings[r.stringsLen + len] = '\0';
+  r.stringsLen += (uint8_t)(len + 1);
+}
+
+static inline void logPack(LogRecord& r, char* s)               { logPack(r, (const char*)s); }
+static inline void logPack(LogRecord& r, bool v)                { logPackRaw(r, (uint32_t)v); }
+static inline void logPack(LogRecord& r, char v)                { logPackRaw(r, (uint32_t)(int32_t)v); }
+static inline void logPack(LogRecord& r, signed char v)         { logPackRaw(r, (uint32_t)(int32_t)v); }
+static inline void logPack(LogRecord& r, unsigned char v)       { logPackRaw(r, (uint32_t)v); }
+static inline void logPack(LogRecord& r, short v)               { logPackRaw(r, (uint32_t)(int32_t)v); }
+static inline void logPack(LogRecord& r, unsigned short v)      { logPackRaw(r, (uint32_t)v); }
+static inline void logPack(LogRecord& r, int v)                 { logPackRaw(r, (uint32_t)(int32_t)v); }
+static inline void logPack(LogRecord& r, unsigned int v)        { logPackRaw(r, (uint32_t)v); }
+static inline void logPack(LogRecord& r, long v)                { logPackRaw(r, (uint32_t)(int32_t)v); }
+static inline void logPack(LogRecord& r, unsigned long v)       { logPackRaw(r, (uint32_t)v); }
+static inline void logPack(LogRecord& r, float v)               { uint32_t raw; memcpy(&raw, &v, 4); logPackRaw(r, raw); }
+static inline void logPack(LogRecord& r, double v)              { logPack(r, (float)v); }
+
+static inline void logPackAll(LogRecord& r) {}
+
+template <typename T, typename... Rest>
+static inline void logPackAll(LogRecord& r, T first, Rest... rest) {
+  logPack(r, first);
+  logPackAll(r, rest...);
+}
+
+// Numărul de argumente numerice (șirurile nu ocupă locuri în args), verificat la compilare
+template <typename T> struct LogIsString { static constexpr int value = 0; };
+template <> struct LogIsString<const char*> { static constexpr int value = 1; };
+template <> struct LogIsString<char*> { static constexpr int value = 1; };
+
+template <typename... Args>
+struct LogArgCount;
+
+template <>
+struct LogArgCount<> { static constexpr int value = 0; };
+
+template <typename T, typename... Rest>
+struct LogArgCount<T, Rest...> {
+  static constexpr int value = (LogIsString<T>::value ? 0 : 1) + LogArgCount<Rest...>::value;
+};
+
+// Funcții
+void Log_init(Print& out);
+bool Log_push(const LogRecord& record);
+size_t Log_drain();
+uint32_t Log_getDropped();
+
+template <typename... Args>
+static inline void Log_write(const LogSite* site, Args... args) {
+  static_assert(LogArgCount<Args...>::value <= LOG_MAX_ARGS, "LOG: prea multe argumente numerice");
+  LogRecord record;
+  record.site = site;
+  record.timestampUs = micros();
+  record.argc = 0;
+  record.stringsLen = 0;
+  logPackAll(record, args...);
+  Log_push(record);
+}
+
+// ******************* MACRO-URI *****************************************
+#define LOG_AT(level, fmt, ...) do { \
+    static constexpr LogSite _logSite = { fmt, logHash(fmt), level }; \
+    Log_write(&_logSite, ##__VA_ARGS__); \
+  } while (0)
+
+#if LOG_LEVEL >= LOG_LEVEL_ERROR
+#define LOG_ERROR(fmt, ...) LOG_AT(LOG_LEVEL_ERROR, fmt, ##__VA_ARGS__)
+#else
+#define LOG_ERROR(fmt, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_WARN
+#define LOG_WARN(fmt, ...) LOG_AT(LOG_LEVEL_WARN, fmt, ##__VA_ARGS__)
+#else
+#define LOG_WARN(fmt, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_INFO
+#define LOG_INFO(fmt, ...) LOG_AT(LOG_LEVEL_INFO, fmt, ##__VA_ARGS__)
+#else
+#define LOG_INFO(fmt, ...) do {} while (0)
+#endif
+
+#if LOG_LEVEL >= LOG_LEVEL_DEBUG
+#define LOG_DEBUG(fmt, ...) LOG_AT(LOG_LEVEL_DEBUG, fmt, ##__VA_ARGS__)
+#else
+#define LOG_DEBUG(fmt, ...) do {} while (0)
+#endif
+
+#endif
@@ -0,0 +1,114 @@
+#ifndef LOG_FORMAT_H
+#define LOG_FORMAT_H
+
+/**
+ * Partea comună dintre firmware și decodorul de pe calculator pentru jurnalul
+ * amânat (fără dependențe Arduino, la fel ca TelemetryCodec.h).
+ *
+ * Un mesaj este identificat prin hash-ul FNV-1a al șirului de format, calculat
+ * la compilare; argumentele numerice se păstrează ca valori brute de 32 de biți,
+ * iar șirurile (%s) sunt copiate unul după altul, terminate cu '\0'.
+ *
+ * Cadru binar (LOG_BINARY_OUTPUT = 1; FrameCodec.h, fluxul FRAME_SYNC_LOG):
+ *   0xA5 0x5D | len | id (u32 LE) | timp µs (u32 LE) | nivel (u8) | argc (u8) |
+ *   lungime șiruri (u8) | argumente (argc x u32 LE) | șiruri | crc16 (LE, peste len + payload)
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <string.h>
+#include "../link/FrameCodec.h"
+
+#define LOG_FRAME_HEADER_LEN 11
+
+#define LOG_LEVEL_NONE  0
+#define LOG_LEVEL_ERROR 1
+#define LOG_LEVEL_WARN  2
+#define LOG_LEVEL_INFO  3
+#define LOG_LEVEL_DEBUG 4
+
+// FNV-1a pe 32 de biți, evaluat la compilare pentru literali (formă recursivă, compatibilă C++11)
+static constexpr uint32_t logHash(const char* s, uint32_t h = 2166136261UL) {
+  return *s ? logHash(s + 1, (h ^ (uint8_t)*s) * 16777619UL) : h;
+}
+
+static inline char logLevelLetter(uint8_t level) {
+  return level == LOG_LEVEL_ERROR ? 'E' : level == LOG_LEVEL_WARN ? 'W' : level == LOG_LEVEL_INFO ? 'I' : 'D';
+}
+
+/**
+ * Formatează un mesaj din argumentele brute; întoarce lungimea scrisă în out.
+ * Sunt acceptate conversiile printf obișnuite; modificatorii de lungime sunt
+ * ignorați, fiindcă toate valorile numerice au fost salvate pe 32 de biți.
+ */
+static inline size_t logFormat(char* out, size_t size, const char* fmt,
+                               const uint32_t* args, uint8_t argc,
+                               const char* strings, uint8_t stringsLen) {
+  if (size == 0) return 0;
+  size_t n = 0;
+  uint8_t argIndex = 0;
+  uint8_t strPos = 0;
+
+  while (*fmt && n + 1 < size) {
+    if (*fmt != '%') {
+      out[n++] = *fmt++;
+      continue;
+    }
+    if (fmt[1] == '%') {
+      out[n++] = '%';
+      fmt += 2;
+      continue;
+    }
+
+    // Reconstruim specificatorul fără modificatorii de lungime
+    char spec[16];
+    size_t s = 0;
+    spec[s++] = *fmt++;
+    while (*fmt && strchr("-+ #0123456789.", *fmt) && s < sizeof(spec) - 3) spec[s++] = *fmt++;
+    while (*fmt && strchr("hlLqjzt", *fmt)) fmt++;
+    char conv = *fmt ? *fmt++ : 'd';
+
+    int written = 0;
+    size_t room = size - n;
+    if (conv == 's') {
+      const char* str = "";
+      if (strPos < stringsLen) {
+        str = strings + strPos;
+        strPos += (uint8_t)(strlen(str) + 1);
+      }
+      spec[s++] = 's';
+      spec[s] = '\0';
+      written = snprintf(out + n, room, spec, str);
+    } else {
+      uint32_t raw = (argIndex < argc) ? args[argIndex++] : 0;
+      if (conv == 'f' || conv == 'F' || conv == 'e' || conv == 'E' || conv == 'g' || conv == 'G') {
+        float f;
+        memcpy(&f, &raw, sizeof(f));
+        spec[s++] = conv;
+        spec[s] = '\0';
+        written = snprintf(out + n, room, spec, (double)f);
+      } else if (conv == 'c') {
+        spec[s++] = 'c';
+        spec[s] = '\0';
+        written = snprintf(out + n, room, spec, (int)raw);
+      } else if (conv == 'd' || conv == 'i') {
+        spec[s++] = 'l';
+        spec[s++] = 'd';
+        spec[s] = '\0';
+        written = snprintf(out + n, room, spec, (long)(int32_t)raw);
+      } else {
+        // u, x, X, o, p
+        spec[s++] = 'l';
+        spec[s++] = (conv == 'p') ? 'x' : conv;
+        spec[s] = '\0';
+        written = snprintf(out + n, room, spec, (unsigned long)raw);
+      }
+    }
+    if (written > 0) n += ((size_t)written < room) ? (size_t)written : room - 1;
+  }
+  out[n] = '\0';
+  return n;
+}
+
+#endif
@@ -0,0 +1,346 @@
+/**
+ * Reluarea pe calculator a detectorului de accident al ESP32 (AccidentDetection.h).
+ *
+ * Trece rulări (sintetice sau înregistrate) prin detector și dă un scor: latența detecției
+ * față de momentul real al impactului, impacturi ratate și alarme false pe minut de rulare.
+ *
+ * Compilare:
+ *   g++ -O2 -std=c++17 -I"../../firmware/Elysium RC/ESP32/alerts" accident_replay.cpp -o accident_replay
+ * Utilizare:
+ *   accident_replay                  (doar rulările sintetice)
+ *   accident_replay rulare.txt ...   (plus rulări înregistrate, câte o linie pe eveniment:
+ *                                       "timp_us W viteză_m_s viteză_cerută_m_s"
+ *                                       "timp_us B 1|0"               (frâna automată activă)
+ *                                       "timp_us U canal cm"          (cm = -1 fără ecou)
+ *                                       "timp_us H orientare_rad"
+ *                                       "timp_us X"                   (impact real, adnotat))
+ */
+
+#include "AccidentDetection.h"
+#include "../common/CheckReport.h"
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+#define LATENCY_TARGET_US 100000UL
+#define MATCH_BEFORE_US 50000UL       // o detecție cu atât înainte de impactul adnotat încă se potrivește
+#define MATCH_AFTER_US 500000UL
+
+struct Event {
+  uint32_t timeUs;
+  char type;                  // W, B, U, H, X
+  float a;
+  float b;
+};
+
+struct Score {
+  int impacts = 0;
+  int detected = 0;
+  int falsePositives = 0;
+  uint32_t maxLatencyUs = 0;
+  double sumLatencyUs = 0;
+  double minutes = 0;
+};
+
+static Score replay(const std::vector<Event>& run, const AccidentConfig& config) {
+  AccidentFusion detector(config);
+  std::vector<uint32_t> impacts;
+  std::vector<uint32_t> detections;
+
+  for (const Event& e : run) {
+    bool fired = false;
+    switch (e.type) {
+      case 'W': fired = detector.onWheel(e.a, e.b, e.timeUs); break;
+      case 'B': detector.setAutoBrake(e.a != 0); break;
+      case 'U': fired = detector.onRange((int)e.a, e.b, e.timeUs); break;
+      case 'H': fired = detector.onHeading(e.a, e.timeUs); break;
+      case 'X': impacts.push_back(e.timeUs); break;
+    }
+    if (fired) detections.push_back(detector.event().timeUs);
+  }
+
+  Score s;
+  s.impacts = (int)impacts.size();
+  std::vector<bool> used(detections.size(), false);
+  for (uint32_t impact : impacts) {
+    for (size_t i = 0; i < detections.size(); i++) {
+      int32_t delta = (int32_t)(detections[i] - impact);
+      if (!used[i] && delta >= -(int32_t)MATCH_BEFORE_US && delta <= (int32_t)MATCH_AFTER_US) {
+        used[i] = true;
+        uint32_t latency = delta > 0 ? (uint32_t)delta : 0;
+        s.detected++;
+        s.sumLatencyUs += latency;
+        if (latency > s.maxLatencyUs) s.maxLatencyUs = latency;
+        break;
+      }
+    }
+  }
+  for (bool u : used) s.falsePositives += u ? 0 : 1;
+  if (!run.empty()) s.minutes = (run.back().timeUs - run.front().timeUs) / 60e6;
+  return s;
+}
+
+static bool report(const char* name, const Score& s, bool expectImpacts) {
+  bool ok = s.falsePositives == 0 && s.detected == s.impacts && s.maxLatencyUs <= LATENCY_TARGET_US;
+  if (expectImpacts) ok = ok && s.impacts > 0;
+  return reportf(name, ok, "impacturi %d/%d, latență medie %.0f ms, max %.0f ms, alarme false %d (%.2f/min)",
+                 s.detected, s.impacts, s.detected ? s.sumLatencyUs / s.detected / 1000.0 : 0.0,
+                 s.maxLatencyUs / 1000.0, s.falsePositives, s.minutes > 0 ? s.falsePositives / s.minutes : 0.0);
+}
+
+// Zgomot determinist, uniform în [-amp, amp]
+static float noise(uint32_t& state, float amp) {
+  state = state * 1664525u + 1013904223u;
+  return amp * (((state >> 8) & 0xFFFF) / 32767.5f - 1.0f);
+}
+
+/**
+ * Simulatorul unei rulări: roata la 200 Hz (cu cuantizarea encoderului), busola la 200 Hz,
+ * câte un canal ultrasonic la 50 ms. Viteza urmează viteza cerută cu întârziere de ordinul întâi.
+ */
+class Simulator {
+public:
+  std::vector<Event> events;
+
+  explicit Simulator(uint32_t seed) : _seed(seed) {}
+
+  void setRange(int channel, float cm) { _range[channel] = cm; }
+  void setHeadingRate(float radPerS) { _headingRate = radPerS; }
+  void setCommanded(float ms) { _commanded = ms; }
+
+  // Rampa vitezei cerute, ca bucla de viteză (SPEED_DECEL_LIMIT ~ 2 m/s^2)
+  void rampTo(float ms, float accel, float seconds) {
+    uint32_t end = _timeUs + (uint32_t)(seconds * 1e6f);
+    while (_timeUs < end) {
+      float step = accel * STEP_US * 1e-6f;
+      if (_commanded < ms) _commanded = fminf(_commanded + step, ms);
+      else _commanded = fmaxf(_commanded - step, ms);
+      tick();
+    }
+  }
+
+  void run(float seconds) {
+    uint32_t end = _timeUs + (uint32_t)(seconds * 1e6f);
+    while (_timeUs < end) tick();
+  }
+
+  // Impact: roata se oprește în câteva ms, motorul încă trage; ultrasonicul vede contactul
+  void impact(int channel, float headingKickRad, float stopMs = 0.008f) {
+    events.push_back({_timeUs, 'X', 0, 0});
+    _stopTau = stopMs;
+    _blocked = true;
+    _range[channel] = 3;
+    _heading += headingKickRad;
+  }
+
+  // Lovit din lateral cu vehiculul oprit: orientarea sare, senzorul lateral vede contactul
+  void sideHit(int channel, float headingKickRad, float seconds) {
+    events.push_back({_timeUs, 'X', 0, 0});
+    _range[channel] = 4;
+    _kickRate = headingKickRad / seconds;
+    _kickUs = (uint32_t)(seconds * 1e6f);
+  }
+
+  // Frâna automată: roata coboară liniar cu decel, iar viteza cerută cade la 0 prin rampa buclei
+  void autoBrake(float decel) {
+    events.push_back({_timeUs, 'B', 1, 0});
+    _brakeDecel = decel;
+  }
+
+  void releaseBrake() {
+    events.push_back({_timeUs, 'B', 0, 0});
+    _brakeDecel = 0;
+  }
+
+  void setHeadingNoise(float amp) { _headingNoise = amp; }
+
+private:
+  static const uint32_t STEP_US = 5000;
+  uint32_t _seed;
+  uint32_t _timeUs = 0;
+  float _commanded = 0;
+  float _speed = 0;
+  float _stopTau = 0;
+  float _brakeDecel = 0;       // m/s^2 cât timp frâna automată este activă
+  bool _blocked = false;
+  float _heading = 0.3f;
+  float _headingRate = 0;
+  float _headingNoise = 0.01f;
+  float _kickRate = 0;         // rad/s cât durează lovitura
+  uint32_t _kickUs = 0;
+  float _range[4] = { -1, -1, -1, -1 };
+  int _nextChannel = 0;
+  uint32_t _nextRangeUs = 0;
+  float _position = 0;         // impulsuri, pentru cuantizare
+
+  void tick() {
+    _timeUs += STEP_US;
+    float dt = STEP_US * 1e-6f;
+    if (_blocked) {
+      _speed += (0 - _speed) * (dt / (_stopTau + dt));
+    } else if (_brakeDecel > 0) {
+      _speed = fmaxf(_speed - _brakeDecel * dt, 0);
+      _commanded = fmaxf(_commanded - 2.0f * dt, 0);
+    } else {
+      _speed += (_commanded - _speed) * (dt / (0.08f + dt));
+    }
+    if (_kickUs > 0) {
+      _heading += _kickRate * dt;
+      _kickUs -= _kickUs < STEP_US ? _kickUs : STEP_US;
+    }
+    _heading += _headingRate * dt;
+
+    // Encoder: 2400 impulsuri/m, viteza măsurată din diferența de impulsuri pe eșantion
+    float before = floorf(_position);
+    _position += _speed * 2400.0f * dt;
+    float measured = (floorf(_position) - before) / 2400.0f / dt;
+    events.push_back({_timeUs, 'W', measured, _commanded});
+
+    float h = _heading + noise(_seed, _headingNoise);
+    while (h > (float)M_PI) h -= 2.0f * (float)M_PI;
+    while (h <= -(float)M_PI) h += 2.0f * (float)M_PI;
+    events.push_back({_timeUs, 'H', h, 0});
+
+    if (_timeUs >= _nextRangeUs) {
+      _nextRangeUs = _timeUs + 50000;
+      float cm = _range[_nextChannel];
+      if (cm >= 0) cm += noise(_seed, 1.0f);
+      events.push_back({_timeUs, 'U', (float)_nextChannel, cm});
+      _nextChannel = (_nextChannel + 1) & 3;
+    }
+  }
+};
+
+static bool loadRun(const char* path, std::vector<Event>& run) {
+  FILE* f = fopen(path, "r");
+  if (!f) return false;
+  char line[128];
+  while (fgets(line, sizeof(line), f)) {
+    unsigned long t;
+    char type;
+    float a = 0, b = 0;
+    int n = sscanf(line, "%lu %c %f %f", &t, &type, &a, &b);
+    if (n >= 2 && strchr("WBUHX", type)) run.push_back({(uint32_t)t, type, a, b});
+  }
+  fclose(f);
+  return !run.empty();
+}
+
+int main(int argc, char** argv) {
+  AccidentConfig config = accidentDefaultConfig();
+  bool allOk = true;
+
+  {
+    // Condus normal într-o cameră goală: accelerări, viraje, opriri comandate, niciun ecou
+    Simulator sim(1);
+    for (int i = 0; i < 20; i++) {
+      sim.rampTo(0.8f, 1.0f, 1.5f);
+      sim.setHeadingRate(i % 2 ? 1.2f : -1.2f);
+      sim.run(2.0f);
+      sim.setHeadingRate(0);
+      sim.rampTo(0, 2.0f, 1.0f);
+      sim.run(0.5f);
+    }
+    allOk &= report("condus normal, cameră goală", replay(sim.events, config), false);
+  }
+  {
+    // Oprire de urgență comandată (cererea de viteză cade direct la 0)
+    Simulator sim(2);
+    for (int i = 0; i < 10; i++) {
+      sim.rampTo(0.8f, 1.0f, 1.5f);
+      sim.run(1.0f);
+      sim.setCommanded(0);
+      sim.run(1.0f);
+    }
+    allOk &= report("opriri bruște comandate", replay(sim.events, config), false);
+  }
+  {
+    // Apropiere lentă de un perete (parcare): distanța scade treptat, fără salt
+    Simulator sim(3);
+    sim.setRange(0, 60);
+    sim.rampTo(0.3f, 1.0f, 0.5f);
+    for (int cm = 60; cm >= 4; cm -= 2) {
+      sim.setRange(0, (float)cm);
+      sim.run(0.07f);
+    }
+    sim.rampTo(0, 2.0f, 0.5f);
+    sim.run(1.0f);
+    allOk &= report("parcare lângă perete", replay(sim.events, config), false);
+  }
+  {
+    // Busolă zgomotoasă lângă motor
+    Simulator sim(4);
+    sim.setHeadingNoise(0.15f);
+    sim.rampTo(0.6f, 1.0f, 1.0f);
+    sim.run(30.0f);
+    allOk &= report("busolă zgomotoasă", replay(sim.events, config), false);
+  }
+  {
+    // Frâna automată pe o podea bună (decelerare peste AEB_DECEL_CMS2, sub marja anvelopei)
+    Simulator sim(8);
+    for (int i = 0; i < 10; i++) {
+      sim.rampTo(0.8f, 1.0f, 1.5f);
+      sim.run(0.5f);
+      sim.autoBrake(i % 2 ? 5.0f : 3.5f);
+      sim.run(1.0f);
+      sim.releaseBrake();
+    }
+    allOk &= report("frâne automate", replay(sim.events, config), false);
+  }
+  {
+    // Impact frontal în plină viteză
+    Simulator sim(5);
+    sim.setRange(0, 40);
+    sim.rampTo(0.8f, 1.0f, 1.5f);
+    sim.run(0.5f);
+    sim.impact(0, 0.1f);
+    sim.run(2.0f);
+    allOk &= report("impact frontal", replay(sim.events, config), true);
+  }
+  {
+    // Impact la viteză mică
+    Simulator sim(6);
+    sim.setRange(0, 50);
+    sim.rampTo(0.4f, 1.0f, 1.0f);
+    sim.run(1.0f);
+    sim.impact(0, 0.0f, 0.02f);
+    sim.run(2.0f);
+    allOk &= report("impact lent", replay(sim.events, config), true);
+  }
+  {
+    // Impact în timpul frânei automate, pe o podea alunecoasă: frâna nu oprește la timp
+    Simulator sim(9);
+    sim.setRange(0, 40);
+    sim.rampTo(0.8f, 1.0f, 1.5f);
+    sim.run(0.5f);
+    sim.autoBrake(1.0f);
+    sim.run(0.2f);
+    sim.impact(0, 0.0f);
+    sim.run(2.0f);
+    allOk &= report("impact cu frâna automată", replay(sim.events, config), true);
+  }
+  {
+    // Lovit lateral cu vehiculul oprit: orientarea și senzorul stâng
+    Simulator sim(7);
+    sim.setRange(1, 45);
+    sim.run(2.0f);
+    sim.sideHit(1, 0.9f, 0.06f);
+    sim.run(2.0f);
+    allOk &= report("lovit lateral, oprit", replay(sim.events, config), true);
+  }
+
+  for (int i = 1; i < argc; i++) {
+    std::vector<Event> run;
+    if (!loadRun(argv[i], run)) {
+      fprintf(stderr, "Nu pot citi rularea %s\n", argv[i]);
+      return 2;
+    }
+    bool annotated = false;
+    for (const Event& e : run) annotated |= e.type == 'X';
+    allOk &= report(argv[i], replay(run, config), annotated);
+  }
+
+  return allOk ? 0 : 1;
+}
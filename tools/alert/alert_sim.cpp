@@ -0,0 +1,292 @@
+/**
+ * Simularea pe calculator a transmisiei alertelor ESP-NOW (AlertScheduler.h).
+ *
+ * Vehiculul anunță incidente către semne printr-un canal cu pierderi (fiecare cadru, alertă
+ * sau confirmare, se pierde independent cu probabilitatea p) și se compară cu transmisia veche:
+ * un singur broadcast sau repetarea lui la 100 ms cât timp condiția rămâne adevărată.
+ * Se raportează probabilitatea ca toate semnele să afișeze incidentul, cadrele puse în aer
+ * pe incident și latența primei confirmări; apoi se verifică regulile cozii (prioritate,
+ * alipire, termen, secvență, confirmări repetate).
+ *
+ * Compilare:
+ *   g++ -O2 -std=c++17 -I"../../firmware/Elysium RC/ESP32/alerts" alert_sim.cpp -o alert_sim
+ * Utilizare:
+ *   alert_sim
+ */
+
+#include "AlertScheduler.h"
+#include "../common/CheckReport.h"
+
+#include <cstdio>
+#include <vector>
+
+#define FRAME_AIRTIME_US 700UL        // ~16 octeți ESP-NOW la 1 Mbps, cu preambul și antet
+#define ACK_DELAY_US 2000UL           // recepție, callback-ul semnului, confirmarea în aer
+#define SEND_BUSY_PROBABILITY 0.02    // callback de trimitere eșuat (canal ocupat)
+#define FLOOD_PERIOD_US 100000UL      // transmisia veche: repetare cât timp condiția rămâne adevărată
+#define FLOOD_HOLD_US 5000000UL
+#define INCIDENTS 2000
+
+// Generator determinist, uniform în [0, 1)
+static double uniform(uint32_t& state) {
+  state = state * 1664525u + 1013904223u;
+  return ((state >> 8) & 0xFFFFFF) / 16777216.0;
+}
+
+struct Outcome {
+  int incidents = 0;
+  int allReached = 0;          // toate semnele active au primit măcar un cadru
+  int delivered = 0;           // vehiculul a primit confirmările cerute
+  double frames = 0;           // cadre ale vehiculului
+  double acks = 0;             // cadre ale semnelor
+  double sumFirstAckMs = 0;
+  int firstAcks = 0;
+  double maxFirstAckMs = 0;
+};
+
+// Un incident cu planificatorul: evenimente discrete până se golește coada
+static void runIncident(AlertScheduler& sched, int signs, int aliveSigns, double loss, uint32_t& rng,
+                        uint32_t startUs, Outcome& out) {
+  struct Pending {
+    uint32_t atUs;
+    bool isAck;
+    bool ok;
+    AlertFrame frame;
+  };
+  std::vector<Pending> pending;
+  std::vector<bool> reached(signs, false);
+  AlertStats before = sched.stats();
+
+  uint32_t now = startUs;
+  sched.submit(ALERT_EVENT_ACCIDENT, 2, 9, now);
+  while (sched.pending() > 0) {
+    AlertFrame frame;
+    if (sched.poll(now, frame)) {
+      out.frames++;
+      pending.push_back({(uint32_t)(now + FRAME_AIRTIME_US), false, uniform(rng) >= SEND_BUSY_PROBABILITY, frame});
+      for (int s = 0; s < aliveSigns; s++) {
+        if (uniform(rng) < loss) continue;
+        reached[s] = true;
+        // Fiecare semn confirmă fiecare transmisie primită
+        AlertFrame ack = frame;
+        ack.type = ALERT_TYPE_ACK;
+        ack.signId = (uint8_t)(s + 1);
+        out.acks++;
+        if (uniform(rng) < loss) continue;
+        pending.push_back({(uint32_t)(now + ACK_DELAY_US + s * FRAME_AIRTIME_US), true, true, ack});
+      }
+      continue;
+    }
+
+    // Următorul moment: un eveniment radio sau acțiunea planificatorului
+    uint32_t next = now + sched.nextActionUs(now);
+    int index = -1;
+    for (size_t i = 0; i < pending.size(); i++) {
+      if ((int32_t)(pending[i].atUs - next) <= 0) {
+        next = pending[i].atUs;
+        index = (int)i;
+      }
+    }
+    now = next;
+    if (index < 0) continue;
+    Pending p = pending[index];
+    pending.erase(pending.begin() + index);
+    if (p.isAck) sched.onAck(p.frame, now);
+    else sched.onSent(p.ok, now);
+  }
+  // Confirmările întârziate, după livrare, doar se numără
+  for (const Pending& p : pending) {
+    if (p.isAck) sched.onAck(p.frame, p.atUs);
+  }
+
+  const AlertStats& after = sched.stats();
+  out.incidents++;
+  bool all = aliveSigns == signs;
+  for (int s = 0; s < aliveSigns; s++) all = all && reached[s];
+  out.allReached += all ? 1 : 0;
+  out.delivered += (int)(after.delivered - before.delivered);
+  if (after.firstAcks != before.firstAcks) {
+    double ms = after.lastFirstAckUs / 1000.0;
+    out.firstAcks++;
+    out.sumFirstAckMs += ms;
+    if (ms > out.maxFirstAckMs) out.maxFirstAckMs = ms;
+  }
+}
+
+static Outcome simulate(int signs, int aliveSigns, double loss, uint32_t seed) {
+  AlertScheduler sched(alertDefaultConfig(), seed);
+  uint32_t rng = seed * 7919u;
+  Outcome out;
+  for (int i = 0; i < INCIDENTS; i++) {
+    runIncident(sched, signs, aliveSigns, loss, rng, (uint32_t)i * 10000000u, out);
+  }
+  return out;
+}
+
+// Transmisia veche: repeats cadre fără confirmare
+static Outcome legacy(int signs, double loss, int repeats, uint32_t seed) {
+  uint32_t rng = seed;
+  Outcome out;
+  for (int i = 0; i < INCIDENTS; i++) {
+    bool all = true;
+    for (int s = 0; s < signs; s++) {
+      bool got = false;
+      for (int r = 0; r < repeats; r++) got |= uniform(rng) >= loss;
+      all = all && got;
+    }
+    out.incidents++;
+    out.allReached += all ? 1 : 0;
+    out.frames += repeats;
+  }
+  return out;
+}
+
+static void print(const char* name, const Outcome& o) {
+  printf("  %-30s livrare %6.2f%%  cadre/incident %5.2f (+%.2f confirmări, %.1f ms în aer)",
+         name, 100.0 * o.allReached / o.incidents, o.frames / o.incidents, o.acks / o.incidents,
+         (o.frames + o.acks) / o.incidents * FRAME_AIRTIME_US / 1000.0);
+  if (o.firstAcks) printf("  prima confirmare %.1f ms (max %.1f)", o.sumFirstAckMs / o.firstAcks, o.maxFirstAckMs);
+  printf("\n");
+}
+
+static AlertFrame ackFor(uint32_t incidentId, uint8_t signId) {
+  AlertFrame ack = {};
+  ack.type = ALERT_TYPE_ACK;
+  ack.incidentId = incidentId;
+  ack.signId = signId;
+  return ack;
+}
+
+int main() {
+  bool allOk = true;
+  const int signs = 2;
+  const int floodRepeats = (int)(FLOOD_HOLD_US / FLOOD_PERIOD_US);
+  char detail[160];
+
+  const double losses[] = { 0.0, 0.1, 0.3, 0.5 };
+  for (double loss : losses) {
+    printf("Pierderi %.0f%%, %d semne:\n", loss * 100, signs);
+    Outcome once = legacy(signs, loss, 1, 11);
+    Outcome flood = legacy(signs, loss, floodRepeats, 12);
+    Outcome acked = simulate(signs, signs, loss, 13);
+    print("un broadcast", once);
+    print("repetare la 100 ms, 5 s", flood);
+    print("cu confirmare", acked);
+
+    double delivery = (double)acked.allReached / acked.incidents;
+    double frames = acked.frames / acked.incidents;
+    bool ok = delivery >= (loss <= 0.3 ? 0.999 : 0.99) && delivery >= (double)once.allReached / once.incidents &&
+              frames * (loss <= 0.3 ? 10 : 5) <= (double)floodRepeats && acked.delivered <= acked.incidents;
+    if (loss == 0.0) ok = ok && frames < 1.1;
+    snprintf(detail, sizeof(detail), "livrare %.2f%%, %.2f cadre/incident (de %.0fx mai puține decât repetarea)",
+             100 * delivery, frames, floodRepeats / frames);
+    char name[48];
+    snprintf(name, sizeof(name), "cu confirmare, pierderi %.0f%%", loss * 100);
+    allOk &= report(name, ok, detail);
+  }
+
+  {
+    // Un semn stins: confirmările nu ajung la 2, incidentul expiră, dar cadrele rămân puține
+    Outcome o = simulate(signs, 1, 0.1, 21);
+    double frames = o.frames / o.incidents;
+    bool ok = o.delivered == 0 && frames <= 20;
+    snprintf(detail, sizeof(detail), "livrate %d, %.1f cadre/incident până la termen", o.delivered, frames);
+    allOk &= report("un semn stins", ok, detail);
+  }
+  {
+    // Secvență crescătoare la fiecare transmisie; alipirea cererilor repetate
+    AlertScheduler s;
+    uint32_t id = s.submit(ALERT_EVENT_ACCIDENT, 2, 9, 0);
+    uint32_t again = s.submit(ALERT_EVENT_ACCIDENT, 2, 9, 100);
+    AlertFrame f;
+    uint16_t lastSeq = 0;
+    bool monotonic = true;
+    uint32_t now = 0;
+    for (int i = 0; i < 5; i++) {
+      now += s.nextActionUs(now);
+      if (!s.poll(now, f)) { monotonic = false; break; }
+      monotonic &= f.sequence > lastSeq && f.incidentId == id;
+      lastSeq = f.sequence;
+      s.onSent(true, now + FRAME_AIRTIME_US);
+      now += FRAME_AIRTIME_US;
+    }
+    bool ok = id != 0 && again == id && s.stats().merged == 1 && monotonic && s.stats().attempts == 5;
+    snprintf(detail, sizeof(detail), "incident %08lx, %lu alipiri, secvența %u", (unsigned long)id,
+             (unsigned long)s.stats().merged, lastSeq);
+    allOk &= report("secvență și alipire", ok, detail);
+  }
+  {
+    // Pauzele se dublează până la maxim
+    AlertScheduler s;
+    s.submit(ALERT_EVENT_ACCIDENT, 2, 9, 0);
+    AlertFrame f;
+    uint32_t now = 0, last = 0;
+    std::vector<uint32_t> gaps;
+    while (s.pending() > 0) {
+      if (s.poll(now, f)) {
+        if (f.sequence > 1) gaps.push_back(now - last);
+        last = now;
+        s.onSent(true, now);
+      }
+      now += s.nextActionUs(now);
+    }
+    AlertSchedulerConfig c = alertDefaultConfig();
+    bool ok = gaps.size() > 4 && s.stats().expired == 1;
+    for (size_t i = 0; i < gaps.size(); i++) {
+      uint32_t nominal = c.firstBackoffUs << (i < 10 ? i : 10);
+      if (nominal > c.maxBackoffUs) nominal = c.maxBackoffUs;
+      ok = ok && gaps[i] >= nominal * 3 / 4 && gaps[i] <= nominal * 5 / 4 + 1;
+    }
+    snprintf(detail, sizeof(detail), "%zu retransmisii în %.1f s, ultima pauză %.0f ms", gaps.size(),
+             c.deadlineUs / 1e6, gaps.empty() ? 0.0 : gaps.back() / 1000.0);
+    allOk &= report("pauze exponențiale, termen", ok, detail);
+  }
+  {
+    // Coada plină: o cerere mai urgentă înlocuiește cea mai veche mai puțin urgentă
+    AlertScheduler s;
+    for (uint8_t e = 0; e < ALERT_QUEUE_LENGTH; e++) s.submit(10 + e, 0, 1, e);
+    uint32_t rejected = s.submit(20, 0, 1, 10);
+    uint32_t urgent = s.submit(ALERT_EVENT_ACCIDENT, 2, 9, 20);
+    AlertFrame f;
+    bool first = s.poll(30, f) && f.incidentId == urgent;
+    bool ok = rejected == 0 && urgent != 0 && first && s.stats().dropped == 2 &&
+              s.pending() == ALERT_QUEUE_LENGTH;
+    snprintf(detail, sizeof(detail), "%lu respinse/înlocuite, urgentul trimis primul: %s",
+             (unsigned long)s.stats().dropped, first ? "da" : "nu");
+    allOk &= report("coadă cu prioritate", ok, detail);
+  }
+  {
+    // Confirmările repetate ale aceluiași semn nu se adună
+    AlertScheduler s;
+    uint32_t id = s.submit(ALERT_EVENT_ACCIDENT, 2, 9, 0);
+    AlertFrame f;
+    s.poll(0, f);
+    s.onSent(true, 700);
+    bool early = s.onAck(ackFor(id, 1), 3000) || s.onAck(ackFor(id, 1), 3500);
+    bool done = s.onAck(ackFor(id, 2), 4000);
+    bool late = s.onAck(ackFor(id, 2), 5000);
+    bool ok = !early && done && !late && s.stats().acks == 2 && s.stats().duplicateAcks == 2 &&
+              s.stats().lastFirstAckUs == 3000 && s.pending() == 0;
+    snprintf(detail, sizeof(detail), "%lu confirmări, %lu repetate, prima după %lu us",
+             (unsigned long)s.stats().acks, (unsigned long)s.stats().duplicateAcks,
+             (unsigned long)s.stats().lastFirstAckUs);
+    allOk &= report("confirmări repetate", ok, detail);
+  }
+  {
+    // Codarea cadrului și cache-ul semnului
+    AlertFrame in = { ALERT_TYPE_ALERT, 0xDEADBEEF, 65000, ALERT_EVENT_ACCIDENT, 2, 9, 0 };
+    uint8_t buffer[ALERT_FRAME_LEN];
+    AlertFrame out;
+    size_t len = alertEncode(in, buffer);
+    bool decoded = alertDecode(buffer, len, out) && out.incidentId == in.incidentId &&
+                   out.sequence == in.sequence && out.severity == in.severity;
+    buffer[0] ^= 1;
+    bool rejected = !alertDecode(buffer, len, out) && !alertDecode(buffer, 22, out);
+    AlertSeenCache<2> seen;
+    bool cache = seen.insert(1) && !seen.insert(1) && seen.insert(2) && seen.insert(3) && seen.insert(1);
+    allOk &= report("cadru și cache de incidente", decoded && rejected && cache,
+                    decoded && rejected && cache ? "codare, respingere, deduplicare" : "nepotrivire");
+  }
+
+  return allOk ? 0 : 1;
+}
@@ -0,0 +1,31 @@
+#ifndef CHECK_REPORT_H
+#define CHECK_REPORT_H
+
+/**
+ * Raportarea comună a verificărilor din uneltele de pe calculator (bancuri, reluări,
+ * simulare): o linie pe verificare, cu numele aliniat, OK/EȘEC și detaliile. Fiecare
+ * program adună rezultatele cu `allOk &= report(...)` și iese cu `allOk ? 0 : 1`,
+ * ca ctest să vadă direct eșecul.
+ */
+
+#include <stdarg.h>
+#include <stdio.h>
+
+static inline bool report(const char* name, bool ok, const char* detail) {
+  printf("%-34s %s  %s\n", name, ok ? "OK  " : "EȘEC", detail);
+  return ok;
+}
+
+// Ca report(), cu detaliile formatate pe loc
+static inline bool reportf(const char* name, bool ok, const char* format, ...)
+    __attribute__((format(printf, 3, 4)));
+static inline bool reportf(const char* name, bool ok, const char* format, ...) {
+  char detail[256];
+  va_list args;
+  va_start(args, format);
+  vsnprintf(detail, sizeof(detail), format, args);
+  va_end(args);
+  return report(name, ok, detail);
+}
+
+#endif
@@ -0,0 +1,172 @@
+/**
+ * Test și măsurători pe calculator pentru decodorul de encoder al Arduino (QuadratureDecoder.h).
+ *
+ * Reia secvențe de fronturi (sintetice sau înregistrate) prin tabelul de tranziții și verifică
+ * poziția finală, numărul de tranziții invalide și perioada estimată a fronturilor,
+ * apoi măsoară timpul de decodare pe front.
+ *
+ * Compilare:
+ *   g++ -O2 -std=c++17 -I"../../firmware/Elysium RC/Arduino" quadrature_bench.cpp -o quadrature_bench
+ * Utilizare:
+ *   quadrature_bench                 (doar secvențele sintetice)
+ *   quadrature_bench captura.txt     (plus o captură: câte o linie "timp_us A B" la fiecare front)
+ */
+
+#include "QuadratureDecoder.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+struct Edge {
+  uint32_t timeUs;
+  uint8_t ab;
+};
+
+struct Expected {
+  int32_t count;
+  uint32_t errors;
+  int32_t edgePeriodUs;     // 0 = nu se verifică
+};
+
+// Sensul înainte: 00 -> 10 -> 11 -> 01
+static const uint8_t FORWARD[4] = {0, 2, 3, 1};
+
+class Generator {
+public:
+  std::vector<Edge> edges;
+  Expected expected = {0, 0, 0};
+
+  Generator() : _phase(0), _timeUs(0) {}
+
+  // steps fronturi în sensul dir (+1/-1), câte unul la periodUs, cu dezechilibru de fază între A și B
+  void run(int steps, int dir, uint32_t periodUs, uint32_t imbalanceUs = 0) {
+    for (int i = 0; i < steps; i++) {
+      _phase = (_phase + dir + 4) & 3;
+      _timeUs += periodUs + ((_phase & 1) ? imbalanceUs : -imbalanceUs);
+      edges.push_back({_timeUs, FORWARD[_phase]});
+      expected.count += dir;
+    }
+    expected.edgePeriodUs = steps >= QUADRATURE_HISTORY + 1 ? dir * (int32_t)periodUs : 0;
+  }
+
+  // Un front pierdut: ambele canale se schimbă deodată (poziția nu se poate deduce)
+  void skip(uint32_t periodUs) {
+    _phase = (_phase + 2) & 3;
+    _timeUs += periodUs;
+    edges.push_back({_timeUs, FORWARD[_phase]});
+    expected.errors++;
+    expected.edgePeriodUs = 0;
+  }
+
+  // Zgomot: întreruperea vine, dar pinii au aceeași stare
+  void glitch() {
+    _timeUs += 1;
+    edges.push_back({_timeUs, FORWARD[_phase]});
+  }
+
+  uint8_t initial() const { return FORWARD[0]; }
+
+private:
+  int _phase;
+  uint32_t _timeUs;
+};
+
+static bool check(const char* name, const std::vector<Edge>& edges, uint8_t initialAb, const Expected& exp) {
+  QuadratureState s;
+  quadratureInit(s, initialAb);
+  for (const Edge& e : edges) quadratureEdge(s, e.ab, e.timeUs);
+
+  bool ok = s.count == exp.count && s.errors == exp.errors;
+  if (exp.edgePeriodUs != 0) ok = ok && std::abs(s.edgePeriodUs - exp.edgePeriodUs) <= 1;
+  printf("%-32s %s  poziție %ld (așteptat %ld), erori %lu (%lu), perioadă %ld us (%ld)\n", name,
+         ok ? "OK  " : "EȘEC", (long)s.count, (long)exp.count, (unsigned long)s.errors,
+         (unsigned long)exp.errors, (long)s.edgePeriodUs, (long)exp.edgePeriodUs);
+  return ok;
+}
+
+static bool loadCapture(const char* path, std::vector<Edge>& edges) {
+  FILE* f = fopen(path, "r");
+  if (!f) return false;
+  unsigned long t;
+  int a, b;
+  while (fscanf(f, "%lu %d %d", &t, &a, &b) == 3) {
+    edges.push_back({(uint32_t)t, (uint8_t)(((a & 1) << 1) | (b & 1))});
+  }
+  fclose(f);
+  return !edges.empty();
+}
+
+int main(int argc, char** argv) {
+  bool allOk = true;
+
+  {
+    Generator g;
+    g.run(1000, +1, 250);
+    allOk &= check("înainte, 1000 fronturi", g.edges, g.initial(), g.expected);
+  }
+  {
+    Generator g;
+    g.run(400, -1, 80);
+    allOk &= check("înapoi, rapid", g.edges, g.initial(), g.expected);
+  }
+  {
+    Generator g;
+    g.run(200, +1, 2000, 600);
+    allOk &= check("lent, fază dezechilibrată", g.edges, g.initial(), g.expected);
+  }
+  {
+    Generator g;
+    g.run(37, +1, 300);
+    g.run(5, -1, 300);
+    g.run(3, +1, 300);
+    g.run(120, -1, 500);
+    allOk &= check("schimbări de sens", g.edges, g.initial(), g.expected);
+  }
+  {
+    Generator g;
+    g.run(100, +1, 100);
+    g.skip(100);
+    g.run(50, +1, 100);
+    g.glitch();
+    g.glitch();
+    g.skip(100);
+    g.run(10, +1, 100);
+    allOk &= check("fronturi pierdute și zgomot", g.edges, g.initial(), g.expected);
+  }
+
+  if (argc > 1) {
+    std::vector<Edge> capture;
+    if (!loadCapture(argv[1], capture)) {
+      fprintf(stderr, "Nu pot citi captura %s\n", argv[1]);
+      return 2;
+    }
+    QuadratureState s;
+    quadratureInit(s, capture[0].ab);
+    for (size_t i = 1; i < capture.size(); i++) quadratureEdge(s, capture[i].ab, capture[i].timeUs);
+    printf("%-32s poziție %ld, erori %lu, ultima perioadă %ld us (%zu fronturi)\n", argv[1],
+           (long)s.count, (unsigned long)s.errors, (long)s.edgePeriodUs, capture.size());
+  }
+
+  // Viteza de decodare: o secvență lungă reluată de mai multe ori
+  Generator g;
+  for (int i = 0; i < 100; i++) {
+    g.run(5000, +1, 50);
+    g.run(5000, -1, 50);
+  }
+  const int rounds = 20;
+  volatile int32_t sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    QuadratureState s;
+    quadratureInit(s, g.initial());
+    for (const Edge& e : g.edges) quadratureEdge(s, e.ab, e.timeUs);
+    sink = sink + s.count;
+  }
+  double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  printf("\nDecodare: %.2f ns/front (%zu fronturi x %d)\n", ns / (g.edges.size() * rounds), g.edges.size(), rounds);
+
+  return allOk ? 0 : 1;
+}
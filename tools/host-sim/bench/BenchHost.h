@@ -0,0 +1,155 @@
+#ifndef BENCH_HOST_H
+#define BENCH_HOST_H
+
+/**
+ * Partea comună a microbenchmark-urilor pe calculator (vehicle_bench, sign_bench): opțiunile,
+ * ceasul gazdei, documentul JSON (MicroBench.h) și comparația cu o rulare de referință.
+ *
+ * Utilizare:
+ *   <bench> [opțiuni]
+ *     --json cale         documentul JSON (formatul Google Benchmark) într-un fișier; implicit stdout
+ *     --filtru text       doar cazurile al căror nume conține textul
+ *     --timp-min ms       durata minimă a unei rulări măsurate (implicit 200)
+ *     --repetari n        repetări pentru mediană (implicit 5, maxim 16)
+ *     --referinta cale    JSON-ul unei rulări anterioare: fiecare caz este comparat cu el
+ *     --prag p            procentul de încetinire peste care comparația eșuează (implicit 10)
+ */
+
+#include "MicroBench.h"
+
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <time.h>
+#include <unistd.h>
+#include <vector>
+
+static FILE* benchJsonOut = NULL;
+
+static uint32_t benchHostNanos() {
+  return (uint32_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+static void benchHostWrite(const char* text) {
+  fputs(text, benchJsonOut);
+}
+
+static bool benchReport(FILE* out, const char* name, bool ok, const char* detail) {
+  fprintf(out, "%-34s %s  %s\n", name, ok ? "OK  " : "EȘEC", detail);
+  return ok;
+}
+
+// real_time-ul cazului name din documentul JSON text; negativ dacă lipsește
+static double benchBaselineTime(const std::string& text, const char* name) {
+  std::string key = std::string("\"name\": \"") + name + "\"";
+  size_t at = text.find(key);
+  if (at == std::string::npos) return -1;
+  at = text.find("\"real_time\":", at);
+  if (at == std::string::npos) return -1;
+  return atof(text.c_str() + at + strlen("\"real_time\":"));
+}
+
+static bool benchReadFile(const char* path, std::string& text) {
+  FILE* f = fopen(path, "rb");
+  if (f == NULL) return false;
+  char chunk[4096];
+  size_t n;
+  while ((n = fread(chunk, 1, sizeof(chunk), f)) > 0) text.append(chunk, n);
+  fclose(f);
+  return true;
+}
+
+static void benchUsage(const char* program) {
+  fprintf(stderr, "Utilizare: %s [--json cale] [--filtru text] [--timp-min ms] [--repetari n]\n"
+                  "           [--referinta cale] [--prag p]\n", program);
+}
+
+static int benchHostMain(int argc, char** argv, const char* executable, const BenchCase* cases, size_t count) {
+  BenchOptions options = { 200000, 5, 100000000, NULL };
+  const char* jsonPath = NULL;
+  const char* baselinePath = NULL;
+  double thresholdPct = 10;
+
+  for (int i = 1; i < argc; i++) {
+    const char* arg = argv[i];
+    const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+    if (value == NULL) {
+      benchUsage(argv[0]);
+      return 2;
+    }
+    if (strcmp(arg, "--json") == 0) jsonPath = value;
+    else if (strcmp(arg, "--filtru") == 0) options.filter = value;
+    else if (strcmp(arg, "--timp-min") == 0) options.minTimeUs = (uint32_t)(atof(value) * 1000);
+    else if (strcmp(arg, "--repetari") == 0) options.repetitions = (uint8_t)atoi(value);
+    else if (strcmp(arg, "--referinta") == 0) baselinePath = value;
+    else if (strcmp(arg, "--prag") == 0) thresholdPct = atof(value);
+    else {
+      benchUsage(argv[0]);
+      return 2;
+    }
+    i++;
+  }
+
+  std::string baseline;
+  if (baselinePath != NULL && !benchReadFile(baselinePath, baseline)) {
+    fprintf(stderr, "Nu pot citi referința %s\n", baselinePath);
+    return 2;
+  }
+
+  benchJsonOut = stdout;
+  if (jsonPath != NULL) {
+    benchJsonOut = fopen(jsonPath, "w");
+    if (benchJsonOut == NULL) {
+      fprintf(stderr, "Nu pot scrie %s\n", jsonPath);
+      return 2;
+    }
+  }
+
+  char date[32];
+  time_t now = time(NULL);
+  strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S%z", localtime(&now));
+  char hostName[64] = "";
+  gethostname(hostName, sizeof(hostName) - 1);
+  BenchContext context = { executable, date, hostName, (uint32_t)sysconf(_SC_NPROCESSORS_ONLN), 0,
+#ifdef NDEBUG
+                           "release" };
+#else
+                           "debug" };
+#endif
+
+  BenchClock clock = { benchHostNanos, 1000 };
+  std::vector<BenchResult> results(count);
+  size_t ran = benchRunAll(cases, count, clock, options, context, benchHostWrite, results.data());
+  if (jsonPath != NULL) fclose(benchJsonOut);
+
+  // Cu JSON-ul la stdout, tabelul și comparația merg pe stderr
+  FILE* table = jsonPath != NULL ? stdout : stderr;
+  fprintf(table, "\n%-34s %12s %12s %12s %14s\n", "Caz", "ns/iter", "min", "max", "elemente/s");
+  for (size_t i = 0; i < ran; i++) {
+    const BenchResult& r = results[i];
+    fprintf(table, "%-34s %12.1f %12.1f %12.1f %14.0f\n", r.name, r.medianNs, r.minNs, r.maxNs,
+            r.itemsPerIteration * 1e9 / r.medianNs);
+  }
+  if (baselinePath == NULL) return ran > 0 ? 0 : 1;
+
+  fprintf(table, "\nComparație cu %s (prag %.0f%%)\n", baselinePath, thresholdPct);
+  bool allOk = true;
+  for (size_t i = 0; i < ran; i++) {
+    const BenchResult& r = results[i];
+    double reference = benchBaselineTime(baseline, r.name);
+    char detail[96];
+    if (reference <= 0) {
+      benchReport(table, r.name, true, "caz nou, fără referință");
+      continue;
+    }
+    double changePct = (r.medianNs / reference - 1) * 100;
+    snprintf(detail, sizeof(detail), "%.1f ns -> %.1f ns (%+.1f%%)", reference, r.medianNs, changePct);
+    allOk &= benchReport(table, r.name, changePct <= thresholdPct, detail);
+  }
+  return allOk ? 0 : 1;
+}
+
+#endif
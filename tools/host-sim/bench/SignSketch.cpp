@@ -0,0 +1,2 @@
+// Schița Arduino a semnului 1, nemodificată; DisplayManager și BleManager se compilează separat
+#include "../../../firmware/Adaptive Traffic System/traffic_sign_1/traffic_sign_1.ino"
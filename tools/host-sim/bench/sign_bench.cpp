@@ -0,0 +1,19 @@
+/**
+ * Microbenchmark-urile semnului de circulație 1 pe calculator: aceleași cazuri ca pe placă
+ * (traffic_sign_1/SignBenchKernels.h), cu schița și modulele ei compilate nemodificat peste
+ * shim-ul din tools/host-sim/shim (GxEPD2 desenează într-un buffer, BLE fără telefon).
+ * Firmware-ul nu pornește (fără setup()); kernelele rulează direct, pe ceasul gazdei.
+ *
+ * Compilare:
+ *   cmake -S tools/host-sim -B build && cmake --build build
+ * Utilizare:
+ *   sign_bench [--json cale] [--filtru text] [--timp-min ms] [--repetari n]
+ *              [--referinta cale] [--prag p]             (vezi BenchHost.h)
+ */
+
+#include "BenchHost.h"
+#include "SignBench.h"
+
+int main(int argc, char** argv) {
+  return benchHostMain(argc, argv, "sign_bench", SIGN_BENCH_CASES, SIGN_BENCH_CASE_COUNT);
+}
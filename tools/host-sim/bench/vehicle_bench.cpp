@@ -0,0 +1,18 @@
+/**
+ * Microbenchmark-urile vehiculului pe calculator: aceleași cazuri ca pe placă
+ * (firmware/Elysium RC/ESP32/bench/VehicleBench.cpp), compilate din Modules.cpp nemodificat.
+ * Firmware-ul nu pornește (fără setup()); kernelele rulează direct, pe ceasul gazdei.
+ *
+ * Compilare:
+ *   cmake -S tools/host-sim -B build && cmake --build build
+ * Utilizare:
+ *   vehicle_bench [--json cale] [--filtru text] [--timp-min ms] [--repetari n]
+ *                 [--referinta cale] [--prag p]          (vezi BenchHost.h)
+ */
+
+#include "BenchHost.h"
+#include "VehicleBench.h"
+
+int main(int argc, char** argv) {
+  return benchHostMain(argc, argv, "vehicle_bench", VEHICLE_BENCH_CASES, VEHICLE_BENCH_CASE_COUNT);
+}
@@ -0,0 +1,251 @@
+#ifndef SIM_ARDUINO_H
+#define SIM_ARDUINO_H
+
+/**
+ * Arduino-ESP32 pe calculator: doar ce folosește firmware-ul vehiculului.
+ *
+ * Timpul (millis/micros/delay) vine din ceasul virtual al nucleului (SimKernel.h), pinii,
+ * PWM-ul și porturile seriale sunt conectate la modelul lumii prin SimHardware.h.
+ * delay() blochează taskul (ca vTaskDelay), delayMicroseconds() și pulseIn() consumă timp
+ * fără să cedeze procesorul, ca pe placă.
+ */
+
+#include <stdint.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <math.h>
+#include <algorithm>
+#include <functional>
+#include <string>
+
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "esp_err.h"
+
+using std::min;
+using std::max;
+
+#define HIGH 0x1
+#define LOW 0x0
+
+#define INPUT 0x01
+#define OUTPUT 0x03
+#define INPUT_PULLUP 0x05
+
+#define RISING 0x01
+#define FALLING 0x02
+#define CHANGE 0x03
+
+#define SERIAL_8N1 0x800001c
+
+#define IRAM_ATTR
+#define F(s) (s)
+
+#define log_e(format, ...) fprintf(stderr, "[E] " format "\n", ##__VA_ARGS__)
+
+#define constrain(amt, low, high) ((amt) < (low) ? (low) : ((amt) > (high) ? (high) : (amt)))
+
+// ******************* TIMP ********************************************
+unsigned long millis();
+unsigned long micros();
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void yield();
+
+// ******************* GPIO / PWM **************************************
+void pinMode(uint8_t pin, uint8_t mode);
+void digitalWrite(uint8_t pin, uint8_t level);
+int digitalRead(uint8_t pin);
+#define digitalPinToInterrupt(p) (p)
+void attachInterruptArg(uint8_t pin, void (*isr)(void*), void* arg, int mode);
+void detachInterrupt(uint8_t pin);
+unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeoutUs = 1000000UL);
+
+bool ledcAttachChannel(uint8_t pin, uint32_t freq, uint8_t resolution, uint8_t channel);
+bool ledcWrite(uint8_t pin, uint32_t duty);
+uint32_t ledcWriteTone(uint8_t pin, uint32_t freq);
+
+// ******************* String ******************************************
+// Bufferul din heap al unui String, numărat ca alocare (SimArduino.cpp): hook-ul de alocare
+// ESP-IDF și heap_caps_get_info() văd aceleași alocări ca pe placă
+void simHeapAcquire(size_t bytes);
+void simHeapRelease(size_t bytes);
+
+// De la atâtea caractere bufferul Arduino-ESP32 nu mai încape în obiect (SSO) și vine din heap
+#define SIM_STRING_SSO 11
+
+class String {
+public:
+  String() {}
+  String(const char* s) : _s(s ? s : "") { track(); }
+  String(const std::string& s) : _s(s) { track(); }
+  String(char c) : _s(1, c) { track(); }
+  String(int v) : _s(std::to_string(v)) { track(); }
+  String(unsigned int v) : _s(std::to_string(v)) { track(); }
+  String(long v) : _s(std::to_string(v)) { track(); }
+  String(unsigned long v) : _s(std::to_string(v)) { track(); }
+  String(float v, unsigned int decimals = 2) : _s(format(v, decimals)) { track(); }
+  String(double v, unsigned int decimals = 2) : _s(format(v, decimals)) { track(); }
+  String(const String& o) : _s(o._s) { track(); }
+  String(String&& o) noexcept : _s(std::move(o._s)), _heapCapacity(o._heapCapacity) { o.forget(); }
+  ~String() { release(); }
+
+  String& operator=(const String& o) {
+    if (this != &o) { _s = o._s; track(); }
+    return *this;
+  }
+  String& operator=(String&& o) noexcept {
+    if (this != &o) {
+      release();
+      _s = std::move(o._s);
+      _heapCapacity = o._heapCapacity;
+      o.forget();
+    }
+    return *this;
+  }
+
+  const char* c_str() const { return _s.c_str(); }
+  unsigned int length() const { return (unsigned int)_s.size(); }
+  char operator[](unsigned int i) const { return i < _s.size() ? _s[i] : 0; }
+  bool operator==(const String& o) const { return _s == o._s; }
+  bool operator!=(const String& o) const { return _s != o._s; }
+  String& operator+=(const String& o) { _s += o._s; track(); return *this; }
+  String& operator+=(const char* o) { _s += o; track(); return *this; }
+  String& operator+=(char c) { _s += c; track(); return *this; }
+  friend String operator+(const String& a, const String& b) { return String(a._s + b._s); }
+  friend String operator+(const String& a, const char* b) { return String(a._s + b); }
+  friend String operator+(const char* a, const String& b) { return String(a + b._s); }
+
+  void trim() {
+    size_t begin = _s.find_first_not_of(" \t\r\n");
+    size_t end = _s.find_last_not_of(" \t\r\n");
+    _s = (begin == std::string::npos) ? std::string() : _s.substr(begin, end - begin + 1);
+  }
+  int toInt() const { return atoi(_s.c_str()); }
+  float toFloat() const { return (float)atof(_s.c_str()); }
+
+private:
+  std::string _s;
+  size_t _heapCapacity = 0;     // capacitatea bufferului din heap de pe placă, 0 în SSO
+
+  // Ca realloc-ul din WString.cpp: bufferul crește doar când șirul nu mai încape
+  void track() {
+    if (_s.size() < SIM_STRING_SSO || _s.size() <= _heapCapacity) return;
+    release();
+    _heapCapacity = _s.size();
+    simHeapAcquire(_heapCapacity + 1);
+  }
+  void release() {
+    if (_heapCapacity > 0) simHeapRelease(_heapCapacity + 1);
+    _heapCapacity = 0;
+  }
+  void forget() {
+    _s.clear();
+    _heapCapacity = 0;
+  }
+
+  static std::string format(double v, unsigned int decimals) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", (int)decimals, v);
+    return buf;
+  }
+};
+
+// ******************* Print / Stream **********************************
+class Print {
+public:
+  virtual ~Print() {}
+  virtual size_t write(uint8_t b) = 0;
+  virtual size_t write(const uint8_t* data, size_t len) {
+    size_t n = 0;
+    while (len--) n += write(*data++);
+    return n;
+  }
+  size_t write(const char* s) { return write((const uint8_t*)s, strlen(s)); }
+
+  size_t print(const char* s) { return write(s); }
+  size_t print(const String& s) { return write(s.c_str()); }
+  size_t print(char c) { return write((uint8_t)c); }
+  // Numerele se formatează pe stivă, ca printNumber() din Arduino, fără String
+  size_t print(int v) { return print((long)v); }
+  size_t print(unsigned int v) { return print((unsigned long)v); }
+  size_t print(long v) { char buf[24]; snprintf(buf, sizeof(buf), "%ld", v); return write(buf); }
+  size_t print(unsigned long v) { char buf[24]; snprintf(buf, sizeof(buf), "%lu", v); return write(buf); }
+  size_t print(double v, int decimals = 2) {
+    char buf[48];
+    snprintf(buf, sizeof(buf), "%.*f", decimals, v);
+    return write(buf);
+  }
+
+  size_t println() { return write("\r\n"); }
+  template <typename T>
+  size_t println(const T& v) { return print(v) + println(); }
+
+  size_t printf(const char* format, ...) __attribute__((format(printf, 2, 3)));
+};
+
+class Stream : public Print {
+public:
+  virtual int available() = 0;
+  virtual int read() = 0;
+  virtual int peek() = 0;
+
+  // Fără așteptare: pe calculator octeții sosesc doar între apelurile de nucleu
+  size_t readBytes(uint8_t* buffer, size_t length) {
+    size_t n = 0;
+    while (n < length && available() > 0) buffer[n++] = (uint8_t)read();
+    return n;
+  }
+  size_t readBytes(char* buffer, size_t length) { return readBytes((uint8_t*)buffer, length); }
+
+  String readStringUntil(char terminator) {
+    std::string s;
+    while (available() > 0) {
+      int c = read();
+      if (c == terminator) break;
+      s += (char)c;
+    }
+    return String(s);
+  }
+};
+
+// Porturile UART0-2; recepția și transmisia sunt legate de lume prin SimHardware.h
+class HardwareSerial : public Stream {
+public:
+  explicit HardwareSerial(int port) : _port(port) {}
+
+  void begin(unsigned long baud, uint32_t config = SERIAL_8N1, int8_t rxPin = -1, int8_t txPin = -1);
+  void end() {}
+  size_t setRxBufferSize(size_t size);
+  int available() override;
+  int read() override;
+  int peek() override;
+  void flush() {}
+  size_t write(uint8_t b) override { return write(&b, 1); }
+  size_t write(const uint8_t* data, size_t len) override;
+  using Print::write;
+  operator bool() const { return true; }
+
+private:
+  int _port;
+};
+
+extern HardwareSerial Serial;
+extern HardwareSerial Serial1;
+extern HardwareSerial Serial2;
+
+// ******************* ESP *********************************************
+class EspClass {
+public:
+  [[noreturn]] void restart();
+  uint32_t getFreeHeap();
+  uint32_t getCycleCount();
+  uint32_t getCpuFreqMHz() { return 240; }
+};
+
+extern EspClass ESP;
+
+#endif
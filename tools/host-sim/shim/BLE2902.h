@@ -0,0 +1,6 @@
+#ifndef SIM_BLE2902_H
+#define SIM_BLE2902_H
+
+#include "BLEDevice.h"
+
+#endif
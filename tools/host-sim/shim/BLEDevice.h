@@ -0,0 +1,175 @@
+#ifndef SIM_BLE_DEVICE_H
+#define SIM_BLE_DEVICE_H
+
+/**
+ * Biblioteca BLE din Arduino-ESP32 pe calculator: serverul GATT (un serviciu, caracteristici
+ * cu scriere și notificare). Telefonul din SimBluetooth.cpp se conectează doar dacă lumea îl
+ * aduce (simBluetoothSetConnected): negociază MTU, activează notificările și schimbă
+ * parametrii conexiunii; scrierile și notificările trec pe evenimentele de conexiune.
+ */
+
+#include <Arduino.h>
+#include <string>
+#include <vector>
+
+// Memoria controllerului Bluetooth Classic (esp_bt.h)
+typedef enum {
+  ESP_BT_MODE_IDLE = 0,
+  ESP_BT_MODE_BLE = 1,
+  ESP_BT_MODE_CLASSIC_BT = 2,
+  ESP_BT_MODE_BTDM = 3
+} esp_bt_mode_t;
+
+static inline esp_err_t esp_bt_controller_mem_release(esp_bt_mode_t mode) {
+  return ESP_OK;
+}
+
+typedef uint8_t esp_bd_addr_t[6];
+
+// Parametrii evenimentelor GATT (esp_gatts_api.h); doar câmpurile folosite de firmware
+struct esp_ble_gatts_cb_param_t {
+  struct {
+    uint16_t conn_id;
+    esp_bd_addr_t remote_bda;
+  } connect;
+  struct {
+    uint16_t conn_id;
+    esp_bd_addr_t remote_bda;
+  } disconnect;
+};
+
+class BLEServer;
+class BLECharacteristic;
+
+class BLEUUID {
+public:
+  BLEUUID() {}
+  explicit BLEUUID(const char* uuid) : _uuid(uuid) {}
+  String toString() const { return _uuid; }
+
+private:
+  String _uuid;
+};
+
+class BLEDescriptor {
+public:
+  virtual ~BLEDescriptor() {}
+};
+
+// Descriptorul CCCD: clientul activează notificările
+class BLE2902 : public BLEDescriptor {
+public:
+  bool getNotifications() const { return _notifications; }
+  void setNotifications(bool enabled) { _notifications = enabled; }
+
+private:
+  bool _notifications = false;
+};
+
+class BLEServerCallbacks {
+public:
+  virtual ~BLEServerCallbacks() {}
+  virtual void onConnect(BLEServer* server) {}
+  virtual void onConnect(BLEServer* server, esp_ble_gatts_cb_param_t* param) {}
+  virtual void onDisconnect(BLEServer* server) {}
+  virtual void onDisconnect(BLEServer* server, esp_ble_gatts_cb_param_t* param) {}
+};
+
+class BLECharacteristicCallbacks {
+public:
+  virtual ~BLECharacteristicCallbacks() {}
+  virtual void onWrite(BLECharacteristic* characteristic) {}
+};
+
+class BLECharacteristic {
+public:
+  static const uint32_t PROPERTY_READ = 1 << 0;
+  static const uint32_t PROPERTY_WRITE = 1 << 1;
+  static const uint32_t PROPERTY_NOTIFY = 1 << 2;
+  static const uint32_t PROPERTY_WRITE_NR = 1 << 5;
+
+  BLECharacteristic(const char* uuid, uint32_t properties) : _uuid(uuid), _properties(properties) {}
+
+  void setCallbacks(BLECharacteristicCallbacks* callbacks) { _callbacks = callbacks; }
+  void addDescriptor(BLEDescriptor* descriptor) { _descriptors.push_back(descriptor); }
+  void setValue(const char* value) { _value = value; }
+  void setValue(const String& value) { _value = value.c_str(); }
+  void setValue(uint8_t* data, size_t len) { _value.assign((const char*)data, len); }
+  String getValue() const { return String(_value); }
+  uint8_t* getData() { return (uint8_t*)&_value[0]; }
+  size_t getLength() const { return _value.size(); }
+  BLEUUID getUUID() const { return _uuid; }
+  // Pleacă spre telefon la următorul eveniment de conexiune, dacă a activat notificările
+  void notify(bool isNotification = true);
+  uint32_t notifications() const { return _notifications; }
+
+  // Pentru telefonul simulat
+  uint32_t properties() const { return _properties; }
+  BLECharacteristicCallbacks* callbacks() const { return _callbacks; }
+  BLE2902* cccd() const;
+
+private:
+  BLEUUID _uuid;
+  uint32_t _properties;
+  BLECharacteristicCallbacks* _callbacks = NULL;
+  std::vector<BLEDescriptor*> _descriptors;
+  std::string _value;
+  uint32_t _notifications = 0;
+};
+
+class BLEService {
+public:
+  explicit BLEService(const char* uuid) : _uuid(uuid) {}
+  ~BLEService();
+
+  BLECharacteristic* createCharacteristic(const char* uuid, uint32_t properties);
+  void start() {}
+  const std::vector<BLECharacteristic*>& characteristics() const { return _characteristics; }
+
+private:
+  BLEUUID _uuid;
+  std::vector<BLECharacteristic*> _characteristics;
+};
+
+class BLEAdvertising {
+public:
+  void addServiceUUID(const char* uuid) {}
+  void setScanResponse(bool scanResponse) {}
+  void setMinPreferred(uint16_t interval) {}
+  void start();
+};
+
+class BLEServer {
+public:
+  ~BLEServer();
+
+  void setCallbacks(BLEServerCallbacks* callbacks) { _callbacks = callbacks; }
+  BLEService* createService(const char* uuid);
+  void startAdvertising();
+  uint16_t getConnId();
+  uint32_t getConnectedCount();
+  uint16_t getPeerMTU(uint16_t connId);
+  // Intervalele în unități de 1.25 ms, timeout în unități de 10 ms
+  void updateConnParams(esp_bd_addr_t remoteBda, uint16_t minInterval, uint16_t maxInterval,
+                        uint16_t latency, uint16_t timeout);
+
+  // Pentru telefonul simulat
+  BLEServerCallbacks* callbacks() const { return _callbacks; }
+  const std::vector<BLEService*>& services() const { return _services; }
+
+private:
+  BLEServerCallbacks* _callbacks = NULL;
+  std::vector<BLEService*> _services;
+};
+
+class BLEDevice {
+public:
+  static void init(const String& name) {}
+  static BLEServer* createServer();
+  static BLEAdvertising* getAdvertising();
+  static void startAdvertising();
+  static void setMTU(uint16_t mtu);
+  static uint16_t getMTU();
+};
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef SIM_BLESERVER_H
+#define SIM_BLESERVER_H
+
+#include "BLEDevice.h"
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef SIM_BLEUTILS_H
+#define SIM_BLEUTILS_H
+
+#include "BLEDevice.h"
+
+#endif
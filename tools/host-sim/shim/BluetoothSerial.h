@@ -0,0 +1,24 @@
+#ifndef SIM_BLUETOOTH_SERIAL_H
+#define SIM_BLUETOOTH_SERIAL_H
+
+#include <Arduino.h>
+
+typedef std::function<void(const uint8_t* buffer, size_t size)> BluetoothSerialDataCb;
+
+// SPP: octeții trimiși de telefon vin din lume (simBluetoothReceive), cei scriși pleacă spre ea
+class BluetoothSerial : public Stream {
+public:
+  bool begin(const String& name, bool isMaster = false);
+  void end() {}
+  bool connected(int timeoutMs = 0);
+  void onData(BluetoothSerialDataCb callback);
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t write(uint8_t b) override { return write(&b, 1); }
+  size_t write(const uint8_t* data, size_t len) override;
+  using Print::write;
+  void flush() {}
+};
+
+#endif
@@ -0,0 +1,19 @@
+#ifndef SIM_ESP32_SERVO_H
+#define SIM_ESP32_SERVO_H
+
+// Unghiul scris ajunge la modelul lumii (simServoAngle)
+class Servo {
+public:
+  Servo() : _pin(-1), _angle(90) {}
+  int attach(int pin);
+  void detach() { _pin = -1; }
+  void write(int angle);
+  int read() const { return _angle; }
+  bool attached() const { return _pin >= 0; }
+
+private:
+  int _pin;
+  int _angle;
+};
+
+#endif
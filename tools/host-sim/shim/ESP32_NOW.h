@@ -0,0 +1,59 @@
+#ifndef SIM_ESP32_NOW_H
+#define SIM_ESP32_NOW_H
+
+/**
+ * Biblioteca ESP_NOW din Arduino-ESP32 3.x, peste magistrala radio din proces (SimHardware.h):
+ * cadrele ajung la nodurile lumii (ex. semnele de circulație) după timpul de emisie, cu pierderi
+ * configurabile; callback-urile rulează în taskul hardware, ca în taskul WiFi pe placă.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "WiFi.h"
+
+#define ESP_NOW_MAX_DATA_LEN 250
+#define ESP_NOW_ETH_ALEN 6
+
+typedef struct {
+  uint8_t* src_addr;
+  uint8_t* des_addr;
+  void* rx_ctrl;
+} esp_now_recv_info_t;
+
+class ESP_NOW_Peer {
+public:
+  ESP_NOW_Peer(const uint8_t* macAddr, uint8_t channel = 0, wifi_interface_t iface = WIFI_IF_AP,
+               const uint8_t* lmk = NULL);
+  virtual ~ESP_NOW_Peer();
+
+  const uint8_t* addr() const { return _mac; }
+  uint8_t getChannel() const { return _channel; }
+
+  virtual void onReceive(const uint8_t* data, size_t len, bool broadcast) {}
+  virtual void onSent(bool success) {}
+
+protected:
+  bool add();
+  bool remove();
+  size_t send(const uint8_t* data, int len);
+
+private:
+  uint8_t _mac[6];
+  uint8_t _channel;
+  bool _added;
+};
+
+class ESP_NOW_Class {
+public:
+  static constexpr uint8_t BROADCAST_ADDR[6] = { 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF };
+
+  bool begin(const uint8_t* pmk = NULL);
+  bool end();
+  int getTotalPeerCount();
+  void onNewPeer(void (*callback)(const esp_now_recv_info_t* info, const uint8_t* data, int len, void* arg),
+                 void* arg);
+};
+
+extern ESP_NOW_Class ESP_NOW;
+
+#endif
@@ -0,0 +1,56 @@
+#ifndef SIM_FS_H
+#define SIM_FS_H
+
+#include <Arduino.h>
+#include <memory>
+
+#define FILE_READ "r"
+#define FILE_WRITE "w"
+#define FILE_APPEND "a"
+
+namespace fs {
+
+struct SimFileHandle;
+
+// Un fișier sau un director deschis din sistemul de fișiere în memorie (SimFlash.cpp)
+class File : public Stream {
+public:
+  File() {}
+  explicit File(std::shared_ptr<SimFileHandle> handle) : _h(handle) {}
+
+  size_t write(uint8_t b) override { return write(&b, 1); }
+  size_t write(const uint8_t* data, size_t len) override;
+  using Print::write;
+  int available() override;
+  int read() override;
+  int peek() override;
+  size_t read(uint8_t* buffer, size_t len);
+  bool seek(uint32_t pos);
+  size_t position() const;
+  size_t size() const;
+  void flush() {}
+  void close() { _h.reset(); }
+  const char* name() const;
+  const char* path() const;
+  bool isDirectory() const;
+  File openNextFile(const char* mode = FILE_READ);
+  operator bool() const { return _h != nullptr; }
+
+private:
+  std::shared_ptr<SimFileHandle> _h;
+};
+
+class FS {
+public:
+  File open(const char* path, const char* mode = FILE_READ, bool create = false);
+  bool exists(const char* path);
+  bool remove(const char* path);
+  bool mkdir(const char* path);
+};
+
+}  // namespace fs
+
+using fs::File;
+using fs::FS;
+
+#endif
@@ -0,0 +1,6 @@
+#ifndef SIM_FREE_MONO_BOLD_9PT7B_H
+#define SIM_FREE_MONO_BOLD_9PT7B_H
+
+// Fontul nu este folosit de DisplayManager (textul folosește fontul clasic din Adafruit_GFX.h)
+
+#endif
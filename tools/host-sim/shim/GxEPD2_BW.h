@@ -0,0 +1,71 @@
+#ifndef SIM_GXEPD2_BW_H
+#define SIM_GXEPD2_BW_H
+
+/**
+ * GxEPD2 pe calculator: display-ul alb-negru desenează în bufferul paginii, cu aceeași rotație
+ * ca biblioteca; nextPage() nu are panou la care să trimită bufferul, doar numără refresh-urile.
+ */
+
+#include <Adafruit_GFX.h>
+
+#define GxEPD_BLACK 0x0000
+#define GxEPD_WHITE 0xFFFF
+
+// Panoul MH-ET LIVE 2.13" (controller flexibil), 104x212 în orientarea nativă
+class GxEPD2_213_flex {
+public:
+  static const uint16_t WIDTH = 104;
+  static const uint16_t HEIGHT = 212;
+
+  GxEPD2_213_flex(int16_t cs, int16_t dc, int16_t rst, int16_t busy) {}
+};
+
+template <typename GxEPD2_Type, const uint16_t page_height>
+class GxEPD2_BW : public Adafruit_GFX {
+public:
+  GxEPD2_Type epd2;
+
+  explicit GxEPD2_BW(GxEPD2_Type epd2_instance)
+      : Adafruit_GFX(GxEPD2_Type::WIDTH, GxEPD2_Type::HEIGHT), epd2(epd2_instance) {
+    memset(_buffer, 0xFF, sizeof(_buffer));
+  }
+
+  void init(uint32_t serial_diag_bitrate = 0) {}
+  void hibernate() {}
+
+  void drawPixel(int16_t x, int16_t y, uint16_t color) override {
+    if (x < 0 || x >= width() || y < 0 || y >= height()) return;
+    int16_t t;
+    switch (getRotation()) {
+      case 1: t = x; x = WIDTH - y - 1; y = t; break;
+      case 2: x = WIDTH - x - 1; y = HEIGHT - y - 1; break;
+      case 3: t = x; x = y; y = HEIGHT - t - 1; break;
+    }
+    if (y >= page_height) return;
+    uint16_t i = x / 8 + y * BYTES_PER_ROW;
+    if (color == GxEPD_WHITE) _buffer[i] |= (uint8_t)(1 << (7 - x % 8));
+    else _buffer[i] &= (uint8_t)~(1 << (7 - x % 8));
+  }
+
+  void fillScreen(uint16_t color) override {
+    memset(_buffer, color == GxEPD_WHITE ? 0xFF : 0x00, sizeof(_buffer));
+  }
+
+  void firstPage() { fillScreen(GxEPD_WHITE); }
+
+  // Pagina are toată înălțimea: un singur "refresh", apoi gata
+  bool nextPage() {
+    _refreshes++;
+    return false;
+  }
+
+  const uint8_t* buffer() const { return _buffer; }
+  uint32_t refreshes() const { return _refreshes; }
+
+private:
+  static const uint16_t BYTES_PER_ROW = (GxEPD2_Type::WIDTH + 7) / 8;
+  uint8_t _buffer[BYTES_PER_ROW * page_height];
+  uint32_t _refreshes = 0;
+};
+
+#endif
@@ -0,0 +1,29 @@
+#ifndef SIM_PREFERENCES_H
+#define SIM_PREFERENCES_H
+
+#include <stddef.h>
+
+// Ca nvs_open(): handle-ul deschis și bufferul unei scrieri vin din heap
+#define SIM_NVS_HANDLE_BYTES 48
+#define SIM_NVS_WRITE_BYTES 32
+
+// NVS în memorie: conținutul se pierde la sfârșitul rulării (o placă nouă, fără calibrări)
+class Preferences {
+public:
+  Preferences() : _open(false), _readOnly(true) {}
+  ~Preferences() { end(); }
+  bool begin(const char* name, bool readOnly = false);
+  void end();
+  size_t getBytesLength(const char* key);
+  size_t getBytes(const char* key, void* buffer, size_t maxLen);
+  size_t putBytes(const char* key, const void* value, size_t len);
+  bool remove(const char* key);
+  bool clear();
+
+private:
+  char _name[16];
+  bool _open;
+  bool _readOnly;
+};
+
+#endif
@@ -0,0 +1,16 @@
+#ifndef SIM_SPI_H
+#define SIM_SPI_H
+
+#include <stdint.h>
+
+// Magistrala SPI a display-ului: pe calculator nu transferă nimic
+class SPIClass {
+public:
+  void begin(int8_t sck = -1, int8_t miso = -1, int8_t mosi = -1, int8_t ss = -1) {}
+  void end() {}
+  void setFrequency(uint32_t freq) {}
+};
+
+extern SPIClass SPI;
+
+#endif
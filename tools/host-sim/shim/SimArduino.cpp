@@ -0,0 +1,549 @@
+#include <Arduino.h>
+#include <ESP32Servo.h>
+#include <Preferences.h>
+#include <esp_random.h>
+#include "driver/gpio.h"
+#include "driver/uart.h"
+#include "esp_timer.h"
+#include "esp_heap_caps.h"
+#include "esp_debug_helpers.h"
+#include "esp_rom_sys.h"
+#include "SimHardware.h"
+#include "SimKernel.h"
+
+#include <stdarg.h>
+#include <atomic>
+#include <chrono>
+#include <unistd.h>
+#include <deque>
+#include <map>
+#include <string>
+#include <vector>
+
+// ******************* TIMP ********************************************
+unsigned long millis() {
+  return (unsigned long)(simNowUs() / 1000);
+}
+
+unsigned long micros() {
+  return (unsigned long)simNowUs();
+}
+
+void delay(uint32_t ms) {
+  vTaskDelay(pdMS_TO_TICKS(ms));
+}
+
+void delayMicroseconds(uint32_t us) {
+  simBusy(us);
+}
+
+void yield() {
+  taskYIELD();
+}
+
+// ******************* GPIO ********************************************
+struct SimPin {
+  int level;
+  void (*isr)(void*);
+  void* isrArg;
+  int isrMode;
+  std::function<void(int)> onWrite;
+  std::function<SimPulse(int)> onPulseIn;
+  bool ledcAttached;
+  uint32_t ledcDuty;
+  uint32_t ledcTone;
+  int servoAngle;
+};
+
+static SimPin pins[SIM_PIN_COUNT];
+
+static SimPin* pinAt(int pin) {
+  if (pin < 0 || pin >= SIM_PIN_COUNT) return NULL;
+  return &pins[pin];
+}
+
+struct SimPinsInit {
+  SimPinsInit() {
+    for (int i = 0; i < SIM_PIN_COUNT; i++) pins[i].servoAngle = -1;
+  }
+};
+
+static SimPinsInit pinsInit;
+
+void pinMode(uint8_t pin, uint8_t mode) {
+}
+
+void digitalWrite(uint8_t pin, uint8_t level) {
+  SimPin* p = pinAt(pin);
+  if (p == NULL) return;
+  p->level = level ? HIGH : LOW;
+  if (p->onWrite) p->onWrite(p->level);
+}
+
+int digitalRead(uint8_t pin) {
+  SimPin* p = pinAt(pin);
+  return p ? p->level : LOW;
+}
+
+int gpio_get_level(gpio_num_t pin) {
+  return digitalRead((uint8_t)pin);
+}
+
+void attachInterruptArg(uint8_t pin, void (*isr)(void*), void* arg, int mode) {
+  SimPin* p = pinAt(pin);
+  if (p == NULL) return;
+  p->isr = isr;
+  p->isrArg = arg;
+  p->isrMode = mode;
+}
+
+void detachInterrupt(uint8_t pin) {
+  SimPin* p = pinAt(pin);
+  if (p != NULL) p->isr = NULL;
+}
+
+unsigned long pulseIn(uint8_t pin, uint8_t state, unsigned long timeoutUs) {
+  SimPin* p = pinAt(pin);
+  SimPulse pulse = { 0, 0 };
+  if (p != NULL && p->onPulseIn) pulse = p->onPulseIn(state);
+  // Așteptare activă, ca pe placă: taskul nu cedează procesorul
+  if (pulse.widthUs == 0 || pulse.delayUs + pulse.widthUs > timeoutUs) {
+    simBusy(timeoutUs);
+    return 0;
+  }
+  simBusy(pulse.delayUs + pulse.widthUs);
+  return pulse.widthUs;
+}
+
+int simPinLevel(int pin) {
+  SimPin* p = pinAt(pin);
+  return p ? p->level : LOW;
+}
+
+void simPinDrive(int pin, int level) {
+  SimPin* p = pinAt(pin);
+  if (p == NULL) return;
+  level = level ? HIGH : LOW;
+  if (level == p->level) return;
+  p->level = level;
+  if (p->isr == NULL) return;
+  if (p->isrMode == CHANGE || (p->isrMode == RISING && level == HIGH) || (p->isrMode == FALLING && level == LOW)) {
+    p->isr(p->isrArg);
+  }
+}
+
+void simPinOnWrite(int pin, std::function<void(int level)> fn) {
+  SimPin* p = pinAt(pin);
+  if (p != NULL) p->onWrite = fn;
+}
+
+void simPinOnPulseIn(int pin, std::function<SimPulse(int state)> fn) {
+  SimPin* p = pinAt(pin);
+  if (p != NULL) p->onPulseIn = fn;
+}
+
+// ******************* PWM / SERVO *************************************
+bool ledcAttachChannel(uint8_t pin, uint32_t freq, uint8_t resolution, uint8_t channel) {
+  SimPin* p = pinAt(pin);
+  if (p == NULL) return false;
+  p->ledcAttached = true;
+  return true;
+}
+
+bool ledcWrite(uint8_t pin, uint32_t duty) {
+  SimPin* p = pinAt(pin);
+  if (p == NULL || !p->ledcAttached) return false;
+  p->ledcDuty = duty;
+  if (duty == 0) p->ledcTone = 0;
+  return true;
+}
+
+uint32_t ledcWriteTone(uint8_t pin, uint32_t freq) {
+  SimPin* p = pinAt(pin);
+  if (p == NULL || !p->ledcAttached) return 0;
+  p->ledcTone = freq;
+  p->ledcDuty = freq > 0 ? 128 : 0;
+  return freq;
+}
+
+uint32_t simLedcDuty(int pin) {
+  SimPin* p = pinAt(pin);
+  return p ? p->ledcDuty : 0;
+}
+
+uint32_t simLedcTone(int pin) {
+  SimPin* p = pinAt(pin);
+  return p ? p->ledcTone : 0;
+}
+
+int Servo::attach(int pin) {
+  SimPin* p = pinAt(pin);
+  if (p == NULL) return 0;
+  _pin = pin;
+  p->servoAngle = _angle;
+  return 1;
+}
+
+void Servo::write(int angle) {
+  _angle = constrain(angle, 0, 180);
+  SimPin* p = pinAt(_pin);
+  if (p != NULL) p->servoAngle = _angle;
+}
+
+int simServoAngle(int pin) {
+  SimPin* p = pinAt(pin);
+  return p ? p->servoAngle : -1;
+}
+
+// ******************* PORTURI SERIALE *********************************
+struct SimSerialPort {
+  std::deque<uint8_t> rx;
+  size_t rxCapacity = 256;           // bufferul implicit al HardwareSerial
+  std::function<void(const uint8_t*, size_t)> onWrite;
+};
+
+static SimSerialPort serialPorts[SIM_SERIAL_PORTS];
+
+HardwareSerial Serial(0);
+HardwareSerial Serial1(1);
+HardwareSerial Serial2(2);
+
+void HardwareSerial::begin(unsigned long baud, uint32_t config, int8_t rxPin, int8_t txPin) {
+}
+
+size_t HardwareSerial::setRxBufferSize(size_t size) {
+  serialPorts[_port].rxCapacity = size;
+  return size;
+}
+
+int HardwareSerial::available() {
+  return (int)serialPorts[_port].rx.size();
+}
+
+int HardwareSerial::read() {
+  std::deque<uint8_t>& rx = serialPorts[_port].rx;
+  if (rx.empty()) return -1;
+  uint8_t b = rx.front();
+  rx.pop_front();
+  return b;
+}
+
+int HardwareSerial::peek() {
+  std::deque<uint8_t>& rx = serialPorts[_port].rx;
+  return rx.empty() ? -1 : rx.front();
+}
+
+size_t HardwareSerial::write(const uint8_t* data, size_t len) {
+  SimSerialPort& port = serialPorts[_port];
+  if (port.onWrite) port.onWrite(data, len);
+  return len;
+}
+
+void simSerialOnWrite(int port, std::function<void(const uint8_t* data, size_t len)> fn) {
+  if (port >= 0 && port < SIM_SERIAL_PORTS) serialPorts[port].onWrite = fn;
+}
+
+void simSerialReceive(int port, const uint8_t* data, size_t len) {
+  if (port < 0 || port >= SIM_SERIAL_PORTS) return;
+  SimSerialPort& p = serialPorts[port];
+  for (size_t i = 0; i < len && p.rx.size() < p.rxCapacity; i++) p.rx.push_back(data[i]);
+}
+
+size_t Print::printf(const char* format, ...) {
+  char buf[256];
+  va_list args;
+  va_start(args, format);
+  int n = vsnprintf(buf, sizeof(buf), format, args);
+  va_end(args);
+  if (n < 0) return 0;
+  return write((const uint8_t*)buf, strlen(buf));
+}
+
+// ******************* HEAP (BUFFERELE String) **************************
+static std::atomic<size_t> heapUsedBytes(0);
+static std::atomic<size_t> heapBlocks(0);
+static std::atomic<size_t> heapMaxUsedBytes(0);
+
+void simHeapAcquire(size_t bytes) {
+  size_t used = heapUsedBytes += bytes;
+  heapBlocks++;
+  size_t peak = heapMaxUsedBytes.load();
+  while (used > peak && !heapMaxUsedBytes.compare_exchange_weak(peak, used)) {}
+  // Ca heap_caps_malloc(): hook-ul vede alocarea în taskul care a făcut-o
+  if (esp_heap_trace_alloc_hook != NULL) esp_heap_trace_alloc_hook(NULL, bytes, MALLOC_CAP_DEFAULT);
+}
+
+void simHeapRelease(size_t bytes) {
+  heapUsedBytes -= bytes;
+  heapBlocks--;
+  if (esp_heap_trace_free_hook != NULL) esp_heap_trace_free_hook(NULL);
+}
+
+size_t heap_caps_get_free_size(uint32_t caps) {
+  return SIM_HEAP_FREE_AT_BOOT - heapUsedBytes.load();
+}
+
+size_t heap_caps_get_largest_free_block(uint32_t caps) {
+  return heap_caps_get_free_size(caps);
+}
+
+size_t heap_caps_get_minimum_free_size(uint32_t caps) {
+  return SIM_HEAP_FREE_AT_BOOT - heapMaxUsedBytes.load();
+}
+
+void heap_caps_get_info(multi_heap_info_t* info, uint32_t caps) {
+  memset(info, 0, sizeof(*info));
+  info->total_free_bytes = heap_caps_get_free_size(caps);
+  info->total_allocated_bytes = heapUsedBytes.load();
+  info->largest_free_block = info->total_free_bytes;
+  info->minimum_free_bytes = heap_caps_get_minimum_free_size(caps);
+  info->allocated_blocks = heapBlocks.load();
+  info->free_blocks = 1;
+  info->total_blocks = info->allocated_blocks + 1;
+}
+
+esp_err_t esp_backtrace_print(int depth) {
+  return ESP_OK;
+}
+
+int esp_rom_printf(const char* format, ...) {
+  va_list args;
+  va_start(args, format);
+  int n = vfprintf(stderr, format, args);
+  va_end(args);
+  return n;
+}
+
+// ******************* DRIVERUL UART (ESP-IDF) *************************
+struct SimUartDriver {
+  bool installed;
+  size_t capacity;
+  std::deque<uint8_t> rx;
+  QueueHandle_t events;
+};
+
+static SimUartDriver uartDrivers[UART_NUM_MAX];
+
+esp_err_t uart_driver_install(uart_port_t port, int rxBufferSize, int txBufferSize, int queueSize,
+                              QueueHandle_t* queue, int intrFlags) {
+  if (port < 0 || port >= UART_NUM_MAX) return ESP_ERR_INVALID_ARG;
+  SimUartDriver& d = uartDrivers[port];
+  d.installed = true;
+  d.capacity = (size_t)rxBufferSize;
+  d.events = (queue != NULL && queueSize > 0) ? xQueueCreate(queueSize, sizeof(uart_event_t)) : NULL;
+  if (queue != NULL) *queue = d.events;
+  return ESP_OK;
+}
+
+esp_err_t uart_param_config(uart_port_t port, const uart_config_t* config) {
+  return ESP_OK;
+}
+
+esp_err_t uart_set_pin(uart_port_t port, int txPin, int rxPin, int rtsPin, int ctsPin) {
+  return ESP_OK;
+}
+
+esp_err_t uart_set_rx_full_threshold(uart_port_t port, int threshold) {
+  return ESP_OK;
+}
+
+esp_err_t uart_set_rx_timeout(uart_port_t port, uint8_t symbols) {
+  return ESP_OK;
+}
+
+int uart_read_bytes(uart_port_t port, void* buffer, uint32_t length, TickType_t ticks) {
+  if (port < 0 || port >= UART_NUM_MAX || !uartDrivers[port].installed) return -1;
+  std::deque<uint8_t>& rx = uartDrivers[port].rx;
+  uint8_t* out = (uint8_t*)buffer;
+  uint32_t n = 0;
+  while (n < length && !rx.empty()) {
+    out[n++] = rx.front();
+    rx.pop_front();
+  }
+  return (int)n;
+}
+
+int uart_write_bytes(uart_port_t port, const void* data, size_t length) {
+  return (int)length;
+}
+
+esp_err_t uart_flush_input(uart_port_t port) {
+  if (port < 0 || port >= UART_NUM_MAX) return ESP_ERR_INVALID_ARG;
+  uartDrivers[port].rx.clear();
+  return ESP_OK;
+}
+
+// Un cadru complet sosit pe linie: un singur eveniment, ca la pragul de recepție al driverului
+void simUartReceive(int port, const uint8_t* data, size_t len) {
+  if (port < 0 || port >= UART_NUM_MAX || !uartDrivers[port].installed) return;
+  SimUartDriver& d = uartDrivers[port];
+  uart_event_t event = {};
+  if (d.rx.size() + len > d.capacity) {
+    event.type = UART_BUFFER_FULL;
+  } else {
+    d.rx.insert(d.rx.end(), data, data + len);
+    event.type = UART_DATA;
+    event.size = len;
+  }
+  if (d.events != NULL) xQueueSendFromISR(d.events, &event, NULL);
+}
+
+// ******************* esp_timer ***************************************
+struct SimTimer {
+  esp_timer_cb_t callback;
+  void* arg;
+  uint32_t generation;       // o oprire invalidează evenimentele deja programate
+  bool active;
+  uint64_t periodUs;
+};
+
+static void timerSchedule(SimTimer* t, uint64_t atUs);
+
+static void timerFire(SimTimer* t, uint32_t generation, uint64_t atUs) {
+  if (t->generation != generation || !t->active) return;
+  if (t->periodUs > 0) {
+    timerSchedule(t, atUs + t->periodUs);
+  } else {
+    t->active = false;
+  }
+  t->callback(t->arg);
+}
+
+static void timerSchedule(SimTimer* t, uint64_t atUs) {
+  uint32_t generation = t->generation;
+  simAt(atUs, [t, generation, atUs] { timerFire(t, generation, atUs); });
+}
+
+esp_err_t esp_timer_create(const esp_timer_create_args_t* args, esp_timer_handle_t* out) {
+  SimTimer* t = new SimTimer();
+  t->callback = args->callback;
+  t->arg = args->arg;
+  t->generation = 0;
+  t->active = false;
+  t->periodUs = 0;
+  *out = t;
+  return ESP_OK;
+}
+
+static esp_err_t timerStart(SimTimer* t, uint64_t delayUs, uint64_t periodUs) {
+  if (t == NULL) return ESP_ERR_INVALID_ARG;
+  if (t->active) return ESP_ERR_INVALID_STATE;
+  t->active = true;
+  t->periodUs = periodUs;
+  t->generation++;
+  timerSchedule(t, simNowUs() + delayUs);
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_start_once(esp_timer_handle_t timer, uint64_t timeoutUs) {
+  return timerStart(timer, timeoutUs, 0);
+}
+
+esp_err_t esp_timer_start_periodic(esp_timer_handle_t timer, uint64_t periodUs) {
+  return timerStart(timer, periodUs, periodUs);
+}
+
+esp_err_t esp_timer_stop(esp_timer_handle_t timer) {
+  if (timer == NULL) return ESP_ERR_INVALID_ARG;
+  if (!timer->active) return ESP_ERR_INVALID_STATE;
+  timer->active = false;
+  timer->generation++;
+  return ESP_OK;
+}
+
+esp_err_t esp_timer_delete(esp_timer_handle_t timer) {
+  if (timer == NULL || timer->active) return ESP_ERR_INVALID_STATE;
+  timer->generation++;
+  return ESP_OK;
+}
+
+int64_t esp_timer_get_time() {
+  return (int64_t)simNowUs();
+}
+
+// ******************* DIVERSE *****************************************
+static uint32_t randomState = 0x12345678u;
+
+void simRandomSeed(uint32_t seed) {
+  randomState = seed ? seed : 1;
+}
+
+// xorshift32
+uint32_t esp_random() {
+  randomState ^= randomState << 13;
+  randomState ^= randomState >> 17;
+  randomState ^= randomState << 5;
+  return randomState;
+}
+
+EspClass ESP;
+
+void EspClass::restart() {
+  fprintf(stderr, "sim: ESP.restart() cerut de firmware, simularea se oprește\n");
+  fflush(stdout);
+  _exit(3);
+}
+
+uint32_t EspClass::getFreeHeap() {
+  return 200000;
+}
+
+// Ceasul gazdei (nu cel virtual) ca un contor de cicluri la getCpuFreqMHz(), pentru măsurători
+uint32_t EspClass::getCycleCount() {
+  uint64_t ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+      std::chrono::steady_clock::now().time_since_epoch()).count();
+  return (uint32_t)(ns * getCpuFreqMHz() / 1000);
+}
+
+// NVS: "spațiu/cheie" -> octeți
+static std::map<std::string, std::vector<uint8_t>> nvs;
+
+bool Preferences::begin(const char* name, bool readOnly) {
+  if (!_open) simHeapAcquire(SIM_NVS_HANDLE_BYTES);
+  snprintf(_name, sizeof(_name), "%s", name);
+  _open = true;
+  _readOnly = readOnly;
+  return true;
+}
+
+void Preferences::end() {
+  if (_open) simHeapRelease(SIM_NVS_HANDLE_BYTES);
+  _open = false;
+}
+
+size_t Preferences::getBytesLength(const char* key) {
+  if (!_open) return 0;
+  auto it = nvs.find(std::string(_name) + "/" + key);
+  return it == nvs.end() ? 0 : it->second.size();
+}
+
+size_t Preferences::getBytes(const char* key, void* buffer, size_t maxLen) {
+  if (!_open) return 0;
+  auto it = nvs.find(std::string(_name) + "/" + key);
+  if (it == nvs.end() || it->second.size() > maxLen) return 0;
+  memcpy(buffer, it->second.data(), it->second.size());
+  return it->second.size();
+}
+
+size_t Preferences::putBytes(const char* key, const void* value, size_t len) {
+  if (!_open || _readOnly) return 0;
+  const uint8_t* bytes = (const uint8_t*)value;
+  simHeapAcquire(SIM_NVS_WRITE_BYTES);
+  nvs[std::string(_name) + "/" + key].assign(bytes, bytes + len);
+  simHeapRelease(SIM_NVS_WRITE_BYTES);
+  return len;
+}
+
+bool Preferences::remove(const char* key) {
+  if (!_open || _readOnly) return false;
+  return nvs.erase(std::string(_name) + "/" + key) > 0;
+}
+
+bool Preferences::clear() {
+  if (!_open || _readOnly) return false;
+  std::string prefix = std::string(_name) + "/";
+  for (auto it = nvs.begin(); it != nvs.end();) {
+    it = it->first.compare(0, prefix.size(), prefix) == 0 ? nvs.erase(it) : std::next(it);
+  }
+  return true;
+}
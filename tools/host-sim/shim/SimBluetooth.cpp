@@ -0,0 +1,339 @@
+#include <BLEDevice.h>
+#include <BluetoothSerial.h>
+#include "SimHardware.h"
+#include "SimKernel.h"
+
+#include <deque>
+#include <string>
+
+// ******************* TELEFONUL ****************************************
+static bool phonePresent = false;
+static std::function<void(const uint8_t*, size_t)> phoneOnReceive;
+static SimBluetoothStats btStats;
+
+static void phoneDeliver(const std::string& bytes) {
+  btStats.packets++;
+  btStats.bytes += bytes.size();
+  if (phoneOnReceive) phoneOnReceive((const uint8_t*)bytes.data(), bytes.size());
+}
+
+// ******************* BLUETOOTH SPP ***********************************
+static bool sppStarted = false;
+static std::deque<uint8_t> sppRx;
+static BluetoothSerialDataCb sppOnData;
+static uint64_t sppTxFreeUs = 0;      // legătura trimite octeții pe rând, la debitul SPP
+
+bool BluetoothSerial::begin(const String& name, bool isMaster) {
+  sppStarted = true;
+  return true;
+}
+
+bool BluetoothSerial::connected(int timeoutMs) {
+  return sppStarted && phonePresent;
+}
+
+void BluetoothSerial::onData(BluetoothSerialDataCb callback) {
+  sppOnData = callback;
+}
+
+int BluetoothSerial::available() {
+  return (int)sppRx.size();
+}
+
+int BluetoothSerial::read() {
+  if (sppRx.empty()) return -1;
+  uint8_t b = sppRx.front();
+  sppRx.pop_front();
+  return b;
+}
+
+int BluetoothSerial::peek() {
+  return sppRx.empty() ? -1 : sppRx.front();
+}
+
+size_t BluetoothSerial::write(const uint8_t* data, size_t len) {
+  if (!connected()) return 0;
+  uint64_t start = std::max(simNowUs(), sppTxFreeUs);
+  sppTxFreeUs = start + len * 1000000ull / SIM_SPP_BYTES_PER_S;
+  std::string bytes((const char*)data, len);
+  simAt(sppTxFreeUs + SIM_SPP_LATENCY_US, [bytes] {
+    if (phonePresent) phoneDeliver(bytes);
+  });
+  return len;
+}
+
+static void sppReceive(const uint8_t* data, size_t len) {
+  std::string bytes((const char*)data, len);
+  simAt(simNowUs() + SIM_SPP_LATENCY_US, [bytes] {
+    if (!phonePresent) return;
+    if (sppOnData) {
+      sppOnData((const uint8_t*)bytes.data(), bytes.size());
+      return;
+    }
+    sppRx.insert(sppRx.end(), bytes.begin(), bytes.end());
+  });
+}
+
+// ******************* BLE *********************************************
+// Obiectele create de firmware trăiesc cât procesul, ca pe placă
+static BLEServer* bleServer = NULL;
+static BLEAdvertising bleAdvertising;
+static uint16_t bleLocalMtu = 23;
+static bool bleAdvertisingOn = false;
+static bool bleConnected = false;
+static uint32_t bleGeneration = 0;     // evenimentele programate pentru o conexiune veche se ignoră
+
+// Evenimentele de conexiune cad la anchorUs + k * intervalUs
+static uint64_t bleAnchorUs = 0;
+static uint32_t bleIntervalUs = SIM_BLE_PHONE_INTERVAL_US;
+static uint16_t bleLatency = 0;
+static uint16_t bleMtu = 23;
+
+static uint64_t bleTxEventUs = 0;      // ultimul eveniment cu notificări programate
+static int bleTxEventCount = 0;
+static int bleTxPending = 0;
+
+static uint64_t bleNextEvent(uint64_t t) {
+  if (t <= bleAnchorUs) return bleAnchorUs;
+  uint64_t k = (t - bleAnchorUs + bleIntervalUs - 1) / bleIntervalUs;
+  return bleAnchorUs + k * bleIntervalUs;
+}
+
+static void bleSetNotifications(bool enabled) {
+  for (BLEService* service : bleServer->services()) {
+    for (BLECharacteristic* c : service->characteristics()) {
+      BLE2902* cccd = c->cccd();
+      if (cccd != NULL) cccd->setNotifications(enabled);
+    }
+  }
+}
+
+static void bleConnect() {
+  if (!phonePresent || !bleAdvertisingOn || bleConnected || bleServer == NULL) return;
+  bleAdvertisingOn = false;
+  bleConnected = true;
+  uint32_t generation = ++bleGeneration;
+  bleAnchorUs = simNowUs();
+  bleIntervalUs = SIM_BLE_PHONE_INTERVAL_US;
+  bleLatency = 0;
+  bleMtu = 23;
+  bleTxEventUs = 0;
+  bleTxEventCount = 0;
+
+  esp_ble_gatts_cb_param_t param = {};
+  param.connect.conn_id = 0;
+  for (int i = 0; i < 6; i++) param.connect.remote_bda[i] = (uint8_t)(0x40 + i);
+  if (bleServer->callbacks() != NULL) {
+    bleServer->callbacks()->onConnect(bleServer);
+    bleServer->callbacks()->onConnect(bleServer, &param);
+  }
+
+  // Aplicația cere MTU-ul mare, apoi descoperă serviciul și activează notificările
+  simAt(bleAnchorUs + 2ull * bleIntervalUs, [generation] {
+    if (generation == bleGeneration) bleMtu = std::min(bleLocalMtu, (uint16_t)SIM_BLE_PHONE_MTU);
+  });
+  simAt(bleAnchorUs + 4ull * bleIntervalUs, [generation] {
+    if (generation == bleGeneration) bleSetNotifications(true);
+  });
+}
+
+static void bleDisconnect() {
+  if (!bleConnected) return;
+  bleConnected = false;
+  bleGeneration++;
+  bleSetNotifications(false);
+  esp_ble_gatts_cb_param_t param = {};
+  if (bleServer->callbacks() != NULL) {
+    bleServer->callbacks()->onDisconnect(bleServer);
+    bleServer->callbacks()->onDisconnect(bleServer, &param);
+  }
+}
+
+static void bleStartAdvertising() {
+  bleAdvertisingOn = true;
+  if (phonePresent && !bleConnected) simAt(simNowUs() + SIM_BLE_CONNECT_US, bleConnect);
+}
+
+// Scriere fără răspuns: vehiculul o primește la primul eveniment în care ascultă
+static void bleReceive(const uint8_t* data, size_t len) {
+  if (!bleConnected) return;
+  BLECharacteristic* target = NULL;
+  for (BLEService* service : bleServer->services()) {
+    for (BLECharacteristic* c : service->characteristics()) {
+      if (target == NULL && (c->properties() & (BLECharacteristic::PROPERTY_WRITE_NR | BLECharacteristic::PROPERTY_WRITE))) {
+        target = c;
+      }
+    }
+  }
+  if (target == NULL) return;
+
+  // Ce sosește chiar la un eveniment pleacă la următorul
+  uint64_t eventUs = bleNextEvent(simNowUs() + 1);
+  if (bleLatency > 0 && bleTxPending == 0) {
+    // Fără date de trimis, vehiculul sare până la bleLatency evenimente
+    uint64_t step = bleLatency + 1;
+    uint64_t k = (eventUs - bleAnchorUs) / bleIntervalUs;
+    eventUs = bleAnchorUs + (k + step - 1) / step * step * bleIntervalUs;
+  }
+
+  size_t chunk = bleMtu - 3;
+  uint32_t generation = bleGeneration;
+  for (size_t pos = 0; pos < len; pos += chunk) {
+    std::string bytes((const char*)data + pos, std::min(chunk, len - pos));
+    simAt(eventUs, [target, bytes, generation] {
+      if (generation != bleGeneration) return;
+      target->setValue((uint8_t*)bytes.data(), bytes.size());
+      if (target->callbacks() != NULL) target->callbacks()->onWrite(target);
+    });
+  }
+}
+
+BLEServer* BLEDevice::createServer() {
+  if (bleServer == NULL) bleServer = new BLEServer();
+  return bleServer;
+}
+
+BLEAdvertising* BLEDevice::getAdvertising() {
+  return &bleAdvertising;
+}
+
+void BLEDevice::startAdvertising() {
+  bleStartAdvertising();
+}
+
+void BLEDevice::setMTU(uint16_t mtu) {
+  bleLocalMtu = mtu;
+}
+
+uint16_t BLEDevice::getMTU() {
+  return bleLocalMtu;
+}
+
+void BLEAdvertising::start() {
+  bleStartAdvertising();
+}
+
+BLEServer::~BLEServer() {
+  for (BLEService* service : _services) delete service;
+}
+
+BLEService* BLEServer::createService(const char* uuid) {
+  _services.push_back(new BLEService(uuid));
+  return _services.back();
+}
+
+void BLEServer::startAdvertising() {
+  bleStartAdvertising();
+}
+
+uint16_t BLEServer::getConnId() {
+  return 0;
+}
+
+uint32_t BLEServer::getConnectedCount() {
+  return bleConnected ? 1 : 0;
+}
+
+uint16_t BLEServer::getPeerMTU(uint16_t connId) {
+  return bleConnected ? bleMtu : 0;
+}
+
+// Telefonul alege intervalul minim cerut; noii parametri se aplică la un eveniment viitor
+void BLEServer::updateConnParams(esp_bd_addr_t remoteBda, uint16_t minInterval, uint16_t maxInterval,
+                                 uint16_t latency, uint16_t timeout) {
+  if (!bleConnected) return;
+  uint64_t instantUs = bleNextEvent(simNowUs()) + (uint64_t)SIM_BLE_UPDATE_EVENTS * bleIntervalUs;
+  uint32_t generation = bleGeneration;
+  simAt(instantUs, [instantUs, minInterval, latency, generation] {
+    if (generation != bleGeneration) return;
+    bleAnchorUs = instantUs;
+    bleIntervalUs = minInterval * 1250u;
+    bleLatency = latency;
+    bleTxEventUs = 0;
+    bleTxEventCount = 0;
+  });
+}
+
+BLEService::~BLEService() {
+  for (BLECharacteristic* characteristic : _characteristics) delete characteristic;
+}
+
+BLECharacteristic* BLEService::createCharacteristic(const char* uuid, uint32_t properties) {
+  _characteristics.push_back(new BLECharacteristic(uuid, properties));
+  return _characteristics.back();
+}
+
+BLE2902* BLECharacteristic::cccd() const {
+  for (BLEDescriptor* descriptor : _descriptors) {
+    BLE2902* cccd = dynamic_cast<BLE2902*>(descriptor);
+    if (cccd != NULL) return cccd;
+  }
+  return NULL;
+}
+
+/**
+ * Ca Bluedroid: fără conexiune sau cu notificările dezactivate nu pleacă nimic, peste
+ * MTU - 3 se trunchiază, iar cu coada stivei plină notificarea se pierde. Altfel pleacă la
+ * primul eveniment de conexiune cu loc (SIM_BLE_PACKETS_PER_EVENT)
+ */
+void BLECharacteristic::notify(bool isNotification) {
+  _notifications++;
+  BLE2902* descriptor = cccd();
+  if (!bleConnected || descriptor == NULL || !descriptor->getNotifications()) return;
+
+  size_t len = _value.size();
+  if (len > (size_t)(bleMtu - 3)) {
+    btStats.truncated++;
+    len = bleMtu - 3;
+  }
+  if (bleTxPending >= SIM_BLE_TX_QUEUE) {
+    btStats.dropped++;
+    return;
+  }
+
+  uint64_t eventUs = std::max(bleNextEvent(simNowUs() + 1), bleTxEventUs);
+  if (eventUs == bleTxEventUs && bleTxEventCount >= SIM_BLE_PACKETS_PER_EVENT) eventUs += bleIntervalUs;
+  if (eventUs != bleTxEventUs) {
+    bleTxEventUs = eventUs;
+    bleTxEventCount = 0;
+  }
+  bleTxEventCount++;
+  bleTxPending++;
+
+  std::string bytes = _value.substr(0, len);
+  uint32_t generation = bleGeneration;
+  simAt(eventUs, [bytes, generation] {
+    bleTxPending--;
+    if (generation == bleGeneration) phoneDeliver(bytes);
+  });
+}
+
+// ******************* API LUME ****************************************
+void simBluetoothSetConnected(bool connected) {
+  phonePresent = connected;
+  if (connected && bleAdvertisingOn) simAt(simNowUs() + SIM_BLE_CONNECT_US, bleConnect);
+  if (!connected) bleDisconnect();
+}
+
+void simBluetoothReceive(const uint8_t* data, size_t len) {
+  if (!phonePresent) return;
+  if (bleServer != NULL) {
+    bleReceive(data, len);
+  } else if (sppStarted) {
+    sppReceive(data, len);
+  }
+}
+
+void simBluetoothOnWrite(std::function<void(const uint8_t* data, size_t len)> fn) {
+  phoneOnReceive = fn;
+}
+
+SimBluetoothStats simBluetoothStats() {
+  SimBluetoothStats s = btStats;
+  s.ble = bleServer != NULL;
+  s.connected = s.ble ? bleConnected : (sppStarted && phonePresent);
+  s.intervalUs = s.ble ? bleIntervalUs : 0;
+  s.latency = s.ble ? bleLatency : 0;
+  s.mtu = s.ble && bleConnected ? bleMtu : 0;
+  return s;
+}
@@ -0,0 +1,211 @@
+#include <LittleFS.h>
+#include "SimHardware.h"
+#include "SimKernel.h"
+
+#include <map>
+#include <set>
+#include <sys/stat.h>
+#include <vector>
+
+// Partiția de date tipică a unui ESP32 cu 4 MB de flash
+#define SIM_FLASH_BYTES (1408 * 1024)
+#define SIM_FLASH_SECTOR 4096
+#define SIM_FLASH_PAGE 256
+#define SIM_FLASH_PAGE_US 700           // programarea unei pagini
+#define SIM_FLASH_ERASE_US 45000        // ștergerea unui sector, la fiecare 4 KB noi dintr-un fișier
+
+LittleFSFS LittleFS;
+
+static std::map<std::string, std::vector<uint8_t>> flashFiles;
+static std::set<std::string> flashDirs = { "/" };
+static bool flashMounted = false;
+
+namespace fs {
+
+struct SimFileHandle {
+  std::string path;
+  bool directory;
+  bool writable;
+  size_t pos;
+  std::vector<std::string> entries;     // conținutul directorului la deschidere
+  size_t nextEntry;
+};
+
+}  // namespace fs
+
+using fs::SimFileHandle;
+
+static std::string flashParent(const std::string& path) {
+  size_t slash = path.rfind('/');
+  return slash == 0 || slash == std::string::npos ? "/" : path.substr(0, slash);
+}
+
+static std::vector<uint8_t>* flashData(const SimFileHandle& h) {
+  auto it = flashFiles.find(h.path);
+  return it == flashFiles.end() ? NULL : &it->second;
+}
+
+// ******************* File ********************************************
+size_t fs::File::write(const uint8_t* data, size_t len) {
+  std::vector<uint8_t>* bytes = _h ? flashData(*_h) : NULL;
+  if (bytes == NULL || !_h->writable) return 0;
+  size_t before = bytes->size();
+  if (_h->pos + len > bytes->size()) bytes->resize(_h->pos + len);
+  memcpy(bytes->data() + _h->pos, data, len);
+  _h->pos += len;
+
+  // Timpul flash-ului, consumat de taskul care scrie (taskurile mai prioritare îl întrerup)
+  size_t pages = (len + SIM_FLASH_PAGE - 1) / SIM_FLASH_PAGE;
+  size_t erases = (bytes->size() + SIM_FLASH_SECTOR - 1) / SIM_FLASH_SECTOR -
+                  (before + SIM_FLASH_SECTOR - 1) / SIM_FLASH_SECTOR;
+  simBusy(pages * SIM_FLASH_PAGE_US + erases * SIM_FLASH_ERASE_US);
+  return len;
+}
+
+int fs::File::available() {
+  std::vector<uint8_t>* bytes = _h ? flashData(*_h) : NULL;
+  return bytes != NULL && _h->pos < bytes->size() ? (int)(bytes->size() - _h->pos) : 0;
+}
+
+int fs::File::read() {
+  uint8_t b;
+  return read(&b, 1) == 1 ? b : -1;
+}
+
+int fs::File::peek() {
+  std::vector<uint8_t>* bytes = _h ? flashData(*_h) : NULL;
+  return bytes != NULL && _h->pos < bytes->size() ? (*bytes)[_h->pos] : -1;
+}
+
+size_t fs::File::read(uint8_t* buffer, size_t len) {
+  std::vector<uint8_t>* bytes = _h ? flashData(*_h) : NULL;
+  if (bytes == NULL || _h->pos >= bytes->size()) return 0;
+  size_t n = std::min(len, bytes->size() - _h->pos);
+  memcpy(buffer, bytes->data() + _h->pos, n);
+  _h->pos += n;
+  return n;
+}
+
+bool fs::File::seek(uint32_t pos) {
+  std::vector<uint8_t>* bytes = _h ? flashData(*_h) : NULL;
+  if (bytes == NULL || pos > bytes->size()) return false;
+  _h->pos = pos;
+  return true;
+}
+
+size_t fs::File::position() const {
+  return _h ? _h->pos : 0;
+}
+
+size_t fs::File::size() const {
+  std::vector<uint8_t>* bytes = _h ? flashData(*_h) : NULL;
+  return bytes != NULL ? bytes->size() : 0;
+}
+
+const char* fs::File::name() const {
+  if (!_h) return "";
+  size_t slash = _h->path.rfind('/');
+  return _h->path.c_str() + (slash == std::string::npos ? 0 : slash + 1);
+}
+
+const char* fs::File::path() const {
+  return _h ? _h->path.c_str() : "";
+}
+
+bool fs::File::isDirectory() const {
+  return _h && _h->directory;
+}
+
+fs::File fs::File::openNextFile(const char* mode) {
+  if (!_h || !_h->directory || _h->nextEntry >= _h->entries.size()) return File();
+  return LittleFS.open(_h->entries[_h->nextEntry++].c_str(), mode);
+}
+
+// ******************* FS **********************************************
+fs::File fs::FS::open(const char* path, const char* mode, bool create) {
+  if (!flashMounted) return File();
+  std::string p(path);
+  auto h = std::make_shared<SimFileHandle>();
+  h->path = p;
+  h->directory = false;
+  h->writable = mode[0] == 'w' || mode[0] == 'a';
+  h->pos = 0;
+  h->nextEntry = 0;
+
+  if (flashDirs.count(p)) {
+    if (h->writable) return File();
+    h->directory = true;
+    for (const auto& f : flashFiles) {
+      if (flashParent(f.first) == p) h->entries.push_back(f.first);
+    }
+    for (const std::string& d : flashDirs) {
+      if (d != p && flashParent(d) == p) h->entries.push_back(d);
+    }
+    return File(h);
+  }
+
+  if (!flashDirs.count(flashParent(p))) return File();
+  auto it = flashFiles.find(p);
+  if (mode[0] == 'w') {
+    flashFiles[p].clear();
+  } else if (mode[0] == 'a') {
+    h->pos = flashFiles[p].size();
+  } else if (it == flashFiles.end()) {
+    return File();
+  }
+  return File(h);
+}
+
+bool fs::FS::exists(const char* path) {
+  return flashMounted && (flashFiles.count(path) || flashDirs.count(path));
+}
+
+bool fs::FS::remove(const char* path) {
+  return flashMounted && flashFiles.erase(path) > 0;
+}
+
+bool fs::FS::mkdir(const char* path) {
+  if (!flashMounted || !flashDirs.count(flashParent(path))) return false;
+  flashDirs.insert(path);
+  return true;
+}
+
+// ******************* LittleFS ****************************************
+bool LittleFSFS::begin(bool formatOnFail, const char* basePath, uint8_t maxOpenFiles, const char* partitionLabel) {
+  flashMounted = true;
+  return true;
+}
+
+bool LittleFSFS::format() {
+  flashFiles.clear();
+  flashDirs = { "/" };
+  return true;
+}
+
+size_t LittleFSFS::totalBytes() {
+  return SIM_FLASH_BYTES;
+}
+
+// Ca LittleFS: fiecare fișier ocupă sectoare întregi
+size_t LittleFSFS::usedBytes() {
+  size_t used = flashDirs.size() * SIM_FLASH_SECTOR;
+  for (const auto& f : flashFiles) {
+    used += (f.second.size() + SIM_FLASH_SECTOR - 1) / SIM_FLASH_SECTOR * SIM_FLASH_SECTOR;
+  }
+  return used;
+}
+
+int simFlashExport(const char* dir) {
+  ::mkdir(dir, 0755);
+  int count = 0;
+  for (const auto& f : flashFiles) {
+    size_t slash = f.first.rfind('/');
+    std::string out = std::string(dir) + "/" + f.first.substr(slash + 1);
+    FILE* file = fopen(out.c_str(), "wb");
+    if (file == NULL) continue;
+    fwrite(f.second.data(), 1, f.second.size(), file);
+    fclose(file);
+    count++;
+  }
+  return count;
+}
@@ -0,0 +1,176 @@
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/queue.h"
+#include "SimKernel.h"
+
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+
+// ******************* TIMP ********************************************
+// Un tick durează 1 ms; un task blocat pentru n tick-uri se trezește la granița tick-ului
+static uint64_t tickDeadline(TickType_t ticks) {
+  if (ticks == portMAX_DELAY) return SIM_FOREVER;
+  return (simNowUs() / 1000 + ticks) * 1000;
+}
+
+TickType_t xTaskGetTickCount() {
+  return (TickType_t)(simNowUs() / 1000);
+}
+
+void vTaskDelay(TickType_t ticks) {
+  simBlock(tickDeadline(ticks), NULL);
+}
+
+void vTaskDelayUntil(TickType_t* previousWake, TickType_t increment) {
+  TickType_t next = *previousWake + increment;
+  *previousWake = next;
+  if ((int32_t)(next - xTaskGetTickCount()) > 0) {
+    simBlock((uint64_t)next * 1000, NULL);
+  } else {
+    simBlock(simNowUs(), NULL);
+  }
+}
+
+void taskYIELD() {
+  simBlock(simNowUs(), NULL);
+}
+
+// ******************* TASKURI *****************************************
+BaseType_t xTaskCreatePinnedToCore(TaskFunction_t fn, const char* name, uint32_t stackBytes, void* arg,
+                                   UBaseType_t priority, TaskHandle_t* handle, BaseType_t core) {
+  // Un singur nucleu: PIPELINE_CORE contează doar pe placă
+  SimTask* task = simCreateTask(fn, name, arg, (int)priority, stackBytes);
+  if (handle != NULL) *handle = task;
+  return pdPASS;
+}
+
+BaseType_t xTaskCreate(TaskFunction_t fn, const char* name, uint32_t stackBytes, void* arg,
+                       UBaseType_t priority, TaskHandle_t* handle) {
+  return xTaskCreatePinnedToCore(fn, name, stackBytes, arg, priority, handle, 0);
+}
+
+void vTaskDelete(TaskHandle_t task) {
+  if (task != NULL && task != simCurrentTask()) {
+    fprintf(stderr, "sim: vTaskDelete pentru alt task nu este suportat\n");
+    return;
+  }
+  simExitTask();
+}
+
+TaskHandle_t xTaskGetCurrentTaskHandle() {
+  return simCurrentTask();
+}
+
+UBaseType_t uxTaskGetStackHighWaterMark(TaskHandle_t task) {
+  return simTaskStack(task != NULL ? task : simCurrentTask());
+}
+
+// ******************* NOTIFICĂRI **************************************
+uint32_t ulTaskNotifyTake(BaseType_t clearOnExit, TickType_t ticks) {
+  uint32_t* value = simTaskNotifyValue(simCurrentTask());
+  if (*value == 0 && ticks > 0) simBlock(tickDeadline(ticks), value);
+  uint32_t taken = *value;
+  if (taken > 0) *value = clearOnExit ? 0 : taken - 1;
+  return taken;
+}
+
+BaseType_t xTaskNotifyGive(TaskHandle_t task) {
+  uint32_t* value = simTaskNotifyValue(task);
+  (*value)++;
+  if (simWakeOne(value)) simPreempt();
+  return pdPASS;
+}
+
+void vTaskNotifyGiveFromISR(TaskHandle_t task, BaseType_t* higherPriorityTaskWoken) {
+  uint32_t* value = simTaskNotifyValue(task);
+  (*value)++;
+  // Taskul trezit rulează la ieșirea din "întrerupere" (taskul hardware cedează procesorul)
+  bool woken = simWakeOne(value);
+  if (higherPriorityTaskWoken != NULL) *higherPriorityTaskWoken = woken ? pdTRUE : pdFALSE;
+}
+
+// ******************* COZI ********************************************
+struct SimQueue {
+  UBaseType_t length;
+  UBaseType_t itemSize;
+  std::vector<uint8_t> storage;
+  UBaseType_t head;
+  UBaseType_t count;
+  int notEmpty;              // doar adrese pe care așteaptă taskurile
+  int notFull;
+};
+
+QueueHandle_t xQueueCreate(UBaseType_t length, UBaseType_t itemSize) {
+  SimQueue* q = new SimQueue();
+  q->length = length;
+  q->itemSize = itemSize;
+  q->storage.resize((size_t)length * itemSize);
+  q->head = 0;
+  q->count = 0;
+  return q;
+}
+
+static void queuePush(SimQueue* q, const void* item) {
+  UBaseType_t tail = (q->head + q->count) % q->length;
+  memcpy(&q->storage[(size_t)tail * q->itemSize], item, q->itemSize);
+  q->count++;
+}
+
+static bool queueSend(SimQueue* q, const void* item, TickType_t ticks) {
+  uint64_t deadline = tickDeadline(ticks);
+  while (q->count >= q->length) {
+    if (ticks == 0) return false;
+    if (!simBlock(deadline, &q->notFull) && q->count >= q->length) return false;
+  }
+  queuePush(q, item);
+  simWakeOne(&q->notEmpty);
+  return true;
+}
+
+BaseType_t xQueueSend(QueueHandle_t queue, const void* item, TickType_t ticks) {
+  if (!queueSend(queue, item, ticks)) return errQUEUE_FULL;
+  simPreempt();
+  return pdPASS;
+}
+
+BaseType_t xQueueSendFromISR(QueueHandle_t queue, const void* item, BaseType_t* higherPriorityTaskWoken) {
+  if (queue->count >= queue->length) return errQUEUE_FULL;
+  queuePush(queue, item);
+  bool woken = simWakeOne(&queue->notEmpty);
+  if (higherPriorityTaskWoken != NULL) *higherPriorityTaskWoken = woken ? pdTRUE : pdFALSE;
+  return pdPASS;
+}
+
+// Doar pentru cozi de un element: înlocuiește valoarea, nu blochează niciodată
+BaseType_t xQueueOverwrite(QueueHandle_t queue, const void* item) {
+  queue->head = 0;
+  queue->count = 0;
+  queuePush(queue, item);
+  if (simWakeOne(&queue->notEmpty)) simPreempt();
+  return pdPASS;
+}
+
+BaseType_t xQueueReceive(QueueHandle_t queue, void* item, TickType_t ticks) {
+  uint64_t deadline = tickDeadline(ticks);
+  while (queue->count == 0) {
+    if (ticks == 0) return pdFALSE;
+    if (!simBlock(deadline, &queue->notEmpty) && queue->count == 0) return pdFALSE;
+  }
+  memcpy(item, &queue->storage[(size_t)queue->head * queue->itemSize], queue->itemSize);
+  queue->head = (queue->head + 1) % queue->length;
+  queue->count--;
+  if (simWakeOne(&queue->notFull)) simPreempt();
+  return pdTRUE;
+}
+
+BaseType_t xQueueReset(QueueHandle_t queue) {
+  queue->head = 0;
+  queue->count = 0;
+  simWakeAll(&queue->notFull);
+  return pdPASS;
+}
+
+UBaseType_t uxQueueMessagesWaiting(QueueHandle_t queue) {
+  return queue->count;
+}
@@ -0,0 +1,104 @@
+#ifndef SIM_HARDWARE_H
+#define SIM_HARDWARE_H
+
+/**
+ * Partea hardware a shim-ului, văzută din modelul lumii (tools/host-sim/sim): ce scrie
+ * firmware-ul pe pini, PWM, servo și porturi, și cum ajung la el semnalele lumii.
+ *
+ * Funcțiile care livrează date către firmware (simPinDrive, simSerialReceive, simUartReceive,
+ * simBluetoothReceive, simRadioSend) se apelează din evenimente programate cu simAt(), adică
+ * din taskul hardware, ca întreruperile și driverele de pe placă.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+
+#define SIM_PIN_COUNT 64
+#define SIM_SERIAL_PORTS 3
+#define SIM_RADIO_AIRTIME_US 700       // ~16 octeți ESP-NOW la 1 Mbps, cu preambul și antet
+
+// Telefonul aplicației; ordine de mărime măsurate pe telefoane Android, nu valori exacte
+#define SIM_SPP_LATENCY_US 12000       // un sens, pe legătura ACL Classic
+#define SIM_SPP_BYTES_PER_S 90000      // debitul util SPP
+#define SIM_BLE_CONNECT_US 50000       // de la anunț până la conexiune
+#define SIM_BLE_PHONE_INTERVAL_US 30000  // intervalul ales de telefon la conectare
+#define SIM_BLE_PHONE_MTU 517          // MTU cerut de telefon
+#define SIM_BLE_PACKETS_PER_EVENT 4    // notificări pe eveniment de conexiune
+#define SIM_BLE_TX_QUEUE 16            // notificări în așteptare în stiva BLE; peste ele se pierd
+#define SIM_BLE_UPDATE_EVENTS 6        // parametrii noi se aplică după atâtea evenimente
+
+// ******************* GPIO / PWM **************************************
+int simPinLevel(int pin);
+// Lumea conduce o intrare; întreruperea atașată pinului rulează imediat, pe frontul potrivit
+void simPinDrive(int pin, int level);
+// Apelată la fiecare digitalWrite() al firmware-ului pe pin
+void simPinOnWrite(int pin, std::function<void(int level)> fn);
+
+// Răspunsul unui pulseIn(): pulsul începe după delayUs și durează widthUs (0 = niciun puls)
+struct SimPulse {
+  uint32_t delayUs;
+  uint32_t widthUs;
+};
+void simPinOnPulseIn(int pin, std::function<SimPulse(int state)> fn);
+
+uint32_t simLedcDuty(int pin);
+uint32_t simLedcTone(int pin);          // frecvența, 0 dacă pinul tace
+int simServoAngle(int pin);             // -1 dacă niciun servo nu este atașat
+
+// ******************* PORTURI SERIALE *********************************
+// Octeții scriși de firmware pe Serial/Serial1/Serial2
+void simSerialOnWrite(int port, std::function<void(const uint8_t* data, size_t len)> fn);
+// Octeți sosiți pe RX; cei care nu mai încap în bufferul portului se pierd
+void simSerialReceive(int port, const uint8_t* data, size_t len);
+// Același lucru pentru un port deținut de driverul UART din ESP-IDF (driver/uart.h)
+void simUartReceive(int port, const uint8_t* data, size_t len);
+
+// ******************* BLUETOOTH (TELEFONUL) ***************************
+// Telefonul vine lângă vehicul (sau pleacă): se conectează prin SPP sau la serverul BLE anunțat
+void simBluetoothSetConnected(bool connected);
+// Octeți trimiși de aplicație: SPP după latența legăturii, BLE ca scrieri fără răspuns pe
+// caracteristica cu scriere, la următorul eveniment de conexiune în care vehiculul ascultă
+void simBluetoothReceive(const uint8_t* data, size_t len);
+// Octeții primiți de aplicație (scrieri SPP sau notificări), în momentul sosirii
+void simBluetoothOnWrite(std::function<void(const uint8_t* data, size_t len)> fn);
+
+struct SimBluetoothStats {
+  bool ble;                 // firmware-ul a pornit un server BLE (altfel SPP)
+  bool connected;
+  uint32_t intervalUs;      // intervalul conexiunii BLE
+  uint16_t latency;         // evenimente pe care vehiculul le poate sări
+  uint16_t mtu;
+  uint32_t packets;         // notificări sau scrieri SPP ajunse la telefon
+  uint32_t bytes;
+  uint32_t dropped;         // notificări pierdute: coada stivei BLE plină
+  uint32_t truncated;       // notificări mai lungi decât MTU - 3, trunchiate
+};
+SimBluetoothStats simBluetoothStats();
+
+// ******************* ESP-NOW *****************************************
+typedef std::function<void(const uint8_t* src, const uint8_t* data, int len)> SimRadioReceiver;
+
+struct SimRadioStats {
+  uint32_t frames;        // cadre puse în aer (de vehicul și de nodurile lumii)
+  uint32_t deliveries;    // recepții reușite (un broadcast poate avea mai multe)
+  uint32_t lost;          // recepții pierdute
+};
+
+extern const uint8_t SIM_VEHICLE_MAC[6];
+
+// Un nod al lumii (ex. un semn de circulație); primește cadrele adresate lui și broadcast-urile
+void simRadioAddNode(const uint8_t mac[6], SimRadioReceiver receiver);
+void simRadioSend(const uint8_t src[6], const uint8_t dst[6], const uint8_t* data, int len);
+// Fiecare recepție se pierde independent cu această probabilitate (generator determinist)
+void simRadioSetLoss(double probability, uint32_t seed);
+SimRadioStats simRadioStats();
+
+// ******************* FLASH *******************************************
+// Copiază fișierele din LittleFS-ul simulat în directorul dir; întoarce numărul lor
+int simFlashExport(const char* dir);
+
+// ******************* DIVERSE *****************************************
+void simRandomSeed(uint32_t seed);
+
+#endif
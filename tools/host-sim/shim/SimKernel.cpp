@@ -0,0 +1,350 @@
+#include "SimKernel.h"
+
+#include <condition_variable>
+#include <mutex>
+#include <queue>
+#include <string>
+#include <thread>
+#include <time.h>
+#include <vector>
+
+struct SimTask {
+  std::string name;
+  int priority;
+  void (*fn)(void*);
+  void* arg;
+  uint32_t stackBytes;
+  std::condition_variable cv;
+  bool ready;                // gata de rulare (taskul curent este și el gata)
+  bool deleted;
+  uint64_t wakeUs;           // SIM_FOREVER: doar o trezire explicită îl deblochează
+  const void* waitObject;
+  bool timedOut;
+  uint64_t order;            // ordinea în care a devenit gata, pentru egalitățile de prioritate
+  uint32_t notifyValue;
+  uint64_t sliceStartNs;
+  SimTaskStats stats;
+};
+
+struct SimEvent {
+  uint64_t atUs;
+  uint64_t order;
+  std::function<void()> fn;
+};
+
+struct SimEventLater {
+  bool operator()(const SimEvent& a, const SimEvent& b) const {
+    return a.atUs != b.atUs ? a.atUs > b.atUs : a.order > b.order;
+  }
+};
+
+static std::mutex kernelMutex;
+static std::condition_variable kernelDone;
+static std::vector<SimTask*> kernelTasks;
+static SimTask* kernelCurrent = NULL;
+static SimTask* hardwareTask = NULL;
+static uint64_t kernelNowUs = 0;
+static uint64_t kernelOrder = 0;
+static uint64_t kernelUntilUs = SIM_FOREVER;
+static uint64_t kernelSwitches = 0;
+static bool kernelStarted = false;
+static bool kernelStopped = false;
+static double kernelCpuScale = 0;
+static std::priority_queue<SimEvent, std::vector<SimEvent>, SimEventLater> kernelEvents;
+
+// Taskul care rulează pe firul curent (NULL pe firul principal al procesului)
+static thread_local SimTask* threadTask = NULL;
+
+static uint64_t threadCpuNs() {
+  timespec ts;
+  clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts);
+  return (uint64_t)ts.tv_sec * 1000000000ull + (uint64_t)ts.tv_nsec;
+}
+
+// Timpul de procesor al taskului care cedează; cu scală, și timp virtual
+static void endSlice(SimTask* self) {
+  uint64_t ns = threadCpuNs() - self->sliceStartNs;
+  self->stats.slices++;
+  self->stats.cpuNs += ns;
+  if (ns > self->stats.maxSliceNs) self->stats.maxSliceNs = ns;
+  if (kernelCpuScale > 0 && self != hardwareTask) kernelNowUs += (uint64_t)(ns * kernelCpuScale / 1000.0);
+}
+
+static void promoteDue() {
+  for (SimTask* t : kernelTasks) {
+    if (!t->ready && !t->deleted && t->wakeUs <= kernelNowUs) {
+      t->ready = true;
+      t->timedOut = true;
+      t->waitObject = NULL;
+      t->wakeUs = SIM_FOREVER;
+      t->order = ++kernelOrder;
+    }
+  }
+}
+
+static SimTask* bestReady(SimTask* exclude) {
+  SimTask* best = NULL;
+  for (SimTask* t : kernelTasks) {
+    if (!t->ready || t->deleted || t == exclude) continue;
+    if (best == NULL || t->priority > best->priority || (t->priority == best->priority && t->order < best->order)) {
+      best = t;
+    }
+  }
+  return best;
+}
+
+// Următorul task de rulat; sare ceasul peste intervalele în care toate taskurile dorm
+static SimTask* pickNext() {
+  while (!kernelStopped) {
+    promoteDue();
+    SimTask* best = bestReady(NULL);
+    if (best != NULL) return best;
+    uint64_t next = SIM_FOREVER;
+    for (SimTask* t : kernelTasks) {
+      if (!t->deleted && t->wakeUs < next) next = t->wakeUs;
+    }
+    if (next == SIM_FOREVER || next > kernelUntilUs) {
+      kernelStopped = true;
+      break;
+    }
+    kernelNowUs = next;
+  }
+  return NULL;
+}
+
+// Predă procesorul și revine când taskul este din nou ales (niciodată după oprire)
+static void switchAway(std::unique_lock<std::mutex>& lock, SimTask* self) {
+  endSlice(self);
+  SimTask* next = pickNext();
+  kernelCurrent = next;
+  kernelSwitches++;
+  if (next == NULL) {
+    kernelDone.notify_all();
+  } else if (next != self) {
+    next->cv.notify_one();
+  }
+  self->cv.wait(lock, [self] { return kernelCurrent == self; });
+  self->sliceStartNs = threadCpuNs();
+}
+
+uint64_t simNowUs() {
+  SimTask* self = threadTask;
+  if (kernelCpuScale > 0 && self != NULL && self == kernelCurrent && self != hardwareTask) {
+    return kernelNowUs + (uint64_t)((threadCpuNs() - self->sliceStartNs) * kernelCpuScale / 1000.0);
+  }
+  return kernelNowUs;
+}
+
+SimTask* simCurrentTask() {
+  return threadTask;
+}
+
+static void taskEntry(SimTask* task) {
+  threadTask = task;
+  {
+    std::unique_lock<std::mutex> lock(kernelMutex);
+    task->cv.wait(lock, [task] { return kernelCurrent == task; });
+    task->sliceStartNs = threadCpuNs();
+  }
+  task->fn(task->arg);
+  simExitTask();
+}
+
+SimTask* simCreateTask(void (*fn)(void*), const char* name, void* arg, int priority, uint32_t stackBytes) {
+  SimTask* task = new SimTask();
+  task->name = name ? name : "";
+  task->priority = priority;
+  task->fn = fn;
+  task->arg = arg;
+  task->stackBytes = stackBytes;
+  task->ready = true;
+  task->deleted = false;
+  task->wakeUs = SIM_FOREVER;
+  task->waitObject = NULL;
+  task->timedOut = false;
+  task->notifyValue = 0;
+  task->sliceStartNs = 0;
+  task->stats = SimTaskStats();
+  {
+    std::lock_guard<std::mutex> lock(kernelMutex);
+    task->order = ++kernelOrder;
+    kernelTasks.push_back(task);
+    task->stats.name = task->name.c_str();
+    task->stats.priority = priority;
+  }
+  std::thread(taskEntry, task).detach();
+  // Un task nou mai prioritar decât creatorul pornește imediat
+  if (kernelStarted && threadTask != NULL) simPreempt();
+  return task;
+}
+
+void simExitTask() {
+  std::unique_lock<std::mutex> lock(kernelMutex);
+  SimTask* self = threadTask;
+  self->deleted = true;
+  self->ready = false;
+  switchAway(lock, self);
+  // Un task șters nu mai este ales niciodată
+  while (true) self->cv.wait(lock);
+}
+
+const char* simTaskName(SimTask* task) {
+  return task ? task->name.c_str() : "";
+}
+
+uint32_t simTaskStack(SimTask* task) {
+  return task ? task->stackBytes : 0;
+}
+
+bool simBlock(uint64_t deadlineUs, const void* waitObject) {
+  std::unique_lock<std::mutex> lock(kernelMutex);
+  SimTask* self = threadTask;
+  self->ready = false;
+  self->wakeUs = deadlineUs;
+  self->waitObject = waitObject;
+  self->timedOut = false;
+  switchAway(lock, self);
+  return !self->timedOut;
+}
+
+static void makeReady(SimTask* t) {
+  t->ready = true;
+  t->timedOut = false;
+  t->waitObject = NULL;
+  t->wakeUs = SIM_FOREVER;
+  t->order = ++kernelOrder;
+}
+
+bool simWakeOne(const void* waitObject) {
+  std::lock_guard<std::mutex> lock(kernelMutex);
+  SimTask* best = NULL;
+  for (SimTask* t : kernelTasks) {
+    if (t->ready || t->deleted || t->waitObject != waitObject) continue;
+    if (best == NULL || t->priority > best->priority || (t->priority == best->priority && t->order < best->order)) {
+      best = t;
+    }
+  }
+  if (best != NULL) makeReady(best);
+  return best != NULL;
+}
+
+void simWakeAll(const void* waitObject) {
+  std::lock_guard<std::mutex> lock(kernelMutex);
+  for (SimTask* t : kernelTasks) {
+    if (!t->ready && !t->deleted && t->waitObject == waitObject) makeReady(t);
+  }
+}
+
+void simPreempt() {
+  std::unique_lock<std::mutex> lock(kernelMutex);
+  SimTask* self = threadTask;
+  if (self == NULL || kernelCurrent != self) return;
+  promoteDue();
+  SimTask* other = bestReady(self);
+  if (other != NULL && other->priority > self->priority) switchAway(lock, self);
+}
+
+// Așteptare activă: ceasul avansează până la ținta fixă, dar taskurile mai prioritare care se
+// trezesc între timp (inclusiv întreruperile) preiau procesorul, ca pe placă
+void simBusy(uint64_t us) {
+  std::unique_lock<std::mutex> lock(kernelMutex);
+  SimTask* self = threadTask;
+  uint64_t target = kernelNowUs + us;
+  if (self == NULL || kernelCurrent != self) {
+    kernelNowUs = target;
+    return;
+  }
+  while (kernelNowUs < target) {
+    uint64_t next = target;
+    for (SimTask* t : kernelTasks) {
+      if (!t->ready && !t->deleted && t->wakeUs < next) next = t->wakeUs;
+    }
+    if (next > kernelNowUs) kernelNowUs = next;
+    promoteDue();
+    SimTask* other = bestReady(self);
+    if (other != NULL && other->priority > self->priority) switchAway(lock, self);
+  }
+}
+
+uint32_t* simTaskNotifyValue(SimTask* task) {
+  return &task->notifyValue;
+}
+
+void simAt(uint64_t atUs, std::function<void()> fn) {
+  {
+    std::lock_guard<std::mutex> lock(kernelMutex);
+    kernelEvents.push(SimEvent{ atUs, ++kernelOrder, std::move(fn) });
+    if (hardwareTask != NULL && !hardwareTask->ready && atUs < hardwareTask->wakeUs) {
+      hardwareTask->wakeUs = atUs;
+    }
+  }
+  if (atUs <= kernelNowUs) simPreempt();
+}
+
+// Taskul hardware: rulează evenimentele scadente, apoi doarme până la următorul
+static void hardwareMain(void* arg) {
+  while (true) {
+    while (true) {
+      SimEvent event;
+      {
+        std::lock_guard<std::mutex> lock(kernelMutex);
+        if (kernelEvents.empty() || kernelEvents.top().atUs > kernelNowUs) break;
+        event = kernelEvents.top();
+        kernelEvents.pop();
+      }
+      event.fn();
+    }
+    uint64_t next;
+    {
+      std::lock_guard<std::mutex> lock(kernelMutex);
+      next = kernelEvents.empty() ? SIM_FOREVER : kernelEvents.top().atUs;
+    }
+    simBlock(next, &kernelEvents);
+  }
+}
+
+static void loopMain(void* arg) {
+  void (*loopFn)() = (void (*)())arg;
+  loopFn();
+}
+
+void simRun(void (*loopFn)(), uint64_t untilUs) {
+  kernelUntilUs = untilUs;
+  hardwareTask = simCreateTask(hardwareMain, "hardware", NULL, SIM_HARDWARE_PRIORITY, 0);
+  simCreateTask(loopMain, "loopTask", (void*)loopFn, SIM_LOOP_PRIORITY, 8192);
+
+  std::unique_lock<std::mutex> lock(kernelMutex);
+  kernelStarted = true;
+  kernelCurrent = pickNext();
+  if (kernelCurrent != NULL) kernelCurrent->cv.notify_one();
+  kernelDone.wait(lock, [] { return kernelStopped && kernelCurrent == NULL; });
+}
+
+void simStop() {
+  std::unique_lock<std::mutex> lock(kernelMutex);
+  SimTask* self = threadTask;
+  kernelStopped = true;
+  if (self != NULL) endSlice(self);
+  kernelCurrent = NULL;
+  kernelDone.notify_all();
+  if (self == NULL) return;
+  while (true) self->cv.wait(lock);
+}
+
+void simSetCpuScale(double scale) {
+  kernelCpuScale = scale;
+}
+
+int simTaskCount() {
+  std::lock_guard<std::mutex> lock(kernelMutex);
+  return (int)kernelTasks.size();
+}
+
+SimTaskStats simTaskStats(int index) {
+  std::lock_guard<std::mutex> lock(kernelMutex);
+  return kernelTasks[index]->stats;
+}
+
+uint64_t simContextSwitches() {
+  return kernelSwitches;
+}
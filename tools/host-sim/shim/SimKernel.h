@@ -0,0 +1,76 @@
+#ifndef SIM_KERNEL_H
+#define SIM_KERNEL_H
+
+/**
+ * Nucleul simulării pe calculator: taskurile FreeRTOS ale firmware-ului rulează pe std::thread,
+ * dar doar unul execută cod la un moment dat, iar ceasul este virtual.
+ *
+ * Planificarea este cea a FreeRTOS pe un singur nucleu: rulează taskul gata cu prioritatea cea
+ * mai mare (la egalitate, cel gata de mai mult timp). Un task cedează procesorul doar în apelurile
+ * de nucleu (delay, cozi, notificări); când un apel trezește un task mai prioritar, acesta rulează
+ * imediat. Când niciun task nu este gata, ceasul sare direct la următoarea trezire, deci simularea
+ * merge mult mai repede decât timpul real și este deterministă: aceeași intrare, aceeași execuție.
+ *
+ * Cu simSetCpuScale(k) > 0, timpul de procesor consumat pe calculator de fiecare task se adaugă
+ * la ceasul virtual (înmulțit cu k, ex. cât de mai lent este ESP32), astfel încât TaskMonitor și
+ * latențele măsurate de firmware reflectă costul codului; simularea nu mai este deterministă.
+ *
+ * Evenimentele hardware (fronturi GPIO, octeți UART, cadre radio, timere) rulează în taskul
+ * "hardware", cu prioritate peste toate taskurile firmware-ului, ca întreruperile.
+ */
+
+#include <stdint.h>
+#include <functional>
+
+#define SIM_HARDWARE_PRIORITY 30
+#define SIM_LOOP_PRIORITY 1          // ca loopTask din Arduino-ESP32
+#define SIM_FOREVER UINT64_MAX
+
+struct SimTask;
+
+struct SimTaskStats {
+  const char* name;
+  int priority;
+  uint64_t slices;          // de câte ori a primit procesorul
+  uint64_t cpuNs;           // timp de procesor pe calculator
+  uint64_t maxSliceNs;
+};
+
+// Timpul virtual (µs de la pornire)
+uint64_t simNowUs();
+
+SimTask* simCurrentTask();
+SimTask* simCreateTask(void (*fn)(void*), const char* name, void* arg, int priority, uint32_t stackBytes);
+[[noreturn]] void simExitTask();
+const char* simTaskName(SimTask* task);
+uint32_t simTaskStack(SimTask* task);
+
+/**
+ * Blochează taskul curent până la deadlineUs (SIM_FOREVER = fără limită) sau până când
+ * simWakeOne/simWake îl trezește. Întoarce false la expirare.
+ */
+bool simBlock(uint64_t deadlineUs, const void* waitObject);
+// Trezește cel mai prioritar task care așteaptă waitObject; întoarce true dacă a existat unul
+bool simWakeOne(const void* waitObject);
+void simWakeAll(const void* waitObject);
+// Punct de preempțiune: cedează procesorul dacă un task mai prioritar este gata
+void simPreempt();
+// Timp consumat activ de taskul curent (delayMicroseconds, pulseIn)
+void simBusy(uint64_t us);
+
+// Notificările de task (ulTaskNotifyTake / xTaskNotifyGive)
+uint32_t* simTaskNotifyValue(SimTask* task);
+
+// Un eveniment hardware la momentul atUs, rulat în taskul hardware
+void simAt(uint64_t atUs, std::function<void()> fn);
+
+// Pornește firmware-ul (loopFn în loopTask) și rulează până la untilUs sau simStop()
+void simRun(void (*loopFn)(), uint64_t untilUs);
+void simStop();
+void simSetCpuScale(double scale);
+
+int simTaskCount();
+SimTaskStats simTaskStats(int index);
+uint64_t simContextSwitches();
+
+#endif
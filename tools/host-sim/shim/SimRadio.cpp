@@ -0,0 +1,198 @@
+#include <ESP32_NOW.h>
+#include <WiFi.h>
+#include "SimHardware.h"
+#include "SimKernel.h"
+
+#include <vector>
+
+// ******************* WiFi ********************************************
+SimWiFiClass WiFi;
+
+static wifi_mode_t wifiMode = WIFI_OFF;
+static uint8_t wifiChannel = 1;
+
+bool SimWiFiSta::started() const {
+  return wifiMode == WIFI_STA || wifiMode == WIFI_AP_STA;
+}
+
+bool SimWiFiClass::mode(wifi_mode_t m) {
+  wifiMode = m;
+  return true;
+}
+
+bool SimWiFiClass::setChannel(uint8_t primary) {
+  if (primary < 1 || primary > 13) return false;
+  wifiChannel = primary;
+  return true;
+}
+
+uint8_t SimWiFiClass::channel() const {
+  return wifiChannel;
+}
+
+// ******************* MAGISTRALA RADIO ********************************
+struct SimRadioNode {
+  uint8_t mac[6];
+  SimRadioReceiver receiver;
+};
+
+const uint8_t SIM_VEHICLE_MAC[6] = { 0x24, 0x6F, 0x28, 0x00, 0x00, 0x01 };
+
+// Stația locală are adresa vehiculului, singurul firmware care folosește radioul simulat
+String SimWiFiClass::macAddress() const {
+  char text[18];
+  snprintf(text, sizeof(text), "%02X:%02X:%02X:%02X:%02X:%02X", SIM_VEHICLE_MAC[0], SIM_VEHICLE_MAC[1],
+           SIM_VEHICLE_MAC[2], SIM_VEHICLE_MAC[3], SIM_VEHICLE_MAC[4], SIM_VEHICLE_MAC[5]);
+  return String(text);
+}
+
+static std::vector<SimRadioNode> radioNodes;
+static SimRadioStats radioStats;
+static double radioLoss = 0;
+static uint32_t radioLossState = 1;
+
+static bool macEqual(const uint8_t* a, const uint8_t* b) {
+  return memcmp(a, b, 6) == 0;
+}
+
+static bool macBroadcast(const uint8_t* mac) {
+  return macEqual(mac, ESP_NOW_Class::BROADCAST_ADDR);
+}
+
+// xorshift32, separat de esp_random() ca pierderile să nu depindă de firmware
+static bool radioLost() {
+  if (radioLoss <= 0) return false;
+  radioLossState ^= radioLossState << 13;
+  radioLossState ^= radioLossState >> 17;
+  radioLossState ^= radioLossState << 5;
+  return (radioLossState & 0xFFFFFF) < (uint32_t)(radioLoss * 0x1000000);
+}
+
+void simRadioAddNode(const uint8_t mac[6], SimRadioReceiver receiver) {
+  SimRadioNode node;
+  memcpy(node.mac, mac, 6);
+  node.receiver = receiver;
+  radioNodes.push_back(node);
+}
+
+void simRadioSetLoss(double probability, uint32_t seed) {
+  radioLoss = probability;
+  radioLossState = seed ? seed : 1;
+}
+
+SimRadioStats simRadioStats() {
+  return radioStats;
+}
+
+// Întoarce true dacă destinatarul unicast a primit cadrul (ACK-ul de nivel MAC)
+static bool radioTransmit(const uint8_t src[6], const uint8_t dst[6], const uint8_t* data, int len) {
+  radioStats.frames++;
+  bool acked = false;
+  uint64_t arrivalUs = simNowUs() + SIM_RADIO_AIRTIME_US;
+  for (const SimRadioNode& node : radioNodes) {
+    if (macEqual(node.mac, src)) continue;
+    if (!macBroadcast(dst) && !macEqual(node.mac, dst)) continue;
+    if (radioLost()) {
+      radioStats.lost++;
+      continue;
+    }
+    radioStats.deliveries++;
+    acked = true;
+    std::vector<uint8_t> frame(data, data + len);
+    std::vector<uint8_t> from(src, src + 6);
+    SimRadioReceiver receiver = node.receiver;
+    simAt(arrivalUs, [receiver, frame, from] { receiver(from.data(), frame.data(), (int)frame.size()); });
+  }
+  return acked;
+}
+
+void simRadioSend(const uint8_t src[6], const uint8_t dst[6], const uint8_t* data, int len) {
+  radioTransmit(src, dst, data, len);
+}
+
+// ******************* ESP-NOW *****************************************
+ESP_NOW_Class ESP_NOW;
+constexpr uint8_t ESP_NOW_Class::BROADCAST_ADDR[6];
+
+static bool espNowStarted = false;
+static std::vector<ESP_NOW_Peer*> espNowPeers;
+static void (*espNowNewPeer)(const esp_now_recv_info_t*, const uint8_t*, int, void*) = NULL;
+static void* espNowNewPeerArg = NULL;
+
+// Recepția vehiculului: peer-ul cunoscut după adresa sursă, altfel callback-ul de peer nou
+static void vehicleReceive(const uint8_t* src, const uint8_t* data, int len) {
+  for (ESP_NOW_Peer* peer : espNowPeers) {
+    if (macEqual(peer->addr(), src)) {
+      peer->onReceive(data, (size_t)len, false);
+      return;
+    }
+  }
+  if (espNowNewPeer == NULL) return;
+  uint8_t srcAddr[6];
+  uint8_t dstAddr[6];
+  memcpy(srcAddr, src, 6);
+  memcpy(dstAddr, SIM_VEHICLE_MAC, 6);
+  esp_now_recv_info_t info = { srcAddr, dstAddr, NULL };
+  espNowNewPeer(&info, data, len, espNowNewPeerArg);
+}
+
+bool ESP_NOW_Class::begin(const uint8_t* pmk) {
+  if (espNowStarted) return true;
+  if (!WiFi.STA.started()) return false;
+  espNowStarted = true;
+  simRadioAddNode(SIM_VEHICLE_MAC, vehicleReceive);
+  return true;
+}
+
+bool ESP_NOW_Class::end() {
+  espNowStarted = false;
+  return true;
+}
+
+int ESP_NOW_Class::getTotalPeerCount() {
+  return (int)espNowPeers.size();
+}
+
+void ESP_NOW_Class::onNewPeer(void (*callback)(const esp_now_recv_info_t*, const uint8_t*, int, void*),
+                              void* arg) {
+  espNowNewPeer = callback;
+  espNowNewPeerArg = arg;
+}
+
+ESP_NOW_Peer::ESP_NOW_Peer(const uint8_t* macAddr, uint8_t channel, wifi_interface_t iface, const uint8_t* lmk)
+    : _channel(channel), _added(false) {
+  memcpy(_mac, macAddr, 6);
+}
+
+ESP_NOW_Peer::~ESP_NOW_Peer() {
+  remove();
+}
+
+bool ESP_NOW_Peer::add() {
+  if (!espNowStarted) return false;
+  if (!_added) espNowPeers.push_back(this);
+  _added = true;
+  return true;
+}
+
+bool ESP_NOW_Peer::remove() {
+  if (!_added) return true;
+  for (size_t i = 0; i < espNowPeers.size(); i++) {
+    if (espNowPeers[i] == this) {
+      espNowPeers.erase(espNowPeers.begin() + i);
+      break;
+    }
+  }
+  _added = false;
+  return true;
+}
+
+size_t ESP_NOW_Peer::send(const uint8_t* data, int len) {
+  if (!_added || len <= 0 || len > ESP_NOW_MAX_DATA_LEN) return 0;
+  bool acked = radioTransmit(SIM_VEHICLE_MAC, _mac, data, len);
+  // Broadcast-ul nu are ACK de nivel MAC: trimiterea reușește mereu
+  bool success = macBroadcast(_mac) || acked;
+  ESP_NOW_Peer* self = this;
+  simAt(simNowUs() + SIM_RADIO_AIRTIME_US, [self, success] { self->onSent(success); });
+  return (size_t)len;
+}
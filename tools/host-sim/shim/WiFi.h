@@ -0,0 +1,36 @@
+#ifndef SIM_WIFI_H
+#define SIM_WIFI_H
+
+#include <stdint.h>
+#include "Arduino.h"
+
+typedef enum {
+  WIFI_IF_STA = 0,
+  WIFI_IF_AP = 1
+} wifi_interface_t;
+
+typedef enum {
+  WIFI_OFF = 0,
+  WIFI_STA = 1,
+  WIFI_AP = 2,
+  WIFI_AP_STA = 3
+} wifi_mode_t;
+
+class SimWiFiSta {
+public:
+  bool started() const;
+};
+
+// Radioul simulat: pornește instantaneu; canalul este doar reținut
+class SimWiFiClass {
+public:
+  bool mode(wifi_mode_t mode);
+  bool setChannel(uint8_t primary);
+  uint8_t channel() const;
+  String macAddress() const;
+  SimWiFiSta STA;
+};
+
+extern SimWiFiClass WiFi;
+
+#endif
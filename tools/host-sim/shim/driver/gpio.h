@@ -0,0 +1,8 @@
+#ifndef SIM_DRIVER_GPIO_H
+#define SIM_DRIVER_GPIO_H
+
+typedef int gpio_num_t;
+
+int gpio_get_level(gpio_num_t pin);
+
+#endif
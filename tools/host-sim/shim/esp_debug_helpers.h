@@ -0,0 +1,9 @@
+#ifndef SIM_ESP_DEBUG_HELPERS_H
+#define SIM_ESP_DEBUG_HELPERS_H
+
+#include "esp_err.h"
+
+// Pe calculator nu se decodează stiva: depanatorul (gdb) arată locul după abort()
+esp_err_t esp_backtrace_print(int depth);
+
+#endif
@@ -0,0 +1,38 @@
+#ifndef SIM_ESP_HEAP_CAPS_H
+#define SIM_ESP_HEAP_CAPS_H
+
+/**
+ * Heap-ul plăcii pe calculator: se numără doar bufferele String (Arduino.h), singurele
+ * alocări ale firmware-ului care nu trec prin biblioteci modelate altfel. Memoria nu se
+ * fragmentează aici, deci cel mai mare bloc liber este toată memoria liberă.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include "sdkconfig.h"
+
+#define MALLOC_CAP_8BIT (1 << 2)
+#define MALLOC_CAP_DEFAULT (1 << 12)
+
+#define SIM_HEAP_FREE_AT_BOOT 160000   // ordinul de mărime pe vehicul, cu BLE și WiFi pornite
+
+typedef struct {
+  size_t total_free_bytes;
+  size_t total_allocated_bytes;
+  size_t largest_free_block;
+  size_t minimum_free_bytes;
+  size_t allocated_blocks;
+  size_t free_blocks;
+  size_t total_blocks;
+} multi_heap_info_t;
+
+size_t heap_caps_get_free_size(uint32_t caps);
+size_t heap_caps_get_largest_free_block(uint32_t caps);
+size_t heap_caps_get_minimum_free_size(uint32_t caps);
+void heap_caps_get_info(multi_heap_info_t* info, uint32_t caps);
+
+// Hook-urile CONFIG_HEAP_USE_HOOKS; implicit lipsesc, firmware-ul le poate defini
+extern "C" void esp_heap_trace_alloc_hook(void* ptr, size_t size, uint32_t caps) __attribute__((weak));
+extern "C" void esp_heap_trace_free_hook(void* ptr) __attribute__((weak));
+
+#endif
@@ -0,0 +1,7 @@
+#ifndef SIM_ESP_MAC_H
+#define SIM_ESP_MAC_H
+
+#define MAC2STR(a) (a)[0], (a)[1], (a)[2], (a)[3], (a)[4], (a)[5]
+#define MACSTR "%02x:%02x:%02x:%02x:%02x:%02x"
+
+#endif
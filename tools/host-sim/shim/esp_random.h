@@ -0,0 +1,9 @@
+#ifndef SIM_ESP_RANDOM_H
+#define SIM_ESP_RANDOM_H
+
+#include <stdint.h>
+
+// Determinist pe calculator: aceeași secvență la fiecare rulare (sămânța: simRandomSeed)
+uint32_t esp_random();
+
+#endif
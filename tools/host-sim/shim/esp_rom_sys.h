@@ -0,0 +1,7 @@
+#ifndef SIM_ESP_ROM_SYS_H
+#define SIM_ESP_ROM_SYS_H
+
+// printf-ul din ROM, fără heap; pe calculator scrie pe stderr
+int esp_rom_printf(const char* format, ...) __attribute__((format(printf, 1, 2)));
+
+#endif
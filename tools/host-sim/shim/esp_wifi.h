@@ -0,0 +1,18 @@
+#ifndef SIM_ESP_WIFI_H
+#define SIM_ESP_WIFI_H
+
+#include "esp_err.h"
+#include "WiFi.h"
+
+typedef enum {
+  WIFI_SECOND_CHAN_NONE = 0,
+  WIFI_SECOND_CHAN_ABOVE,
+  WIFI_SECOND_CHAN_BELOW
+} wifi_second_chan_t;
+
+// Canalul radioului simulat; canalul secundar nu contează
+static inline esp_err_t esp_wifi_set_channel(uint8_t primary, wifi_second_chan_t second) {
+  return WiFi.setChannel(primary) ? ESP_OK : ESP_ERR_INVALID_ARG;
+}
+
+#endif
@@ -0,0 +1,7 @@
+#ifndef SIM_SDKCONFIG_H
+#define SIM_SDKCONFIG_H
+
+// Opțiunile ESP-IDF pe care le citește firmware-ul; pe calculator, ca într-o compilare de depanare
+#define CONFIG_HEAP_USE_HOOKS 1
+
+#endif
@@ -0,0 +1,2 @@
+// Schița Arduino a vehiculului, nemodificată; Modules.cpp aduce restul modulelor
+#include "../../../firmware/Elysium RC/ESP32/ElysiumRC/ElysiumRC.ino"
@@ -0,0 +1,486 @@
+#include "SimWorld.h"
+#include "SimHardware.h"
+#include "SimKernel.h"
+
+#include "SensorLinkCodec.h"
+#include "AlertProtocol.h"
+#include "RfidProtocol.h"
+#include "TrackMapData.h"
+#include "UltrasonicProfile.h"
+
+#include <fcntl.h>
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+// Pinii vehiculului (DCMotor.cpp, ServoMotor.h, UltrasonicSensors.h)
+#define PIN_IN1 5
+#define PIN_IN2 18
+#define PIN_ENA 21
+#define PIN_SERVO 22
+#define SERVO_LEFT 0
+#define SERVO_CENTER 38
+#define SERVO_RIGHT 80
+
+// Mașina
+#define PHYSICS_PERIOD_US 1000
+#define WHEEL_MAX_SPEED 0.833         // m/s la factor de umplere 255 (2000 impulsuri/s la 2400 pe metru)
+#define MOTOR_TAU_S 0.15              // constanta de timp a motorului
+#define BRAKE_DECEL 3.5               // m/s^2 cu puntea H în scurtcircuit
+#define WHEELBASE_M 0.26
+#define STEER_MAX_RAD 0.45
+#define COUNTS_PER_METER 2400.0
+#define BODY_HALF_LENGTH 0.20
+#define BODY_HALF_WIDTH 0.08
+
+// Arduino-ul de pe SensorLink
+#define LINK_UART 1
+#define LINK_BYTE_US 20               // 10 biți la 500000 baud
+#define ARDUINO_CLOCK_OFFSET_US 7331  // ceasurile plăcilor nu sunt sincronizate
+
+// Senzori ultrasonici
+#define ECHO_DELAY_US 460             // declanșare -> începutul ecoului la HC-SR04
+#define ECHO_US_PER_CM 58.3           // dus-întors
+#define SONAR_MAX_M 4.0
+#define SONAR_MIN_M 0.02
+#define SONAR_HALF_BEAM_RAD 0.14      // ~8°, trei raze pe con
+
+// Cititorul RFID
+#define RFID_UART 2
+#define RFID_BYTE_US 87               // 10 biți la 115200 baud
+#define RFID_CYCLE_US 20000           // o rundă de inventar
+#define RFID_RANGE_M 0.03             // antena, în centrul mașinii, vede tag-ul de dedesubt
+#define RFID_RSSI -52
+
+// Semnele de circulație
+#define SIGN_ACK_DELAY_US 2000
+#define SIGN_MAX 3
+
+#define IO_POLL_US 5000
+
+struct SonarMount {
+  int trigPin;
+  int echoPin;
+  double x, y, angle;                 // în sistemul mașinii
+};
+
+// Senzorii din profilul firmware-ului, pe conturul caroseriei, pe direcția în care privesc
+static SonarMount sonarMount(const UltrasonicChannelSpec& spec) {
+  double angle = spec.mountDeg * M_PI / 180;
+  double c = cos(angle), s = sin(angle);
+  double toEnd = fabs(c) > 1e-9 ? BODY_HALF_LENGTH / fabs(c) : INFINITY;
+  double toSide = fabs(s) > 1e-9 ? BODY_HALF_WIDTH / fabs(s) : INFINITY;
+  double r = fmin(toEnd, toSide);
+  return SonarMount{ spec.trigPin, spec.echoPin, r * c, r * s, angle };
+}
+
+static const int SONAR_COUNT = ULTRASONIC_SENSOR_COUNT;
+static SonarMount sonarMounts[SONAR_COUNT];
+
+static SimWorldConfig world;
+static SimVehicleState vehicle;
+static bool blocked = false;           // caroseria apasă un obstacol
+static int trigLevel[SONAR_COUNT];
+
+static uint16_t linkSequence = 0;
+static uint32_t lastEdgeUs = 0;
+static int32_t edgePeriodUs = 0;
+static long lastCount = 0;
+
+static RfidDecoder rfidCommands;
+static bool rfidActive = false;
+static uint32_t rfidPollsLeft = 0;
+
+static std::function<void()> tickObserver;
+static std::function<void(const uint8_t*, size_t)> bluetoothObserver;
+
+static int bluetoothInFd = -1;
+static int bluetoothOutFd = -1;
+static int serialOutFd = -1;
+static timespec wallStart;
+static uint64_t virtualStartUs = 0;
+
+static void every(uint64_t atUs, uint64_t periodUs, std::function<void()> fn) {
+  simAt(atUs, [atUs, periodUs, fn] {
+    fn();
+    every(atUs + periodUs, periodUs, fn);
+  });
+}
+
+// ******************* GEOMETRIE ***************************************
+static bool insideObstacle(double x, double y) {
+  for (const SimObstacle& o : world.obstacles) {
+    if (x >= o.x0 && x <= o.x1 && y >= o.y0 && y <= o.y1) return true;
+  }
+  return false;
+}
+
+// Distanța de la (x, y) pe direcția angle până la primul obstacol (metoda plăcilor), sau -1
+static double castRay(double x, double y, double angle, double maxRange) {
+  double dx = cos(angle), dy = sin(angle);
+  double best = -1;
+  for (const SimObstacle& o : world.obstacles) {
+    double tMin = 0, tMax = maxRange;
+    const double origin[2] = { x, y };
+    const double dir[2] = { dx, dy };
+    const double lo[2] = { o.x0, o.y0 };
+    const double hi[2] = { o.x1, o.y1 };
+    bool hit = true;
+    for (int axis = 0; axis < 2 && hit; axis++) {
+      if (fabs(dir[axis]) < 1e-12) {
+        if (origin[axis] < lo[axis] || origin[axis] > hi[axis]) hit = false;
+        continue;
+      }
+      double t0 = (lo[axis] - origin[axis]) / dir[axis];
+      double t1 = (hi[axis] - origin[axis]) / dir[axis];
+      if (t0 > t1) std::swap(t0, t1);
+      tMin = std::max(tMin, t0);
+      tMax = std::min(tMax, t1);
+      if (tMin > tMax) hit = false;
+    }
+    if (hit && (best < 0 || tMin < best)) best = tMin;
+  }
+  return best;
+}
+
+static void bodyToWorld(double bx, double by, double& wx, double& wy) {
+  double c = cos(vehicle.theta), s = sin(vehicle.theta);
+  wx = vehicle.x + bx * c - by * s;
+  wy = vehicle.y + bx * s + by * c;
+}
+
+// Ecoul cel mai apropiat din conul senzorului, în metri; -1 = niciun ecou
+static double sonarRange(int index) {
+  const SonarMount& m = sonarMounts[index];
+  double x, y;
+  bodyToWorld(m.x, m.y, x, y);
+  double best = -1;
+  for (int ray = -1; ray <= 1; ray++) {
+    double d = castRay(x, y, vehicle.theta + m.angle + ray * SONAR_HALF_BEAM_RAD, SONAR_MAX_M);
+    if (d >= 0 && (best < 0 || d < best)) best = d;
+  }
+  if (best >= 0 && best < SONAR_MIN_M) best = SONAR_MIN_M;
+  return best;
+}
+
+double SimWorld_frontGap() {
+  double x, y;
+  bodyToWorld(BODY_HALF_LENGTH, 0, x, y);
+  double d = castRay(x, y, vehicle.theta, 100.0);
+  return d < 0 ? 100.0 : d;
+}
+
+// ******************* DINAMICA ****************************************
+static double steeringRad() {
+  int angle = simServoAngle(PIN_SERVO);
+  if (angle < 0) return 0;
+  if (angle <= SERVO_CENTER) return STEER_MAX_RAD * (SERVO_CENTER - angle) / (double)(SERVO_CENTER - SERVO_LEFT);
+  return -STEER_MAX_RAD * (angle - SERVO_CENTER) / (double)(SERVO_RIGHT - SERVO_CENTER);
+}
+
+static bool bodyCollides(double x, double y, double theta) {
+  double c = cos(theta), s = sin(theta);
+  const double corners[4][2] = {
+    {  BODY_HALF_LENGTH,  BODY_HALF_WIDTH }, {  BODY_HALF_LENGTH, -BODY_HALF_WIDTH },
+    { -BODY_HALF_LENGTH,  BODY_HALF_WIDTH }, { -BODY_HALF_LENGTH, -BODY_HALF_WIDTH },
+  };
+  for (const auto& p : corners) {
+    if (insideObstacle(x + p[0] * c - p[1] * s, y + p[0] * s + p[1] * c)) return true;
+  }
+  return false;
+}
+
+static void physicsStep() {
+  const double dt = PHYSICS_PERIOD_US / 1e6;
+  int in1 = simPinLevel(PIN_IN1);
+  int in2 = simPinLevel(PIN_IN2);
+  double duty = simLedcDuty(PIN_ENA) / 255.0;
+
+  double v = vehicle.speed;
+  if (in1 && in2) {
+    double dv = BRAKE_DECEL * dt;
+    v = fabs(v) <= dv ? 0 : v - (v > 0 ? dv : -dv);
+  } else {
+    double target = (in1 ? 1 : (in2 ? -1 : 0)) * duty * WHEEL_MAX_SPEED;
+    v += (target - v) * dt / MOTOR_TAU_S;
+  }
+  // Pe o podea alunecoasă roțile patinează: nici frâna, nici motorul nu schimbă viteza mai repede
+  if (world.traction > 0) {
+    double dv = world.traction * dt;
+    v = fmin(fmax(v, vehicle.speed - dv), vehicle.speed + dv);
+  }
+
+  if (!vehicle.onStand) {
+    double ds = v * dt;
+    double theta = vehicle.theta + ds / WHEELBASE_M * tan(steeringRad());
+    double x = vehicle.x + ds * cos(vehicle.theta);
+    double y = vehicle.y + ds * sin(vehicle.theta);
+    if (ds == 0) {
+      // pe loc: nici contact nou, nici desprindere
+    } else if (bodyCollides(x, y, theta)) {
+      if (!blocked) {
+        if (vehicle.collisions == 0) {
+          vehicle.firstCollisionUs = simNowUs();
+          vehicle.impactSpeed = v;
+        }
+        vehicle.collisions++;
+      }
+      blocked = true;
+      v = 0;                           // roțile se opresc odată cu caroseria
+    } else {
+      blocked = false;
+      vehicle.x = x;
+      vehicle.y = y;
+      vehicle.theta = theta;
+      vehicle.distance += ds;
+    }
+  }
+
+  vehicle.speed = v;
+  vehicle.encoderCounts += v * dt * COUNTS_PER_METER * (1.0 + world.odometryError);
+
+  long count = lroundl(floor(vehicle.encoderCounts));
+  if (count != lastCount) {
+    uint32_t arduinoUs = (uint32_t)(simNowUs() + ARDUINO_CLOCK_OFFSET_US);
+    double countsPerS = v * COUNTS_PER_METER * (1.0 + world.odometryError);
+    edgePeriodUs = fabs(countsPerS) < 1 ? 0 : (int32_t)(1e6 / countsPerS);
+    lastEdgeUs = arduinoUs;
+    lastCount = count;
+  }
+
+  if (tickObserver) tickObserver();
+}
+
+// ******************* SENSORLINK **************************************
+static void sendLinkSample() {
+  SensorLinkSample s = {};
+  s.sequence = linkSequence++;
+  s.arduinoTimeUs = (uint32_t)(simNowUs() + ARDUINO_CLOCK_OFFSET_US);
+  s.encoder = (int32_t)lastCount;
+  s.compass[0] = (int16_t)lround(1200 * cos(vehicle.theta));
+  s.compass[1] = (int16_t)lround(-1200 * sin(vehicle.theta));
+  s.compass[2] = -400;
+  s.voltageCentivolts = 780;
+  s.lastEdgeUs = lastEdgeUs;
+  s.edgePeriodUs = edgePeriodUs;
+
+  uint8_t frame[SENSOR_LINK_MAX_FRAME];
+  size_t len = sensorLinkEncode(s, frame);
+  std::vector<uint8_t> bytes(frame, frame + len);
+  simAt(simNowUs() + len * LINK_BYTE_US, [bytes] { simUartReceive(LINK_UART, bytes.data(), bytes.size()); });
+}
+
+// ******************* ULTRASONIC **************************************
+static void onTrigger(int index, int level) {
+  bool falling = trigLevel[index] != 0 && level == 0;
+  trigLevel[index] = level;
+  if (!falling) return;
+
+  double range = sonarRange(index);
+  if (range < 0) return;                // niciun ecou: firmware-ul expiră după ULTRASONIC_TIMEOUT_US
+  int echo = sonarMounts[index].echoPin;
+  uint64_t riseUs = simNowUs() + ECHO_DELAY_US;
+  uint64_t fallUs = riseUs + (uint64_t)lround(range * 100 * ECHO_US_PER_CM);
+  simAt(riseUs, [echo] { simPinDrive(echo, 1); });
+  simAt(fallUs, [echo] { simPinDrive(echo, 0); });
+}
+
+static SimPulse onPulseIn(int index, int state) {
+  double range = sonarRange(index);
+  if (range < 0) return SimPulse{ 0, 0 };
+  return SimPulse{ ECHO_DELAY_US, (uint32_t)lround(range * 100 * ECHO_US_PER_CM) };
+}
+
+// ******************* RFID ********************************************
+static size_t rfidFrame(uint8_t type, uint8_t command, const uint8_t* params, uint16_t len, uint8_t* out) {
+  out[0] = RFID_FRAME_HEADER;
+  out[1] = type;
+  out[2] = command;
+  out[3] = (uint8_t)(len >> 8);
+  out[4] = (uint8_t)len;
+  memcpy(out + 5, params, len);
+  uint8_t sum = 0;
+  for (uint16_t i = 1; i < 5 + len; i++) sum += out[i];
+  out[5 + len] = sum;
+  out[6 + len] = RFID_FRAME_END;
+  return 7 + len;
+}
+
+static void rfidReply(const uint8_t* frame, size_t len) {
+  std::vector<uint8_t> bytes(frame, frame + len);
+  simAt(simNowUs() + len * RFID_BYTE_US, [bytes] { simSerialReceive(RFID_UART, bytes.data(), bytes.size()); });
+}
+
+static void onRfidCommand(const uint8_t* data, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    if (!rfidCommands.push(data[i]) || rfidCommands.type() != RFID_TYPE_COMMAND) continue;
+    if (rfidCommands.command() == RFID_CMD_MULTI_POLL && rfidCommands.paramsLen() == 3) {
+      const uint8_t* p = rfidCommands.params();
+      rfidPollsLeft = ((uint32_t)p[1] << 8) | p[2];
+      rfidActive = rfidPollsLeft > 0;
+      vehicle.rfidInventories++;
+    } else if (rfidCommands.command() == RFID_CMD_STOP_POLL) {
+      rfidActive = false;
+      uint8_t ok = 0x00;
+      uint8_t frame[RFID_MAX_FRAME];
+      rfidReply(frame, rfidFrame(RFID_TYPE_RESPONSE, RFID_CMD_STOP_POLL, &ok, 1, frame));
+    }
+  }
+}
+
+// O rundă de inventar: o notificare pentru fiecare tag din câmp, altfel eroarea "niciun tag"
+static void rfidCycle() {
+  if (!rfidActive) return;
+  if (--rfidPollsLeft == 0) rfidActive = false;
+
+  uint8_t frame[RFID_MAX_FRAME];
+  bool any = false;
+  for (const TrackTag& tag : TRACK_MAP_TAGS) {
+    if (tag.epc.len == 0) continue;
+    if (hypot(vehicle.x - tag.x, vehicle.y - tag.y) > RFID_RANGE_M) continue;
+    uint8_t params[5 + RFID_EPC_MAX];
+    params[0] = (uint8_t)(int8_t)RFID_RSSI;
+    params[1] = 0x30;                  // PC: 96 de biți de EPC
+    params[2] = 0x00;
+    memcpy(params + 3, tag.epc.bytes, tag.epc.len);
+    // CRC-16 EPC Gen2: același CCITT ca în FrameCodec.h, inversat
+    uint16_t crc = (uint16_t)~frameCrc16(params + 1, 2 + tag.epc.len);
+    params[3 + tag.epc.len] = (uint8_t)(crc >> 8);
+    params[4 + tag.epc.len] = (uint8_t)crc;
+    rfidReply(frame, rfidFrame(RFID_TYPE_NOTICE, RFID_CMD_SINGLE_POLL, params, 5 + tag.epc.len, frame));
+    vehicle.rfidNotices++;
+    any = true;
+  }
+  if (!any) {
+    uint8_t error = RFID_ERROR_NO_TAG;
+    rfidReply(frame, rfidFrame(RFID_TYPE_RESPONSE, RFID_CMD_ERROR, &error, 1, frame));
+  }
+}
+
+// ******************* SEMNE DE CIRCULAȚIE *****************************
+static void signReceive(int signId, const uint8_t* src, const uint8_t* data, int len) {
+  AlertFrame alert;
+  if (!alertDecode(data, (size_t)len, alert) || alert.type != ALERT_TYPE_ALERT) return;
+  vehicle.signAlerts[signId]++;
+
+  AlertFrame ack = alert;
+  ack.type = ALERT_TYPE_ACK;
+  ack.signId = (uint8_t)signId;
+  uint8_t frame[ALERT_FRAME_LEN];
+  size_t n = alertEncode(ack, frame);
+  std::vector<uint8_t> bytes(frame, frame + n);
+  std::vector<uint8_t> to(src, src + 6);
+  simAt(simNowUs() + SIGN_ACK_DELAY_US, [signId, bytes, to] {
+    const uint8_t mac[6] = { 0x30, 0xAE, 0xA4, 0x00, 0x00, (uint8_t)signId };
+    vehicle.signAcks[signId]++;
+    simRadioSend(mac, to.data(), bytes.data(), (int)bytes.size());
+  });
+}
+
+// ******************* INTRĂRI / IEȘIRI ********************************
+static int openOutput(const std::string& path) {
+  if (path.empty()) return -1;
+  int fd = open(path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) perror(path.c_str());
+  return fd;
+}
+
+static void writeAll(int fd, const uint8_t* data, size_t len) {
+  while (fd >= 0 && len > 0) {
+    ssize_t n = write(fd, data, len);
+    if (n <= 0) return;
+    data += n;
+    len -= (size_t)n;
+  }
+}
+
+static void pollIo() {
+  // Aplicația se conectează după pornire, ca scriptul de comenzi
+  if (bluetoothInFd >= 0 && !vehicle.onStand) {
+    uint8_t buffer[256];
+    ssize_t n = read(bluetoothInFd, buffer, sizeof(buffer));
+    if (n > 0) simBluetoothReceive(buffer, (size_t)n);
+  }
+  if (world.realtime) {
+    timespec now;
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    int64_t wallUs = (now.tv_sec - wallStart.tv_sec) * 1000000LL + (now.tv_nsec - wallStart.tv_nsec) / 1000;
+    int64_t aheadUs = (int64_t)(simNowUs() - virtualStartUs) - wallUs;
+    if (aheadUs > 0) usleep((useconds_t)aheadUs);
+  }
+}
+
+// ******************* API *********************************************
+void SimWorld_init(const SimWorldConfig& config) {
+  world = config;
+  vehicle = SimVehicleState();
+  vehicle.x = config.startX;
+  vehicle.y = config.startY;
+  vehicle.theta = config.startTheta;
+  vehicle.onStand = true;
+
+  simRandomSeed(config.seed);
+  simRadioSetLoss(config.radioLoss, config.seed * 2654435761u);
+
+  for (int i = 0; i < SONAR_COUNT; i++) {
+    sonarMounts[i] = sonarMount(ULTRASONIC_CHANNELS[i]);
+    simPinOnWrite(sonarMounts[i].trigPin, [i](int level) { onTrigger(i, level); });
+    simPinOnPulseIn(sonarMounts[i].echoPin, [i](int state) { return onPulseIn(i, state); });
+  }
+
+  simSerialOnWrite(RFID_UART, onRfidCommand);
+  serialOutFd = openOutput(config.serialOut);
+  simSerialOnWrite(0, [](const uint8_t* data, size_t len) {
+    if (world.serialToStdout) fwrite(data, 1, len, stdout);
+    writeAll(serialOutFd, data, len);
+  });
+  // Aplicația este lângă vehicul de la pornire: se conectează imediat ce Bluetooth-ul pornește
+  bluetoothOutFd = openOutput(config.bluetoothOut);
+  simBluetoothOnWrite([](const uint8_t* data, size_t len) {
+    writeAll(bluetoothOutFd, data, len);
+    if (bluetoothObserver) bluetoothObserver(data, len);
+  });
+  simBluetoothSetConnected(true);
+  if (!config.bluetoothIn.empty()) {
+    bluetoothInFd = open(config.bluetoothIn.c_str(), O_RDONLY | O_NONBLOCK);
+    if (bluetoothInFd < 0) perror(config.bluetoothIn.c_str());
+  }
+
+  for (int id = 1; id <= config.signCount && id <= SIGN_MAX; id++) {
+    const uint8_t mac[6] = { 0x30, 0xAE, 0xA4, 0x00, 0x00, (uint8_t)id };
+    simRadioAddNode(mac, [id](const uint8_t* src, const uint8_t* data, int len) { signReceive(id, src, data, len); });
+  }
+
+  every(0, PHYSICS_PERIOD_US, physicsStep);
+  every(SENSOR_LINK_PERIOD_US, SENSOR_LINK_PERIOD_US, sendLinkSample);
+  every(RFID_CYCLE_US, RFID_CYCLE_US, rfidCycle);
+  if (bluetoothInFd >= 0 || config.realtime) {
+    clock_gettime(CLOCK_MONOTONIC, &wallStart);
+    every(IO_POLL_US, IO_POLL_US, pollIo);
+  }
+}
+
+void SimWorld_onReady() {
+  vehicle.onStand = false;
+  vehicle.readyUs = simNowUs();
+  for (const SimBluetoothCommand& cmd : world.bluetooth) {
+    std::string bytes = cmd.bytes;
+    simAt(vehicle.readyUs + cmd.atMs * 1000ull, [bytes] {
+      simBluetoothReceive((const uint8_t*)bytes.data(), bytes.size());
+    });
+  }
+}
+
+void SimWorld_onTick(std::function<void()> observer) {
+  tickObserver = observer;
+}
+
+void SimWorld_onBluetooth(std::function<void(const uint8_t* data, size_t len)> observer) {
+  bluetoothObserver = observer;
+}
+
+const SimVehicleState& SimWorld_state() {
+  return vehicle;
+}
@@ -0,0 +1,80 @@
+#ifndef SIM_WORLD_H
+#define SIM_WORLD_H
+
+/**
+ * Lumea în care rulează firmware-ul vehiculului pe calculator: dinamica mașinii (puntea H,
+ * servomotorul de direcție), Arduino-ul de pe SensorLink (encoder, busolă), senzorii
+ * ultrasonici față de obstacolele din scenă, cititorul RFID YRM1003 deasupra tag-urilor din
+ * TrackMapData.h, semnele de circulație care confirmă alertele ESP-NOW și aplicația Bluetooth.
+ *
+ * Totul rulează pe evenimentele nucleului (SimKernel.h), deci o rulare este deterministă.
+ * Până la SimWorld_onReady() mașina stă pe suport: roțile se învârt (testul motorului din
+ * setup()), dar caroseria nu se mișcă.
+ */
+
+#include <stddef.h>
+#include <stdint.h>
+#include <functional>
+#include <string>
+#include <vector>
+
+// Dreptunghi aliniat cu axele, în metri
+struct SimObstacle {
+  float x0, y0;
+  float x1, y1;
+};
+
+// Octeți trimiși de aplicație la atMs după SimWorld_onReady()
+struct SimBluetoothCommand {
+  uint32_t atMs;
+  std::string bytes;
+};
+
+struct SimWorldConfig {
+  float startX = 0;
+  float startY = 0;
+  float startTheta = 0;
+  float odometryError = 0;          // eroarea relativă a encoderului (ex. 0.1 = roată cu 10% mai mare)
+  float traction = 0;               // m/s^2 cel mult transmiși de roți (podea alunecoasă), 0 = nelimitat
+  std::vector<SimObstacle> obstacles;
+  std::vector<SimBluetoothCommand> bluetooth;
+  int signCount = 2;                // semne de circulație cu ID 1..signCount
+  double radioLoss = 0;
+  uint32_t seed = 1;
+
+  // Ieșiri și intrări externe (FIFO-uri sau fișiere); goale = dezactivate
+  std::string bluetoothIn;
+  std::string bluetoothOut;
+  std::string serialOut;
+  bool serialToStdout = false;
+  bool realtime = false;            // simularea nu o ia înaintea ceasului de perete
+};
+
+struct SimVehicleState {
+  double x, y, theta;               // poziția reală
+  double speed;                     // m/s, cu semn
+  double distance;                  // m parcurși de caroserie (cu semn)
+  double encoderCounts;
+  bool onStand;
+  uint64_t readyUs;                 // momentul ieșirii de pe suport
+  uint32_t collisions;
+  uint64_t firstCollisionUs;
+  double impactSpeed;               // m/s la prima coliziune
+  uint32_t rfidNotices;             // notificări de tag trimise de cititor
+  uint32_t rfidInventories;         // comenzi de inventar continuu primite
+  uint32_t signAlerts[4];           // alerte primite de fiecare semn (index = ID)
+  uint32_t signAcks[4];
+};
+
+void SimWorld_init(const SimWorldConfig& config);
+// Sfârșitul lui setup(): mașina coboară de pe suport la poziția de start
+void SimWorld_onReady();
+// Apelată după fiecare pas al dinamicii (1 ms), în taskul hardware: aici scenariile citesc stările
+void SimWorld_onTick(std::function<void()> observer);
+// Apelată cu fiecare pachet primit de aplicație (notificare BLE sau scriere SPP), la sosire
+void SimWorld_onBluetooth(std::function<void(const uint8_t* data, size_t len)> observer);
+// Spațiul liber în fața (sensul de mers înainte) până la cel mai apropiat obstacol, în metri
+double SimWorld_frontGap();
+const SimVehicleState& SimWorld_state();
+
+#endif
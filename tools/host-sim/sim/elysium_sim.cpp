@@ -0,0 +1,615 @@
+/**
+ * Simularea pe calculator a vehiculului Elysium RC: firmware-ul ESP32 (ElysiumRC.ino și
+ * Modules.cpp), compilat nemodificat peste shim-ul Linux din tools/host-sim/shim, rulează într-o
+ * lume simulată (sim/SimWorld.h) pe un ceas virtual, mult mai repede decât în timp real.
+ *
+ * Fiecare scenariu pornește firmware-ul de la setup() (inclusiv testele motoarelor, ~17 s
+ * virtuale), coboară mașina pe traseu, trimite comenzile aplicației prin Bluetooth și verifică
+ * la final starea firmware-ului și a lumii. O rulare fără --cpu este deterministă.
+ *
+ * Compilare:
+ *   cmake -S tools/host-sim -B build && cmake --build build      (apoi ctest --test-dir build)
+ * Utilizare:
+ *   elysium_sim <scenariu> [opțiuni]
+ *     scenarii:  aeb       zid la 2 m, mers înainte: frâna automată oprește mașina înainte de zid
+ *                marsarier după frâna din fața zidului, mers înapoi spre un al doilea zid: frâna
+ *                          automată oprește mașina și în sensul opus blocajului
+ *                traseu    odometrie cu 10% eroare: tag-urile RFID corectează poziția, limita zonei
+ *                accident  frâna automată dezactivată, impact: detecție și alertă confirmată de semne
+ *                alunecos  podea alunecoasă: frâna automată nu oprește la timp, impactul din timpul
+ *                          frânării este detectat ca accident
+ *                bluetooth ping-uri și telemetrie cu profilul de latență mică, apoi cu cel de consum
+ *                          redus: latența dus-întors și debitul (elysium_sim_spp: același test pe SPP)
+ *                liber     fără verificări, pentru comenzi din --bt-in
+ *     --durata s          secunde virtuale după setup() (implicit: ale scenariului)
+ *     --cpu k             timpul de procesor al calculatorului, x k, se adaugă ceasului virtual
+ *     --seed n            sămânța pentru esp_random() și pierderile radio
+ *     --serial            jurnalul firmware-ului (Serial) la stdout
+ *     --serial-out cale   jurnalul firmware-ului într-un fișier sau FIFO
+ *     --bt-in cale        octeți de la "aplicație" (ex. un FIFO: echo F > bt_in)
+ *     --bt-out cale       telemetria și răspunsurile trimise prin Bluetooth
+ *     --timp-real         nu o ia înaintea ceasului de perete (pentru --bt-in interactiv)
+ *     --jurnal dir        la final, fișierele înregistratorului (LittleFS) se copiază în dir
+ *
+ * Toate scenariile verifică și termenele taskurilor, înregistratorul și heap-ul: după setup()
+ * taskurile monitorizate și loop() nu mai alocă (shared/heap/HeapGuard, cu Stringurile numărate
+ * de shim).
+ */
+
+#include "SimKernel.h"
+#include "SimWorld.h"
+
+#include "EmergencyBrake.h"
+#include "AccidentDetector.h"
+#include "AlertTransmitter.h"
+#include "BuzzerManager.h"
+#include "Navigation.h"
+#include "Pipeline.h"
+#include "TaskMonitor.h"
+#include "Recorder.h"
+#include "CommandChannel.h"
+#include "HeapGuard.h"
+#include "TelemetryCodec.h"
+#include "SimHardware.h"
+#include "../../common/CheckReport.h"
+
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+void setup();
+void loop();
+
+#define SIM_LIMIT_US (600ull * 1000000ull)   // plasă de siguranță pentru un firmware blocat
+
+struct Scenario {
+  const char* name;
+  uint32_t durationMs;
+};
+
+static const Scenario scenarios[] = {
+  { "aeb", 8000 },
+  { "marsarier", 10000 },
+  { "traseu", 14000 },
+  { "accident", 8000 },
+  { "alunecos", 8000 },
+  { "busola", 30000 },
+  { "bluetooth", 12500 },
+  { "liber", 60000 },
+};
+
+static SimWorldConfig config;
+static uint32_t durationMs = 0;
+
+// Urmărite pe parcurs (taskul hardware, după fiecare pas al dinamicii)
+struct TrackProbe {
+  bool beforeTag;          // eroarea de poziție chiar înainte de tagul 2
+  float errorBeforeTag;
+  bool afterTag;           // ... și imediat după
+  float errorAfterTag;
+  uint64_t zoneUs;         // momentul trecerii peste tagul 3 (limita de 0.3 m/s)
+  bool zoneSpeedTaken;
+  double zoneSpeed;        // viteza reală la 1.5 s după tagul 3
+};
+
+static TrackProbe track;
+
+// Aplicația din scenariul bluetooth: ping-uri, apoi aceleași ping-uri după schimbarea profilului
+#define PING_PERIOD_MS 100
+#define PHASE_COUNT 2
+
+struct BluetoothPhase {
+  const char* name;
+  uint32_t startMs;        // după SimWorld_onReady()
+  uint32_t endMs;
+};
+
+static const BluetoothPhase phases[PHASE_COUNT] = {
+  { "latență mică", 1000, 6000 },
+  { "consum redus", 7000, 12000 },
+};
+
+struct PhaseProbe {
+  std::vector<double> rttMs;
+  uint32_t packets;
+  uint32_t bytes;
+};
+
+struct BluetoothProbe {
+  std::vector<uint32_t> pingAtMs;      // indexul este jetonul
+  std::vector<bool> answered;
+  uint32_t pongs;
+  uint32_t strayPongs;
+  PhaseProbe phase[PHASE_COUNT];
+  TelemetryDecoder telemetry;
+  std::string line;
+};
+
+static BluetoothProbe phone;
+
+static int phaseAt(uint64_t us) {
+  uint64_t readyUs = SimWorld_state().readyUs;
+  if (SimWorld_state().onStand || us < readyUs) return -1;
+  uint32_t ms = (uint32_t)((us - readyUs) / 1000);
+  for (int i = 0; i < PHASE_COUNT; i++) {
+    if (ms >= phases[i].startMs && ms < phases[i].endMs) return i;
+  }
+  return -1;
+}
+
+static std::string commandFrame(uint8_t id, uint16_t seq, const uint8_t* args, uint8_t argLen) {
+  uint8_t frame[16 + FRAME_OVERHEAD] = { 0, 0, 0, id, (uint8_t)seq, (uint8_t)(seq >> 8), 0, 0, 0, 0 };
+  memcpy(frame + FRAME_HEADER_LEN + 7, args, argLen);
+  size_t len = frameSeal(frame, FRAME_SYNC_COMMAND, 7 + argLen);
+  return std::string((const char*)frame, len);
+}
+
+static void onPhoneLine(const std::string& line) {
+  // Octeții tipăribili de la sfârșitul unui cadru binar pot preceda linia
+  const char* pong = strstr(line.c_str(), "PONG ");
+  unsigned long token = 0, vehicleUs = 0;
+  if (pong == NULL || sscanf(pong, "PONG %lu %lu", &token, &vehicleUs) != 2) return;
+  if (token >= phone.pingAtMs.size() || phone.answered[token]) {
+    phone.strayPongs++;
+    return;
+  }
+  phone.answered[token] = true;
+  phone.pongs++;
+  // Aplicația predă ping-ul stivei Bluetooth exact la momentul programat
+  uint64_t sentUs = SimWorld_state().readyUs + phone.pingAtMs[token] * 1000ull;
+  int p = phaseAt(sentUs);
+  if (p >= 0) phone.phase[p].rttMs.push_back((simNowUs() - sentUs) / 1000.0);
+}
+
+static void onPhoneReceive(const uint8_t* data, size_t len) {
+  int p = phaseAt(simNowUs());
+  if (p >= 0) {
+    phone.phase[p].packets++;
+    phone.phase[p].bytes += len;
+  }
+  for (size_t i = 0; i < len; i++) {
+    phone.telemetry.push(data[i]);
+    // Liniile text ("PONG ...") apar între cadrele binare ale telemetriei
+    if (data[i] == '\n') {
+      onPhoneLine(phone.line);
+      phone.line.clear();
+    } else if (data[i] >= 0x20 && data[i] < 0x7F) {
+      phone.line += (char)data[i];
+    } else if (data[i] != '\r') {
+      phone.line.clear();
+    }
+  }
+}
+
+static void setupBluetooth() {
+  // Octeți izolați, ca dintr-un cadru stricat: nicio literă din ei nu este o comandă, nici urmată de liniște
+  config.bluetooth.push_back({ 400, "\xA5O\nxO\nOA\n\xA5O" });
+  // Litera simplă, fără '\n', a aplicațiilor vechi
+  config.bluetooth.push_back({ 450, "M" });
+  config.bluetooth.push_back({ 500, "F\n" });
+  uint16_t seq = 0;
+  for (int p = 0; p < PHASE_COUNT; p++) {
+    if (p > 0) {
+      const uint8_t profile = BT_PROFILE_LOW_POWER;
+      config.bluetooth.push_back({ phases[p].startMs - 500, commandFrame(CMD_BT_PROFILE, seq++, &profile, 1) });
+    }
+    for (uint32_t ms = phases[p].startMs; ms + PING_PERIOD_MS <= phases[p].endMs; ms += PING_PERIOD_MS) {
+      uint32_t token = (uint32_t)phone.pingAtMs.size();
+      const uint8_t args[4] = { (uint8_t)token, (uint8_t)(token >> 8), (uint8_t)(token >> 16), (uint8_t)(token >> 24) };
+      // Primul ping vine după un octet de sincronizare rătăcit, care nu trebuie să-l înghită
+      std::string frame = commandFrame(CMD_PING, seq++, args, 4);
+      config.bluetooth.push_back({ ms, token == 0 ? "\xA5" + frame : frame });
+      phone.pingAtMs.push_back(ms);
+      phone.answered.push_back(false);
+    }
+  }
+  SimWorld_onBluetooth(onPhoneReceive);
+}
+
+static float poseError() {
+  const SimVehicleState& s = SimWorld_state();
+  NavPose pose = Navigation_getPose();
+  return (float)hypot(pose.x - s.x, pose.y - s.y);
+}
+
+static void observeTrack() {
+  const SimVehicleState& s = SimWorld_state();
+  if (s.onStand) return;
+  if (!track.beforeTag && s.x >= 1.90) {
+    track.beforeTag = true;
+    track.errorBeforeTag = poseError();
+  }
+  if (!track.afterTag && s.x >= 2.05) {
+    track.afterTag = true;
+    track.errorAfterTag = poseError();
+  }
+  if (track.zoneUs == 0 && s.x >= 4.0) track.zoneUs = simNowUs();
+  if (track.zoneUs != 0 && !track.zoneSpeedTaken && simNowUs() >= track.zoneUs + 1500000) {
+    track.zoneSpeedTaken = true;
+    track.zoneSpeed = s.speed;
+  }
+}
+
+// Liniștea cea mai lungă a buzzer-ului după prima alarmă AEB: zidul rămâne sub pragul de avertizare
+static struct {
+  bool alarmSeen;
+  uint64_t silentSinceUs;
+  uint64_t longestSilenceUs;
+} buzzerWatch;
+
+static void observeBuzzer() {
+  int priority = Buzzer_getActivePriority();
+  if (priority == BUZZER_PRIORITY_ALERT) buzzerWatch.alarmSeen = true;
+  if (!buzzerWatch.alarmSeen) return;
+  if (priority >= BUZZER_PRIORITY_PROXIMITY) {
+    buzzerWatch.silentSinceUs = 0;
+  } else if (buzzerWatch.silentSinceUs == 0) {
+    buzzerWatch.silentSinceUs = simNowUs();
+  } else {
+    buzzerWatch.longestSilenceUs = std::max(buzzerWatch.longestSilenceUs, simNowUs() - buzzerWatch.silentSinceUs);
+  }
+}
+
+// loopTask: setup() ca pe placă, apoi mașina coboară pe traseu și loop() rulează la nesfârșit
+static void firmwareMain() {
+  setup();
+  SimWorld_onReady();
+  Navigation_setPose(config.startX, config.startY, config.startTheta);
+  simAt(simNowUs() + durationMs * 1000ull, [] { simStop(); });
+  while (true) loop();
+}
+
+static bool checkAeb() {
+  char detail[128];
+  bool allOk = true;
+  const SimVehicleState& s = SimWorld_state();
+  EmergencyBrakeStatus aeb = EmergencyBrake_getStatus();
+
+  snprintf(detail, sizeof(detail), "%lu coliziuni", (unsigned long)s.collisions);
+  allOk &= report("AEB: fără coliziune", s.collisions == 0, detail);
+  double gap = SimWorld_frontGap();
+  snprintf(detail, sizeof(detail), "%.1f cm până la zid, %.2f m/s", gap * 100, s.speed);
+  allOk &= report("AEB: oprire înaintea zidului", gap >= 0.05 && fabs(s.speed) < 0.01, detail);
+  snprintf(detail, sizeof(detail), "%lu intervenții, la %.1f cm, TTC %.2f s", (unsigned long)aeb.interventions,
+           aeb.distanceCm, aeb.ttcS);
+  allOk &= report("AEB: intervenție", aeb.interventions >= 1, detail);
+  snprintf(detail, sizeof(detail), "max %lu us, %lu peste țintă", (unsigned long)aeb.maxLatencyUs,
+           (unsigned long)aeb.latencyMisses);
+  allOk &= report("AEB: latența ecou -> frână", aeb.latencyMisses == 0, detail);
+  // Frânarea automată este o oprire comandată, nu un accident
+  AccidentDetectorStatus accident = AccidentDetector_getStatus();
+  snprintf(detail, sizeof(detail), "%lu detecții", (unsigned long)accident.detections);
+  allOk &= report("AEB: fără alarmă de accident", accident.detections == 0, detail);
+  // Alarma AEB înlocuiește avertizarea de proximitate; după ce se termină, zidul tot e aproape
+  snprintf(detail, sizeof(detail), "liniște max %.0f ms, prioritatea activă %d",
+           buzzerWatch.longestSilenceUs / 1000.0, Buzzer_getActivePriority());
+  allOk &= report("AEB: proximitate reluată după alarmă",
+                  buzzerWatch.alarmSeen && buzzerWatch.longestSilenceUs < 100000 &&
+                  Buzzer_getActivePriority() == BUZZER_PRIORITY_PROXIMITY, detail);
+  return allOk;
+}
+
+static bool checkReverse() {
+  char detail[128];
+  bool allOk = true;
+  const SimVehicleState& s = SimWorld_state();
+  EmergencyBrakeStatus aeb = EmergencyBrake_getStatus();
+
+  snprintf(detail, sizeof(detail), "%lu coliziuni", (unsigned long)s.collisions);
+  allOk &= report("Marșarier: fără coliziune", s.collisions == 0, detail);
+  snprintf(detail, sizeof(detail), "%lu intervenții, ultima pe senzorul %d, la %.1f cm",
+           (unsigned long)aeb.interventions, aeb.sensor, aeb.distanceCm);
+  allOk &= report("Marșarier: frână și în spate", aeb.interventions >= 2 && aeb.sensor == SENSOR_BACK, detail);
+  snprintf(detail, sizeof(detail), "%.2f m/s", s.speed);
+  allOk &= report("Marșarier: oprit", fabs(s.speed) < 0.01, detail);
+  snprintf(detail, sizeof(detail), "max %lu us, %lu peste țintă", (unsigned long)aeb.maxLatencyUs,
+           (unsigned long)aeb.latencyMisses);
+  allOk &= report("Marșarier: latența ecou -> frână", aeb.latencyMisses == 0, detail);
+  return allOk;
+}
+
+static bool checkTrack() {
+  char detail[128];
+  bool allOk = true;
+  snprintf(detail, sizeof(detail), "%.1f cm la x = 1.90 m", track.errorBeforeTag * 100);
+  allOk &= report("Traseu: deriva odometriei", track.beforeTag && track.errorBeforeTag > 0.15f, detail);
+  snprintf(detail, sizeof(detail), "%.1f cm la x = 2.05 m", track.errorAfterTag * 100);
+  allOk &= report("Traseu: corecție la tag", track.afterTag && track.errorAfterTag < 0.07f, detail);
+  // Limita zonei este în m/s ai firmware-ului; roata cu 10% mai mare merge proporțional mai încet
+  double limit = 0.30 / (1.0 + config.odometryError) + 0.02;
+  snprintf(detail, sizeof(detail), "%.3f m/s la 1.5 s după tag (max %.3f)", track.zoneSpeed, limit);
+  allOk &= report("Traseu: limita de viteză a zonei", track.zoneSpeedTaken && track.zoneSpeed <= limit, detail);
+  return allOk;
+}
+
+static bool checkAccident() {
+  char detail[128];
+  bool allOk = true;
+  const SimVehicleState& s = SimWorld_state();
+  AccidentDetectorStatus accident = AccidentDetector_getStatus();
+  AlertStats alerts = AlertTransmitter_getStats();
+
+  snprintf(detail, sizeof(detail), "%lu coliziuni, impact la %.2f m/s", (unsigned long)s.collisions, s.impactSpeed);
+  allOk &= report("Accident: impact", s.collisions >= 1, detail);
+  long latencyMs = (long)accident.lastDetectionMs - (long)(s.firstCollisionUs / 1000);
+  snprintf(detail, sizeof(detail), "%lu detecții, la %ld ms după impact (semnale 0x%x)",
+           (unsigned long)accident.detections, latencyMs, accident.lastSignals);
+  allOk &= report("Accident: detecție", accident.detections >= 1 && latencyMs >= 0 && latencyMs < 200, detail);
+  snprintf(detail, sizeof(detail), "%lu livrate, %lu trimiteri, %lu confirmări, prima după %lu us",
+           (unsigned long)alerts.delivered, (unsigned long)alerts.attempts, (unsigned long)alerts.acks,
+           (unsigned long)alerts.lastFirstAckUs);
+  allOk &= report("Accident: alertă confirmată", alerts.delivered >= 1, detail);
+  snprintf(detail, sizeof(detail), "semnul 1: %lu alerte, semnul 2: %lu alerte",
+           (unsigned long)s.signAlerts[1], (unsigned long)s.signAlerts[2]);
+  allOk &= report("Accident: semnele anunțate", s.signAlerts[1] >= 1 && s.signAlerts[2] >= 1, detail);
+  return allOk;
+}
+
+static bool checkSlippery() {
+  char detail[128];
+  bool allOk = true;
+  const SimVehicleState& s = SimWorld_state();
+  EmergencyBrakeStatus aeb = EmergencyBrake_getStatus();
+  AccidentDetectorStatus accident = AccidentDetector_getStatus();
+
+  snprintf(detail, sizeof(detail), "%lu intervenții, impact la %.2f m/s", (unsigned long)aeb.interventions, s.impactSpeed);
+  allOk &= report("Alunecos: impact în timpul frânei", aeb.interventions >= 1 && s.collisions >= 1, detail);
+  // Decelerarea impactului depășește anvelopa frânei, deci semnalul ei rămâne activ
+  long latencyMs = (long)accident.lastDetectionMs - (long)(s.firstCollisionUs / 1000);
+  snprintf(detail, sizeof(detail), "%lu detecții, la %ld ms după impact (semnale 0x%x)",
+           (unsigned long)accident.detections, latencyMs, accident.lastSignals);
+  allOk &= report("Alunecos: detecție", accident.detections >= 1 && (accident.lastSignals & ACC_SIGNAL_DECEL) &&
+                  latencyMs >= 0 && latencyMs < 200, detail);
+  return allOk;
+}
+
+static bool checkCompass() {
+  char detail[128];
+  NavigationStatus nav = Navigation_getStatus();
+  snprintf(detail, sizeof(detail), "%d/%d direcții, offset %.0f %.0f", nav.calibrationCoverage, NAV_CAL_SECTORS,
+           nav.calibration.offsetX, nav.calibration.offsetY);
+  // Coeficienții se scriu în NVS din taskul de navigație; checkHeap() cere ca scrierea să fie permisă
+  return report("Busolă: calibrare salvată", nav.calibrated && !nav.calibrating, detail);
+}
+
+static bool checkBluetooth() {
+  char detail[160];
+  bool allOk = true;
+  SimBluetoothStats link = simBluetoothStats();
+  CommandChannelStats commands = CommandChannel_getStats();
+
+  printf("%-16s %-14s %8s %8s %8s %10s %10s %10s\n", link.ble ? "BLE" : "SPP", "profil", "ping min",
+         "mediu", "max ms", "B/s", "pachete/s", "B/pachet");
+  double packetRate[PHASE_COUNT];
+  double maxRtt[PHASE_COUNT];
+  for (int p = 0; p < PHASE_COUNT; p++) {
+    const PhaseProbe& probe = phone.phase[p];
+    double seconds = (phases[p].endMs - phases[p].startMs) / 1000.0;
+    double sum = 0, lo = 0, hi = 0;
+    for (size_t i = 0; i < probe.rttMs.size(); i++) {
+      sum += probe.rttMs[i];
+      lo = i == 0 ? probe.rttMs[i] : std::min(lo, probe.rttMs[i]);
+      hi = std::max(hi, probe.rttMs[i]);
+    }
+    packetRate[p] = probe.packets / seconds;
+    maxRtt[p] = hi;
+    printf("%-16s %-14s %8.1f %8.1f %8.1f %10.0f %10.1f %10.1f\n", "", phases[p].name, lo,
+           probe.rttMs.empty() ? 0.0 : sum / probe.rttMs.size(), hi, probe.bytes / seconds, packetRate[p],
+           probe.packets > 0 ? (double)probe.bytes / probe.packets : 0.0);
+  }
+  printf("\n");
+
+  snprintf(detail, sizeof(detail), "%lu din %lu, %lu neașteptate", (unsigned long)phone.pongs,
+           (unsigned long)phone.pingAtMs.size(), (unsigned long)phone.strayPongs);
+  allOk &= report("Bluetooth: ping-uri cu răspuns", phone.pongs == phone.pingAtMs.size() && phone.strayPongs == 0,
+                  detail);
+  snprintf(detail, sizeof(detail), "max %.1f ms dus-întors (sosire -> execuție max %lu us)", maxRtt[0],
+           (unsigned long)commands.maxDispatchUs);
+  allOk &= report("Bluetooth: latență mică", maxRtt[0] > 0 && maxRtt[0] < 50, detail);
+  snprintf(detail, sizeof(detail), "%lu cadre, %lu CRC, %lu goluri; %lu notificări pierdute, %lu trunchiate",
+           (unsigned long)phone.telemetry.framesOk, (unsigned long)phone.telemetry.crcErrors,
+           (unsigned long)phone.telemetry.sequenceGaps, (unsigned long)link.dropped, (unsigned long)link.truncated);
+  allOk &= report("Bluetooth: telemetrie intactă", phone.telemetry.framesOk > 0 && phone.telemetry.crcErrors == 0 &&
+                  phone.telemetry.sequenceGaps == 0 && link.dropped == 0 && link.truncated == 0, detail);
+#if !ELYSIUM_BT_CLASSIC
+  // SPP nu are parametri de conexiune; pe BLE profilul de consum redus adună mai multe cadre pe pachet
+  snprintf(detail, sizeof(detail), "%.1f -> %.1f pachete/s, interval %.1f ms, MTU %u", packetRate[0], packetRate[1],
+           link.intervalUs / 1000.0, link.mtu);
+  allOk &= report("Bluetooth: consum redus", packetRate[1] < packetRate[0] * 0.75 && link.latency > 0, detail);
+#endif
+  snprintf(detail, sizeof(detail), "%lu comenzi literă, frâna automată %s", (unsigned long)commands.legacyCommands,
+           EmergencyBrake_isOverridden() ? "dezactivată" : "activă");
+  allOk &= report("Bluetooth: doar comenzi literă", commands.legacyCommands == 2 && !EmergencyBrake_isOverridden(), detail);
+  return allOk;
+}
+
+// Cu ceasul virtual doar planificarea poate întârzia un task: orice depășire este o regresie
+static bool checkDeadlines() {
+  char detail[128];
+  uint32_t misses = 0;
+  const char* worst = "-";
+  uint32_t worstMisses = 0;
+  for (int i = 0; i < TaskMonitor_getCount(); i++) {
+    TaskMonitorEntry e = TaskMonitor_get(i);
+    misses += e.deadlineMisses;
+    if (e.deadlineMisses > worstMisses) {
+      worstMisses = e.deadlineMisses;
+      worst = e.name;
+    }
+  }
+  // Un task care nu a încăput în tabel nu are nici termene verificate
+  snprintf(detail, sizeof(detail), "%lu depășiri (cele mai multe: %s), %d nemonitorizate", (unsigned long)misses,
+           worst, TaskMonitor_getRejected());
+  return report("Taskuri: termene respectate", misses == 0 && TaskMonitor_getRejected() == 0, detail);
+}
+
+static bool checkRecorder() {
+  char detail[128];
+  RecorderStats r = Recorder_getStats();
+  snprintf(detail, sizeof(detail), "%lu înregistrări, %lu blocuri, %lu pierdute, scriere max %lu us",
+           (unsigned long)r.records, (unsigned long)r.blocks, (unsigned long)r.dropped,
+           (unsigned long)r.maxWriteUs);
+  return report("Înregistrare: fără pierderi", r.mounted && r.blocks > 0 && r.dropped == 0 &&
+                r.writeErrors == 0, detail);
+}
+
+// Bufferele String se numără în shim: după setup() căile fierbinți nu trebuie să mai aloce
+static bool checkHeap() {
+  char detail[160];
+  HeapGuardStats h = HeapGuard_getStats();
+  HeapGuardSite sites[HEAP_GUARD_MAX_SITES];
+  int n = HeapGuard_getSites(sites, HEAP_GUARD_MAX_SITES);
+  snprintf(detail, sizeof(detail), "%lu neașteptate%s%s, %lu permise, %ld blocuri față de pornire",
+           (unsigned long)h.unexpected, n > 0 ? ", prima în " : "", n > 0 ? sites[0].task : "",
+           (unsigned long)h.allowed, (long)h.blocksDelta);
+  return report("Heap: fără alocări după pornire", h.steady && h.hooked && h.unexpected == 0 &&
+                h.blocksDelta <= 0, detail);
+}
+
+static void printTasks(double wallS) {
+  double virtualS = simNowUs() / 1e6;
+  printf("\nTimp virtual %.2f s, timp real %.2f s (x%.0f), %llu comutări de context\n", virtualS, wallS,
+         wallS > 0 ? virtualS / wallS : 0.0, (unsigned long long)simContextSwitches());
+
+  printf("\n%-16s %4s %10s %12s %12s\n", "Task", "prio", "rulări", "CPU gazdă ms", "max felie us");
+  for (int i = 0; i < simTaskCount(); i++) {
+    SimTaskStats t = simTaskStats(i);
+    printf("%-16s %4d %10llu %12.2f %12.1f\n", t.name, t.priority, (unsigned long long)t.slices,
+           t.cpuNs / 1e6, t.maxSliceNs / 1e3);
+  }
+
+  printf("\n%-16s %10s %10s %12s %14s\n", "TaskMonitor", "iterații", "ratate", "exec max us", "întârziere us");
+  for (int i = 0; i < TaskMonitor_getCount(); i++) {
+    TaskMonitorEntry e = TaskMonitor_get(i);
+    printf("%-16s %10lu %10lu %12lu %14lu\n", e.name, (unsigned long)e.iterations, (unsigned long)e.deadlineMisses,
+           (unsigned long)e.maxExecUs, (unsigned long)e.maxLatenessUs);
+  }
+
+  printf("\n%-16s %10s %12s\n", "Pipeline", "cadre", "latență max us");
+  for (int i = 0; i < Pipeline_getSubscriberCount(); i++) {
+    PipelineLatency l = Pipeline_getLatency(i);
+    printf("%-16s %10lu %12lu\n", l.name, (unsigned long)l.frames, (unsigned long)l.maxUs);
+  }
+}
+
+static void usage(const char* program) {
+  fprintf(stderr, "Utilizare: %s aeb|marsarier|traseu|accident|alunecos|busola|bluetooth|liber [--durata s] [--cpu k] [--seed n] [--serial]\n"
+                  "           [--serial-out cale] [--bt-in cale] [--bt-out cale] [--timp-real] [--jurnal dir]\n",
+          program);
+}
+
+int main(int argc, char** argv) {
+  if (argc < 2) {
+    usage(argv[0]);
+    return 2;
+  }
+  const Scenario* scenario = NULL;
+  for (const Scenario& s : scenarios) {
+    if (strcmp(argv[1], s.name) == 0) scenario = &s;
+  }
+  if (scenario == NULL) {
+    usage(argv[0]);
+    return 2;
+  }
+  durationMs = scenario->durationMs;
+
+  double cpuScale = 0;
+  const char* recorderDir = NULL;
+  for (int i = 2; i < argc; i++) {
+    const char* arg = argv[i];
+    const char* value = i + 1 < argc ? argv[i + 1] : NULL;
+    if (strcmp(arg, "--serial") == 0) {
+      config.serialToStdout = true;
+    } else if (strcmp(arg, "--timp-real") == 0) {
+      config.realtime = true;
+    } else if (value == NULL) {
+      usage(argv[0]);
+      return 2;
+    } else {
+      if (strcmp(arg, "--durata") == 0) durationMs = (uint32_t)(atof(value) * 1000);
+      else if (strcmp(arg, "--cpu") == 0) cpuScale = atof(value);
+      else if (strcmp(arg, "--seed") == 0) config.seed = (uint32_t)strtoul(value, NULL, 0);
+      else if (strcmp(arg, "--serial-out") == 0) config.serialOut = value;
+      else if (strcmp(arg, "--bt-in") == 0) config.bluetoothIn = value;
+      else if (strcmp(arg, "--bt-out") == 0) config.bluetoothOut = value;
+      else if (strcmp(arg, "--jurnal") == 0) recorderDir = value;
+      else {
+        usage(argv[0]);
+        return 2;
+      }
+      i++;
+    }
+  }
+
+  const SimObstacle wall = { 2.0f, -1.0f, 2.2f, 1.0f };
+  bool (*check)() = NULL;
+  if (strcmp(scenario->name, "aeb") == 0) {
+    config.obstacles.push_back(wall);
+    config.bluetooth.push_back({ 500, "F\n" });
+    SimWorld_onTick(observeBuzzer);
+    check = checkAeb;
+  } else if (strcmp(scenario->name, "marsarier") == 0) {
+    // Zidul din spate este mai aproape decât drumul până la eliberarea frânei din față
+    config.startX = 1.3f;
+    config.obstacles.push_back(wall);
+    config.obstacles.push_back({ 0.7f, -1.0f, 1.0f, 1.0f });
+    config.bluetooth.push_back({ 500, "F\n" });
+    config.bluetooth.push_back({ 3000, "B\n" });
+    check = checkReverse;
+  } else if (strcmp(scenario->name, "traseu") == 0) {
+    config.startX = -0.5f;
+    config.odometryError = 0.1f;
+    config.bluetooth.push_back({ 500, "F\n" });
+    SimWorld_onTick(observeTrack);
+    check = checkTrack;
+  } else if (strcmp(scenario->name, "accident") == 0) {
+    config.obstacles.push_back(wall);
+    config.radioLoss = 0.2;
+    config.bluetooth.push_back({ 300, "O\n" });
+    config.bluetooth.push_back({ 500, "F\n" });
+    check = checkAccident;
+  } else if (strcmp(scenario->name, "alunecos") == 0) {
+    config.obstacles.push_back(wall);
+    config.traction = 0.5f;
+    config.bluetooth.push_back({ 500, "F\n" });
+    check = checkSlippery;
+  } else if (strcmp(scenario->name, "busola") == 0) {
+    // Teren liber: calibrarea merge în cerc cu direcția la maxim
+    config.bluetooth.push_back({ 500, "C\n" });
+    check = checkCompass;
+  } else if (strcmp(scenario->name, "bluetooth") == 0) {
+    setupBluetooth();
+    check = checkBluetooth;
+  }
+
+  printf("Scenariul %s: %.1f s după setup()%s\n", scenario->name, durationMs / 1000.0,
+         cpuScale > 0 ? ", cu timpul de procesor al gazdei" : "");
+  fflush(stdout);
+
+  SimWorld_init(config);
+  simSetCpuScale(cpuScale);
+  timespec start, end;
+  clock_gettime(CLOCK_MONOTONIC, &start);
+  simRun(firmwareMain, SIM_LIMIT_US);
+  clock_gettime(CLOCK_MONOTONIC, &end);
+  double wallS = (end.tv_sec - start.tv_sec) + (end.tv_nsec - start.tv_nsec) / 1e9;
+
+  // Toate taskurile sunt oprite: starea firmware-ului se citește fără concurență
+  printf("\n");
+  bool allOk = check == NULL || check();
+  if (check != NULL) allOk &= checkDeadlines();
+  if (check != NULL) allOk &= checkRecorder();
+  if (check != NULL) allOk &= checkHeap();
+  if (recorderDir != NULL) printf("Jurnal: %d fișiere copiate în %s\n", simFlashExport(recorderDir), recorderDir);
+  printTasks(wallS);
+
+  // Firele taskurilor rămân parcate: ieșirea nu rulează destructorii statici peste ele
+  fflush(stdout);
+  _exit(allOk ? 0 : 1);
+}
@@ -0,0 +1,134 @@
+/**
+ * Decodor pe calculator pentru jurnalul binar (LOG_BINARY_OUTPUT = 1).
+ *
+ * Construiește dicționarul ID -> format căutând apelurile LOG_ERROR/WARN/INFO/DEBUG
+ * în sursele date, apoi transformă captura portului serial în text.
+ *
+ * Compilare:
+ *   g++ -O2 -std=c++17 -I../../firmware/shared/log log_decode.cpp -o log_decode
+ * Utilizare:
+ *   log_decode captura.bin ../../firmware [alte directoare...]
+ */
+
+#include "LogFormat.h"
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <map>
+#include <regex>
+#include <sstream>
+#include <string>
+#include <vector>
+
+namespace fs = std::filesystem;
+
+// Transformă conținutul unui literal C în octeții pe care îi vede compilatorul
+static std::string unescape(const std::string& s) {
+  std::string out;
+  for (size_t i = 0; i < s.size(); i++) {
+    if (s[i] != '\\' || i + 1 >= s.size()) {
+      out += s[i];
+      continue;
+    }
+    char c = s[++i];
+    switch (c) {
+      case 'n': out += '\n'; break;
+      case 't': out += '\t'; break;
+      case 'r': out += '\r'; break;
+      case '0': out += '\0'; break;
+      case 'x': {
+        int v = 0, digits = 0;
+        while (i + 1 < s.size() && isxdigit((unsigned char)s[i + 1]) && digits < 2) {
+          v = v * 16 + std::stoi(std::string(1, s[++i]), nullptr, 16);
+          digits++;
+        }
+        out += (char)v;
+        break;
+      }
+      default: out += c; break;
+    }
+  }
+  return out;
+}
+
+static void scanSources(const fs::path& root, std::map<uint32_t, std::string>& dict) {
+  static const std::regex call(R"(LOG_(ERROR|WARN|INFO|DEBUG)\s*\(\s*\"((?:[^\"\\]|\\.)*)\")");
+  for (const auto& entry : fs::recursive_directory_iterator(root)) {
+    if (!entry.is_regular_file()) continue;
+    std::string ext = entry.path().extension().string();
+    if (ext != ".cpp" && ext != ".h" && ext != ".ino") continue;
+
+    std::ifstream in(entry.path(), std::ios::binary);
+    std::stringstream buffer;
+    buffer << in.rdbuf();
+    std::string text = buffer.str();
+
+    for (std::sregex_iterator it(text.begin(), text.end(), call), end; it != end; ++it) {
+      std::string fmt = unescape((*it)[2].str());
+      uint32_t id = logHash(fmt.c_str());
+      auto found = dict.find(id);
+      if (found != dict.end() && found->second != fmt) {
+        fprintf(stderr, "Coliziune de ID %08x: \"%s\" / \"%s\"\n", id, found->second.c_str(), fmt.c_str());
+      }
+      dict[id] = fmt;
+    }
+  }
+}
+
+static uint32_t readU32(const uint8_t* p) {
+  return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    fprintf(stderr, "Utilizare: %s captura.bin director_surse [...]\n", argv[0]);
+    return 2;
+  }
+
+  std::map<uint32_t, std::string> dict;
+  for (int i = 2; i < argc; i++) scanSources(argv[i], dict);
+  fprintf(stderr, "%zu formate găsite\n", dict.size());
+
+  std::ifstream in(argv[1], std::ios::binary);
+  std::vector<uint8_t> data((std::istreambuf_iterator<char>(in)), std::istreambuf_iterator<char>());
+
+  size_t frames = 0, crcErrors = 0, unknown = 0;
+  FrameDecoder<255> decoder(FRAME_SYNC_LOG, LOG_FRAME_HEADER_LEN);
+  for (uint8_t b : data) {
+    FrameResult r = decoder.push(b);
+    if (r == FRAME_BAD_CRC) crcErrors++;
+    if (r != FRAME_READY) continue;
+    const uint8_t* payload = decoder.payload();
+    uint8_t len = decoder.length();
+
+    uint32_t id = readU32(payload);
+    uint32_t timeUs = readU32(payload + 4);
+    uint8_t level = payload[8];
+    uint8_t argCount = payload[9];
+    uint8_t stringsLen = payload[10];
+    if (LOG_FRAME_HEADER_LEN + 4u * argCount + stringsLen != len) {
+      crcErrors++;
+      continue;
+    }
+
+    uint32_t args[256];
+    for (uint8_t a = 0; a < argCount; a++) args[a] = readU32(payload + LOG_FRAME_HEADER_LEN + 4 * a);
+    const char* strings = (const char*)payload + LOG_FRAME_HEADER_LEN + 4 * argCount;
+
+    char text[512];
+    auto found = dict.find(id);
+    if (found != dict.end()) {
+      logFormat(text, sizeof(text), found->second.c_str(), args, argCount, strings, stringsLen);
+    } else {
+      snprintf(text, sizeof(text), "<format necunoscut %08x, %u argumente>", id, argCount);
+      unknown++;
+    }
+    printf("[%7u.%06u] %c %s\n", timeUs / 1000000u, timeUs % 1000000u, logLevelLetter(level), text);
+
+    frames++;
+  }
+
+  fprintf(stderr, "%zu mesaje, %zu erori CRC, %zu formate necunoscute\n", frames, crcErrors, unknown);
+  return crcErrors == 0 ? 0 : 1;
+}
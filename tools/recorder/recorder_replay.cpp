@@ -0,0 +1,416 @@
+/**
+ * Reluarea pe calculator a jurnalelor înregistratorului de senzori al ESP32 (core/Recorder.h).
+ *
+ * Fișierele .erl (copiate de pe LittleFS, descărcate prin Bluetooth sau scrise de simulare)
+ * sunt mapate în memorie cu mmap și trecute, în ordinea indexului, prin același cod ca pe
+ * vehicul: filtrul fiecărui canal ultrasonic (RangeFilter.h), decizia frânei automate
+ * (AebDecision.h) și detectorul de accident (AccidentDetection.h). Reluarea nu așteaptă
+ * timpul înregistrat, deci un jurnal de minute se reia în milisecunde.
+ *
+ * Compilare:
+ *   g++ -O2 -std=c++17 -I"../../firmware/Elysium RC/ESP32/core" -I"../../firmware/Elysium RC/ESP32/sensors" \
+ *       -I"../../firmware/Elysium RC/ESP32/motion-control" -I"../../firmware/Elysium RC/ESP32/alerts" \
+ *       -I"../../firmware/Elysium RC/ESP32/navigation" recorder_replay.cpp -o recorder_replay
+ * Utilizare:
+ *   recorder_replay [opțiuni] jurnal.erl|director ...
+ *     --text cale          evenimentele în formatul text al tools/accident ("timp_us W|B|U|H ...")
+ *     --astept-frana       eșuează dacă reluarea nu frânează niciodată
+ *     --astept-accident    eșuează dacă reluarea nu detectează niciun accident
+ *   recorder_replay --extrage captura_bt.bin director
+ *     reface fișierele din bucățile CMD_LOG_READ dintr-o captură Bluetooth (amestecată cu telemetria)
+ */
+
+#include "RecorderFormat.h"
+#include "RangeFilter.h"
+#include "AebDecision.h"
+#include "AccidentDetection.h"
+#include "NavigationMath.h"
+#include "../common/CheckReport.h"
+
+#include <algorithm>
+#include <chrono>
+#include <dirent.h>
+#include <fcntl.h>
+#include <map>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#include <vector>
+
+// Ca pe vehicul (UltrasonicSensors.h, Navigation.h)
+#define REPLAY_CHANNELS 4
+#define REPLAY_REFRESH_S (REPLAY_CHANNELS * 0.05f)   // AEB_REFRESH_S: un canal la fiecare 50 ms
+#define REPLAY_SENSOR_FRONT 0
+#define REPLAY_SENSOR_BACK 2
+#define REPLAY_COUNTS_PER_METER 2400.0f
+
+struct MappedLog {
+  std::string path;
+  const uint8_t* data;
+  size_t len;
+  RecorderFileHeader header;
+};
+
+struct Counts {
+  uint32_t byType[8] = {0};
+  uint32_t blocks = 0;
+  uint32_t corruptBlocks = 0;
+  uint32_t skippedBytes = 0;
+  uint32_t controlFrames = 0;
+  uint32_t loggedBrakes = 0;       // frânele vehiculului, din indicatorii RECORD_DRIVE
+  uint32_t replayBrakes = 0;
+  uint32_t accidents = 0;
+  double durationS = 0;
+};
+
+// Starea reluării: aceleași componente ca taskurile de pe vehicul, fără FreeRTOS
+class Replay {
+public:
+  Counts counts;
+
+  explicit Replay(FILE* text) : _text(text), _accident(accidentDefaultConfig()) {}
+
+  void setCompass(const RecorderFileHeader& h) {
+    compassCalibrationDefault(_calibration);
+    _calibration.valid = (h.flags & RECORDER_FLAG_CALIBRATED) != 0;
+    _calibration.offsetX = h.compassOffsetX;
+    _calibration.offsetY = h.compassOffsetY;
+    _calibration.scaleX = h.compassScaleX;
+    _calibration.scaleY = h.compassScaleY;
+    _compassSign = h.compassSign;
+    _compassMount = h.compassMountRad;
+  }
+
+  void feed(const RecorderEvent& e) {
+    // Ceasul ESP32 se reia după ~71 de minute: timpul afișat se acumulează din diferențe
+    if (_haveTime) _elapsedUs += (int64_t)(int32_t)(e.timeUs - _lastUs);
+    _haveTime = true;
+    _lastUs = e.timeUs;
+    if (e.type < 8) counts.byType[e.type]++;
+
+    switch (e.type) {
+      case RECORD_RANGE: onRange(e); break;
+      case RECORD_ARDUINO: onArduino(e); break;
+      case RECORD_DRIVE: onDrive(e); break;
+      case RECORD_RFID: onRfid(e); break;
+      case RECORD_COMMAND: onCommand(e); break;
+    }
+  }
+
+  double seconds() const { return _elapsedUs / 1e6; }
+
+private:
+  FILE* _text;
+  RangeFilter _filters[REPLAY_CHANNELS];
+  AccidentFusion _accident;
+  CompassCalibration _calibration;
+  float _compassSign = 1;
+  float _compassMount = 0;
+
+  bool _haveTime = false;
+  uint32_t _lastUs = 0;
+  int64_t _elapsedUs = 0;
+
+  // Starea de mers din jurnal
+  int _direction = 0;
+  float _setpoint = 0;             // impulsuri/s
+  uint8_t _driveFlags = 0;
+
+  // Roata, ca în taskul detectorului de accident
+  bool _haveEncoder = false;
+  int32_t _lastEncoder = 0;
+  uint32_t _lastArduinoUs = 0;
+  float _speed = 0;                // m/s, cu semn
+  bool _textAutoBrake = false;     // ultima stare a frânei scrisă în rularea text
+
+  // Frâna reluată, ca în taskul AEB
+  int _blocked = 0;
+  bool _clearing = false;
+  uint32_t _clearSinceUs = 0;
+
+  void onAccidentFired() {
+    counts.accidents++;
+    printf("  %9.3f s  accident: semnale 0x%x, scor %u\n", seconds(), _accident.event().signals,
+           _accident.event().score);
+  }
+
+  void onRange(const RecorderEvent& e) {
+    if (e.channel >= REPLAY_CHANNELS) return;
+    if (e.value >= 0) {
+      _filters[e.channel].measure((float)e.value, e.timeUs);
+    } else {
+      _filters[e.channel].miss();
+    }
+    if (_text) fprintf(_text, "%lu U %u %ld\n", (unsigned long)e.timeUs, e.channel, (long)e.value);
+
+    // Distanțele brute: filtrul ar respinge tocmai saltul până la contact
+    if (_accident.onRange(e.channel, (float)e.value, e.timeUs)) onAccidentFired();
+
+    RangeEstimate range[REPLAY_CHANNELS];
+    for (int i = 0; i < REPLAY_CHANNELS; i++) {
+      _filters[i].age(e.timeUs);
+      range[i] = _filters[i].estimate();
+    }
+    brakeStep(range, e.timeUs);
+  }
+
+  void brakeStep(const RangeEstimate* range, uint32_t nowUs) {
+    if (_driveFlags & RECORD_DRIVE_AEB_OVERRIDDEN) {
+      _blocked = 0;
+      return;
+    }
+    if (_blocked != 0) {
+      int sensor = _blocked > 0 ? REPLAY_SENSOR_FRONT : REPLAY_SENSOR_BACK;
+      if (!aebPathClear(range[sensor])) {
+        _clearing = false;
+      } else if (!_clearing) {
+        _clearing = true;
+        _clearSinceUs = nowUs;
+      } else if (nowUs - _clearSinceUs >= AEB_RELEASE_MS * 1000UL) {
+        _clearing = false;
+        _blocked = 0;
+      }
+    }
+
+    // Ca pe vehicul, și sensul opus blocajului este evaluat
+    int direction = _direction;
+    if (direction == 0) direction = _speed > 0.05f ? 1 : (_speed < -0.05f ? -1 : 0);
+    if (direction == 0 || direction == _blocked) return;
+    int sensor = direction > 0 ? REPLAY_SENSOR_FRONT : REPLAY_SENSOR_BACK;
+    const RangeEstimate& r = range[sensor];
+    if (!r.valid()) return;
+
+    float age = (float)(uint32_t)(nowUs - r.updatedUs) * 1e-6f;
+    AebAssessment a = aebAssess(r, fabsf(_speed) * 100.0f, aebHorizonS(age, REPLAY_REFRESH_S));
+    if (!a.brake) return;
+    _blocked = direction;
+    _clearing = false;
+    counts.replayBrakes++;
+    printf("  %9.3f s  frână %s: %.0f cm, apropiere %.0f cm/s, TTC %.2f s\n", seconds(),
+           direction > 0 ? "înainte" : "înapoi", a.distanceCm, a.closingCmS, a.ttcS);
+  }
+
+  void onArduino(const RecorderEvent& e) {
+    uint32_t dtUs = e.arduinoTimeUs - _lastArduinoUs;
+    if (_haveEncoder && dtUs > 0) {
+      _speed = (e.encoder - _lastEncoder) * 1e6f / dtUs / REPLAY_COUNTS_PER_METER;
+      // Frâna automată este o oprire comandată în anvelopa ei, ca în AccidentDetector.cpp
+      bool autoBrake = (_driveFlags & RECORD_DRIVE_AEB_ENGAGED) != 0;
+      if (_text && autoBrake != _textAutoBrake) fprintf(_text, "%lu B %d\n", (unsigned long)e.timeUs, autoBrake ? 1 : 0);
+      _textAutoBrake = autoBrake;
+      _accident.setAutoBrake(autoBrake);
+      float commanded = _setpoint / REPLAY_COUNTS_PER_METER;
+      if (_text) fprintf(_text, "%lu W %.4f %.4f\n", (unsigned long)e.timeUs, _speed, commanded);
+      if (_accident.onWheel(_speed, commanded, e.timeUs)) onAccidentFired();
+    }
+    _lastEncoder = e.encoder;
+    _lastArduinoUs = e.arduinoTimeUs;
+    _haveEncoder = true;
+
+    if (_calibration.valid) {
+      float heading = compassHeading(_calibration, e.compass[0], e.compass[1], _compassSign, _compassMount);
+      if (_text) fprintf(_text, "%lu H %.4f\n", (unsigned long)e.timeUs, heading);
+      if (_accident.onHeading(heading, e.timeUs)) onAccidentFired();
+    }
+  }
+
+  void onDrive(const RecorderEvent& e) {
+    if ((e.flags & RECORD_DRIVE_AEB_ENGAGED) && !(_driveFlags & RECORD_DRIVE_AEB_ENGAGED)) {
+      counts.loggedBrakes++;
+      printf("  %9.3f s  vehiculul a frânat (jurnal)\n", seconds());
+    }
+    _direction = e.direction;
+    _setpoint = (float)e.value;
+    _driveFlags = e.flags;
+  }
+
+  void onRfid(const RecorderEvent& e) {
+    char epc[2 * RECORDER_DATA_MAX + 1];
+    for (int i = 0; i < e.len; i++) snprintf(epc + 2 * i, 3, "%02X", e.data[i]);
+    epc[2 * e.len] = '\0';
+    printf("  %9.3f s  tag %s %s (%d dBm)\n", seconds(), epc, e.flags == 0 ? "sosit" : "plecat", e.rssi);
+  }
+
+  void onCommand(const RecorderEvent& e) {
+    // Controlul continuu vine la 20 Hz: doar se numără
+    if (e.code == 0x10) {
+      counts.controlFrames++;
+    } else if (e.code == RECORD_COMMAND_TIMEOUT) {
+      printf("  %9.3f s  oprire de siguranță (control continuu întrerupt)\n", seconds());
+    } else if (e.code >= 'A' && e.code <= 'Z') {
+      printf("  %9.3f s  comanda %c\n", seconds(), e.code);
+    } else {
+      printf("  %9.3f s  comanda 0x%02x (%u argumente)\n", seconds(), e.code, e.len);
+    }
+  }
+};
+
+static bool mapLog(const std::string& path, MappedLog& log) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) return false;
+  struct stat st;
+  if (fstat(fd, &st) != 0 || st.st_size < RECORDER_FILE_HEADER) {
+    close(fd);
+    return false;
+  }
+  void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) return false;
+  log.path = path;
+  log.data = (const uint8_t*)data;
+  log.len = (size_t)st.st_size;
+  if (!recorderDecodeFileHeader(log.data, log.len, log.header)) {
+    munmap(data, log.len);
+    return false;
+  }
+  return true;
+}
+
+static void addPath(const char* path, std::vector<std::string>& files) {
+  struct stat st;
+  if (stat(path, &st) != 0) {
+    fprintf(stderr, "Nu există: %s\n", path);
+    return;
+  }
+  if (!S_ISDIR(st.st_mode)) {
+    files.push_back(path);
+    return;
+  }
+  DIR* dir = opendir(path);
+  if (dir == NULL) return;
+  while (dirent* entry = readdir(dir)) {
+    std::string name = entry->d_name;
+    if (name.size() > 4 && name.compare(name.size() - 4, 4, ".erl") == 0) {
+      files.push_back(std::string(path) + "/" + name);
+    }
+  }
+  closedir(dir);
+}
+
+// Bucățile din captură, puse la offset-ul lor; fișierul se termină la bucata goală
+static int extract(const char* capturePath, const char* outDir) {
+  FILE* in = fopen(capturePath, "rb");
+  if (in == NULL) {
+    fprintf(stderr, "Nu pot citi %s\n", capturePath);
+    return 2;
+  }
+  std::map<uint16_t, std::vector<uint8_t>> files;
+  RecorderChunkDecoder decoder;
+  uint32_t chunks = 0;
+  int c;
+  while ((c = fgetc(in)) != EOF) {
+    if (!decoder.push((uint8_t)c)) continue;
+    chunks++;
+    std::vector<uint8_t>& f = files[decoder.fileIndex];
+    if (f.size() < decoder.offset + decoder.len) f.resize(decoder.offset + decoder.len);
+    memcpy(f.data() + decoder.offset, decoder.data, decoder.len);
+  }
+  fclose(in);
+
+  mkdir(outDir, 0755);
+  for (const auto& f : files) {
+    char path[512];
+    snprintf(path, sizeof(path), "%s/%05u.erl", outDir, f.first);
+    FILE* out = fopen(path, "wb");
+    if (out == NULL) continue;
+    fwrite(f.second.data(), 1, f.second.size(), out);
+    fclose(out);
+    printf("%s: %zu octeți\n", path, f.second.size());
+  }
+  printf("%u bucăți, %u cu CRC greșit, %zu fișiere\n", chunks, decoder.errors(), files.size());
+  return files.empty() ? 1 : 0;
+}
+
+static void usage(const char* program) {
+  fprintf(stderr, "Utilizare: %s [--text cale] [--astept-frana] [--astept-accident] jurnal.erl|director ...\n"
+                  "           %s --extrage captura_bt.bin director\n", program, program);
+}
+
+int main(int argc, char** argv) {
+  const char* textPath = NULL;
+  bool expectBrake = false;
+  bool expectAccident = false;
+  std::vector<std::string> paths;
+
+  for (int i = 1; i < argc; i++) {
+    if (strcmp(argv[i], "--extrage") == 0) {
+      if (i + 2 >= argc) {
+        usage(argv[0]);
+        return 2;
+      }
+      return extract(argv[i + 1], argv[i + 2]);
+    } else if (strcmp(argv[i], "--text") == 0 && i + 1 < argc) {
+      textPath = argv[++i];
+    } else if (strcmp(argv[i], "--astept-frana") == 0) {
+      expectBrake = true;
+    } else if (strcmp(argv[i], "--astept-accident") == 0) {
+      expectAccident = true;
+    } else if (argv[i][0] == '-') {
+      usage(argv[0]);
+      return 2;
+    } else {
+      addPath(argv[i], paths);
+    }
+  }
+
+  std::vector<MappedLog> logs;
+  for (const std::string& p : paths) {
+    MappedLog log;
+    if (mapLog(p, log)) logs.push_back(log);
+    else fprintf(stderr, "Nu este un jurnal valid: %s\n", p.c_str());
+  }
+  if (logs.empty()) {
+    usage(argv[0]);
+    return 2;
+  }
+  std::sort(logs.begin(), logs.end(),
+            [](const MappedLog& a, const MappedLog& b) { return a.header.fileIndex < b.header.fileIndex; });
+
+  FILE* text = NULL;
+  if (textPath != NULL && (text = fopen(textPath, "w")) == NULL) {
+    fprintf(stderr, "Nu pot scrie %s\n", textPath);
+    return 2;
+  }
+
+  Replay replay(text);
+  auto start = std::chrono::steady_clock::now();
+  for (const MappedLog& log : logs) {
+    RecorderReader reader(log.data, log.len);
+    replay.setCompass(log.header);
+    printf("%s (fișierul %lu, busolă %s)\n", log.path.c_str(), (unsigned long)log.header.fileIndex,
+           (log.header.flags & RECORDER_FLAG_CALIBRATED) ? "calibrată" : "necalibrată");
+    RecorderEvent e;
+    while (reader.next(e)) replay.feed(e);
+    replay.counts.blocks += reader.stats().blocks;
+    replay.counts.corruptBlocks += reader.stats().corruptBlocks;
+    replay.counts.skippedBytes += reader.stats().skippedBytes;
+  }
+  double wallS = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+  if (text != NULL) fclose(text);
+
+  const Counts& c = replay.counts;
+  printf("\n%u blocuri (%u corupte, %u octeți săriți)\n", c.blocks, c.corruptBlocks, c.skippedBytes);
+  printf("Înregistrări: %u distanțe, %u eșantioane Arduino, %u stări de mers, %u RFID, %u comenzi "
+         "(%u de control continuu)\n", c.byType[RECORD_RANGE], c.byType[RECORD_ARDUINO], c.byType[RECORD_DRIVE],
+         c.byType[RECORD_RFID], c.byType[RECORD_COMMAND], c.controlFrames);
+  printf("Jurnal de %.2f s reluat în %.1f ms (x%.0f față de timpul real)\n", replay.seconds(), wallS * 1000,
+         wallS > 0 ? replay.seconds() / wallS : 0.0);
+  printf("Frâne: %u în reluare, %u în jurnal; accidente în reluare: %u\n\n", c.replayBrakes, c.loggedBrakes,
+         c.accidents);
+
+  bool allOk = report("Jurnal: fără blocuri corupte", c.corruptBlocks == 0, "");
+  char detail[64];
+  if (expectBrake) {
+    snprintf(detail, sizeof(detail), "%u în reluare, %u în jurnal", c.replayBrakes, c.loggedBrakes);
+    allOk &= report("Reluare: frâna automată", c.replayBrakes > 0 && c.loggedBrakes > 0, detail);
+  }
+  if (expectAccident) {
+    snprintf(detail, sizeof(detail), "%u detecții", c.accidents);
+    allOk &= report("Reluare: accident detectat", c.accidents > 0, detail);
+  }
+  return allOk ? 0 : 1;
+}
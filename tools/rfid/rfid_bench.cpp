@@ -0,0 +1,245 @@
+/**
+ * Test și măsurători pe calculator pentru driverul RFID al ESP32 (RfidProtocol.h, RfidTagCache.h).
+ *
+ * Verifică decodarea cadrelor YRM1003 (notificări de tag, erori, resincronizare după octeți
+ * corupți), evenimentele de sosire/plecare emise o singură dată, tabelul de dispersie față de
+ * o listă de referință la inserări și ștergeri aleatoare, apoi măsoară timpul decodării și al
+ * actualizării cache-ului pentru un cadru de tag.
+ *
+ * Compilare:
+ *   g++ -O2 -std=c++17 -I"../../firmware/Elysium RC/ESP32/sensors" rfid_bench.cpp -o rfid_bench
+ * Utilizare:
+ *   rfid_bench                 (teste și măsurători)
+ *   rfid_bench captura.bin     (plus o captură brută de pe UART: tag-urile și contoarele decodorului)
+ */
+
+#include "RfidProtocol.h"
+#include "RfidTagCache.h"
+#include "../common/CheckReport.h"
+
+#include <chrono>
+#include <cstdio>
+#include <vector>
+
+// Cadrul de notificare pe care îl trimite cititorul pentru un tag
+static std::vector<uint8_t> tagNotice(const RfidEpc& epc, int8_t rssi) {
+  uint8_t params[RFID_MAX_PARAMS];
+  params[0] = (uint8_t)rssi;
+  params[1] = (uint8_t)((epc.len / 2) << 3);   // PC: lungimea EPC în cuvinte
+  params[2] = 0x00;
+  memcpy(params + 3, epc.bytes, epc.len);
+  params[3 + epc.len] = 0x12;
+  params[4 + epc.len] = 0x34;
+  uint8_t frame[RFID_MAX_FRAME];
+  size_t n = rfidEncodeCommand(RFID_CMD_SINGLE_POLL, params, epc.len + 5, frame);
+  // Același format ca o comandă, doar tipul diferă (suma de control se corectează)
+  frame[1] = RFID_TYPE_NOTICE;
+  frame[n - 2] += RFID_TYPE_NOTICE;
+  return std::vector<uint8_t>(frame, frame + n);
+}
+
+static RfidEpc makeEpc(uint32_t id) {
+  RfidEpc epc;
+  epc.len = RFID_EPC_MAX;
+  for (int i = 0; i < RFID_EPC_MAX; i++) epc.bytes[i] = (uint8_t)(i < 8 ? 0xE2 + i : id >> (8 * (11 - i)));
+  return epc;
+}
+
+// Zgomot determinist
+static uint32_t nextRandom(uint32_t& state) {
+  state = state * 1664525u + 1013904223u;
+  return state >> 8;
+}
+
+static int feed(RfidDecoder& d, const std::vector<uint8_t>& bytes, std::vector<RfidTagRead>& reads) {
+  int frames = 0;
+  for (uint8_t b : bytes) {
+    if (!d.push(b)) continue;
+    frames++;
+    RfidTagRead r;
+    if (d.tagRead(r)) reads.push_back(r);
+  }
+  return frames;
+}
+
+int main(int argc, char** argv) {
+  bool allOk = true;
+  char detail[160];
+
+  {
+    // Comanda de inventar continuu, identică cu exemplul din documentația modulului
+    uint8_t params[3] = { 0x22, 0xFF, 0xFF };
+    uint8_t frame[RFID_MAX_FRAME];
+    size_t n = rfidEncodeCommand(RFID_CMD_MULTI_POLL, params, 3, frame);
+    const uint8_t expected[] = { 0xBB, 0x00, 0x27, 0x00, 0x03, 0x22, 0xFF, 0xFF, 0x4A, 0x7E };
+    bool ok = n == sizeof(expected) && memcmp(frame, expected, n) == 0;
+    allOk &= report("codarea comenzii 0x27", ok, ok ? "BB 00 27 00 03 22 FF FF 4A 7E" : "nepotrivire");
+  }
+  {
+    // Notificări valide, o eroare "fără tag", zgomot între cadre și un cadru corupt
+    RfidDecoder d;
+    std::vector<uint8_t> stream = { 0x00, 0x55 };
+    auto a = tagNotice(makeEpc(1), -52);
+    auto b = tagNotice(makeEpc(2), -70);
+    stream.insert(stream.end(), a.begin(), a.end());
+    const uint8_t noTag[] = { 0xBB, 0x01, 0xFF, 0x00, 0x01, 0x15, 0x16, 0x7E };
+    stream.insert(stream.end(), noTag, noTag + sizeof(noTag));
+    auto corrupt = b;
+    corrupt[8] ^= 0x40;
+    stream.insert(stream.end(), corrupt.begin(), corrupt.end());
+    stream.insert(stream.end(), b.begin(), b.end());
+
+    std::vector<RfidTagRead> reads;
+    int errorCode = -1;
+    int frames = 0;
+    for (uint8_t x : stream) {
+      if (!d.push(x)) continue;
+      frames++;
+      RfidTagRead r;
+      if (d.tagRead(r)) reads.push_back(r);
+      else errorCode = d.errorCode();
+    }
+    bool ok = frames == 3 && reads.size() == 2 && reads[0].epc == makeEpc(1) && reads[0].rssi == -52 &&
+              reads[1].epc == makeEpc(2) && errorCode == RFID_ERROR_NO_TAG && d.checksumErrors == 1;
+    snprintf(detail, sizeof(detail), "%d cadre, %zu tag-uri, %lu corupte, %lu octeți ignorați", frames,
+             reads.size(), (unsigned long)d.checksumErrors, (unsigned long)d.resyncBytes);
+    allOk &= report("decodare și resincronizare", ok, detail);
+  }
+  {
+    // Tag-uri care stau în câmp și pleacă: o singură sosire și o singură plecare fiecare
+    RfidTagCache cache(500);
+    int arrivals = 0, departures = 0;
+    for (uint32_t t = 0; t < 3000; t += 10) {
+      // Tagul 1 stă tot timpul; tagul 2 doar între 1000 și 1500 ms; citiri la 10 ms, cu goluri
+      RfidTagRead r;
+      r.rssi = -60;
+      RfidTagEvent e, evicted;
+      bool ev;
+      if (t % 100 != 50) {
+        r.epc = makeEpc(1);
+        if (cache.observe(r, t, e, evicted, ev)) arrivals++;
+      }
+      if (t >= 1000 && t < 1500) {
+        r.epc = makeEpc(2);
+        if (cache.observe(r, t, e, evicted, ev)) arrivals++;
+      }
+      while (cache.expire(t, e)) departures++;
+    }
+    bool ok = arrivals == 2 && departures == 1 && cache.count() == 1;
+    snprintf(detail, sizeof(detail), "%d sosiri, %d plecări, %lu citiri", arrivals, departures,
+             (unsigned long)cache.stats().reads);
+    allOk &= report("sosire și plecare o singură dată", ok, detail);
+  }
+  {
+    // Tabelul comparat cu o listă simplă: sosiri, plecări și înlocuiri aleatoare
+    RfidTagCache cache(300);
+    std::vector<std::pair<uint32_t, uint32_t>> reference;   // (id, ultima citire)
+    uint32_t seed = 7;
+    bool ok = true;
+    for (uint32_t t = 0; t < 200000 && ok; t += 3) {
+      // Populația de tag-uri alunecă în timp: cele vechi pleacă, iar uneori sunt prea multe în câmp
+      uint32_t id = t / 2000 + nextRandom(seed) % (t % 40000 < 20000 ? 12 : 40);
+      RfidTagRead r;
+      r.epc = makeEpc(id);
+      r.rssi = -50;
+      RfidTagEvent e, evicted;
+      bool evictedValid;
+      bool arrived = cache.observe(r, t, e, evicted, evictedValid);
+
+      if (evictedValid) {
+        size_t oldest = 0;
+        for (size_t i = 1; i < reference.size(); i++) {
+          if (reference[i].second < reference[oldest].second) oldest = i;
+        }
+        ok &= evicted.epc == makeEpc(reference[oldest].first);
+        reference.erase(reference.begin() + oldest);
+      }
+      bool known = false;
+      for (auto& entry : reference) {
+        if (entry.first == id) {
+          entry.second = t;
+          known = true;
+        }
+      }
+      ok &= arrived == !known;
+      if (!known) reference.push_back({id, t});
+
+      while (cache.expire(t, e)) {
+        bool found = false;
+        for (size_t i = 0; i < reference.size(); i++) {
+          if (e.epc == makeEpc(reference[i].first)) {
+            ok &= t - reference[i].second >= 300;
+            reference.erase(reference.begin() + i);
+            found = true;
+            break;
+          }
+        }
+        ok &= found;
+      }
+      ok &= cache.count() == (int)reference.size();
+      for (auto& entry : reference) {
+        RfidTagEvent found;
+        ok &= cache.lookup(makeEpc(entry.first), found) && found.lastSeenMs == entry.second;
+      }
+    }
+    const RfidCacheStats& s = cache.stats();
+    snprintf(detail, sizeof(detail), "%lu sosiri, %lu plecări (%lu înlocuiri), sondare max %u",
+             (unsigned long)s.arrivals, (unsigned long)s.departures, (unsigned long)s.evictions, s.maxProbe);
+    allOk &= report("tabel față de referință", ok && s.evictions > 0 && s.departures > s.evictions, detail);
+  }
+
+  {
+    // Timpul pe cadru: decodare + actualizarea cache-ului, 20 de tag-uri în câmp
+    std::vector<uint8_t> stream;
+    for (int i = 0; i < 2000; i++) {
+      auto f = tagNotice(makeEpc(i % 20), (int8_t)(-40 - i % 30));
+      stream.insert(stream.end(), f.begin(), f.end());
+    }
+    RfidDecoder d;
+    RfidTagCache cache;
+    const int rounds = 200;
+    uint32_t now = 0;
+    size_t frames = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+      for (uint8_t b : stream) {
+        if (!d.push(b)) continue;
+        frames++;
+        RfidTagRead read;
+        RfidTagEvent e, evicted;
+        bool ev;
+        if (d.tagRead(read)) cache.observe(read, now, e, evicted, ev);
+      }
+      now += 5;
+    }
+    double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+    size_t frameLen = stream.size() / 2000;
+    printf("\nCadru de tag (%zu octeți): %.1f ns decodare + cache; la %d baud linia duce %.0f citiri/s\n",
+           frameLen, ns / frames, 115200, 115200 / 10.0 / frameLen);
+  }
+
+  if (argc > 1) {
+    FILE* f = fopen(argv[1], "rb");
+    if (!f) {
+      fprintf(stderr, "Nu pot citi captura %s\n", argv[1]);
+      return 2;
+    }
+    std::vector<uint8_t> bytes;
+    int c;
+    while ((c = fgetc(f)) != EOF) bytes.push_back((uint8_t)c);
+    fclose(f);
+    RfidDecoder d;
+    std::vector<RfidTagRead> reads;
+    int frames = feed(d, bytes, reads);
+    for (const RfidTagRead& r : reads) {
+      char hex[2 * RFID_EPC_MAX + 1];
+      rfidEpcToHex(r.epc, hex);
+      printf("%s %d\n", hex, r.rssi);
+    }
+    fprintf(stderr, "%d cadre, %zu tag-uri, %lu corupte, %lu prea lungi, %lu octeți ignorați\n", frames,
+            reads.size(), (unsigned long)d.checksumErrors, (unsigned long)d.oversize,
+            (unsigned long)d.resyncBytes);
+  }
+
+  return allOk ? 0 : 1;
+}
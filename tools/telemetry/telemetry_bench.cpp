@@ -0,0 +1,108 @@
+/**
+ * Măsurători pe calculator pentru formatul binar de telemetrie Elysium RC.
+ *
+ * Simulează un traseu (bucla principală la 10 ms), compară traficul Bluetooth
+ * al vechiului format text cu cel al cadrelor binare și măsoară viteza de decodare.
+ *
+ * Compilare:
+ *   g++ -O2 -std=c++17 -I"../../firmware/Elysium RC/ESP32/core" telemetry_bench.cpp -o telemetry_bench
+ */
+
+#include "TelemetryCodec.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <vector>
+
+static const int LOOP_MS = 10;
+static const int PERIOD_MS = 50;
+static const int KEYFRAME_MS = 1000;
+static const int DURATION_MS = 10 * 60 * 1000;
+
+// Traseu sintetic: obstacole care se apropie și se depărtează, encoder, busolă, baterie
+static void simulate(uint32_t t, TelemetrySample& s) {
+  double sec = t / 1000.0;
+  // senzorii se actualizează la 200 ms fiecare (un senzor la 50 ms)
+  uint32_t slot = t / 200;
+  s.value[TELEMETRY_CH_US_FRONT] = (int32_t)(80 + 60 * std::sin(slot * 0.05));
+  s.value[TELEMETRY_CH_US_LEFT]  = (int32_t)(40 + 10 * std::sin(slot * 0.11));
+  s.value[TELEMETRY_CH_US_BACK]  = (slot % 37 == 0) ? -1 : 150;
+  s.value[TELEMETRY_CH_US_RIGHT] = (int32_t)(35 + 5 * std::cos(slot * 0.07));
+  // Arduino trimite la 100 ms
+  uint32_t ard = t / 100;
+  s.value[TELEMETRY_CH_ENCODER]   = (int32_t)(ard * 12);
+  s.value[TELEMETRY_CH_COMPASS_X] = (int32_t)(1200 * std::cos(ard * 0.01)) + (int32_t)(ard % 3);
+  s.value[TELEMETRY_CH_COMPASS_Y] = (int32_t)(1200 * std::sin(ard * 0.01));
+  s.value[TELEMETRY_CH_COMPASS_Z] = -400 + (int32_t)(ard % 2);
+  s.value[TELEMETRY_CH_VOLTAGE]   = 780 - (int32_t)(sec / 20);
+  s.value[TELEMETRY_CH_MOTOR_DIR]   = (slot / 50) % 2 ? 1 : 0;
+  s.value[TELEMETRY_CH_MOTOR_PWM]   = s.value[TELEMETRY_CH_MOTOR_DIR] ? 190 : 0;
+  s.value[TELEMETRY_CH_SERVO_ANGLE] = (slot / 30) % 3 == 0 ? 38 : ((slot / 30) % 3 == 1 ? 0 : 80);
+  s.rfidLen = 0;
+  if ((slot / 100) % 5 == 1) {
+    const char* tag = "E20000172211011718905C4A";
+    s.rfidLen = 24;
+    memcpy(s.rfid, tag, 24);
+  }
+}
+
+int main() {
+  TelemetryEncoder encoder;
+  std::vector<uint8_t> stream;
+  size_t textBytes = 0;
+  size_t frames = 0;
+  uint32_t lastSend = 0, lastKey = 0;
+  bool first = true;
+
+  for (uint32_t t = 0; t < (uint32_t)DURATION_MS; t += LOOP_MS) {
+    TelemetrySample s;
+    simulate(t, s);
+
+    // vechiul format: println("f,b,l,r") la fiecare loop()
+    char line[64];
+    textBytes += snprintf(line, sizeof(line), "%d,%d,%d,%d\r\n",
+                          (int)s.value[TELEMETRY_CH_US_FRONT], (int)s.value[TELEMETRY_CH_US_BACK],
+                          (int)s.value[TELEMETRY_CH_US_LEFT], (int)s.value[TELEMETRY_CH_US_RIGHT]);
+
+    if (!first && t - lastSend < (uint32_t)PERIOD_MS) continue;
+    lastSend = t;
+    bool key = first || (t - lastKey >= (uint32_t)KEYFRAME_MS);
+    if (!key && !encoder.changed(s)) continue;
+    if (key) lastKey = t;
+    first = false;
+
+    uint8_t frame[TELEMETRY_MAX_FRAME];
+    size_t len = encoder.encode(s, t, key, frame);
+    stream.insert(stream.end(), frame, frame + len);
+    frames++;
+  }
+
+  double seconds = DURATION_MS / 1000.0;
+  printf("Durata simulată: %.0f s\n", seconds);
+  printf("Text (doar 4 distanțe): %zu octeți, %.1f B/s\n", textBytes, textBytes / seconds);
+  printf("Binar (toate canalele): %zu octeți, %.1f B/s, %zu cadre, %.1f B/cadru\n",
+         stream.size(), stream.size() / seconds, frames, (double)stream.size() / frames);
+
+  // Viteza de decodare: decodăm fluxul de mai multe ori
+  const int ROUNDS = 200;
+  size_t decoded = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < ROUNDS; r++) {
+    TelemetryDecoder decoder;
+    for (uint8_t b : stream) {
+      if (decoder.push(b)) decoded++;
+    }
+  }
+  auto end = std::chrono::steady_clock::now();
+  double elapsed = std::chrono::duration<double>(end - start).count();
+  printf("Decodare: %.2f MB/s, %.0f cadre/s (%zu cadre)\n",
+         stream.size() * (double)ROUNDS / elapsed / 1e6, decoded / elapsed, decoded);
+
+  // Verificare: ultimul eșantion decodat trebuie să fie identic cu cel transmis
+  TelemetryDecoder check;
+  for (uint8_t b : stream) check.push(b);
+  printf("Cadre valide: %u, erori CRC: %u, salturi de secvență: %u\n",
+         check.framesOk, check.crcErrors, check.sequenceGaps);
+  return (check.framesOk == frames && check.crcErrors == 0) ? 0 : 1;
+}
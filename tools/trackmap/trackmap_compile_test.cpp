@@ -0,0 +1,9 @@
+/**
+ * Testul de compilare al hărții traseului: un TrackMapData.h generat cu trackmap_gen --aleator
+ * (tools/host-sim/CMakeLists.txt) trebuie să treacă static_assert-ul trackMapValid() și pentru
+ * o hartă mult mai mare decât pista, fără să atingă limita de recursie constexpr.
+ */
+
+#include "TrackMapData.h"
+
+static_assert(TRACK_MAP_TAG_COUNT >= 1000, "testul are nevoie de o hartă mare");
@@ -0,0 +1,413 @@
+/**
+ * Generatorul hărții traseului pentru ESP32 (navigation/TrackMap.h): din lista tag-urilor RFID
+ * cu poziție cunoscută construiește tabelul de dispersie perfectă și scrie TrackMapData.h.
+ *
+ * Harta este un CSV, câte un tag pe linie (# începe un comentariu, antetul este ignorat):
+ *   epc,x,y,orientare,limita,zona,atribute
+ *     epc        EPC-ul în hex (cel mult 24 de cifre)
+ *     x, y       poziția în metri, în sistemul de coordonate al odometriei
+ *     orientare  grade, sens trigonometric; gol dacă tagul poate fi trecut în ambele sensuri
+ *     limita     viteza maximă în m/s în zona care începe la tag; gol sau 0 = fără limită
+ *     zona       identificatorul zonei (0..255)
+ *     atribute   opțional: "stop" pentru o linie de oprire
+ *
+ * Pentru fiecare găleată se caută un seed cu care toate cheile ei cad în locuri libere; dacă
+ * o găleată nu are seed, tabelul se dublează. Două EPC-uri identice sau cu aceeași dispersie
+ * FNV-1a nu pot fi separate și opresc generarea. Tabelul rezultat este verificat: fiecare tag
+ * se găsește, iar EPC-urile care nu sunt pe hartă nu se găsesc.
+ *
+ * Compilare:
+ *   g++ -O2 -std=c++17 -I"../../firmware/Elysium RC/ESP32/navigation" trackmap_gen.cpp -o trackmap_gen
+ * Utilizare:
+ *   trackmap_gen                                  (teste pe hărți aleatoare și măsurători)
+ *   trackmap_gen harta_pista.csv                  (doar verificarea hărții)
+ *   trackmap_gen harta_pista.csv TrackMapData.h   (plus scrierea tabelului)
+ *   trackmap_gen --aleator n TrackMapData.h       (hartă aleatoare de n tag-uri, pentru testul
+ *                                                  de compilare din tools/host-sim)
+ */
+
+#include "TrackMap.h"
+#include "NavigationMath.h"
+#include "../common/CheckReport.h"
+
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+struct TrackTable {
+  uint32_t buckets;
+  uint32_t slots;
+  std::vector<uint16_t> seeds;
+  std::vector<TrackTag> tags;
+  uint64_t seedTries;          // încercări de seed, pentru raport
+};
+
+// Rezultatele măsurătorilor, ca optimizatorul să nu elimine căutările
+static volatile uint64_t resultSink;
+
+static uint32_t epcHash(const RfidEpc& epc) {
+  return trackEpcHash(epc.bytes, epc.len);
+}
+
+static const TrackTag* find(const TrackTable& t, const RfidEpc& epc) {
+  return trackMapLookup(epc, t.tags.data(), t.seeds.data(), t.buckets, t.slots);
+}
+
+/**
+ * Construiește tabelul; întoarce false (cu motivul în error) dacă două tag-uri nu pot fi separate
+ */
+static bool buildTable(const std::vector<TrackTag>& input, TrackTable& out, std::string& error) {
+  size_t n = input.size();
+  for (size_t i = 0; i < n; i++) {
+    if (input[i].epc.len == 0) {
+      error = "EPC gol";
+      return false;
+    }
+    for (size_t j = i + 1; j < n; j++) {
+      char hex[2 * RFID_EPC_MAX + 1];
+      rfidEpcToHex(input[j].epc, hex);
+      if (input[i].epc == input[j].epc) {
+        error = std::string("EPC duplicat ") + hex;
+        return false;
+      }
+      if (epcHash(input[i].epc) == epcHash(input[j].epc)) {
+        error = std::string("coliziune FNV-1a pentru ") + hex;
+        return false;
+      }
+    }
+  }
+
+  // Încărcare de cel mult 80%, găleți de ~3 chei
+  uint32_t slots = 1;
+  while (slots * 4 < n * 5) slots <<= 1;
+  uint32_t buckets = n > 3 ? (uint32_t)((n + 2) / 3) : 1;
+  out.seedTries = 0;
+
+  while (true) {
+    std::vector<std::vector<size_t>> members(buckets);
+    for (size_t i = 0; i < n; i++) members[epcHash(input[i].epc) % buckets].push_back(i);
+    // Gălețile mari întâi, cât tabelul este gol
+    std::vector<uint32_t> order(buckets);
+    for (uint32_t b = 0; b < buckets; b++) order[b] = b;
+    std::stable_sort(order.begin(), order.end(),
+                     [&](uint32_t a, uint32_t b) { return members[a].size() > members[b].size(); });
+
+    out.buckets = buckets;
+    out.slots = slots;
+    out.seeds.assign(buckets, 0);
+    out.tags.assign(slots, TrackTag());
+    std::vector<bool> used(slots, false);
+    bool placed = true;
+
+    for (uint32_t b : order) {
+      if (members[b].empty()) break;
+      bool found = false;
+      for (uint32_t seed = 0; seed <= 0xFFFF && !found; seed++) {
+        out.seedTries++;
+        std::vector<uint32_t> taken;
+        bool ok = true;
+        for (size_t i : members[b]) {
+          uint32_t slot = trackMix(epcHash(input[i].epc) ^ seed) & (slots - 1);
+          if (used[slot] || std::find(taken.begin(), taken.end(), slot) != taken.end()) {
+            ok = false;
+            break;
+          }
+          taken.push_back(slot);
+        }
+        if (!ok) continue;
+        out.seeds[b] = (uint16_t)seed;
+        for (size_t k = 0; k < taken.size(); k++) {
+          used[taken[k]] = true;
+          out.tags[taken[k]] = input[members[b][k]];
+        }
+        found = true;
+      }
+      if (!found) {
+        placed = false;
+        break;
+      }
+    }
+    if (placed) return true;
+    slots <<= 1;
+  }
+}
+
+// Fiecare tag se găsește la locul lui, nimic altceva nu se găsește
+static bool verifyTable(const TrackTable& t, const std::vector<TrackTag>& input, uint32_t strangers,
+                        uint32_t& falseHits) {
+  bool ok = trackMapValid(t.tags.data(), t.seeds.data(), t.buckets, t.slots);
+  for (const TrackTag& tag : input) {
+    const TrackTag* hit = find(t, tag.epc);
+    ok &= hit != NULL && hit->epc == tag.epc && hit->x == tag.x && hit->y == tag.y;
+  }
+  falseHits = 0;
+  uint32_t state = 12345;
+  for (uint32_t i = 0; i < strangers; i++) {
+    RfidEpc epc;
+    epc.len = RFID_EPC_MAX;
+    for (int k = 0; k < RFID_EPC_MAX; k++) {
+      state = state * 1664525u + 1013904223u;
+      epc.bytes[k] = (uint8_t)(state >> 24);
+    }
+    bool onMap = false;
+    for (const TrackTag& tag : input) onMap |= tag.epc == epc;
+    if (!onMap && find(t, epc) != NULL) falseHits++;
+  }
+  return ok && falseHits == 0;
+}
+
+static bool parseEpc(const std::string& text, RfidEpc& epc) {
+  if (text.empty() || text.size() % 2 != 0 || text.size() > 2 * RFID_EPC_MAX) return false;
+  epc.len = (uint8_t)(text.size() / 2);
+  for (size_t i = 0; i < epc.len; i++) {
+    if (!isxdigit((unsigned char)text[2 * i]) || !isxdigit((unsigned char)text[2 * i + 1])) return false;
+    char byte[3] = { text[2 * i], text[2 * i + 1], 0 };
+    epc.bytes[i] = (uint8_t)strtol(byte, NULL, 16);
+  }
+  return true;
+}
+
+static std::string trim(const std::string& s) {
+  size_t a = s.find_first_not_of(" \t\r\n");
+  if (a == std::string::npos) return "";
+  size_t b = s.find_last_not_of(" \t\r\n");
+  return s.substr(a, b - a + 1);
+}
+
+static bool loadCsv(const char* path, std::vector<TrackTag>& tags) {
+  FILE* f = fopen(path, "r");
+  if (!f) {
+    fprintf(stderr, "Nu pot citi harta %s\n", path);
+    return false;
+  }
+  char line[512];
+  int lineNo = 0;
+  bool ok = true;
+  while (fgets(line, sizeof(line), f)) {
+    lineNo++;
+    std::string text(line);
+    size_t hash = text.find('#');
+    if (hash != std::string::npos) text.resize(hash);
+    if (trim(text).empty()) continue;
+
+    std::vector<std::string> fields;
+    size_t start = 0;
+    while (true) {
+      size_t comma = text.find(',', start);
+      fields.push_back(trim(text.substr(start, comma == std::string::npos ? std::string::npos : comma - start)));
+      if (comma == std::string::npos) break;
+      start = comma + 1;
+    }
+    while (fields.size() < 7) fields.push_back("");
+
+    TrackTag tag = TrackTag();
+    if (!parseEpc(fields[0], tag.epc)) {
+      if (tags.empty() && fields[0] == "epc") continue;   // antetul
+      fprintf(stderr, "%s:%d: EPC invalid \"%s\"\n", path, lineNo, fields[0].c_str());
+      ok = false;
+      continue;
+    }
+    char* end;
+    tag.x = strtof(fields[1].c_str(), &end);
+    bool valid = !fields[1].empty() && *end == '\0';
+    tag.y = strtof(fields[2].c_str(), &end);
+    valid &= !fields[2].empty() && *end == '\0';
+    if (!fields[3].empty()) {
+      float degrees = strtof(fields[3].c_str(), &end);
+      valid &= *end == '\0';
+      tag.heading = navWrapAngle((float)(degrees * M_PI / 180.0));
+      tag.flags |= TRACK_TAG_HEADING;
+    }
+    if (!fields[4].empty()) {
+      tag.speedLimit = strtof(fields[4].c_str(), &end);
+      valid &= *end == '\0' && tag.speedLimit >= 0;
+    }
+    if (!fields[5].empty()) {
+      long zone = strtol(fields[5].c_str(), &end, 10);
+      valid &= *end == '\0' && zone >= 0 && zone <= 255;
+      tag.zone = (uint8_t)zone;
+    }
+    if (fields[6] == "stop") tag.flags |= TRACK_TAG_STOP;
+    else valid &= fields[6].empty();
+
+    if (!valid) {
+      fprintf(stderr, "%s:%d: câmp invalid\n", path, lineNo);
+      ok = false;
+      continue;
+    }
+    tags.push_back(tag);
+  }
+  fclose(f);
+  return ok;
+}
+
+static bool writeHeader(const char* path, const char* source, const TrackTable& t, size_t count) {
+  FILE* f = fopen(path, "w");
+  if (!f) {
+    fprintf(stderr, "Nu pot scrie %s\n", path);
+    return false;
+  }
+  const char* name = strrchr(source, '/');
+  name = name ? name + 1 : source;
+
+  fprintf(f, "#ifndef TRACK_MAP_DATA_H\n#define TRACK_MAP_DATA_H\n\n");
+  fprintf(f, "/**\n * Harta traseului, generată de tools/trackmap/trackmap_gen din %s; nu se editează manual.\n", name);
+  fprintf(f, " * %zu tag-uri în %u locuri, %u găleți.\n */\n\n", count, t.slots, t.buckets);
+  fprintf(f, "#include \"TrackMap.h\"\n\n");
+  fprintf(f, "#define TRACK_MAP_TAG_COUNT %zu\n#define TRACK_MAP_BUCKETS %u\n#define TRACK_MAP_SLOTS %u\n\n",
+          count, t.buckets, t.slots);
+
+  fprintf(f, "static constexpr uint16_t TRACK_MAP_SEEDS[TRACK_MAP_BUCKETS] = {");
+  for (uint32_t b = 0; b < t.buckets; b++) {
+    fprintf(f, "%s%u", b % 12 == 0 ? "\n  " : " ", t.seeds[b]);
+    if (b + 1 < t.buckets) fputc(',', f);
+  }
+  fprintf(f, "\n};\n\n");
+
+  fprintf(f, "// { { lungime, EPC }, x, y, orientare, limită, zonă, atribute }\n");
+  fprintf(f, "static constexpr TrackTag TRACK_MAP_TAGS[TRACK_MAP_SLOTS] = {\n");
+  for (uint32_t i = 0; i < t.slots; i++) {
+    const TrackTag& tag = t.tags[i];
+    if (tag.epc.len == 0) {
+      fprintf(f, "  { { 0, { 0 } }, 0, 0, 0, 0, 0, 0 },\n");
+      continue;
+    }
+    fprintf(f, "  { { %u, {", tag.epc.len);
+    for (uint8_t k = 0; k < tag.epc.len; k++) fprintf(f, "%s0x%02X", k ? ", " : " ", tag.epc.bytes[k]);
+    fprintf(f, " } }, %.3ff, %.3ff, %.5ff, %.2ff, %u, 0x%02X },\n", tag.x, tag.y, tag.heading, tag.speedLimit,
+            tag.zone, tag.flags);
+  }
+  fprintf(f, "};\n\n");
+
+  fprintf(f, "static_assert((TRACK_MAP_SLOTS & (TRACK_MAP_SLOTS - 1)) == 0, \"TRACK_MAP_SLOTS trebuie sa fie putere a lui 2\");\n");
+  fprintf(f, "static_assert(trackMapValid(TRACK_MAP_TAGS, TRACK_MAP_SEEDS, TRACK_MAP_BUCKETS, TRACK_MAP_SLOTS),\n");
+  fprintf(f, "              \"harta traseului are coliziuni: regenerati TrackMapData.h\");\n\n");
+  fprintf(f, "static inline const TrackTag* trackMapFind(const RfidEpc& epc) {\n");
+  fprintf(f, "  return trackMapLookup(epc, TRACK_MAP_TAGS, TRACK_MAP_SEEDS, TRACK_MAP_BUCKETS, TRACK_MAP_SLOTS);\n}\n\n");
+  fprintf(f, "#endif\n");
+  fclose(f);
+  return true;
+}
+
+static std::vector<TrackTag> randomMap(size_t n, uint32_t seed) {
+  std::vector<TrackTag> tags;
+  uint32_t state = seed;
+  for (size_t i = 0; i < n; i++) {
+    TrackTag tag = TrackTag();
+    tag.epc.len = RFID_EPC_MAX;
+    // Tag-uri din același lot: prefix comun, doar ultimii octeți diferă
+    for (int k = 0; k < RFID_EPC_MAX; k++) tag.epc.bytes[k] = (uint8_t)(k < 8 ? 0xE2 + k : 0);
+    state = state * 1664525u + 1013904223u;
+    uint32_t serial = (uint32_t)i * 7919u + (state >> 20);
+    for (int k = 0; k < 4; k++) tag.epc.bytes[8 + k] = (uint8_t)(serial >> (8 * (3 - k)));
+    tag.x = (float)i;
+    tag.y = (float)(state >> 16);
+    bool duplicate = false;
+    for (const TrackTag& other : tags) duplicate |= other.epc == tag.epc;
+    if (!duplicate) tags.push_back(tag);
+  }
+  return tags;
+}
+
+int main(int argc, char** argv) {
+  char detail[160];
+
+  if (argc > 1) {
+    std::vector<TrackTag> input;
+    bool generated = strcmp(argv[1], "--aleator") == 0;
+    if (generated) {
+      if (argc != 4) {
+        fprintf(stderr, "Utilizare: %s --aleator n TrackMapData.h\n", argv[0]);
+        return 2;
+      }
+      size_t n = strtoul(argv[2], NULL, 10);
+      input = randomMap(n, (uint32_t)n + 1);
+    } else if (!loadCsv(argv[1], input)) {
+      return 1;
+    }
+    TrackTable table;
+    std::string error;
+    if (!buildTable(input, table, error)) {
+      fprintf(stderr, "Harta nu poate fi generată: %s\n", error.c_str());
+      return 1;
+    }
+    uint32_t falseHits;
+    bool ok = verifyTable(table, input, 100000, falseHits);
+    snprintf(detail, sizeof(detail), "%zu tag-uri, %u locuri, %u găleți, %lu încercări", input.size(),
+             table.slots, table.buckets, (unsigned long)table.seedTries);
+    report("dispersie perfectă", ok, detail);
+    if (!ok) return 1;
+    if (generated) return writeHeader(argv[3], "hartă aleatoare", table, input.size()) ? 0 : 1;
+    if (argc > 2 && !writeHeader(argv[2], argv[1], table, input.size())) return 1;
+    return 0;
+  }
+
+  bool allOk = true;
+  {
+    // Hărți de diferite mărimi, cu EPC-uri dintr-un singur lot (cazul cel mai nefavorabil pentru dispersie)
+    const size_t sizes[] = { 0, 1, 2, 7, 40, 256, 1000 };
+    for (size_t n : sizes) {
+      std::vector<TrackTag> input = randomMap(n, (uint32_t)n + 1);
+      TrackTable table;
+      std::string error;
+      bool ok = buildTable(input, table, error);
+      uint32_t falseHits = 0;
+      if (ok) ok = verifyTable(table, input, 20000, falseHits);
+      char name[48];
+      snprintf(name, sizeof(name), "hartă de %zu tag-uri", n);
+      snprintf(detail, sizeof(detail), "%u locuri (încărcare %.0f%%), %u găleți, %lu încercări, %u false",
+               table.slots, table.slots ? 100.0 * input.size() / table.slots : 0.0, table.buckets,
+               (unsigned long)table.seedTries, falseHits);
+      allOk &= report(name, ok, detail);
+    }
+  }
+  {
+    // EPC-uri duplicate sunt refuzate
+    std::vector<TrackTag> input = randomMap(5, 3);
+    input.push_back(input[2]);
+    TrackTable table;
+    std::string error;
+    bool ok = !buildTable(input, table, error);
+    allOk &= report("EPC duplicat refuzat", ok, error.c_str());
+  }
+  {
+    // Timpul unei căutări, comparat cu parcurgerea listei
+    std::vector<TrackTag> input = randomMap(256, 99);
+    TrackTable table;
+    std::string error;
+    buildTable(input, table, error);
+    std::vector<RfidEpc> queries;
+    for (int i = 0; i < 4096; i++) queries.push_back(input[(i * 37) % input.size()].epc);
+
+    const int rounds = 200;
+    uint64_t sum = 0;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+      for (const RfidEpc& q : queries) sum += (uintptr_t)find(table, q);
+    }
+    double hashNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                    (rounds * queries.size());
+    start = std::chrono::steady_clock::now();
+    for (int r = 0; r < rounds; r++) {
+      for (const RfidEpc& q : queries) {
+        for (const TrackTag& tag : input) {
+          if (tag.epc == q) {
+            sum += (uintptr_t)&tag;
+            break;
+          }
+        }
+      }
+    }
+    double linearNs = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count() /
+                      (rounds * queries.size());
+    resultSink = sum;
+    printf("\nCăutare în harta de 256 de tag-uri: %.1f ns (listă: %.1f ns)\n", hashNs, linearNs);
+  }
+  return allOk ? 0 : 1;
+}
@@ -0,0 +1,211 @@
+/**
+ * Test și măsurători pe calculator pentru filtrul ultrasonic al ESP32 (RangeFilter.h).
+ *
+ * Reia urme de măsurători (sintetice sau înregistrate) prin filtru și verifică distanța și viteza
+ * estimate, respingerea salturilor, tratarea ecourilor lipsă și a estimărilor vechi,
+ * apoi măsoară timpul unei actualizări.
+ *
+ * Compilare:
+ *   g++ -O2 -std=c++17 -I"../../firmware/Elysium RC/ESP32/sensors" range_filter_bench.cpp -o range_filter_bench
+ * Utilizare:
+ *   range_filter_bench               (doar urmele sintetice)
+ *   range_filter_bench urma.txt      (plus o urmă: câte o linie "timp_us senzor cm", cm = -1 fără ecou;
+ *                                     ieșirea filtrată se scrie pe stdout ca linii
+ *                                     "timp_us senzor brut distanță viteză încredere indicatori")
+ */
+
+#include "RangeFilter.h"
+#include "../common/CheckReport.h"
+
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <vector>
+
+#define SENSORS 4
+#define CHANNEL_PERIOD_US 200000UL   // fiecare canal este citit o dată la 4 x 50 ms
+
+struct Reading {
+  uint32_t timeUs;
+  int sensor;
+  float cm;                   // < 0 = fără ecou
+};
+
+// Zgomot determinist, uniform în [-amp, amp]
+static float noise(uint32_t& state, float amp) {
+  state = state * 1664525u + 1013904223u;
+  return amp * (((state >> 8) & 0xFFFF) / 32767.5f - 1.0f);
+}
+
+static void feed(RangeFilter& f, const Reading& r) {
+  if (r.cm < 0) f.miss();
+  else f.measure(r.cm, r.timeUs);
+}
+
+// Obiect care se apropie cu viteză constantă (rate < 0), cu zgomot de ±1 cm
+static std::vector<Reading> approach(float startCm, float rateCmS, int samples, uint32_t seed = 1) {
+  std::vector<Reading> out;
+  for (int i = 0; i < samples; i++) {
+    float t = i * CHANNEL_PERIOD_US * 1e-6f;
+    out.push_back({(uint32_t)(i * CHANNEL_PERIOD_US), 0, startCm + rateCmS * t + noise(seed, 1.0f)});
+  }
+  return out;
+}
+
+static float truth(float startCm, float rateCmS, uint32_t timeUs) {
+  return startCm + rateCmS * timeUs * 1e-6f;
+}
+
+// După stabilizare, eroarea maximă de distanță și eroarea finală de viteză
+static bool checkTracking(const char* name, const std::vector<Reading>& trace, float startCm, float rateCmS,
+                          float maxErrCm, float maxRateErr, uint32_t expectedOutliers) {
+  RangeFilter f;
+  float worst = 0;
+  int invalid = 0;
+  for (size_t i = 0; i < trace.size(); i++) {
+    feed(f, trace[i]);
+    if (i < 5) continue;
+    const RangeEstimate& e = f.estimate();
+    if (!e.valid()) {
+      invalid++;
+      continue;
+    }
+    float err = std::fabs(e.distanceCm - truth(startCm, rateCmS, e.updatedUs));
+    if (err > worst) worst = err;
+  }
+  float rateErr = std::fabs(f.estimate().rateCmS - rateCmS);
+  bool ok = worst <= maxErrCm && rateErr <= maxRateErr && invalid == 0 && f.stats().outliers == expectedOutliers;
+  char detail[160];
+  snprintf(detail, sizeof(detail), "eroare max %.1f cm, viteză %.1f cm/s (%.1f), respinse %lu, invalide %d",
+           worst, f.estimate().rateCmS, rateCmS, (unsigned long)f.stats().outliers, invalid);
+  return report(name, ok, detail);
+}
+
+static bool loadTrace(const char* path, std::vector<Reading>& trace) {
+  FILE* f = fopen(path, "r");
+  if (!f) return false;
+  unsigned long t;
+  int sensor;
+  float cm;
+  while (fscanf(f, "%lu %d %f", &t, &sensor, &cm) == 3) {
+    if (sensor >= 0 && sensor < SENSORS) trace.push_back({(uint32_t)t, sensor, cm});
+  }
+  fclose(f);
+  return !trace.empty();
+}
+
+int main(int argc, char** argv) {
+  bool allOk = true;
+
+  allOk &= checkTracking("apropiere 50 cm/s", approach(250, -50, 20), 250, -50, 3.0f, 8.0f, 0);
+  allOk &= checkTracking("obiect nemișcat", approach(120, 0, 30), 120, 0, 2.0f, 3.0f, 0);
+
+  {
+    // Ecouri multiple: salturi izolate de +150 cm, respinse fără a strica estimarea
+    std::vector<Reading> trace = approach(300, -40, 30);
+    for (size_t i = 7; i < trace.size(); i += 7) trace[i].cm += 150;
+    allOk &= checkTracking("salturi izolate (multipath)", trace, 300, -40, 4.0f, 8.0f, 4);
+  }
+  {
+    // Salturi mari în ambele sensuri (ecou de la perete, reflexie de la sol)
+    std::vector<Reading> trace = approach(200, -30, 30);
+    trace[12].cm = 390;
+    trace[20].cm = 15;
+    allOk &= checkTracking("salturi mari izolate", trace, 200, -30, 4.0f, 8.0f, 2);
+  }
+  {
+    // Câte un ecou lipsă izolat: canalul rămâne valid, estimarea continuă
+    std::vector<Reading> trace = approach(180, -20, 30);
+    for (size_t i = 6; i < trace.size(); i += 6) trace[i].cm = -1;
+    RangeFilter f;
+    int invalid = 0;
+    for (size_t i = 0; i < trace.size(); i++) {
+      feed(f, trace[i]);
+      if (i >= 5 && !f.estimate().valid()) invalid++;
+    }
+    char detail[96];
+    snprintf(detail, sizeof(detail), "invalide %d, fără ecou %lu", invalid, (unsigned long)f.stats().misses);
+    allOk &= report("ecouri lipsă izolate", invalid == 0 && !(f.estimate().flags & RANGE_NO_ECHO), detail);
+  }
+  {
+    // Obstacolul dispare: după RANGE_MISSES_NO_ECHO timeouturi canalul este liber, nu o distanță veche
+    std::vector<Reading> trace = approach(80, 0, 10);
+    uint32_t t = trace.back().timeUs;
+    for (int i = 1; i <= RANGE_MISSES_NO_ECHO; i++) trace.push_back({(uint32_t)(t + i * CHANNEL_PERIOD_US), 0, -1});
+    RangeFilter f;
+    for (const Reading& r : trace) feed(f, r);
+    const RangeEstimate& e = f.estimate();
+    allOk &= report("obstacol dispărut", !e.valid() && (e.flags & RANGE_NO_ECHO), "canal liber, fără distanță");
+  }
+  {
+    // Obiect nou apărut brusc (300 -> 60 cm): acceptat după RANGE_REACQUIRE_OUTLIERS eșantioane coerente
+    std::vector<Reading> trace = approach(300, 0, 10);
+    uint32_t t = trace.back().timeUs;
+    int acquiredAfter = -1;
+    RangeFilter f;
+    for (const Reading& r : trace) feed(f, r);
+    for (int i = 1; i <= 6; i++) {
+      f.measure(60 + (i & 1), t + i * CHANNEL_PERIOD_US);
+      if (acquiredAfter < 0 && f.estimate().valid() && std::fabs(f.estimate().distanceCm - 60) < 3) acquiredAfter = i;
+    }
+    char detail[96];
+    snprintf(detail, sizeof(detail), "valid după %d eșantioane, reachiziții %lu", acquiredAfter,
+             (unsigned long)f.stats().reacquired);
+    allOk &= report("obiect nou", acquiredAfter > 0 && acquiredAfter <= RANGE_REACQUIRE_OUTLIERS + 1, detail);
+  }
+  {
+    // Senzorul nu mai publică nimic: estimarea devine veche
+    RangeFilter f;
+    for (const Reading& r : approach(100, 0, 10)) feed(f, r);
+    uint32_t last = f.estimate().updatedUs;
+    f.age(last + RANGE_STALE_US / 2);
+    bool validBefore = f.estimate().valid();
+    f.age(last + RANGE_STALE_US + 1);
+    const RangeEstimate& e = f.estimate();
+    allOk &= report("estimare veche", validBefore && !e.valid() && (e.flags & RANGE_STALE), "invalidă după RANGE_STALE_US");
+  }
+
+  if (argc > 1) {
+    std::vector<Reading> trace;
+    if (!loadTrace(argv[1], trace)) {
+      fprintf(stderr, "Nu pot citi urma %s\n", argv[1]);
+      return 2;
+    }
+    RangeFilter filters[SENSORS];
+    for (const Reading& r : trace) {
+      feed(filters[r.sensor], r);
+      const RangeEstimate& e = filters[r.sensor].estimate();
+      printf("%lu %d %.0f %.1f %.1f %u 0x%02x\n", (unsigned long)r.timeUs, r.sensor, r.cm, e.distanceCm,
+             e.rateCmS, e.confidence, e.flags);
+    }
+    for (int s = 0; s < SENSORS; s++) {
+      const RangeFilterStats& st = filters[s].stats();
+      fprintf(stderr, "senzor %d: %lu acceptate, %lu respinse, %lu fără ecou, %lu reachiziții\n", s,
+              (unsigned long)st.accepted, (unsigned long)st.outliers, (unsigned long)st.misses,
+              (unsigned long)st.reacquired);
+    }
+  }
+
+  // Viteza filtrului: o urmă lungă cu salturi și ecouri lipsă
+  std::vector<Reading> trace;
+  uint32_t seed = 7;
+  for (int i = 0; i < 200000; i++) {
+    float cm = 150 + 100 * std::sin(i * 0.01f) + noise(seed, 1.0f);
+    if (i % 11 == 0) cm += 200;
+    if (i % 17 == 0) cm = -1;
+    trace.push_back({(uint32_t)(i * CHANNEL_PERIOD_US), 0, cm});
+  }
+  const int rounds = 10;
+  volatile float sink = 0;
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++) {
+    RangeFilter f;
+    for (const Reading& reading : trace) feed(f, reading);
+    sink = sink + f.estimate().distanceCm;
+  }
+  double ns = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+  printf("\nFiltrare: %.2f ns/măsurătoare (%zu măsurători x %d)\n", ns / (trace.size() * rounds), trace.size(), rounds);
+
+  return allOk ? 0 : 1;
+}